@@ -0,0 +1,43 @@
+# benchmark.cmake - a CMake script for building the microbenchmarks for a
+# project
+#
+# PROJECT_NAME is a CMake environment variable that contains the name of the
+#   project.
+# BUILD_BENCHMARKS is a CMake environment variable that sets whether to build
+#   the benchmarks for this project, defaults to off
+# BENCHMARKS is a CMake environment variable list that contains the benchmark
+#   source files to build with Google Benchmark
+# BENCHMARK_INCLUDE_DIRS is a CMake environment variable list that contains
+#   any extra include directories the benchmarks require, such as test data
+
+# ----- BENCHMARKS OPTION ----- #
+option(BUILD_BENCHMARKS "Create benchmarks (requires Google Benchmark)" OFF)
+
+# ----- BENCHMARKS ----- #
+if (BUILD_BENCHMARKS)
+    # make sure we have something to benchmark
+    if (BENCHMARKS)
+        # ----- LOOK FOR GOOGLE BENCHMARK ----- #
+        find_package(benchmark REQUIRED)
+
+        # ----- CREATE BENCHMARK EXE ----- #
+        add_executable(${PROJECT_NAME}-benchmarks ${BENCHMARKS})
+        set_target_properties(${PROJECT_NAME}-benchmarks PROPERTIES OUTPUT_NAME ${PROJECT_NAME}-benchmarks)
+        target_include_directories(${PROJECT_NAME}-benchmarks PRIVATE ${BENCHMARK_INCLUDE_DIRS})
+
+        # ----- LINK LIBRARIES ----- #
+        # Link the target library (if the target is a library)
+        get_target_property(target_type ${PROJECT_NAME} TYPE)
+        if (NOT "${target_type}" STREQUAL "EXECUTABLE")
+            target_link_libraries(${PROJECT_NAME}-benchmarks ${PROJECT_NAME})
+        endif ()
+
+        # link google benchmark
+        target_link_libraries(${PROJECT_NAME}-benchmarks benchmark::benchmark)
+
+        # link various optional libraries and flags
+        target_link_libraries(${PROJECT_NAME}-benchmarks ${PTHREADLIB})
+
+        # the benchmarks are run by hand, they are not part of the build
+    endif (BENCHMARKS)
+endif(BUILD_BENCHMARKS)
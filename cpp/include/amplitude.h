@@ -14,6 +14,13 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats amplitude validation error codes
+ */
+enum amplitudeerror {
+	amplitudeperiodinvalid, amplitudesnrinvalid, amplitudeerrorcount
+};
+
 /**
  * \brief detectionformats amplitude conversion class
  *
@@ -64,6 +71,27 @@ class amplitude : public detectionbase {
 	 */
 	amplitude(const amplitude & newamplitude);
 
+	/**
+	 * \brief amplitude move constructor
+	 *
+	 * The move constructor for the amplitude class.
+	 * Moves members from provided amplitude without copying them.
+	 *
+	 * \param newamplitude - A detectionformats::amplitude to move from
+	 */
+	amplitude(amplitude &&newamplitude) = default;
+
+	/**
+	 * \brief amplitude assignment operators
+	 *
+	 * Copies or moves members from provided amplitude.
+	 *
+	 * \param newamplitude - A detectionformats::amplitude to copy or move from
+	 * \return Returns a reference to this amplitude
+	 */
+	amplitude & operator=(const amplitude &newamplitude) = default;
+	amplitude & operator=(amplitude &&newamplitude) = default;
+
 	/**
 	 * \brief amplitude destructor
 	 *
@@ -86,6 +114,27 @@ class amplitude : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of amplitudeerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -100,7 +149,7 @@ class amplitude : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief amplitude ampvalue
@@ -0,0 +1,267 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_ARCHIVE_H
+#define DETECTION_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "detection.h" // NOLINT
+
+/**
+ * \brief the version of the archive segment format
+ */
+#define ARCHIVE_VERSION 1
+
+/**
+ * \brief default number of records in an archive segment
+ */
+#define ARCHIVE_SEGMENTRECORDS 65536
+
+/**
+ * \brief number of records of a type between entries of the segment index
+ */
+#define ARCHIVE_INDEXINTERVAL 64
+
+/**
+ * \brief the extension of archive segment files
+ */
+#define ARCHIVE_EXTENSION ".dfa"
+
+namespace detectionformats {
+/**
+ * \brief detectionformats archive writer class
+ *
+ * Appends picks, correlations, and detections to a time indexed archive.
+ *
+ * An archive is a series of segment files named from a base path, such as
+ * "picks.000000.dfa", "picks.000001.dfa", and so on. Each segment holds
+ * up to a set number of records, each one a message in the binary encoding
+ * (see ToBinary()) with its time, the pick or correlation time or the
+ * detection hypocenter time. A segment is written once it is full, or when
+ * the writer is sealed or destroyed, and is never changed afterwards, so
+ * new records always go to new segments, also after the archive is opened
+ * again.
+ *
+ * Within a segment the records are sorted by type, and then by time, and
+ * the segment ends with a sparse index holding the time and position of
+ * every ARCHIVE_INDEXINTERVAL'th record of each type, so that an
+ * archive_reader finds the records in a time window with a binary search
+ * instead of a scan.
+ *
+ * An archive_writer is not thread safe.
+ */
+class archive_writer {
+ public:
+	/**
+	 * \brief archive_writer constructor
+	 *
+	 * The constructor for the archive_writer class.
+	 * \param newbasepath - A std::string containing the path the segment
+	 * file names start with
+	 * \param newsegmentrecords - The number of records in each segment
+	 */
+	explicit archive_writer(const std::string &newbasepath,
+							size_t newsegmentrecords = ARCHIVE_SEGMENTRECORDS);
+
+	/**
+	 * \brief archive_writer destructor
+	 *
+	 * The destructor for the archive_writer class, seals the open segment.
+	 */
+	~archive_writer();
+
+	archive_writer(const archive_writer &newwriter) = delete;
+	archive_writer & operator=(const archive_writer &newwriter) = delete;
+
+	/**
+	 * \brief Append a message
+	 *
+	 * Adds the message to the open segment, writing the segment once it is
+	 * full.
+	 * \param object - The message to append
+	 * \return Returns true if the message was appended, false if its time
+	 * is not finite, throws std::runtime_error if a full segment could not be
+	 * written
+	 */
+	bool append(pick &object); // NOLINT
+	bool append(correlation &object); // NOLINT
+	bool append(detection &object); // NOLINT
+
+	/**
+	 * \brief Seal the open segment
+	 *
+	 * Writes the records appended since the last segment as a segment, if
+	 * there are any. Throws std::runtime_error if the segment could not be
+	 * written.
+	 */
+	void seal();
+
+	/**
+	 * \brief Gets the number of the next segment to be written
+	 */
+	size_t getsegmentnumber() const;
+
+ private:
+	/**
+	 * \brief an appended record, its message is in the data buffer
+	 */
+	struct record {
+		int type;
+		double time;
+		size_t offset;
+		size_t length;
+	};
+
+	/**
+	 * \brief Append an encoded message in the buffer
+	 */
+	bool append(int type, double time);
+
+	std::string basepath;
+	size_t segmentrecords;
+	size_t segmentnumber;
+	std::vector<record> records;
+	std::string data;
+	std::string buffer;
+};
+
+/**
+ * \brief detectionformats archive record class
+ *
+ * A record found in an archive, pointing into the mapped segment that holds
+ * it, so it is only valid while its archive_reader is.
+ */
+class archive_record {
+ public:
+	/**
+	 * \brief The formattypes value of the record
+	 */
+	int type;
+
+	/**
+	 * \brief The time of the record, in epoch seconds
+	 */
+	double time;
+
+	/**
+	 * \brief A pointer to the binary encoded message, see FromBinary()
+	 */
+	const char *data;
+
+	/**
+	 * \brief The length of the binary encoded message in bytes
+	 */
+	size_t length;
+};
+
+/**
+ * \brief detectionformats archive reader class
+ *
+ * Finds the records in a time window in an archive written by an
+ * archive_writer. The segments are memory mapped when the reader is
+ * created, segments written afterwards are not seen. Segments whose times
+ * do not overlap a window are skipped, and within the others the sparse
+ * index is binary searched for the first record of the window, so only
+ * the records of the window and at most ARCHIVE_INDEXINTERVAL others are
+ * read.
+ *
+ * Finding records does not change the reader, so a reader can be shared
+ * between threads.
+ */
+class archive_reader {
+ public:
+	/**
+	 * \brief archive_reader constructor
+	 *
+	 * The constructor for the archive_reader class, maps the segments of
+	 * the archive, from the first until one is missing. Segments that are
+	 * not valid archive segments, such as empty or corrupt files, are
+	 * skipped, see getskippedsegments().
+	 * \param basepath - A std::string containing the path the segment file
+	 * names start with
+	 */
+	explicit archive_reader(const std::string &basepath);
+
+	/**
+	 * \brief archive_reader destructor
+	 *
+	 * The destructor for the archive_reader class, unmaps the segments.
+	 */
+	~archive_reader();
+
+	archive_reader(const archive_reader &newreader) = delete;
+	archive_reader & operator=(const archive_reader &newreader) = delete;
+
+	/**
+	 * \brief Find records in a time window
+	 *
+	 * Finds the records of a type with times from the start time to the end
+	 * time, both included, sorted by time within each segment.
+	 * \param type - The formattypes value of the records to find
+	 * \param starttime - A double containing the start of the window in
+	 * epoch seconds
+	 * \param endtime - A double containing the end of the window in epoch
+	 * seconds
+	 * \param found - A pointer to the std::vector to add the records to
+	 * \return Returns the number of records found
+	 */
+	size_t find(int type, double starttime, double endtime,
+				std::vector<archive_record> *found) const;
+
+	/**
+	 * \brief Read messages in a time window
+	 *
+	 * Finds the messages with times from the start time to the end time,
+	 * see find(), and decodes them.
+	 * \param starttime - A double containing the start of the window in
+	 * epoch seconds
+	 * \param endtime - A double containing the end of the window in epoch
+	 * seconds
+	 * \param objects - A pointer to the std::vector to add the messages to
+	 * \return Returns the number of messages read, throws
+	 * std::invalid_argument, from FromBinary(), if a record in the window
+	 * is not a valid message, leaving objects as it was
+	 */
+	size_t read(double starttime, double endtime,
+				std::vector<pick> *objects) const;
+	size_t read(double starttime, double endtime,
+				std::vector<correlation> *objects) const;
+	size_t read(double starttime, double endtime,
+				std::vector<detection> *objects) const;
+
+	/**
+	 * \brief Gets the number of mapped segments
+	 */
+	size_t getsegmentcount() const;
+
+	/**
+	 * \brief Gets the skipped segments
+	 *
+	 * \return Returns the file names of the segments that were skipped
+	 * because they are not valid archive segments, in order
+	 */
+	const std::vector<std::string> & getskippedsegments() const;
+
+	/**
+	 * \brief Gets the number of records in the mapped segments
+	 */
+	uint64_t size() const;
+
+ private:
+	class segment;
+
+	std::vector<std::unique_ptr<segment>> segments;
+	std::vector<std::string> skipped;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_ARCHIVE_H
@@ -0,0 +1,213 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_ARENA_H
+#define DETECTION_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "base.h" // NOLINT
+
+/**
+ * \brief initial size in bytes of the message_arena memory pool
+ */
+#define ARENA_POOLSIZE 65536
+
+namespace detectionformats {
+/**
+ * \brief detectionformats message arena class
+ *
+ * A monotonic memory pool that whole message views are built in, see
+ * detection_view. Memory is handed out from the pool and never freed one
+ * block at a time, reset() releases everything at once.
+ *
+ * Like the codec_context pool, the pool grows on reset() when the previous
+ * messages overflowed it, so once the arena has held a given amount it
+ * holds that amount again without allocating.
+ *
+ * Containers using an arena_allocator, such as the Data of a detection_view,
+ * destroy their elements when they are destroyed, so they must be destroyed
+ * before reset(). Clearing them is not enough, they keep their memory.
+ *
+ * A message_arena is not thread safe, use one per thread.
+ */
+class message_arena {
+ public:
+	/**
+	 * \brief message_arena constructor
+	 *
+	 * The constructor for the message_arena class.
+	 * Allocates the memory pool.
+	 * \param poolsize - The initial size in bytes of the memory pool
+	 */
+	explicit message_arena(size_t poolsize = ARENA_POOLSIZE);
+
+	/**
+	 * \brief message_arena destructor
+	 *
+	 * The destructor for the message_arena class.
+	 */
+	~message_arena();
+
+	message_arena(const message_arena &newarena) = delete;
+	message_arena & operator=(const message_arena &newarena) = delete;
+
+	/**
+	 * \brief Allocate memory
+	 *
+	 * \param size - The number of bytes to allocate
+	 * \return Returns a pointer to the memory, aligned for any type up to
+	 * the size of a pointer, or NULL if size is 0
+	 */
+	void * allocate(size_t size);
+
+	/**
+	 * \brief Copy characters into the arena
+	 *
+	 * \param str - A pointer to the characters to copy
+	 * \param length - The number of characters
+	 * \return Returns a pointer to the null terminated copy
+	 */
+	const char * copy(const char *str, size_t length);
+
+	/**
+	 * \brief Reset the arena
+	 *
+	 * Releases everything allocated from the arena at once, nothing built
+	 * in the arena may be used afterwards. If the pool overflowed, it is
+	 * grown so that the same amount fits next time. Every container using
+	 * the arena must have been destroyed, which is asserted.
+	 */
+	void reset();
+
+	/**
+	 * \brief Gets the used size
+	 *
+	 * \return Returns the number of bytes allocated since the last reset
+	 */
+	size_t getused() const;
+
+	/**
+	 * \brief Gets the memory pool size
+	 *
+	 * \return Returns the current size in bytes of the memory pool
+	 */
+	size_t getpoolsize() const;
+
+	/**
+	 * \brief Gets the container block count
+	 *
+	 * \return Returns the number of blocks arena_allocators hold in the
+	 * arena, which reset() requires to be 0
+	 */
+	size_t getcontainerblocks() const;
+
+	/**
+	 * \brief Gets the arena allocator
+	 *
+	 * \return Returns a reference to the rapidjson allocator over the pool,
+	 * for building json values in the arena
+	 */
+	rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & getallocator();
+
+ private:
+	/**
+	 * \brief Build the memory pool allocator over the current pool buffer
+	 */
+	void buildpool();
+
+	template<class T>
+	friend class arena_allocator;
+
+	std::vector<char> poolbuffer;
+	size_t containerblocks;
+	std::unique_ptr<rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>>
+			poolallocator;
+};
+
+/**
+ * \brief detectionformats arena allocator class
+ *
+ * A standard library allocator that allocates from a message_arena, so that
+ * containers can live in the arena. deallocate() only counts arena memory
+ * as given back, the arena releases it on reset().
+ *
+ * A default constructed arena_allocator has no arena and uses operator new
+ * and operator delete, so containers using it behave like ordinary
+ * containers until they are given an arena.
+ */
+template<class T>
+class arena_allocator {
+ public:
+	typedef T value_type;
+
+	arena_allocator()
+			: memory(NULL) {
+	}
+
+	explicit arena_allocator(message_arena *newmemory)
+			: memory(newmemory) {
+	}
+
+	template<class U>
+	arena_allocator(const arena_allocator<U> &newallocator) // NOLINT
+			: memory(newallocator.getarena()) {
+	}
+
+	T * allocate(size_t count) {
+		static_assert(alignof(T) <= alignof(void *),
+						"arena memory is only pointer aligned");
+
+		if (memory == NULL) {
+			return (static_cast<T *>(::operator new(count * sizeof(T))));
+		}
+
+		// the arena gives NULL for 0 bytes, and an empty allocation still
+		// needs a pointer of its own
+		void *block = memory->allocate((count > 0 ? count : 1) * sizeof(T));
+		if (block == NULL) {
+			throw std::bad_alloc();
+		}
+		memory->containerblocks++;
+		return (static_cast<T *>(block));
+	}
+
+	void deallocate(T *pointer, size_t) {
+		if (memory == NULL) {
+			::operator delete(pointer);
+		} else {
+			memory->containerblocks--;
+		}
+	}
+
+	/**
+	 * \brief Gets the arena
+	 *
+	 * \return Returns a pointer to the arena, NULL if allocating with
+	 * operator new
+	 */
+	message_arena * getarena() const {
+		return (memory);
+	}
+
+	template<class U>
+	bool operator==(const arena_allocator<U> &other) const {
+		return (memory == other.getarena());
+	}
+
+	template<class U>
+	bool operator!=(const arena_allocator<U> &other) const {
+		return (memory != other.getarena());
+	}
+
+ private:
+	message_arena *memory;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_ARENA_H
@@ -14,6 +14,14 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats association validation error codes
+ */
+enum associationerror {
+	associationphaseinvalid, associationdistanceinvalid,
+	associationazimuthinvalid, associationerrorcount
+};
+
 /**
  * \brief detectionformats association conversion class
  *
@@ -69,6 +77,27 @@ class association : public detectionbase {
 	 */
 	association(const association & newassociation);
 
+	/**
+	 * \brief association move constructor
+	 *
+	 * The move constructor for the association class.
+	 * Moves members from provided association without copying them.
+	 *
+	 * \param newassociation - A detectionformats::association to move from
+	 */
+	association(association &&newassociation) = default;
+
+	/**
+	 * \brief association assignment operators
+	 *
+	 * Copies or moves members from provided association.
+	 *
+	 * \param newassociation - A detectionformats::association to copy or move from
+	 * \return Returns a reference to this association
+	 */
+	association & operator=(const association &newassociation) = default;
+	association & operator=(association &&newassociation) = default;
+
 	/**
 	 * \brief association destructor
 	 *
@@ -91,6 +120,27 @@ class association : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of associationerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -105,7 +155,7 @@ class association : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief association phase name
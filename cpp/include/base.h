@@ -7,13 +7,125 @@
 #ifndef DETECTION_BASE_H
 #define DETECTION_BASE_H
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <cmath>
 
 #include "util.h" // NOLINT
 
+/**
+ * \brief the errorcodes bit for the provided error code
+ */
+#define ERRORCODE(code) (static_cast<detectionformats::errorcodes>(1) << (code))
+
+/**
+ * \brief the valid latitude range in degrees, both included
+ */
+#define LATITUDE_MINIMUM (-90.0)
+#define LATITUDE_MAXIMUM 90.0
+
+/**
+ * \brief the valid longitude range in degrees, both included
+ */
+#define LONGITUDE_MINIMUM (-180.0)
+#define LONGITUDE_MAXIMUM 180.0
+
+/**
+ * \brief the valid site elevation range in meters, both included
+ */
+#define ELEVATION_MINIMUM (-500.0)
+#define ELEVATION_MAXIMUM 8900.0
+
+/**
+ * \brief the valid depth range in kilometers, both included
+ */
+#define DEPTH_MINIMUM (-100.0)
+#define DEPTH_MAXIMUM 1500.0
+
+/**
+ * \brief the valid magnitude range, both included
+ */
+#define MAGNITUDE_MINIMUM (-2.0)
+#define MAGNITUDE_MAXIMUM 10.0
+
+/**
+ * \brief the largest valid signal to noise ratio, the smallest is 0
+ */
+#define SNR_MAXIMUM 9999999999.999
+
+/**
+ * \brief the first invalid classification distance in degrees, the
+ * smallest valid one is 0
+ */
+#define DISTANCE_MAXIMUM 180.0
+
+/**
+ * \brief the first invalid classification azimuth and the largest valid
+ * detection gap in degrees, the smallest valid values are 0
+ */
+#define AZIMUTH_MAXIMUM 360.0
+
+/**
+ * \brief the smallest valid detection rms
+ */
+#define RMS_MINIMUM (-10000.0)
+
 namespace detectionformats {
+/**
+ * \brief detectionformats validation error codes
+ *
+ * A bitmask with one bit set for each error found by validate(), the bit
+ * positions are the values of the error code enum of the validated class.
+ * Zero means the class is valid.
+ */
+typedef uint64_t errorcodes;
+
+/**
+ * \brief detectionformats json writer
+ *
+ * The rapidjson writer that write() streams the classes to, writing json
+ * text into a rapidjson::StringBuffer.
+ */
+typedef rapidjson::Writer<rapidjson::StringBuffer> jsonwriter;
+
+/**
+ * \brief detectionformats json handler
+ *
+ * The interface write() walks the members of the classes into, the part of
+ * rapidjson's Handler concept that the classes use, with the same names and
+ * arguments. A jsonwriter is driven through it to write json text, and the
+ * MessagePack and CBOR writers implement it, so each class lists its keys
+ * in one place whatever the encoding.
+ */
+class jsonhandler {
+ public:
+	virtual ~jsonhandler() {
+	}
+
+	virtual bool StartObject() = 0;
+	virtual bool Key(const char *str, rapidjson::SizeType length,
+						bool copy = false) = 0;
+	virtual bool EndObject(rapidjson::SizeType memberCount = 0) = 0;
+	virtual bool StartArray() = 0;
+	virtual bool EndArray(rapidjson::SizeType elementCount = 0) = 0;
+	virtual bool String(const char *str, rapidjson::SizeType length,
+						bool copy = false) = 0;
+	virtual bool Double(double d) = 0;
+	virtual bool Bool(bool b) = 0;
+
+	// keys and strings that are null terminated
+	bool Key(const char *str) {
+		return (Key(str, static_cast<rapidjson::SizeType>(std::strlen(str))));
+	}
+
+	bool String(const char *str) {
+		return (String(str,
+						static_cast<rapidjson::SizeType>(std::strlen(str))));
+	}
+};
+
 class detectionbase {
  public:
 	/**
@@ -24,6 +136,23 @@ class detectionbase {
 	 */
 	detectionbase();
 
+	/**
+	 * \brief detectionbase copy and move constructors
+	 *
+	 * Declared so that the destructor does not suppress the implicit move
+	 * operations of the derived classes.
+	 */
+	detectionbase(const detectionbase &newbase) = default;
+	detectionbase(detectionbase &&newbase) = default;
+
+	/**
+	 * \brief detectionbase assignment operators
+	 *
+	 * Copies or moves the type from provided detectionbase.
+	 */
+	detectionbase & operator=(const detectionbase &newbase) = default;
+	detectionbase & operator=(detectionbase &&newbase) = default;
+
 	/**
 	 * \brief site destructor
 	 *
@@ -45,22 +174,67 @@ class detectionbase {
 			rapidjson::Value &json, // NOLINT
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) = 0; // NOLINT
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document. Writes the same json as
+	 * tojson(), and is the only place the keys of the class are written, for
+	 * json text, MessagePack, and CBOR alike.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	virtual void write(jsonhandler &writer) = 0; // NOLINT
+
+	/**
+	 * \brief Write json function
+	 *
+	 * Writes the contents of the class to a json writer as json text, by
+	 * driving the writer with write(jsonhandler &).
+	 * \param writer - a reference to the jsonwriter to write the class
+	 * contents to
+	 */
+	void write(jsonwriter &writer); // NOLINT
+
 	/**
 	 * \brief Validates the values in the class
 	 *
-	 * Validates the values contained in the class
+	 * Validates the values contained in the class, does not allocate
 	 * \return Returns 1 if successful, 0 otherwise
 	 */
 	virtual bool isvalid();
 
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text, does not allocate
+	 * \return Returns an errorcodes bitmask of the errors found, 0 if the
+	 * class is valid
+	 */
+	virtual errorcodes validate() = 0;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
-	 * Gets any formatting errors in the class
+	 * Gets any formatting errors in the class, rendering the text for each
+	 * error code returned by validate()
 	 * \return Returns a std::vector<std::string> containing the errors
 	 */
 	virtual std::vector<std::string> geterrors() = 0;
 
+	/**
+	 * \brief Gets the error text for an object member
+	 *
+	 * Builds the error text for a member object that did not validate,
+	 * followed by each of the member's own errors
+	 * \param message - The error text for the member
+	 * \param member - The member object that did not validate
+	 * \return Returns a std::string containing the error text
+	 */
+	static std::string getmembererror(const char *message,
+										detectionbase &member); // NOLINT
+
 	/**
 	 * \brief type identifier
 	 *
@@ -68,5 +242,15 @@ class detectionbase {
 	 */
 	std::string type;
 };
+
+/**
+ * \brief Convert to json string function
+ *
+ * Streams the contents of the class to a serialized json string using
+ * write(), without building a rapidjson::Value document
+ * \param object - a reference to the class to convert
+ * \return Returns a std::string containing the serialized json string
+ */
+std::string ToJSONString(detectionbase &object); // NOLINT
 }  // namespace detectionformats
 #endif  // DETECTION_BASE_H
@@ -0,0 +1,288 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_BATCH_H
+#define DETECTION_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pick.h" // NOLINT
+#include "sitekey.h" // NOLINT
+#include "codec.h" // NOLINT
+
+namespace detectionformats {
+/**
+ * \brief detectionformats pick batch column enum
+ *
+ * The numeric columns of a pick_batch, see pick_batch::getcolumn().
+ */
+enum pickcolumn {
+	timecolumn = 0,
+	latitudecolumn = 1,
+	longitudecolumn = 2,
+	elevationcolumn = 3,
+	amplitudecolumn = 4,
+	periodcolumn = 5,
+	snrcolumn = 6,
+	backazimuthcolumn = 7,
+	backazimutherrorcolumn = 8,
+	slownesscolumn = 9,
+	slownesserrorcolumn = 10,
+	powerratiocolumn = 11,
+	powerratioerrorcolumn = 12,
+	distancecolumn = 13,
+	azimuthcolumn = 14,
+	residualcolumn = 15,
+	sigmacolumn = 16,
+	pickcolumncount = 17,
+	unknowncolumn = -1
+};
+
+/**
+ * \brief detectionformats pick batch presence enum
+ *
+ * The bits of the presence bitmap of a pick_batch row, set for each
+ * optional member the pick has, see pick_batch::getpresence().
+ */
+enum pickpresence {
+	amplitudepresent = 0x01,
+	beampresent = 0x02,
+	associationpresent = 0x04,
+	classificationpresent = 0x08,
+	filterpresent = 0x10
+};
+
+/**
+ * \brief detectionformats pick batch class
+ *
+ * Holds picks as columns rather than as pick objects, so that a pass over
+ * one member of many picks reads only that member, contiguously, instead of
+ * walking objects full of strings. The numbers (the time, the site
+ * coordinates, and the amplitude, beam, and association values) are each an
+ * array of doubles, missing values being NaN as in a pick. The site is an
+ * array of site_keys, the polarity, onset, and picker are arrays of bytes,
+ * and each row has a bitmap of the optional members present.
+ *
+ * The strings of a row are kept together in one character buffer, and the
+ * filters in one array, so adding a typical pick allocates only when a
+ * column grows. The rare members, a classification, a type other than
+ * "Pick", site codes too wide for a site_key, or the text of a polarity,
+ * onset, or picker that is not valid, are kept aside for the rows that have
+ * them. Converting a pick to a row and back gives an equal pick.
+ *
+ * A pick_batch is not thread safe, but its const members can be called
+ * from several threads.
+ */
+class pick_batch {
+ public:
+	/**
+	 * \brief pick_batch constructor
+	 *
+	 * The constructor for the pick_batch class.
+	 * Initializes the batch to empty.
+	 */
+	pick_batch();
+
+	/**
+	 * \brief pick_batch destructor
+	 *
+	 * The destructor for the pick_batch class.
+	 */
+	~pick_batch();
+
+	/**
+	 * \brief Gets the number of rows
+	 */
+	size_t size() const;
+
+	/**
+	 * \brief Checks if the batch has no rows
+	 */
+	bool empty() const;
+
+	/**
+	 * \brief Remove all rows
+	 *
+	 * Empties the batch, keeping the capacity of its columns.
+	 */
+	void clear();
+
+	/**
+	 * \brief Reserve rows
+	 *
+	 * Makes room in the columns for the provided number of rows.
+	 * \param count - The number of rows to make room for
+	 */
+	void reserve(size_t count);
+
+	/**
+	 * \brief Add picks
+	 *
+	 * Adds the provided picks to the end of the batch, one row each.
+	 * \param object - The pick to add
+	 * \param objects - The picks to add
+	 * \param count - The number of picks to add
+	 */
+	void push_back(const pick &object);
+	void append(const pick *objects, size_t count);
+	void append(const std::vector<pick> &objects);
+
+	/**
+	 * \brief Decode NDJSON
+	 *
+	 * Decodes the picks in newline delimited json, one message per line,
+	 * straight into rows with the context decoder. Blank lines and messages
+	 * of other types are passed over, malformed messages, and messages that
+	 * span lines, are skipped.
+	 * \param ndjson - A std::string containing the messages
+	 * \param context - The codec_context to decode with
+	 * \param skipped - A pointer to a size_t to add the number of skipped
+	 * messages to, NULL to not count them
+	 * \return Returns the number of picks added
+	 */
+	size_t decode(const std::string &ndjson, codec_context &context, // NOLINT
+					size_t *skipped = NULL);
+
+	/**
+	 * \brief Get a pick
+	 *
+	 * Converts a row back into a pick, reusing the capacity of its strings
+	 * and arrays.
+	 * \param row - The row to convert
+	 * \param object - The pick to convert into
+	 * \return Returns a reference to the pick
+	 */
+	pick & get(size_t row, pick &object) const; // NOLINT
+
+	/**
+	 * \brief Get all picks
+	 *
+	 * Converts every row back into a pick, in order.
+	 * \param objects - A pointer to the std::vector to add the picks to
+	 * \return Returns the number of picks added
+	 */
+	size_t get(std::vector<pick> *objects) const;
+
+	/**
+	 * \brief Gets a numeric column
+	 *
+	 * \param column - The pickcolumn value of the column
+	 * \return Returns a pointer to size() doubles, or NULL if the column is
+	 * not a pickcolumn. The pointer is valid until the batch changes.
+	 */
+	const double * getcolumn(int column) const;
+
+	/**
+	 * \brief Gets the site column
+	 *
+	 * \return Returns a pointer to size() site_keys, an invalid key for a
+	 * site whose codes are too wide
+	 */
+	const site_key * getsites() const;
+
+	/**
+	 * \brief Gets the presence column
+	 *
+	 * \return Returns a pointer to size() bitmaps of pickpresence bits
+	 */
+	const uint8_t * getpresence() const;
+
+	/**
+	 * \brief Gets the polarity, onset, and picker columns
+	 *
+	 * \return Returns a pointer to size() polarityindex, onsetindex, or
+	 * pickerindex values
+	 */
+	const int8_t * getpolarities() const;
+	const int8_t * getonsets() const;
+	const int8_t * getpickers() const;
+
+	/**
+	 * \brief Gets the id and phase of a row
+	 *
+	 * \param row - The row to get the string of
+	 * \return Returns a std::string containing the id or phase
+	 */
+	std::string getid(size_t row) const;
+	std::string getphase(size_t row) const;
+
+	/**
+	 * \brief Select rows by a column range
+	 *
+	 * Finds the rows whose value in a column is from the minimum to the
+	 * maximum, both included. Rows with a missing value are not selected.
+	 * The column is scanned without branching on the values, so that the
+	 * compiler can vectorize the scan.
+	 * \param column - The pickcolumn value of the column
+	 * \param minimum - A double containing the smallest value to select
+	 * \param maximum - A double containing the largest value to select
+	 * \param rows - A pointer to the std::vector to add the selected rows to,
+	 * in order
+	 * \return Returns the number of rows selected
+	 */
+	size_t select(int column, double minimum, double maximum,
+					std::vector<size_t> *rows) const;
+
+ private:
+	/**
+	 * \brief a string of a row, in the text buffer
+	 */
+	struct textspan {
+		size_t offset;
+		size_t length;
+	};
+
+	/**
+	 * \brief the rare members of a row, kept aside for the rows that have
+	 * them
+	 */
+	struct rarerow {
+		size_t row;
+		std::string type;
+		bool hassite;
+		detectionformats::site site;
+		detectionformats::classification classificationinfo;
+		std::string polaritytext;
+		std::string onsettext;
+		std::string pickertext;
+	};
+
+	/**
+	 * \brief Adds a string to the text buffer
+	 */
+	textspan puttext(const std::string &str);
+
+	/**
+	 * \brief Copies a string out of the text buffer
+	 */
+	void gettext(const textspan &span, std::string &str) const; // NOLINT
+
+	/**
+	 * \brief Converts a row, with its rare members if it has any
+	 */
+	void getrow(size_t row, const rarerow *rare, pick &object) const; // NOLINT
+
+	std::vector<double> columns[pickcolumncount];
+	std::vector<site_key> sites;
+	std::vector<uint8_t> presence;
+	std::vector<int8_t> polarities;
+	std::vector<int8_t> onsets;
+	std::vector<int8_t> pickers;
+	std::string text;
+	std::vector<textspan> ids;
+	std::vector<textspan> phases;
+	std::vector<textspan> agencyids;
+	std::vector<textspan> authors;
+	std::vector<textspan> associationphases;
+	std::vector<filter> filters;
+	std::vector<size_t> filterends;
+	std::vector<rarerow> rarerows;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_BATCH_H
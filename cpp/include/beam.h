@@ -16,6 +16,15 @@
 
 namespace detectionformats {
 
+/**
+ * \brief detectionformats beam validation error codes
+ */
+enum beamerror {
+	beambackazimuthmissing, beambackazimuthinvalid, beamslownessmissing,
+	beamslownessinvalid, beampowerratioinvalid, beambackazimutherrorinvalid,
+	beamslownesserrorinvalid, beampowerratioerrorinvalid, beamerrorcount
+};
+
 /**
  * \brief detectionformats beam conversion class
  *
@@ -78,6 +87,27 @@ class beam : public detectionbase {
 	 */
 	beam(const beam &newbeam);
 
+	/**
+	 * \brief beam move constructor
+	 *
+	 * The move constructor for the beam class.
+	 * Moves members from provided beam without copying them.
+	 *
+	 * \param newbeam - A detectionformats::beam to move from
+	 */
+	beam(beam &&newbeam) = default;
+
+	/**
+	 * \brief beam assignment operators
+	 *
+	 * Copies or moves members from provided beam.
+	 *
+	 * \param newbeam - A detectionformats::beam to copy or move from
+	 * \return Returns a reference to this beam
+	 */
+	beam & operator=(const beam &newbeam) = default;
+	beam & operator=(beam &&newbeam) = default;
+
 	/**
 	 * \brief beam destructor
 	 *
@@ -100,6 +130,27 @@ class beam : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of beamerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -114,7 +165,7 @@ class beam : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief beam back azimuth
@@ -0,0 +1,100 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_BINARY_H
+#define DETECTION_BINARY_H
+
+#include <cstddef>
+#include <string>
+
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "detection.h" // NOLINT
+#include "retract.h" // NOLINT
+#include "stationInfo.h" // NOLINT
+#include "stationInfoRequest.h" // NOLINT
+
+/**
+ * \brief the version of the binary encoding written by ToBinary()
+ */
+#define BINARY_VERSION 1
+
+/**
+ * \brief size in bytes of the binary message header
+ */
+#define BINARY_HEADERSIZE 4
+
+/**
+ * \brief smallest capacity in bytes ToBinary() gives a buffer
+ */
+#define BINARY_INITIALSIZE 512
+
+namespace detectionformats {
+/**
+ * \brief Get binary message type function
+ *
+ * Reads the message type from the header of a binary message.
+ *
+ * The binary encoding is a compact alternative to json for passing messages
+ * between processes. A message starts with a header of the two magic bytes
+ * "DF", the version, and the formattypes value of the message, followed by
+ * the members in a fixed order. Numbers are little endian IEEE 754 doubles,
+ * enums and flags are single bytes, an enum value that is not valid being
+ * followed by its text, and strings and arrays are prefixed with their
+ * length as an unsigned LEB128 varint. The optional amplitude, beam,
+ * association, and classification are preceded by a bitmap of which are
+ * present, and left out when empty. Every member is kept, so that
+ * decoding an encoded object gives back an equal object.
+ * \param data - A pointer to the binary message
+ * \param length - The length of the binary message in bytes
+ * \return Returns the formattypes value of the message, or
+ * formattypes::unknown if it is not a binary message of a supported version
+ */
+int GetBinaryType(const char *data, size_t length);
+
+/**
+ * \brief Convert to binary functions
+ *
+ * Encodes the provided object into the buffer, replacing its contents and
+ * keeping its capacity so that a reused buffer does not allocate. The
+ * message is sized before it is written, so the buffer is resized once.
+ * \param object - The object to encode
+ * \param buffer - A std::string to hold the binary message
+ * \return Returns a reference to the buffer
+ */
+std::string & ToBinary(pick &object, std::string &buffer); // NOLINT
+std::string & ToBinary(correlation &object, std::string &buffer); // NOLINT
+std::string & ToBinary(detection &object, std::string &buffer); // NOLINT
+std::string & ToBinary(retract &object, std::string &buffer); // NOLINT
+std::string & ToBinary(stationInfo &object, std::string &buffer); // NOLINT
+std::string & ToBinary(stationInfoRequest &object,
+						std::string &buffer); // NOLINT
+
+/**
+ * \brief Convert from binary functions
+ *
+ * Decodes a binary message into the provided object, reusing the capacity
+ * of its strings and arrays.
+ * \param data - A pointer to the binary message
+ * \param length - The length of the binary message in bytes
+ * \param object - The object to decode into
+ * \return Returns a reference to the object, throws std::invalid_argument if
+ * the message is truncated, malformed, of an unsupported version, or of
+ * another type
+ */
+pick & FromBinary(const char *data, size_t length, pick &object); // NOLINT
+correlation & FromBinary(const char *data, size_t length,
+							correlation &object); // NOLINT
+detection & FromBinary(const char *data, size_t length,
+						detection &object); // NOLINT
+retract & FromBinary(const char *data, size_t length,
+						retract &object); // NOLINT
+stationInfo & FromBinary(const char *data, size_t length,
+							stationInfo &object); // NOLINT
+stationInfoRequest & FromBinary(const char *data, size_t length,
+								stationInfoRequest &object); // NOLINT
+}  // namespace detectionformats
+#endif  // DETECTION_BINARY_H
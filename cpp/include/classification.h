@@ -16,6 +16,15 @@
 #include "source.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats classification validation error codes
+ */
+enum classerror {
+	classphaseinvalid, classdistanceinvalid, classazimuthinvalid,
+	classmagnitudeinvalid, classdepthinvalid, classeventtypeinvalid,
+	classsourceinvalid, classerrorcount
+};
+
 /**
  * \brief detectionformats classification conversion class
  *
@@ -141,6 +150,27 @@ class classification : public detectionbase {
 	 */
 	classification(const classification & newclassification);
 
+	/**
+	 * \brief classification move constructor
+	 *
+	 * The move constructor for the classification class.
+	 * Moves members from provided classification without copying them.
+	 *
+	 * \param newclassification - A detectionformats::classification to move from
+	 */
+	classification(classification &&newclassification) = default;
+
+	/**
+	 * \brief classification assignment operators
+	 *
+	 * Copies or moves members from provided classification.
+	 *
+	 * \param newclassification - A detectionformats::classification to copy or move from
+	 * \return Returns a reference to this classification
+	 */
+	classification & operator=(const classification &newclassification) = default;
+	classification & operator=(classification &&newclassification) = default;
+
 	/**
 	 * \brief classification destructor
 	 *
@@ -163,6 +193,27 @@ class classification : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of classerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -177,7 +228,7 @@ class classification : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief classification phase name
@@ -0,0 +1,264 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_CODEC_H
+#define DETECTION_CODEC_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base.h" // NOLINT
+#include "decoder.h" // NOLINT
+#include "validator.h" // NOLINT
+
+/**
+ * \brief initial size in bytes of the codec_context memory pool
+ */
+#define CODEC_POOLSIZE 65536
+
+/**
+ * \brief initial size in bytes of the codec_context document parse stack
+ */
+#define CODEC_STACKSIZE 1024
+
+namespace detectionformats {
+/**
+ * \brief detectionformats codec document type
+ *
+ * A rapidjson::Document that takes both its values and its parse stack from
+ * the codec_context memory pool.
+ */
+typedef rapidjson::GenericDocument<rapidjson::UTF8<>,
+		rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>,
+		rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>> codecdocument;
+
+/**
+ * \brief detectionformats codec context class
+ *
+ * The detectionformats codec context class owns the memory pool, parse
+ * stacks, decoder, validator, and output buffer used to parse, validate, and
+ * serialize messages. Each is reset but not freed between messages, so once the
+ * context has seen a message of a given size, processing another message of
+ * that size does not allocate.
+ *
+ * A codec_context is not thread safe, use one per thread, see
+ * GetCodecContext(). Anything returned from a function taking a context is
+ * only valid until the context is next used.
+ */
+class codec_context {
+ public:
+	/**
+	 * \brief codec_context constructor
+	 *
+	 * The constructor for the codec_context class.
+	 * Allocates the memory pool.
+	 * \param poolsize - The initial size in bytes of the memory pool
+	 */
+	explicit codec_context(size_t poolsize = CODEC_POOLSIZE);
+
+	/**
+	 * \brief codec_context destructor
+	 *
+	 * The destructor for the codec_context class.
+	 */
+	~codec_context();
+
+	codec_context(const codec_context &newcontext) = delete;
+	codec_context & operator=(const codec_context &newcontext) = delete;
+
+	/**
+	 * \brief Reset the context
+	 *
+	 * Releases everything parsed or written by the previous message back to
+	 * the context. If the previous message overflowed the memory pool, the
+	 * pool is grown so that the next message of that size fits.
+	 */
+	void reset();
+
+	/**
+	 * \brief Parse a json string
+	 *
+	 * Resets the context and parses the provided string into the context
+	 * document.
+	 * \param jsonstring - A std::string containing the serialized json
+	 * \return Returns a reference to the context document, check
+	 * HasParseError() for success
+	 */
+	codecdocument & parse(const std::string &jsonstring);
+
+	/**
+	 * \brief Parse a json buffer in place
+	 *
+	 * Resets the context and parses the provided buffer into the context
+	 * document with ParseInsitu, the document strings point into the buffer
+	 * instead of being copied into the memory pool.
+	 * \param jsonbuffer - A null terminated char buffer containing the
+	 * serialized json, which is overwritten by the parse and must outlive
+	 * the document
+	 * \return Returns a reference to the context document, check
+	 * HasParseError() for success
+	 */
+	codecdocument & parseinsitu(char *jsonbuffer);
+
+	/**
+	 * \brief Start writing a json string
+	 *
+	 * Clears the output buffer and returns the writer attached to it.
+	 * \return Returns a reference to the context jsonwriter
+	 */
+	jsonwriter & startwriting();
+
+	/**
+	 * \brief Gets the memory pool size
+	 *
+	 * \return Returns the current size in bytes of the memory pool
+	 */
+	size_t getpoolsize() const;
+
+	/**
+	 * \brief Gets the context document
+	 *
+	 * \return Returns a reference to the document filled in by parse()
+	 */
+	codecdocument & getdocument();
+
+	/**
+	 * \brief Gets the context reader
+	 *
+	 * \return Returns a reference to the reader, which keeps its parse stack
+	 * between messages
+	 */
+	rapidjson::Reader & getreader();
+
+	/**
+	 * \brief Gets the context decoder
+	 *
+	 * \return Returns a reference to the SAX decoder
+	 */
+	decoder & getdecoder();
+
+	/**
+	 * \brief Gets the context validator
+	 *
+	 * \return Returns a reference to the SAX validator
+	 */
+	validator & getvalidator();
+
+	/**
+	 * \brief Gets the context output buffer
+	 *
+	 * \return Returns a reference to the buffer written by startwriting()
+	 */
+	rapidjson::StringBuffer & getbuffer();
+
+	/**
+	 * \brief validation targets
+	 *
+	 * The objects that messages are decoded into while validating, reused so
+	 * that their strings and vectors keep their capacity.
+	 */
+	pick picktarget;
+	correlation correlationtarget;
+	detection detectiontarget;
+	retract retracttarget;
+	stationInfo stationinfotarget;
+	stationInfoRequest requesttarget;
+
+ private:
+	/**
+	 * \brief Build the memory pool allocator and document over the current
+	 * pool buffer
+	 */
+	void buildpool();
+
+	std::vector<char> poolbuffer;
+	std::unique_ptr<rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>>
+			poolallocator;
+	std::unique_ptr<codecdocument> document;
+	rapidjson::Reader reader;
+	decoder handler;
+	validator checker;
+	rapidjson::StringBuffer buffer;
+	jsonwriter writer;
+};
+
+/**
+ * \brief Get the codec context for this thread
+ *
+ * \return Returns a reference to a codec_context owned by the calling thread
+ */
+codec_context & GetCodecContext();
+
+/**
+ * \brief detectionformats function to check whether a string is valid json
+ *
+ * Parses with the calling thread's codec_context, see GetCodecContext()
+ */
+bool IsJSONValid(const std::string &jsonstring);
+
+/**
+ * \brief detectionformats function to check whether a string is valid json
+ * using the provided context
+ */
+bool IsJSONValid(const std::string &jsonstring,
+					codec_context &context); // NOLINT
+
+/**
+ * \brief Convert from json string function
+ *
+ * Parses the provided string into the context document
+ * \param jsonstring - A std::string containing the serialized json
+ * \param context - The codec_context to parse with
+ * \return Returns a reference to the context document, throws
+ * std::invalid_argument if the string is not a valid json object
+ */
+codecdocument & FromJSONString(const std::string &jsonstring,
+								codec_context &context); // NOLINT
+
+/**
+ * \brief Convert from json string functions
+ *
+ * Converts the provided string directly into the provided object using the
+ * context reader and decoder
+ * \param jsonstring - A std::string containing the serialized json
+ * \param object - The object to populate
+ * \param context - The codec_context to parse with
+ * \return Returns a reference to the populated object, throws
+ * std::invalid_argument if the string is not a valid json object
+ */
+pick & FromJSONString(const std::string &jsonstring, pick &object,
+						codec_context &context); // NOLINT
+correlation & FromJSONString(const std::string &jsonstring,
+								correlation &object,
+								codec_context &context); // NOLINT
+detection & FromJSONString(const std::string &jsonstring, detection &object,
+							codec_context &context); // NOLINT
+retract & FromJSONString(const std::string &jsonstring, retract &object,
+							codec_context &context); // NOLINT
+stationInfo & FromJSONString(const std::string &jsonstring,
+								stationInfo &object,
+								codec_context &context); // NOLINT
+stationInfoRequest & FromJSONString(const std::string &jsonstring,
+									stationInfoRequest &object,
+									codec_context &context); // NOLINT
+
+/**
+ * \brief Convert to json string functions
+ *
+ * Serializes the provided object or json value into the context output
+ * buffer
+ * \param object - The object or json value to convert
+ * \param context - The codec_context to write with
+ * \return Returns the serialized json string, owned by the context, its
+ * length is getbuffer().GetSize()
+ */
+const char * ToJSONString(detectionbase &object,
+							codec_context &context); // NOLINT
+const char * ToJSONString(rapidjson::Value &json,
+							codec_context &context); // NOLINT
+}  // namespace detectionformats
+#endif  // DETECTION_CODEC_H
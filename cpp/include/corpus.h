@@ -0,0 +1,229 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_CORPUS_H
+#define DETECTION_CORPUS_H
+
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "detection.h" // NOLINT
+#include "retract.h" // NOLINT
+#include "stationInfo.h" // NOLINT
+#include "stationInfoRequest.h" // NOLINT
+
+/**
+ * \brief largest station count, the station codes are an S and at most four
+ * base 36 digits
+ */
+#define CORPUS_MAXSTATIONS 1679616
+
+/**
+ * \brief number of recent detection ids that retracts are chosen from
+ */
+#define CORPUS_RETRACTIDS 1024
+
+namespace detectionformats {
+/**
+ * \brief detectionformats corpus options class
+ *
+ * The settings that shape the messages a corpusgenerator produces.
+ */
+class corpusoptions {
+ public:
+	/**
+	 * \brief corpusoptions constructor
+	 *
+	 * The constructor for the corpusoptions class.
+	 * Initializes members to a mostly pick stream with a few detections and
+	 * station lists, with half of the optional members filled in and no
+	 * errors.
+	 */
+	corpusoptions();
+
+	/**
+	 * \brief random seed
+	 *
+	 * A uint64_t containing the seed, the same seed and options always
+	 * produce the same messages.
+	 */
+	uint64_t seed;
+
+	/**
+	 * \brief message mix
+	 *
+	 * The relative weight of each message type, indexed by formattypes. A
+	 * weight of 0 means that type is never produced.
+	 */
+	double mix[6];
+
+	/**
+	 * \brief detection pick counts
+	 *
+	 * The smallest and largest number of associated picks in the Data of a
+	 * detection, the count is chosen uniformly between them.
+	 */
+	int minimumdetectionpicks;
+	int maximumdetectionpicks;
+
+	/**
+	 * \brief optional member density
+	 *
+	 * A double containing the chance, from 0 to 1, that each optional member
+	 * or group of members is filled in.
+	 */
+	double optionaldensity;
+
+	/**
+	 * \brief error rate
+	 *
+	 * A double containing the chance, from 0 to 1, that a message is made
+	 * invalid.
+	 */
+	double errorrate;
+
+	/**
+	 * \brief station count
+	 *
+	 * The number of stations in the station list that picks, correlations,
+	 * and station messages are made for, at most CORPUS_MAXSTATIONS.
+	 */
+	int stationcount;
+
+	/**
+	 * \brief start time
+	 *
+	 * A double containing the epoch time of the first message.
+	 */
+	double starttime;
+
+	/**
+	 * \brief message interval
+	 *
+	 * A double containing the mean time in seconds between messages.
+	 */
+	double interval;
+};
+
+/**
+ * \brief detectionformats corpus generator class
+ *
+ * The detectionformats corpus generator class produces a deterministic
+ * stream of realistic messages for load and benchmark testing, built with
+ * the class constructors and serialized with ToJSONString(). Picks and
+ * correlations are made for stations from a fixed station list, detections
+ * carry associated picks whose distances, azimuths, and times follow from
+ * the hypocenter and the stations, and retracts retract one of the last
+ * CORPUS_RETRACTIDS detections.
+ *
+ * Messages are invalid at the configured error rate, getlastvalid() tells
+ * whether the last message was made invalid.
+ */
+class corpusgenerator {
+ public:
+	/**
+	 * \brief corpusgenerator constructor
+	 *
+	 * The constructor for the corpusgenerator class.
+	 * Builds the station list from the seed, throws std::invalid_argument
+	 * if the station count is above CORPUS_MAXSTATIONS.
+	 * \param newoptions - The corpusoptions to generate with
+	 */
+	explicit corpusgenerator(const corpusoptions &newoptions = corpusoptions());
+
+	/**
+	 * \brief corpusgenerator destructor
+	 *
+	 * The destructor for the corpusgenerator class.
+	 */
+	~corpusgenerator();
+
+	/**
+	 * \brief Generate the next message
+	 *
+	 * Chooses the type of the next message from the mix and generates it.
+	 * \return Returns a std::string containing the serialized json message
+	 */
+	std::string next();
+
+	/**
+	 * \brief Write messages as NDJSON
+	 *
+	 * Writes the next count messages to the stream, one per line.
+	 * \param stream - The std::ostream to write to
+	 * \param count - The number of messages to write
+	 * \return Returns the number of bytes written
+	 */
+	size_t write(std::ostream &stream, size_t count); // NOLINT
+
+	/**
+	 * \brief Generate the next message of a type
+	 *
+	 * Each of these generates the next message of its type, ignoring the
+	 * mix, and counts as the last message.
+	 * \return Returns the generated message
+	 */
+	pick nextpick();
+	correlation nextcorrelation();
+	detection nextdetection();
+	retract nextretract();
+	stationInfo nextstationinfo();
+	stationInfoRequest nextrequest();
+
+	/**
+	 * \brief Gets the type of the last message
+	 *
+	 * \return Returns the formattypes value of the last message, unknown if
+	 * no message has been generated
+	 */
+	int getlasttype() const;
+
+	/**
+	 * \brief Gets whether the last message is valid
+	 *
+	 * \return Returns false if the last message was made invalid, true
+	 * otherwise
+	 */
+	bool getlastvalid() const;
+
+	/**
+	 * \brief Gets the station list
+	 *
+	 * \return Returns the sites the messages are generated for
+	 */
+	const std::vector<site> & getstations() const;
+
+ private:
+	double uniform(double minimum, double maximum);
+	int index(int count);
+	bool chance(double probability);
+	std::string makeid();
+	double advance();
+	source makesource();
+	eventtype makeeventtype();
+	hypocenter makehypocenter(double time);
+	pick makepick(const site &station, double time,
+					const hypocenter *origin);
+	correlation makecorrelation(const site &station, double time,
+								const hypocenter &origin);
+	bool makeinvalid(int type);
+
+	corpusoptions options;
+	std::mt19937_64 engine;
+	std::vector<site> stations;
+	std::vector<std::string> detectionids;
+	size_t nextdetectionid;
+	double clock;
+	int lasttype;
+	bool lastvalid;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_CORPUS_H
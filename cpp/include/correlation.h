@@ -19,6 +19,18 @@
 
 namespace detectionformats {
 
+/**
+ * \brief detectionformats correlation validation error codes
+ */
+enum correlationerror {
+	correlationtypeinvalid, correlationidmissing, correlationsiteinvalid,
+	correlationsourceinvalid, correlationphasemissing, correlationphaseinvalid,
+	correlationtimemissing, correlationtimeinvalid, correlationvaluemissing,
+	correlationvalueinvalid, correlationhypocenterinvalid,
+	correlationeventtypeinvalid, correlationmagnitudeinvalid,
+	correlationsnrinvalid, correlationassociationinvalid, correlationerrorcount
+};
+
 /**
  * \brief detectionformats correlation conversion class
  *
@@ -258,6 +270,27 @@ class correlation : public detectionbase {
 	 */
 	correlation(const correlation &newcorrelation);
 
+	/**
+	 * \brief correlation move constructor
+	 *
+	 * The move constructor for the correlation class.
+	 * Moves members from provided correlation without copying them.
+	 *
+	 * \param newcorrelation - A detectionformats::correlation to move from
+	 */
+	correlation(correlation &&newcorrelation) = default;
+
+	/**
+	 * \brief correlation assignment operators
+	 *
+	 * Copies or moves members from provided correlation.
+	 *
+	 * \param newcorrelation - A detectionformats::correlation to copy or move from
+	 * \return Returns a reference to this correlation
+	 */
+	correlation & operator=(const correlation &newcorrelation) = default;
+	correlation & operator=(correlation &&newcorrelation) = default;
+
 	/**
 	 * \brief correlation destructor
 	 *
@@ -280,6 +313,27 @@ class correlation : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of correlationerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -0,0 +1,191 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_DECODER_H
+#define DETECTION_DECODER_H
+
+#include <string>
+#include <vector>
+
+#include "detection.h" // NOLINT
+#include "retract.h" // NOLINT
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "stationInfo.h" // NOLINT
+#include "stationInfoRequest.h" // NOLINT
+
+/**
+ * \brief maximum object nesting depth tracked by the decoder, deeper objects
+ * are skipped
+ */
+#define DECODER_MAXDEPTH 8
+
+namespace detectionformats {
+/**
+ * \brief detectionformats decoder object kind enum
+ */
+enum objectkind {
+	pickkind = 0,
+	correlationkind = 1,
+	detectionkind = 2,
+	retractkind = 3,
+	stationinfokind = 4,
+	stationinforequestkind = 5,
+	sitekind = 6,
+	sourcekind = 7,
+	filterkind = 8,
+	amplitudekind = 9,
+	beamkind = 10,
+	associationkind = 11,
+	classificationkind = 12,
+	hypocenterkind = 13,
+	eventtypekind = 14,
+	datakind = 15,
+	filterarraykind = 16,
+	dataarraykind = 17,
+	objectkindcount = 18,
+	unknownkind = -1
+};
+
+/**
+ * \brief detectionformats SAX decoder class
+ *
+ * The detectionformats decoder class is a rapidjson SAX handler that fills
+ * the pick, correlation, detection, retract, stationInfo, and
+ * stationInfoRequest classes (and their nested objects) directly from
+ * rapidjson::Reader events, without building an intermediate
+ * rapidjson::Document.
+ *
+ * The decoder applies the same type checks and defaults as the
+ * rapidjson::Value constructors of each class, unknown keys and values of the
+ * wrong type are ignored.
+ */
+class decoder {
+ public:
+	/**
+	 * \brief decoder constructor
+	 *
+	 * The constructor for the decoder class.
+	 * Initializes members to null values.
+	 */
+	decoder();
+
+	/**
+	 * \brief decoder destructor
+	 *
+	 * The destructor for the decoder class.
+	 */
+	~decoder();
+
+	/**
+	 * \brief Set the object to decode into
+	 *
+	 * Sets the object that the next parsed json object will populate. The
+	 * object is reset to the same values the rapidjson::Value constructor would
+	 * produce for an empty json object when the root json object starts.
+	 * \param object - A pointer to the object to populate
+	 */
+	void settarget(pick *object);
+	void settarget(correlation *object);
+	void settarget(detection *object);
+	void settarget(retract *object);
+	void settarget(stationInfo *object);
+	void settarget(stationInfoRequest *object);
+
+	/**
+	 * \brief rapidjson SAX handler functions
+	 *
+	 * Called by rapidjson::Reader for each parsing event.
+	 * \return Returns true to continue parsing, false to stop with an error
+	 */
+	bool Null();
+	bool Bool(bool value);
+	bool Int(int value);
+	bool Uint(unsigned value);
+	bool Int64(int64_t value);
+	bool Uint64(uint64_t value);
+	bool Double(double value);
+	bool RawNumber(const char *str, rapidjson::SizeType length, bool copy);
+	bool String(const char *str, rapidjson::SizeType length, bool copy);
+	bool StartObject();
+	bool Key(const char *str, rapidjson::SizeType length, bool copy);
+	bool EndObject(rapidjson::SizeType membercount);
+	bool StartArray();
+	bool EndArray(rapidjson::SizeType elementcount);
+
+ private:
+	/**
+	 * \brief decoder stack frame
+	 *
+	 * One frame per json object or array currently being decoded
+	 */
+	struct frame {
+		int kind;
+		void *target;
+		int memberkind;
+		void *member;
+		int key;
+	};
+
+	bool number(double value, bool isdouble, bool isint);
+	bool push(int kind, void *target);
+	void truncatedata(detection *object);
+
+	int rootkind;
+	void *roottarget;
+	frame stack[DECODER_MAXDEPTH];
+	int depth;
+	int skipdepth;
+
+	// data array elements are decoded in place into both the next pick and
+	// the next correlation of the detection until their type is known. The
+	// detection keeps its elements between messages and is truncated to
+	// the counts decoded, the spare element past each count is kept here
+	pick datapick;
+	correlation datacorrelation;
+	pick *datapicktarget;
+	correlation *datacorrelationtarget;
+	size_t datapickcount;
+	size_t datacorrelationcount;
+};
+
+/**
+ * \brief Find an object key
+ *
+ * Looks up a json key in the key table of the provided object kind
+ * \param kind - The objectkind of the object holding the key
+ * \param str - A pointer to the key
+ * \param length - The length of the key
+ * \return Returns the key index for the object kind, or -1 if the key is
+ * not a member of that kind of object
+ */
+int FindObjectKey(int kind, const char *str, rapidjson::SizeType length);
+
+/**
+ * \brief Convert from json string functions
+ *
+ * Converts the provided string from a serialized json string directly into
+ * the provided object using the SAX decoder, without building a
+ * rapidjson::Document. The decoder of the calling thread's codec_context is
+ * used, see GetCodecContext().
+ * \param jsonstring - A std::string containing the serialized json
+ * \param object - The object to populate
+ * \return Returns a reference to the populated object, throws
+ * std::invalid_argument if the string is not a valid json object
+ */
+pick & FromJSONString(const std::string &jsonstring, pick &object); // NOLINT
+correlation & FromJSONString(const std::string &jsonstring,
+								correlation &object); // NOLINT
+detection & FromJSONString(const std::string &jsonstring,
+							detection &object); // NOLINT
+retract & FromJSONString(const std::string &jsonstring,
+							retract &object); // NOLINT
+stationInfo & FromJSONString(const std::string &jsonstring,
+								stationInfo &object); // NOLINT
+stationInfoRequest & FromJSONString(const std::string &jsonstring,
+									stationInfoRequest &object); // NOLINT
+}  // namespace detectionformats
+#endif  // DETECTION_DECODER_H
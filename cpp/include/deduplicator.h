@@ -0,0 +1,178 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_DEDUPLICATOR_H
+#define DETECTION_DEDUPLICATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "pick.h" // NOLINT
+#include "sitekey.h" // NOLINT
+#include "views.h" // NOLINT
+
+/**
+ * \brief default largest time difference in seconds between duplicate picks
+ */
+#define DEDUP_TOLERANCE 0.01
+
+/**
+ * \brief default number of seconds of picks each generation holds
+ */
+#define DEDUP_WINDOW 10.0
+
+/**
+ * \brief default largest number of picks each generation holds
+ */
+#define DEDUP_MAXENTRIES 131072
+
+namespace detectionformats {
+/**
+ * \brief detectionformats pick deduplicator class
+ *
+ * Suppresses near duplicate picks, such as the same pick arriving from
+ * redundant feeds with a different ID. Two picks are duplicates when they
+ * have the same site, phase, and source, and their times are within the
+ * tolerance of each other. The first pick offered is retained, later
+ * duplicates of it are suppressed.
+ *
+ * Retained picks are held in a hash table keyed by the site, phase, source,
+ * and the time bucket the pick falls in, buckets being one tolerance wide,
+ * so a duplicate is found in the bucket of the pick or one of the two next
+ * to it. The table is split into two generations. Picks are added to the
+ * current generation, and once it spans the window or holds the largest
+ * number of picks, the previous generation is dropped and the current one
+ * takes its place. Memory is bounded by the two generations, and a pick is
+ * remembered for at least the window unless the pick rate fills a
+ * generation first.
+ *
+ * The phase and source are compared by a 64 bit hash. A pick_deduplicator
+ * is not thread safe.
+ */
+class pick_deduplicator {
+ public:
+	/**
+	 * \brief pick_deduplicator constructor
+	 *
+	 * The constructor for the pick_deduplicator class. Both generations are
+	 * allocated up front, each a table of twice the largest number of picks,
+	 * rounded up to a power of two, of 64 byte entries, so the defaults take
+	 * 2 x 262144 x 64 bytes, 32 MB. Lower the largest number of picks for a
+	 * smaller deduplicator. Throws std::invalid_argument if the tolerance or
+	 * window is not a positive number, or the largest number of picks is too
+	 * large to allocate.
+	 * \param newtolerance - A double containing the largest time difference
+	 * in seconds between duplicate picks
+	 * \param newwindow - A double containing the number of seconds of picks
+	 * each generation holds
+	 * \param newmaxentries - The largest number of picks each generation
+	 * holds
+	 */
+	explicit pick_deduplicator(double newtolerance = DEDUP_TOLERANCE,
+								double newwindow = DEDUP_WINDOW,
+								size_t newmaxentries = DEDUP_MAXENTRIES);
+
+	/**
+	 * \brief pick_deduplicator destructor
+	 *
+	 * The destructor for the pick_deduplicator class.
+	 */
+	~pick_deduplicator();
+
+	pick_deduplicator(const pick_deduplicator &newdeduplicator) = delete;
+	pick_deduplicator & operator=(const pick_deduplicator &newdeduplicator) =
+			delete;
+
+	/**
+	 * \brief Offer a pick
+	 *
+	 * Checks the pick against the retained picks, and retains it if it is
+	 * not a duplicate. Picks are numbered from 0 in the order they are
+	 * offered. A pick without a valid time is always retained.
+	 * \param object - The pick to offer
+	 * \param retained - A pointer to a uint64_t to set to the number of the
+	 * retained pick, the number of this pick if it is retained, or NULL
+	 * \return Returns true if the pick is retained, false if it is a
+	 * duplicate
+	 */
+	bool offer(const pick &object, uint64_t *retained = NULL);
+	bool offer(const pick_view &view, uint64_t *retained = NULL);
+
+	/**
+	 * \brief Clear the deduplicator
+	 *
+	 * Forgets every retained pick and restarts the pick numbering.
+	 */
+	void clear();
+
+	/**
+	 * \brief Gets the number of picks offered
+	 */
+	uint64_t getoffered() const;
+
+	/**
+	 * \brief Gets the number of duplicates suppressed
+	 */
+	uint64_t getduplicates() const;
+
+	/**
+	 * \brief Gets the number of picks remembered
+	 *
+	 * \return Returns the number of retained picks held by both generations
+	 */
+	size_t size() const;
+
+ private:
+	/**
+	 * \brief a retained pick
+	 */
+	struct entry {
+		site_key key;
+		uint64_t tag;
+		int64_t bucket;
+		double time;
+		uint64_t number;
+		uint64_t stamp;
+	};
+
+	/**
+	 * \brief a generation of retained picks, an open addressed table, only
+	 * entries with the current stamp are in use so that clearing it does not
+	 * touch the entries
+	 */
+	struct generation {
+		void clear();
+
+		size_t mask;
+		size_t count;
+		uint64_t stamp;
+		double starttime;
+		std::unique_ptr<entry[]> entries;
+	};
+
+	/**
+	 * \brief Offer a pick by its key, tag, and time
+	 */
+	bool offer(const site_key &key, uint64_t tag, double time,
+				uint64_t *retained);
+
+	/**
+	 * \brief Find a retained pick within the tolerance in a generation
+	 */
+	const entry * find(const generation &table, const site_key &key,
+						uint64_t tag, double time) const;
+
+	double tolerance;
+	double window;
+	size_t maxentries;
+	generation tables[2];
+	int currenttable;
+	uint64_t offered;
+	uint64_t duplicates;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_DEDUPLICATOR_H
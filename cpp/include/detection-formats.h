@@ -2,6 +2,7 @@
 #define DETECTION_H
 
 #include <string>
+#include <vector>
 
 #include "detection.h" // NOLINT
 #include "retract.h" // NOLINT
@@ -9,6 +10,18 @@
 #include "correlation.h" // NOLINT
 #include "stationInfo.h" // NOLINT
 #include "stationInfoRequest.h" // NOLINT
+#include "decoder.h" // NOLINT
+#include "codec.h" // NOLINT
+#include "views.h" // NOLINT
+#include "sitekey.h" // NOLINT
+#include "registry.h" // NOLINT
+#include "deduplicator.h" // NOLINT
+#include "binary.h" // NOLINT
+#include "packed.h" // NOLINT
+#include "archive.h" // NOLINT
+#include "batch.h" // NOLINT
+#include "rangecheck.h" // NOLINT
+#include "corpus.h" // NOLINT
 
 namespace detectionformats {
     /**
@@ -22,5 +35,37 @@ namespace detectionformats {
      * provided json formatted string
      */
     std::string ValidateJSONErrors(const std::string & jsonstring);
+
+    /**
+     * \brief detectionformats function to validate a provided
+     * json formatted string using the provided codec_context
+     */
+    bool ValidateJSON(const std::string & jsonstring,
+                        codec_context &context); // NOLINT
+
+    /**
+     * \brief detectionformats function to print out validation errors from a
+     * provided json formatted string using the provided codec_context
+     */
+    std::string ValidateJSONErrors(const std::string & jsonstring,
+                                    codec_context &context); // NOLINT
+
+    /**
+     * \brief detectionformats function to validate a batch of json
+     * formatted strings in parallel
+     *
+     * Spreads the messages across a work stealing pool of threads, each
+     * validating with its own codec_context, see workqueue.
+     * \param messages - A pointer to the first of the std::strings to validate
+     * \param count - The number of messages
+     * \param threads - The number of threads to use, including the calling
+     * thread, 0 to use one per hardware thread
+     * \return Returns a std::vector<bool> holding the ValidateJSON() result for
+     * each message, in the same order as the messages
+     */
+    std::vector<bool> ValidateJSONBatch(const std::string *messages,
+                                        size_t count, int threads = 0);
+    std::vector<bool> ValidateJSONBatch(
+            const std::vector<std::string> &messages, int threads = 0);
 }  // namespace detectionformats
 #endif  // DETECTION_H
@@ -18,6 +18,17 @@
 #include "eventtype.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats detection validation error codes
+ */
+enum detectionerror {
+	detectiontypeinvalid, detectionidmissing, detectionsourceinvalid,
+	detectionhypocenterinvalid, detectiondetectiontypeinvalid,
+	detectiontimeinvalid, detectioneventtypeinvalid, detectionbayesinvalid,
+	detectionmindistinvalid, detectionrmsinvalid, detectiongapinvalid,
+	detectionpickinvalid, detectioncorrelationinvalid, detectionerrorcount
+};
+
 /**
  * \brief detectionformats detection conversion class
  *
@@ -153,7 +164,28 @@ class detection : public detectionbase {
 	 * Copies the provided object from a detection, populating members
 	 * \param newdetection - A detection.
 	 */
-	detection(const detection & newdetection);
+	detection(const detection & newdetection) = default;
+
+	/**
+	 * \brief detection move constructor
+	 *
+	 * The move constructor for the detection class.
+	 * Moves members from provided detection without copying them.
+	 *
+	 * \param newdetection - A detectionformats::detection to move from
+	 */
+	detection(detection &&newdetection) = default;
+
+	/**
+	 * \brief detection assignment operators
+	 *
+	 * Copies or moves members from provided detection.
+	 *
+	 * \param newdetection - A detectionformats::detection to copy or move from
+	 * \return Returns a reference to this detection
+	 */
+	detection & operator=(const detection &newdetection) = default;
+	detection & operator=(detection &&newdetection) = default;
 
 	/**
 	 * \brief detection destructor
@@ -177,6 +209,27 @@ class detection : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of detectionerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -211,10 +264,20 @@ class detection : public detectionbase {
 	/**
 	 * \brief detection type
 	 *
-	 * An optional std::string containing the detection type of this detection
-	 * valid values are >New>, >Update>, >Final>, or >Retract>
+	 * An optional detectiontypeindex containing the detection type of this
+	 * detection valid values are newdetection, update, final, or
+	 * retractdetection, detectiontypecount if there is no detection type
+	 */
+	detectiontypeindex detectiontype;
+
+	/**
+	 * \brief detection type text
+	 *
+	 * The string of a detection type that is not a valid value, kept so that
+	 * it is written back out, empty unless detectiontype is
+	 * unknowndetectiontype
 	 */
-	std::string detectiontype;
+	std::string detectiontypetext;
 
 	/**
 	 * \brief detection event type
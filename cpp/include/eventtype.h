@@ -14,6 +14,13 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats eventtype validation error codes
+ */
+enum eventtypeerror {
+	eventtypetypeinvalid, eventtypecertaintyinvalid, eventtypeerrorcount
+};
+
 /**
  * \brief detectionformats eventtype conversion class
  *
@@ -62,6 +69,27 @@ class eventtype : public detectionbase {
 	 */
 	eventtype(const eventtype & neweventtype);
 
+	/**
+	 * \brief eventtype move constructor
+	 *
+	 * The move constructor for the eventtype class.
+	 * Moves members from provided eventtype without copying them.
+	 *
+	 * \param neweventtype - A detectionformats::eventtype to move from
+	 */
+	eventtype(eventtype &&neweventtype) = default;
+
+	/**
+	 * \brief eventtype assignment operators
+	 *
+	 * Copies or moves members from provided eventtype.
+	 *
+	 * \param neweventtype - A detectionformats::eventtype to copy or move from
+	 * \return Returns a reference to this eventtype
+	 */
+	eventtype & operator=(const eventtype &neweventtype) = default;
+	eventtype & operator=(eventtype &&neweventtype) = default;
+
 	/**
 	 * \brief eventtype destructor
 	 *
@@ -84,6 +112,27 @@ class eventtype : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of eventtypeerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -98,14 +147,34 @@ class eventtype : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
+
+	/**
+	 * \brief eventtype type
+	 *
+	 * An optional eventtypeindex containing the type for this eventtype,
+	 * eventtypecount if there is no type. Hides detectionbase::type, which is
+	 * not used by this class.
+	 */
+	eventtypeindex type;
+
+	/**
+	 * \brief eventtype certainty
+	 *
+	 * An optional eventtypecertaintyindex containing the certainty for this
+	 * eventtype, eventtypecertaintycount if there is no certainty.
+	 */
+	eventtypecertaintyindex certainty;
 
 	/**
-	 * \brief site autnor
+	 * \brief eventtype type and certainty text
 	 *
-	 * An optional std::string containing the certainty for this eventtype.
+	 * The strings of a type or certainty that are not valid values, kept so
+	 * that they are written back out, empty unless the index is
+	 * unknowneventtype or unknowncertainty
 	 */
-	std::string certainty;
+	std::string typetext;
+	std::string certaintytext;
 };
 }  // namespace detectionformats
 #endif  // DETECTION_EVENTTYPE_H
@@ -14,6 +14,13 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats filter validation error codes
+ */
+enum filtererror {
+	filtererrorcount = 0
+};
+
 /**
  * \brief detectionformats filter conversion class
  *
@@ -67,6 +74,27 @@ class filter : public detectionbase {
 	 */
 	filter(const filter & newfilter);
 
+	/**
+	 * \brief filter move constructor
+	 *
+	 * The move constructor for the filter class.
+	 * Moves members from provided filter without copying them.
+	 *
+	 * \param newfilter - A detectionformats::filter to move from
+	 */
+	filter(filter &&newfilter) = default;
+
+	/**
+	 * \brief filter assignment operators
+	 *
+	 * Copies or moves members from provided filter.
+	 *
+	 * \param newfilter - A detectionformats::filter to copy or move from
+	 * \return Returns a reference to this filter
+	 */
+	filter & operator=(const filter &newfilter) = default;
+	filter & operator=(filter &&newfilter) = default;
+
 	/**
 	 * \brief filter destructor
 	 *
@@ -89,6 +117,27 @@ class filter : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of filtererror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -103,7 +152,7 @@ class filter : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief filter highpass
@@ -14,6 +14,15 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats hypocenter validation error codes
+ */
+enum hypoerror {
+	hypolatitudemissing, hypolatitudeinvalid, hypolongitudemissing,
+	hypolongitudeinvalid, hypotimemissing, hypotimeinvalid, hypodepthmissing,
+	hypodepthinvalid, hypoerrorcount
+};
+
 /**
  * \brief detectionformats hypocenter conversion class
  *
@@ -73,6 +82,27 @@ class hypocenter : public detectionbase {
 	 */
 	hypocenter(const hypocenter & newhypo);
 
+	/**
+	 * \brief hypocenter move constructor
+	 *
+	 * The move constructor for the hypocenter class.
+	 * Moves members from provided hypocenter without copying them.
+	 *
+	 * \param newhypo - A detectionformats::hypocenter to move from
+	 */
+	hypocenter(hypocenter &&newhypo) = default;
+
+	/**
+	 * \brief hypocenter assignment operators
+	 *
+	 * Copies or moves members from provided hypocenter.
+	 *
+	 * \param newhypo - A detectionformats::hypocenter to copy or move from
+	 * \return Returns a reference to this hypocenter
+	 */
+	hypocenter & operator=(const hypocenter &newhypo) = default;
+	hypocenter & operator=(hypocenter &&newhypo) = default;
+
 	/**
 	 * \brief hypocenter destructor
 	 *
@@ -95,6 +125,27 @@ class hypocenter : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of hypoerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -0,0 +1,450 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_KEYS_H
+#define DETECTION_KEYS_H
+
+#include <cstdint>
+
+#include "util.h" // NOLINT
+
+// JSON Keys
+#define ID_KEY "ID"
+#define SITE_KEY "Site"
+#define SOURCE_KEY "Source"
+#define TIME_KEY "Time"
+#define PHASE_KEY "Phase"
+#define POLARITY_KEY "Polarity"
+#define ONSET_KEY "Onset"
+#define PICKER_KEY "Picker"
+#define FILTER_KEY "Filter"
+#define AMPLITUDE_KEY "Amplitude"
+#define BEAM_KEY "Beam"
+#define ASSOCIATIONINFO_KEY "AssociationInfo"
+#define CLASSIFICATIONINFO_KEY "ClassificationInfo"
+#define CORRELATION_KEY "Correlation"
+#define HYPOCENTER_KEY "Hypocenter"
+#define EVENTTYPE_KEY "EventType"
+#define MAGNITUDE_KEY "Magnitude"
+#define SNR_KEY "SNR"
+#define ZSCORE_KEY "ZScore"
+#define DETECTIONTHRESHOLD_KEY "DetectionThreshold"
+#define THRESHOLDTYPE_KEY "ThresholdType"
+#define DETECTIONTYPE_KEY "DetectionType"
+#define DETECTIONTIME_KEY "DetectionTime"
+#define BAYES_KEY "Bayes"
+#define MINIMUMDISTANCE_KEY "MinimumDistance"
+#define RMS_KEY "RMS"
+#define GAP_KEY "Gap"
+#define DATA_KEY "Data"
+#define QUALITY_KEY "Quality"
+#define ENABLE_KEY "Enable"
+#define USE_KEY "Use"
+#define USEFORTELESEISMIC_KEY "UseForTeleseismic"
+#define INFORMATIONREQUESTOR_KEY "InformationRequestor"
+#define STATION_KEY "Station"
+#define CHANNEL_KEY "Channel"
+#define NETWORK_KEY "Network"
+#define LOCATION_KEY "Location"
+#define LATITUDE_KEY "Latitude"
+#define LONGITUDE_KEY "Longitude"
+#define ELEVATION_KEY "Elevation"
+#define AGENCYID_KEY "AgencyID"
+#define AUTHOR_KEY "Author"
+#define HIGHPASS_KEY "HighPass"
+#define LOWPASS_KEY "LowPass"
+#define UNITS_KEY "Units"
+#define PERIOD_KEY "Period"
+#define BACKAZIMUTH_KEY "BackAzimuth"
+#define SLOWNESS_KEY "Slowness"
+#define POWERRATIO_KEY "PowerRatio"
+#define BACKAZIMUTHERROR_KEY "BackAzimuthError"
+#define SLOWNESSERROR_KEY "SlownessError"
+#define POWERRATIOERROR_KEY "PowerRatioError"
+#define DISTANCE_KEY "Distance"
+#define AZIMUTH_KEY "Azimuth"
+#define RESIDUAL_KEY "Residual"
+#define SIGMA_KEY "Sigma"
+#define PHASEPROB_KEY "PhaseProbability"
+#define DISTANCEPROB_KEY "DistanceProbability"
+#define AZIMUTHPROB_KEY "AzimuthProbability"
+#define MAGNITUDETYPE_KEY "MagnitudeType"
+#define MAGNITUDEPROB_KEY "MagnitudeProbability"
+#define DEPTH_KEY "Depth"
+#define DEPTHPROB_KEY "DepthProbability"
+#define EVENTTYPEPROB_KEY "EventTypeProbability"
+#define LATITUDE_ERROR_KEY "LatitudeError"
+#define LONGITUDE_ERROR_KEY "LongitudeError"
+#define DEPTH_ERROR_KEY "DepthError"
+#define TIME_ERROR_KEY "TimeError"
+#define CERTAINTY_KEY "Certainty"
+
+/**
+ * \brief the largest hash seed tried when building a key table
+ */
+#define KEYTABLE_MAXSEED 100000
+
+namespace detectionformats {
+/**
+ * \brief detectionformats json key hash function
+ *
+ * A seeded FNV-1a hash of the provided key, with the high bits folded
+ * into the low bits
+ * \param str - A pointer to the key characters
+ * \param length - The number of characters in the key
+ * \param seed - The seed to start the hash with
+ * \return Returns the hash of the key
+ */
+constexpr uint32_t keyhash(const char *str, uint32_t length, uint32_t seed) {
+	uint32_t hash = seed;
+	for (uint32_t i = 0; i < length; i++) {
+		hash = (hash ^ static_cast<uint8_t>(str[i])) * 16777619u;
+	}
+
+	// fold the high bits down so the low (slot) bits depend on every
+	// character
+	return (hash ^ (hash >> 16));
+}
+
+/**
+ * \brief detectionformats json key length function
+ *
+ * \param str - A pointer to a null terminated key
+ * \return Returns the number of characters in the key
+ */
+constexpr uint32_t keylength(const char *str) {
+	uint32_t length = 0;
+	while (str[length] != '\0') {
+		length++;
+	}
+	return (length);
+}
+
+/**
+ * \brief detectionformats json key table
+ *
+ * A perfect hash table mapping the json keys of one class to their key
+ * index, built at compile time by makekeytable(). Every key hashes to its
+ * own slot, so a lookup is one hash, one slot read, and one comparison.
+ */
+template<int COUNT, int SIZE>
+struct keytable {
+	static_assert((SIZE & (SIZE - 1)) == 0,
+					"key table size must be a power of two");
+
+	/**
+	 * \brief Find a key
+	 *
+	 * \param str - A pointer to the key characters, not null terminated
+	 * \param length - The number of characters in the key
+	 * \return Returns the index of the key, or -1 if the key is not in the
+	 * table
+	 */
+	constexpr int find(const char *str, uint32_t length) const {
+		int index = slots[keyhash(str, length, seed) & (SIZE - 1)];
+		if ((index < 0) || (lengths[index] != length)) {
+			return (-1);
+		}
+		for (uint32_t i = 0; i < length; i++) {
+			if (keys[index][i] != str[i]) {
+				return (-1);
+			}
+		}
+		return (index);
+	}
+
+	/**
+	 * \brief the keys, in key index order
+	 */
+	const char *keys[COUNT];
+
+	/**
+	 * \brief the length of each key, in key index order
+	 */
+	uint32_t lengths[COUNT];
+
+	/**
+	 * \brief the key index stored in each hash slot, -1 for empty slots
+	 */
+	int slots[SIZE];
+
+	/**
+	 * \brief the hash seed that places every key in its own slot, 0 if no
+	 * seed was found
+	 */
+	uint32_t seed;
+};
+
+/**
+ * \brief Build a key table
+ *
+ * Builds a perfect hash table for the provided keys by searching for a hash
+ * seed that gives every key its own slot.
+ * \param keys - The keys, in key index order
+ * \return Returns the key table
+ */
+template<int SIZE, int COUNT>
+constexpr keytable<COUNT, SIZE> makekeytable(
+		const char * const (&keys)[COUNT]) {
+	keytable<COUNT, SIZE> table = {};
+
+	for (int i = 0; i < COUNT; i++) {
+		table.keys[i] = keys[i];
+		table.lengths[i] = keylength(keys[i]);
+	}
+
+	for (uint32_t seed = 1; seed < KEYTABLE_MAXSEED; seed++) {
+		for (int i = 0; i < SIZE; i++) {
+			table.slots[i] = -1;
+		}
+
+		bool collision = false;
+		for (int i = 0; (i < COUNT) && (collision == false); i++) {
+			uint32_t slot = keyhash(keys[i], table.lengths[i], seed)
+					& (SIZE - 1);
+			if (table.slots[slot] >= 0) {
+				collision = true;
+			} else {
+				table.slots[slot] = i;
+			}
+		}
+
+		if (collision == false) {
+			table.seed = seed;
+			return (table);
+		}
+	}
+
+	// no perfect seed
+	table.seed = 0;
+	return (table);
+}
+
+/**
+ * \brief pick json key index enum
+ */
+enum pickkeyindex {
+	picktypekey, pickidkey, picksitekey, picksourcekey, picktimekey,
+	pickphasekey, pickpolaritykey, pickonsetkey, pickpickerkey,
+	pickfilterkey, pickamplitudekey, pickbeamkey, pickassociationkey,
+	pickclassificationkey, pickkeycount
+};
+static constexpr const char *pickkeys[] = { TYPE_KEY, ID_KEY, SITE_KEY,
+		SOURCE_KEY, TIME_KEY, PHASE_KEY, POLARITY_KEY, ONSET_KEY, PICKER_KEY,
+		FILTER_KEY, AMPLITUDE_KEY, BEAM_KEY, ASSOCIATIONINFO_KEY,
+		CLASSIFICATIONINFO_KEY };
+static constexpr keytable<pickkeycount, 32> pickkeytable =
+		makekeytable<32>(pickkeys);
+static_assert(pickkeytable.seed != 0, "no perfect hash for pick keys");
+
+/**
+ * \brief correlation json key index enum
+ */
+enum correlationkeyindex {
+	correlationtypekey, correlationidkey, correlationsitekey,
+	correlationsourcekey, correlationphasekey, correlationtimekey,
+	correlationvaluekey, correlationhypocenterkey, correlationeventtypekey,
+	correlationmagnitudekey, correlationsnrkey, correlationzscorekey,
+	correlationthresholdkey, correlationthresholdtypekey,
+	correlationassociationkey, correlationkeycount
+};
+static constexpr const char *correlationkeys[] = { TYPE_KEY, ID_KEY,
+		SITE_KEY, SOURCE_KEY, PHASE_KEY, TIME_KEY, CORRELATION_KEY,
+		HYPOCENTER_KEY, EVENTTYPE_KEY, MAGNITUDE_KEY, SNR_KEY, ZSCORE_KEY,
+		DETECTIONTHRESHOLD_KEY, THRESHOLDTYPE_KEY, ASSOCIATIONINFO_KEY };
+static constexpr keytable<correlationkeycount, 32> correlationkeytable =
+		makekeytable<32>(correlationkeys);
+static_assert(correlationkeytable.seed != 0,
+				"no perfect hash for correlation keys");
+
+/**
+ * \brief detection json key index enum
+ */
+enum detectionkeyindex {
+	detectiontypekey, detectionidkey, detectionsourcekey,
+	detectionhypocenterkey, detectiondetectiontypekey, detectiontimekey,
+	detectioneventtypekey, detectionbayeskey, detectionmindistkey,
+	detectionrmskey, detectiongapkey, detectiondatakey, detectionkeycount
+};
+static constexpr const char *detectionkeys[] = { TYPE_KEY, ID_KEY,
+		SOURCE_KEY, HYPOCENTER_KEY, DETECTIONTYPE_KEY, DETECTIONTIME_KEY,
+		EVENTTYPE_KEY, BAYES_KEY, MINIMUMDISTANCE_KEY, RMS_KEY, GAP_KEY,
+		DATA_KEY };
+static constexpr keytable<detectionkeycount, 32> detectionkeytable =
+		makekeytable<32>(detectionkeys);
+static_assert(detectionkeytable.seed != 0,
+				"no perfect hash for detection keys");
+
+/**
+ * \brief retract json key index enum
+ */
+enum retractkeyindex {
+	retracttypekey, retractidkey, retractsourcekey, retractkeycount
+};
+static constexpr const char *retractkeys[] = { TYPE_KEY, ID_KEY,
+		SOURCE_KEY };
+static constexpr keytable<retractkeycount, 8> retractkeytable =
+		makekeytable<8>(retractkeys);
+static_assert(retractkeytable.seed != 0, "no perfect hash for retract keys");
+
+/**
+ * \brief stationInfo json key index enum
+ */
+enum stationinfokeyindex {
+	stationinfotypekey, stationinfositekey, stationinfoqualitykey,
+	stationinfoenablekey, stationinfousekey, stationinfoteleseismickey,
+	stationinforequestorkey, stationinfokeycount
+};
+static constexpr const char *stationinfokeys[] = { TYPE_KEY, SITE_KEY,
+		QUALITY_KEY, ENABLE_KEY, USE_KEY, USEFORTELESEISMIC_KEY,
+		INFORMATIONREQUESTOR_KEY };
+static constexpr keytable<stationinfokeycount, 16> stationinfokeytable =
+		makekeytable<16>(stationinfokeys);
+static_assert(stationinfokeytable.seed != 0,
+				"no perfect hash for stationInfo keys");
+
+/**
+ * \brief stationInfoRequest json key index enum
+ */
+enum stationinforequestkeyindex {
+	requesttypekey, requestsitekey, requestsourcekey, requestkeycount
+};
+static constexpr const char *requestkeys[] = { TYPE_KEY, SITE_KEY,
+		SOURCE_KEY };
+static constexpr keytable<requestkeycount, 8> requestkeytable =
+		makekeytable<8>(requestkeys);
+static_assert(requestkeytable.seed != 0,
+				"no perfect hash for stationInfoRequest keys");
+
+/**
+ * \brief site json key index enum
+ */
+enum sitekeyindex {
+	sitestationkey, sitechannelkey, sitenetworkkey, sitelocationkey,
+	sitelatitudekey, sitelongitudekey, siteelevationkey, sitekeycount
+};
+static constexpr const char *sitekeys[] = { STATION_KEY, CHANNEL_KEY,
+		NETWORK_KEY, LOCATION_KEY, LATITUDE_KEY, LONGITUDE_KEY,
+		ELEVATION_KEY };
+static constexpr keytable<sitekeycount, 16> sitekeytable =
+		makekeytable<16>(sitekeys);
+static_assert(sitekeytable.seed != 0, "no perfect hash for site keys");
+
+/**
+ * \brief source json key index enum
+ */
+enum sourcekeyindex {
+	sourceagencyidkey, sourceauthorkey, sourcekeycount
+};
+static constexpr const char *sourcekeys[] = { AGENCYID_KEY, AUTHOR_KEY };
+static constexpr keytable<sourcekeycount, 4> sourcekeytable =
+		makekeytable<4>(sourcekeys);
+static_assert(sourcekeytable.seed != 0, "no perfect hash for source keys");
+
+/**
+ * \brief filter json key index enum
+ */
+enum filterkeyindex {
+	filtertypekey, filterhighpasskey, filterlowpasskey, filterunitskey,
+	filterkeycount
+};
+static constexpr const char *filterkeys[] = { TYPE_KEY, HIGHPASS_KEY,
+		LOWPASS_KEY, UNITS_KEY };
+static constexpr keytable<filterkeycount, 8> filterkeytable =
+		makekeytable<8>(filterkeys);
+static_assert(filterkeytable.seed != 0, "no perfect hash for filter keys");
+
+/**
+ * \brief amplitude json key index enum
+ */
+enum amplitudekeyindex {
+	amplitudevaluekey, amplitudeperiodkey, amplitudesnrkey, amplitudekeycount
+};
+static constexpr const char *amplitudekeys[] = { AMPLITUDE_KEY, PERIOD_KEY,
+		SNR_KEY };
+static constexpr keytable<amplitudekeycount, 8> amplitudekeytable =
+		makekeytable<8>(amplitudekeys);
+static_assert(amplitudekeytable.seed != 0,
+				"no perfect hash for amplitude keys");
+
+/**
+ * \brief beam json key index enum
+ */
+enum beamkeyindex {
+	beambackazimuthkey, beamslownesskey, beampowerratiokey,
+	beambackazimutherrorkey, beamslownesserrorkey, beampowerratioerrorkey,
+	beamkeycount
+};
+static constexpr const char *beamkeys[] = { BACKAZIMUTH_KEY, SLOWNESS_KEY,
+		POWERRATIO_KEY, BACKAZIMUTHERROR_KEY, SLOWNESSERROR_KEY,
+		POWERRATIOERROR_KEY };
+static constexpr keytable<beamkeycount, 16> beamkeytable =
+		makekeytable<16>(beamkeys);
+static_assert(beamkeytable.seed != 0, "no perfect hash for beam keys");
+
+/**
+ * \brief association json key index enum
+ */
+enum associationkeyindex {
+	associationphasekey, associationdistancekey, associationazimuthkey,
+	associationresidualkey, associationsigmakey, associationkeycount
+};
+static constexpr const char *associationkeys[] = { PHASE_KEY, DISTANCE_KEY,
+		AZIMUTH_KEY, RESIDUAL_KEY, SIGMA_KEY };
+static constexpr keytable<associationkeycount, 16> associationkeytable =
+		makekeytable<16>(associationkeys);
+static_assert(associationkeytable.seed != 0,
+				"no perfect hash for association keys");
+
+/**
+ * \brief classification json key index enum
+ */
+enum classificationkeyindex {
+	classphasekey, classphaseprobkey, classdistancekey, classdistanceprobkey,
+	classazimuthkey, classazimuthprobkey, classmagnitudekey,
+	classmagnitudetypekey, classmagnitudeprobkey, classdepthkey,
+	classdepthprobkey, classeventtypekey, classeventtypeprobkey,
+	classsourcekey, classificationkeycount
+};
+static constexpr const char *classificationkeys[] = { PHASE_KEY,
+		PHASEPROB_KEY, DISTANCE_KEY, DISTANCEPROB_KEY, AZIMUTH_KEY,
+		AZIMUTHPROB_KEY, MAGNITUDE_KEY, MAGNITUDETYPE_KEY, MAGNITUDEPROB_KEY,
+		DEPTH_KEY, DEPTHPROB_KEY, EVENTTYPE_KEY, EVENTTYPEPROB_KEY,
+		SOURCE_KEY };
+static constexpr keytable<classificationkeycount, 32>
+		classificationkeytable = makekeytable<32>(classificationkeys);
+static_assert(classificationkeytable.seed != 0,
+				"no perfect hash for classification keys");
+
+/**
+ * \brief hypocenter json key index enum
+ */
+enum hypocenterkeyindex {
+	hypolatitudekey, hypolongitudekey, hypodepthkey, hypotimekey,
+	hypolatitudeerrorkey, hypolongitudeerrorkey, hypodeptherrorkey,
+	hypotimeerrorkey, hypocenterkeycount
+};
+static constexpr const char *hypocenterkeys[] = { LATITUDE_KEY,
+		LONGITUDE_KEY, DEPTH_KEY, TIME_KEY, LATITUDE_ERROR_KEY,
+		LONGITUDE_ERROR_KEY, DEPTH_ERROR_KEY, TIME_ERROR_KEY };
+static constexpr keytable<hypocenterkeycount, 16> hypocenterkeytable =
+		makekeytable<16>(hypocenterkeys);
+static_assert(hypocenterkeytable.seed != 0,
+				"no perfect hash for hypocenter keys");
+
+/**
+ * \brief eventtype json key index enum
+ */
+enum eventtypekeyindex {
+	eventtypetypekey, eventtypecertaintykey, eventtypekeycount
+};
+static constexpr const char *eventtypekeys[] = { TYPE_KEY, CERTAINTY_KEY };
+static constexpr keytable<eventtypekeycount, 4> eventtypekeytable =
+		makekeytable<4>(eventtypekeys);
+static_assert(eventtypekeytable.seed != 0,
+				"no perfect hash for eventtype keys");
+}  // namespace detectionformats
+#endif  // DETECTION_KEYS_H
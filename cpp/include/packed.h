@@ -0,0 +1,112 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_PACKED_H
+#define DETECTION_PACKED_H
+
+#include <cstddef>
+#include <string>
+
+#include "codec.h" // NOLINT
+
+/**
+ * \brief deepest nesting of arrays and maps read from a packed message
+ */
+#define PACKED_MAXDEPTH 32
+
+/**
+ * \brief smallest room in bytes ToMessagePack() and ToCBOR() give a buffer
+ * to write into
+ */
+#define PACKED_INITIALSIZE 512
+
+namespace detectionformats {
+/**
+ * \brief Convert to MessagePack and CBOR functions
+ *
+ * Encodes the provided object or json value as MessagePack or CBOR
+ * (RFC 8949), with the same maps, arrays, and key names as the json, into
+ * the buffer, replacing its contents and keeping its capacity. Objects are
+ * written by their own write(), the same walk that writes their json, and
+ * json values through rapidjson::Value::Accept(). Integers and strings take
+ * their shortest encodings, and doubles are written as single precision
+ * floats when that loses nothing.
+ * \param object - The object to encode
+ * \param json - The json value to encode
+ * \param buffer - A std::string to hold the encoded message
+ * \return Returns a reference to the buffer, throws std::invalid_argument if
+ * the json value nests deeper than PACKED_MAXDEPTH
+ */
+std::string & ToMessagePack(detectionbase &object,
+							std::string &buffer); // NOLINT
+std::string & ToMessagePack(const rapidjson::Value &json,
+							std::string &buffer); // NOLINT
+std::string & ToCBOR(detectionbase &object, std::string &buffer); // NOLINT
+std::string & ToCBOR(const rapidjson::Value &json,
+						std::string &buffer); // NOLINT
+
+/**
+ * \brief Convert from MessagePack and CBOR to document functions
+ *
+ * Reads a MessagePack or CBOR message into the context document, the same
+ * way FromJSONString() parses json.
+ * \param data - A pointer to the encoded message
+ * \param length - The length of the encoded message in bytes
+ * \param context - The codec_context to read with
+ * \return Returns a reference to the context document, throws
+ * std::invalid_argument if the message is malformed, has map keys that are
+ * not strings, or is not a map
+ */
+codecdocument & FromMessagePack(const char *data, size_t length,
+								codec_context &context); // NOLINT
+codecdocument & FromCBOR(const char *data, size_t length,
+							codec_context &context); // NOLINT
+
+/**
+ * \brief Convert from MessagePack and CBOR functions
+ *
+ * Decodes a MessagePack or CBOR message straight into the provided object
+ * with the context decoder, the same way FromJSONString() decodes json, so
+ * the object is filled in, and can be validated, exactly as from json with
+ * the same content.
+ * \param data - A pointer to the encoded message
+ * \param length - The length of the encoded message in bytes
+ * \param object - The object to decode into
+ * \param context - The codec_context to decode with
+ * \return Returns a reference to the object, throws std::invalid_argument if
+ * the message is malformed or does not fit the object
+ */
+pick & FromMessagePack(const char *data, size_t length, pick &object,
+						codec_context &context); // NOLINT
+correlation & FromMessagePack(const char *data, size_t length,
+								correlation &object,
+								codec_context &context); // NOLINT
+detection & FromMessagePack(const char *data, size_t length,
+							detection &object,
+							codec_context &context); // NOLINT
+retract & FromMessagePack(const char *data, size_t length, retract &object,
+							codec_context &context); // NOLINT
+stationInfo & FromMessagePack(const char *data, size_t length,
+								stationInfo &object,
+								codec_context &context); // NOLINT
+stationInfoRequest & FromMessagePack(const char *data, size_t length,
+										stationInfoRequest &object,
+										codec_context &context); // NOLINT
+pick & FromCBOR(const char *data, size_t length, pick &object,
+				codec_context &context); // NOLINT
+correlation & FromCBOR(const char *data, size_t length, correlation &object,
+						codec_context &context); // NOLINT
+detection & FromCBOR(const char *data, size_t length, detection &object,
+						codec_context &context); // NOLINT
+retract & FromCBOR(const char *data, size_t length, retract &object,
+					codec_context &context); // NOLINT
+stationInfo & FromCBOR(const char *data, size_t length, stationInfo &object,
+						codec_context &context); // NOLINT
+stationInfoRequest & FromCBOR(const char *data, size_t length,
+								stationInfoRequest &object,
+								codec_context &context); // NOLINT
+}  // namespace detectionformats
+#endif  // DETECTION_PACKED_H
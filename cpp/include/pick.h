@@ -21,6 +21,17 @@
 
 namespace detectionformats {
 
+/**
+ * \brief detectionformats pick validation error codes
+ */
+enum pickerror {
+	picktypeinvalid, pickidmissing, picksiteinvalid, picksourceinvalid,
+	picktimemissing, picktimeinvalid, pickphaseinvalid, pickpolarityinvalid,
+	pickonsetinvalid, pickpickerinvalid, pickfilterinvalid,
+	pickamplitudeinvalid, pickbeaminvalid, pickassociationinvalid,
+	pickclassificationinvalid, pickerrorcount
+};
+
 /**
  * \brief detectionformats pick conversion class
  *
@@ -378,7 +389,28 @@ class pick : public detectionbase {
 	 *
 	 * \param newpick - A detectionformats::pick to copy from
 	 */
-	pick(const pick &newpick);
+	pick(const pick &newpick) = default;
+
+	/**
+	 * \brief pick move constructor
+	 *
+	 * The move constructor for the pick class.
+	 * Moves members from provided pick without copying them.
+	 *
+	 * \param newpick - A detectionformats::pick to move from
+	 */
+	pick(pick &&newpick) = default;
+
+	/**
+	 * \brief pick assignment operators
+	 *
+	 * Copies or moves members from provided pick.
+	 *
+	 * \param newpick - A detectionformats::pick to copy or move from
+	 * \return Returns a reference to this pick
+	 */
+	pick & operator=(const pick &newpick) = default;
+	pick & operator=(pick &&newpick) = default;
 
 	/**
 	 * \brief pick destructor
@@ -402,6 +434,27 @@ class pick : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of pickerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -450,27 +503,39 @@ class pick : public detectionbase {
 	/**
 	 * \brief pick polarity
 	 *
-	 * An optional std::string containing the polarity for this pick message
-	 * valid values are >up> or >down>
+	 * An optional polarityindex containing the polarity for this pick message
+	 * valid values are up or down, polaritycount if there is no polarity
 	 */
-	std::string polarity;
+	polarityindex polarity;
 
 	/**
 	 * \brief pick onset
 	 *
-	 * An optional std::string containing the onset for this pick message
-	 * valid values are >impulsive>, >emergent>, or >questionable>
+	 * An optional onsetindex containing the onset for this pick message
+	 * valid values are impulsive, emergent, or questionable, onsetcount if
+	 * there is no onset
 	 */
-	std::string onset;
+	onsetindex onset;
 
 	/**
 	 * \brief pick picker type
 	 *
-	 * An optional std::string defining the picker that made this pick message
-	 * valid values are >manual>, >raypicker>, >filterpicker>, >earthworm>, or
-	 * >other>
+	 * An optional pickerindex defining the picker that made this pick message
+	 * valid values are manual, raypicker, filterpicker, earthworm, or other,
+	 * pickercount if there is no picker
+	 */
+	pickerindex picker;
+
+	/**
+	 * \brief pick polarity, onset, and picker text
+	 *
+	 * The strings of a polarity, onset, or picker that are not valid values,
+	 * kept so that they are written back out, empty unless the index is
+	 * unknownpolarity, unknownonset, or unknownpicker
 	 */
-	std::string picker;
+	std::string polaritytext;
+	std::string onsettext;
+	std::string pickertext;
 
 	/**
 	 * \brief pick filter data
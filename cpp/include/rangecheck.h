@@ -0,0 +1,125 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_RANGECHECK_H
+#define DETECTION_RANGECHECK_H
+
+#include <cstddef>
+
+#include "base.h" // NOLINT
+#include "site.h" // NOLINT
+#include "classification.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "stationInfo.h" // NOLINT
+#include "batch.h" // NOLINT
+
+namespace detectionformats {
+/**
+ * \brief detectionformats range check level enum
+ *
+ * The instruction sets the range check kernels can use, see
+ * GetRangeCheckLevel().
+ */
+enum rangechecklevel {
+	scalarlevel = 0,
+	sse2level = 1,
+	avx2level = 2,
+	rangechecklevelcount = 3,
+	unknownlevel = -1
+};
+
+/**
+ * \brief Get range check level function
+ *
+ * Gets the instruction set the range check functions use. It is chosen when
+ * first needed from what the processor supports, AVX2, SSE2 on any other
+ * x86-64 processor, or plain C++ elsewhere.
+ * \return Returns the rangechecklevel value in use
+ */
+int GetRangeCheckLevel();
+
+/**
+ * \brief Set range check level function
+ *
+ * Sets the instruction set the range check functions use, for comparing
+ * the kernels. A level the processor does not support is lowered to the
+ * best one it does.
+ * \param level - The rangechecklevel value to use
+ * \return Returns the rangechecklevel value now in use
+ */
+int SetRangeCheckLevel(int level);
+
+/**
+ * \brief Check range function
+ *
+ * Checks a column of values against a range, the kernel of the functions
+ * below. Values from the minimum to the maximum are valid, NaN values are
+ * missing, and any others are invalid. The code for each row is ORed into
+ * its error bitmask, without branching on the values, AVX2 and SSE2
+ * kernels checking four and two rows at a time.
+ * \param values - A pointer to the column of values
+ * \param count - The number of values
+ * \param minimum - A double containing the smallest valid value
+ * \param maximum - A double containing the largest valid value, or the
+ * first value past the valid values if includemaximum is false
+ * \param includemaximum - A boolean flag indicating whether the maximum is
+ * a valid value
+ * \param invalidcode - The errorcodes to set for invalid values
+ * \param missingcode - The errorcodes to set for missing values, 0 if the
+ * value is optional
+ * \param errors - A pointer to count error bitmasks to OR the codes into
+ */
+void CheckRange(const double *values, size_t count, double minimum,
+				double maximum, bool includemaximum, errorcodes invalidcode,
+				errorcodes missingcode, errorcodes *errors);
+
+/**
+ * \brief Check column ranges functions
+ *
+ * Checks columns of the numeric members of many objects at once, setting
+ * the same siteerror, classerror, correlationerror, or stationinfoerror
+ * codes the validate() function of each object would for the ranges of
+ * those members. The codes are ORed into the error bitmasks, so the
+ * caller zeroes them first, and members that are not range checked, such
+ * as strings, are left to validate().
+ * \param latitudes - A pointer to the column of latitudes
+ * \param longitudes - A pointer to the column of longitudes
+ * \param elevations - A pointer to the column of elevations
+ * \param distances - A pointer to the column of distances
+ * \param azimuths - A pointer to the column of azimuths
+ * \param magnitudes - A pointer to the column of magnitudes
+ * \param depths - A pointer to the column of depths
+ * \param snrs - A pointer to the column of signal to noise ratios
+ * \param count - The number of rows
+ * \param errors - A pointer to count error bitmasks to OR the codes into
+ */
+void CheckSiteRanges(const double *latitudes, const double *longitudes,
+						const double *elevations, size_t count,
+						errorcodes *errors);
+void CheckClassificationRanges(const double *distances,
+								const double *azimuths,
+								const double *magnitudes,
+								const double *depths, size_t count,
+								errorcodes *errors);
+void CheckCorrelationRanges(const double *magnitudes, const double *snrs,
+							size_t count, errorcodes *errors);
+void CheckStationInfoRanges(const double *latitudes,
+							const double *longitudes,
+							const double *elevations, size_t count,
+							errorcodes *errors);
+
+/**
+ * \brief Check pick batch site ranges function
+ *
+ * Checks the site coordinate columns of a pick_batch, setting siteerror
+ * codes as CheckSiteRanges() does.
+ * \param batch - The pick_batch to check
+ * \param errors - A pointer to batch.size() error bitmasks to OR the codes
+ * into
+ */
+void CheckSiteRanges(const pick_batch &batch, errorcodes *errors);
+}  // namespace detectionformats
+#endif  // DETECTION_RANGECHECK_H
@@ -0,0 +1,195 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_REGISTRY_H
+#define DETECTION_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "stationInfo.h" // NOLINT
+#include "sitekey.h" // NOLINT
+
+/**
+ * \brief initial number of slots in the station_registry table
+ */
+#define REGISTRY_INITIALSLOTS 1024
+
+namespace detectionformats {
+/**
+ * \brief detectionformats station record class
+ *
+ * The station metadata a station_registry holds for a site, copied out by
+ * station_registry::find().
+ */
+class station_record {
+ public:
+	station_record();
+
+	site_key key;
+	double latitude;
+	double longitude;
+	double elevation;
+	double quality;
+	bool enable;
+	bool use;
+	bool useforteleseismic;
+};
+
+/**
+ * \brief detectionformats station registry class
+ *
+ * Holds the latest station metadata for each site from stationInfo
+ * messages, for looking up the station of every incoming pick.
+ *
+ * Lookups are wait free and may run on any number of threads while a writer
+ * updates the registry. The table is an open addressed hash table of
+ * pointers to immutable station_records. A writer publishes a changed
+ * station by swapping in a new record, and publishes a grown table by
+ * swapping in a new table, RCU style. A writer frees the replaced records
+ * and tables once every reader that could have seen them has finished.
+ * Writers are serialized with each other.
+ *
+ * Each reading thread has a slot of its own, on its own cache line, that
+ * it stores the current epoch in for the length of a lookup, so a lookup
+ * takes a bounded number of steps, never retries, and writes no memory
+ * another reader does. A writer advances the epoch and waits for the slots
+ * that hold an earlier one.
+ *
+ * A lookup is one hash probe in the common case, the table is kept at most
+ * half full.
+ */
+class station_registry {
+ public:
+	/**
+	 * \brief station_registry constructor
+	 *
+	 * The constructor for the station_registry class.
+	 * \param slots - The initial number of table slots, rounded up to a
+	 * power of two
+	 */
+	explicit station_registry(size_t slots = REGISTRY_INITIALSLOTS);
+
+	/**
+	 * \brief station_registry destructor
+	 *
+	 * The destructor for the station_registry class.
+	 * No lookups may be running.
+	 */
+	~station_registry();
+
+	station_registry(const station_registry &newregistry) = delete;
+	station_registry & operator=(const station_registry &newregistry) =
+			delete;
+
+	/**
+	 * \brief Find a station
+	 *
+	 * Wait free, safe to call while the registry is updated.
+	 * Not reentrant: a thread looks up one station at a time.
+	 * \param key - The site_key to look up
+	 * \param record - A pointer to the station_record to copy the station
+	 * into
+	 * \return Returns true if the station was found, false otherwise
+	 */
+	bool find(const site_key &key, station_record *record) const;
+
+	/**
+	 * \brief Update a station
+	 *
+	 * Adds the station, or replaces the station of the same site.
+	 * \param object - The stationInfo to add
+	 * \return Returns true if the station was added, false if the
+	 * stationInfo is not valid
+	 */
+	bool update(stationInfo &object); // NOLINT
+
+	/**
+	 * \brief Update stations
+	 *
+	 * Adds or replaces each station, waiting for readers once for the
+	 * whole batch.
+	 * \param objects - A pointer to the stationInfos to add
+	 * \param count - The number of stationInfos
+	 * \return Returns the number of stations added, invalid stationInfos
+	 * are skipped
+	 */
+	size_t update(stationInfo *objects, size_t count);
+
+	/**
+	 * \brief Load stations
+	 *
+	 * Reads stationInfo messages, as in a .jsonsta (STATIONINFOEXTENSION)
+	 * file, and adds them as one batch. Messages may be separated by any
+	 * whitespace, messages that are not valid stationInfos are skipped.
+	 * \param stream - The std::istream to read the messages from
+	 * \return Returns the number of stations added
+	 */
+	size_t load(std::istream &stream); // NOLINT
+
+	/**
+	 * \brief Load stations from a file
+	 *
+	 * See load(std::istream &).
+	 * \param filename - A std::string containing the path of the file
+	 * \return Returns the number of stations added, throws
+	 * std::invalid_argument if the file cannot be opened
+	 */
+	size_t load(const std::string &filename);
+
+	/**
+	 * \brief Gets the number of stations
+	 *
+	 * \return Returns the number of sites in the registry
+	 */
+	size_t size() const;
+
+	/**
+	 * \brief Gets the version
+	 *
+	 * \return Returns the number of updates published, which changes
+	 * whenever the registry does
+	 */
+	uint64_t getversion() const;
+
+ private:
+	/**
+	 * \brief a table of record pointers, the slot count is a power of two
+	 */
+	struct table {
+		explicit table(size_t newslots);
+
+		size_t mask;
+		std::unique_ptr<std::atomic<const station_record *>[]> slots;
+	};
+
+	/**
+	 * \brief Add a record to the current table, growing it if needed, and
+	 * collect what it replaces, must hold the write lock
+	 */
+	void insert(station_record *record);
+
+	/**
+	 * \brief Wait until no reader can see what was replaced, then free it,
+	 * must hold the write lock
+	 */
+	void synchronize();
+
+	std::atomic<table *> current;
+	std::atomic<size_t> stationcount;
+	std::atomic<uint64_t> version;
+
+	std::mutex writelock;
+	std::vector<const station_record *> retiredrecords;
+	std::vector<table *> retiredtables;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_REGISTRY_H
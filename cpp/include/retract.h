@@ -14,6 +14,14 @@
 #include "source.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats retract validation error codes
+ */
+enum retracterror {
+	retracttypeinvalid, retractidmissing, retractsourceinvalid,
+	retracterrorcount
+};
+
 /**
  * \brief detectionformats retract conversion class
  *
@@ -77,6 +85,27 @@ class retract : public detectionbase {
 	 */
 	retract(const retract & newretract);
 
+	/**
+	 * \brief retract move constructor
+	 *
+	 * The move constructor for the retract class.
+	 * Moves members from provided retract without copying them.
+	 *
+	 * \param newretract - A detectionformats::retract to move from
+	 */
+	retract(retract &&newretract) = default;
+
+	/**
+	 * \brief retract assignment operators
+	 *
+	 * Copies or moves members from provided retract.
+	 *
+	 * \param newretract - A detectionformats::retract to copy or move from
+	 * \return Returns a reference to this retract
+	 */
+	retract & operator=(const retract &newretract) = default;
+	retract & operator=(retract &&newretract) = default;
+
 	/**
 	 * \brief retract destructor
 	 *
@@ -99,6 +128,27 @@ class retract : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of retracterror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
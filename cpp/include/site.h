@@ -14,6 +14,14 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats site validation error codes
+ */
+enum siteerror {
+	sitestationmissing, sitenetworkmissing, sitelatitudeinvalid,
+	sitelongitudeinvalid, siteelevationinvalid, siteerrorcount
+};
+
 /**
  * \brief detectionformats site conversion class
  *
@@ -84,6 +92,27 @@ class site : public detectionbase {
 	 */
 	site(const site & newsite);
 
+	/**
+	 * \brief site move constructor
+	 *
+	 * The move constructor for the site class.
+	 * Moves members from provided site without copying them.
+	 *
+	 * \param newsite - A detectionformats::site to move from
+	 */
+	site(site &&newsite) = default;
+
+	/**
+	 * \brief site assignment operators
+	 *
+	 * Copies or moves members from provided site.
+	 *
+	 * \param newsite - A detectionformats::site to copy or move from
+	 * \return Returns a reference to this site
+	 */
+	site & operator=(const site &newsite) = default;
+	site & operator=(site &&newsite) = default;
+
 	/**
 	 * \brief site destructor
 	 *
@@ -106,6 +135,27 @@ class site : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of siteerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
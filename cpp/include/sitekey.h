@@ -0,0 +1,160 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_SITEKEY_H
+#define DETECTION_SITEKEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "site.h" // NOLINT
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "stationInfo.h" // NOLINT
+#include "stationInfoRequest.h" // NOLINT
+#include "views.h" // NOLINT
+
+/**
+ * \brief the widest SEED codes a site_key holds
+ */
+#define SITEKEY_STATIONWIDTH 5
+#define SITEKEY_CHANNELWIDTH 3
+#define SITEKEY_NETWORKWIDTH 2
+#define SITEKEY_LOCATIONWIDTH 2
+
+namespace detectionformats {
+/**
+ * \brief detectionformats site key class
+ *
+ * A 16 byte value identifying a site by its SEED station, channel, network,
+ * and location codes, for use as a key in per station tables. The codes are
+ * packed into 12 bytes, padded with nulls, and followed by a 4 byte hash
+ * computed when the key is made, so hashing a key is a load and comparing
+ * two keys compares two 64 bit words.
+ *
+ * Codes wider than SEED allows (5, 3, 2, and 2 characters) cannot be
+ * packed, a key made from them is invalid, see isvalid(). All invalid keys
+ * compare equal.
+ */
+class alignas(16) site_key {
+ public:
+	/**
+	 * \brief site_key constructor
+	 *
+	 * The constructor for the site_key class.
+	 * Initializes the key to empty codes.
+	 */
+	site_key();
+
+	/**
+	 * \brief site_key advanced constructor
+	 *
+	 * Initializes the key to the provided codes.
+	 * \param station - A std::string containing the station code
+	 * \param channel - A std::string containing the channel code
+	 * \param network - A std::string containing the network code
+	 * \param location - A std::string containing the location code
+	 */
+	site_key(const std::string &station, const std::string &channel,
+				const std::string &network, const std::string &location);
+
+	/**
+	 * \brief site_key object constructors
+	 *
+	 * Initializes the key to the codes of the provided site, or of the site
+	 * of the provided message.
+	 */
+	explicit site_key(const site &object);
+	explicit site_key(const site_view &view);
+	explicit site_key(const pick &object);
+	explicit site_key(const correlation &object);
+	explicit site_key(const stationInfo &object);
+	explicit site_key(const stationInfoRequest &object);
+
+	/**
+	 * \brief site_key json constructor
+	 *
+	 * Reads the codes straight from the json without building a site.
+	 * \param json - A json site object, or a json message with a Site
+	 * member
+	 */
+	explicit site_key(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Gets whether the key is valid
+	 *
+	 * \return Returns true if the codes fit and the station and network
+	 * are present, false otherwise
+	 */
+	bool isvalid() const;
+
+	/**
+	 * \brief Gets the codes
+	 *
+	 * \return Returns a std::string containing the code, empty if missing
+	 * or if the key is invalid
+	 */
+	std::string getstation() const;
+	std::string getchannel() const;
+	std::string getnetwork() const;
+	std::string getlocation() const;
+
+	/**
+	 * \brief Gets the hash
+	 *
+	 * \return Returns the hash computed when the key was made
+	 */
+	uint32_t gethash() const {
+		return (static_cast<uint32_t>(words[1] >> 32));
+	}
+
+	bool operator==(const site_key &other) const {
+		// the hash is part of the second word, which only differs if the
+		// codes do
+		return (((words[0] ^ other.words[0]) | (words[1] ^ other.words[1]))
+				== 0);
+	}
+
+	bool operator!=(const site_key &other) const {
+		return ((*this == other) == false);
+	}
+
+ private:
+	/**
+	 * \brief Pack the codes and compute the hash
+	 */
+	void pack(const char *station, size_t stationlength, const char *channel,
+				size_t channellength, const char *network, size_t networklength,
+				const char *location, size_t locationlength);
+
+	/**
+	 * \brief Get a code from the packed bytes
+	 */
+	std::string getcode(int offset, int width) const;
+
+	/**
+	 * \brief the codes in the first 12 bytes, then the hash
+	 */
+	uint64_t words[2];
+};
+
+static_assert(sizeof(site_key) == 16, "site_key must be 16 bytes");
+}  // namespace detectionformats
+
+namespace std {
+/**
+ * \brief site_key hash, so that site_key can key unordered containers
+ */
+template<>
+struct hash<detectionformats::site_key> {
+	size_t operator()(const detectionformats::site_key &key) const {
+		return (key.gethash());
+	}
+};
+}  // namespace std
+#endif  // DETECTION_SITEKEY_H
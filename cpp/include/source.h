@@ -14,6 +14,13 @@
 #include "base.h" // NOLINT
 
 namespace detectionformats {
+/**
+ * \brief detectionformats source validation error codes
+ */
+enum sourceerror {
+	sourceagencyidmissing, sourceauthormissing, sourceerrorcount
+};
+
 /**
  * \brief detectionformats source conversion class
  *
@@ -60,6 +67,27 @@ class source : public detectionbase {
 	 */
 	source(const source & newsource);
 
+	/**
+	 * \brief source move constructor
+	 *
+	 * The move constructor for the source class.
+	 * Moves members from provided source without copying them.
+	 *
+	 * \param newsource - A detectionformats::source to move from
+	 */
+	source(source &&newsource) = default;
+
+	/**
+	 * \brief source assignment operators
+	 *
+	 * Copies or moves members from provided source.
+	 *
+	 * \param newsource - A detectionformats::source to copy or move from
+	 * \return Returns a reference to this source
+	 */
+	source & operator=(const source &newsource) = default;
+	source & operator=(source &&newsource) = default;
+
 	/**
 	 * \brief source destructor
 	 *
@@ -82,6 +110,27 @@ class source : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of sourceerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -96,7 +145,7 @@ class source : public detectionbase {
 	 * Checks to see if this object is empty
 	 * \return Returns true if empty, false otherwise.
 	 */
-	bool isempty();
+	bool isempty() const;
 
 	/**
 	 * \brief source agency identifier
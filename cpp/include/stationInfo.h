@@ -17,6 +17,17 @@
 
 namespace detectionformats {
 
+/**
+ * \brief detectionformats stationInfo validation error codes
+ */
+enum stationinfoerror {
+	stationinfotypeinvalid, stationinfositeinvalid, stationinfolatitudemissing,
+	stationinfolatitudeinvalid, stationinfolongitudemissing,
+	stationinfolongitudeinvalid, stationinfoelevationmissing,
+	stationinfoelevationinvalid, stationinforequestorinvalid,
+	stationinfoerrorcount
+};
+
 /**
  * \brief detectionformats stationInfo conversion class
  *
@@ -109,6 +120,27 @@ class stationInfo : public detectionbase {
 	 */
 	stationInfo(const stationInfo &newstation);
 
+	/**
+	 * \brief stationInfo move constructor
+	 *
+	 * The move constructor for the stationInfo class.
+	 * Moves members from provided stationInfo without copying them.
+	 *
+	 * \param newstation - A detectionformats::stationInfo to move from
+	 */
+	stationInfo(stationInfo &&newstation) = default;
+
+	/**
+	 * \brief stationInfo assignment operators
+	 *
+	 * Copies or moves members from provided stationInfo.
+	 *
+	 * \param newstation - A detectionformats::stationInfo to copy or move from
+	 * \return Returns a reference to this stationInfo
+	 */
+	stationInfo & operator=(const stationInfo &newstation) = default;
+	stationInfo & operator=(stationInfo &&newstation) = default;
+
 	/**
 	 * \brief stationInfo destructor
 	 *
@@ -131,6 +163,27 @@ class stationInfo : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of stationinfoerror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
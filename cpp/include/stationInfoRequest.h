@@ -17,6 +17,14 @@
 
 namespace detectionformats {
 
+/**
+ * \brief detectionformats stationInfoRequest validation error codes
+ */
+enum requesterror {
+	requesttypeinvalid, requestsiteinvalid, requestsourceinvalid,
+	requesterrorcount
+};
+
 /**
  * \brief detectionformats stationInfoRequest conversion class
  *
@@ -88,6 +96,27 @@ class stationInfoRequest : public detectionbase {
 	 */
 	stationInfoRequest(const stationInfoRequest &newstation);
 
+	/**
+	 * \brief stationInfoRequest move constructor
+	 *
+	 * The move constructor for the stationInfoRequest class.
+	 * Moves members from provided stationInfoRequest without copying them.
+	 *
+	 * \param newstation - A detectionformats::stationInfoRequest to move from
+	 */
+	stationInfoRequest(stationInfoRequest &&newstation) = default;
+
+	/**
+	 * \brief stationInfoRequest assignment operators
+	 *
+	 * Copies or moves members from provided stationInfoRequest.
+	 *
+	 * \param newstation - A detectionformats::stationInfoRequest to copy or move from
+	 * \return Returns a reference to this stationInfoRequest
+	 */
+	stationInfoRequest & operator=(const stationInfoRequest &newstation) = default;
+	stationInfoRequest & operator=(stationInfoRequest &&newstation) = default;
+
 	/**
 	 * \brief stationInfoRequest destructor
 	 *
@@ -110,6 +139,27 @@ class stationInfoRequest : public detectionbase {
 			rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) // NOLINT
 					override;
 
+	/**
+	 * \brief Write function
+	 *
+	 * Walks the contents of the class into a json handler as a json object,
+	 * without building a rapidjson::Value document.
+	 * \param writer - a reference to the jsonhandler to write the class
+	 * contents to
+	 */
+	void write(jsonhandler &writer) override; // NOLINT
+	using detectionbase::write;
+
+	/**
+	 * \brief Gets the error codes for the class
+	 *
+	 * Checks the values contained in the class without building any error
+	 * text
+	 * \return Returns an errorcodes bitmask of requesterror values, 0 if the class
+	 * is valid
+	 */
+	errorcodes validate() override;
+
 	/**
 	 * \brief Gets any errors in the class
 	 *
@@ -29,6 +29,12 @@
 #define STATIONINFOEXTENSION "jsonsta"
 #define STATIONINFOREQUESTEXTENSION "jsonstareq"
 
+#define ISO8601_LENGTH 24
+#define ISO8601_BUFFERSIZE 25
+#define ISO8601_PREFIXLENGTH 17
+#define ISO8601_MINTIME -62167219200.0
+#define ISO8601_MAXTIME 253402300800.0
+
 #define TYPE_KEY "Type"
 #define DETECTION_TYPE "Detection"
 #define CORRELATION_TYPE "Correlation"
@@ -47,6 +53,9 @@ namespace detectionformats {
  * \brief detectionformats valid event type index enum. Detection formats 
  * supports a subset of the QuakeML 1.2 event types that are automatically 
  * classifiable.
+ *
+ * eventtypecount is used for a missing value, unknowneventtype for a value
+ * that is not in eventtypevalues.
  */
 enum eventtypeindex {
 	earthquake = 0,
@@ -58,7 +67,8 @@ enum eventtypeindex {
 	fluidinjection = 6,
 	icequake = 7,
 	volcaniceruption = 8,
-	eventtypecount = 9
+	eventtypecount = 9,
+	unknowneventtype = -1
 };
 
 /**
@@ -66,57 +76,72 @@ enum eventtypeindex {
  * supports a subset of the QuakeML 1.2 event types that are automatically 
  * classifiable.
  */
-static const char *eventtypevalues[] = { "Earthquake", "MineCollapse",
-		"NuclearExplosion", "QuarryBlast", "InducedOrTriggered",
+static constexpr const char *eventtypevalues[] = { "Earthquake",
+		"MineCollapse", "NuclearExplosion", "QuarryBlast", "InducedOrTriggered",
 		"RockBurst", "FluidInjection", "IceQuake", "VolcanicEruption", "" };
 
 /**
  * \brief detectionformats valid event type certainty index enum
+ *
+ * eventtypecertaintycount is used for a missing value, unknowncertainty for a
+ * value that is not in eventtypecertaintyvalues.
  */
 enum eventtypecertaintyindex {
 	suspected = 0,
 	confirmed = 1,
-	eventtypecertaintycount = 2
+	eventtypecertaintycount = 2,
+	unknowncertainty = -1
 };
 
 /**
  * \brief detectionformats valid event type values
  */
-static const char *eventtypecertaintyvalues[] = { "Suspected", "Confirmed",
-		 "" };
+static constexpr const char *eventtypecertaintyvalues[] = { "Suspected",
+		"Confirmed", "" };
 
 /**
  * \brief detectionformats valid pick polarity index enum
+ *
+ * polaritycount is used for a missing value, unknownpolarity for a value that
+ * is not in polarityvalues.
  */
 enum polarityindex {
 	up = 0,
 	down = 1,
-	polaritycount = 2
+	polaritycount = 2,
+	unknownpolarity = -1
 };
 
 /**
  * \brief detectionformats valid pick polarity values
  */
-static const char *polarityvalues[] = { "up", "down", "" };
+static constexpr const char *polarityvalues[] = { "up", "down", "" };
 
 /**
  * \brief detectionformats valid pick onset index enum
+ *
+ * onsetcount is used for a missing value, unknownonset for a value that is
+ * not in onsetvalues.
  */
 enum onsetindex {
 	impulsive = 0,
 	emergent = 1,
 	questionable = 2,
-	onsetcount = 3
+	onsetcount = 3,
+	unknownonset = -1
 };
 
 /**
  * \brief detectionformats valid pick onset values
  */
-static const char *onsetvalues[] =
+static constexpr const char *onsetvalues[] =
 		{ "impulsive", "emergent", "questionable", "" };
 
 /**
  * \brief detectionformats valid picker index enum
+ *
+ * pickercount is used for a missing value, unknownpicker for a value that is
+ * not in pickervalues.
  */
 enum pickerindex {
 	manual = 0,
@@ -124,31 +149,212 @@ enum pickerindex {
 	filterpicker = 2,
 	earthworm = 3,
 	other = 4,
-	pickercount = 5
+	pickercount = 5,
+	unknownpicker = -1
 };
 
 /**
  * \brief detectionformats valid picker values
  */
-static const char *pickervalues[] = { "manual", "raypicker", "filterpicker",
-		"earthworm", "other", "" };
+static constexpr const char *pickervalues[] = { "manual", "raypicker",
+		"filterpicker", "earthworm", "other", "" };
 
 /**
  * \brief detectionformats valid detection type index enum
+ *
+ * detectiontypecount is used for a missing value, unknowndetectiontype for a
+ * value that is not in detectiontypevalues.
  */
 enum detectiontypeindex {
 	newdetection = 0,
 	update = 1,
 	final = 2,
 	retractdetection = 3,
-	detectiontypecount = 4
+	detectiontypecount = 4,
+	unknowndetectiontype = -1
 };
 
 /**
  * \brief detectionformats valid detection type values
  */
-static const char *detectiontypevalues[] = { "New", "Update", "Final",
-		"Retract", "" };
+static constexpr const char *detectiontypevalues[] = { "New", "Update",
+		"Final", "Retract", "" };
+
+/**
+ * \brief detectionformats function to compare a null terminated string to a
+ * string of the provided length, usable at compile time
+ */
+constexpr bool IsStringEqual(const char *value, const char *str,
+								size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		if ((value[i] == '\0') || (value[i] != str[i])) {
+			return (false);
+		}
+	}
+
+	return (value[length] == '\0');
+}
+
+/**
+ * \brief detectionformats function to find a string in a values table
+ *
+ * Searches the first count + 1 entries of a values table, the last of which
+ * is the empty string used for missing values.
+ * \param values - The values table to search
+ * \param count - The number of valid values in the table
+ * \param str - A pointer to the string characters, which do not need to be
+ * null terminated
+ * \param length - The number of characters in the string
+ * \return Returns the index of the string, count if the string is empty, or
+ * -1 if the string is not in the table
+ */
+constexpr int FindStringValue(const char * const *values, int count,
+								const char *str, size_t length) {
+	for (int i = 0; i <= count; i++) {
+		if (IsStringEqual(values[i], str, length) == true) {
+			return (i);
+		}
+	}
+
+	return (-1);
+}
+
+/**
+ * \brief detectionformats functions to convert a string to a value index
+ *
+ * Converts the provided string to the matching index enum value, usable at
+ * compile time
+ * \param str - A pointer to the string characters, which do not need to be
+ * null terminated
+ * \param length - The number of characters in the string
+ * \return Returns the index of the value, the count value if the string is
+ * empty, or the unknown value if the string is not valid
+ */
+constexpr eventtypeindex GetEventTypeIndex(const char *str, size_t length) {
+	return (static_cast<eventtypeindex>(FindStringValue(eventtypevalues,
+			eventtypeindex::eventtypecount, str, length)));
+}
+constexpr eventtypecertaintyindex GetEventTypeCertaintyIndex(const char *str,
+		size_t length) {
+	return (static_cast<eventtypecertaintyindex>(FindStringValue(
+			eventtypecertaintyvalues,
+			eventtypecertaintyindex::eventtypecertaintycount, str, length)));
+}
+constexpr polarityindex GetPolarityIndex(const char *str, size_t length) {
+	return (static_cast<polarityindex>(FindStringValue(polarityvalues,
+			polarityindex::polaritycount, str, length)));
+}
+constexpr onsetindex GetOnsetIndex(const char *str, size_t length) {
+	return (static_cast<onsetindex>(FindStringValue(onsetvalues,
+			onsetindex::onsetcount, str, length)));
+}
+constexpr pickerindex GetPickerIndex(const char *str, size_t length) {
+	return (static_cast<pickerindex>(FindStringValue(pickervalues,
+			pickerindex::pickercount, str, length)));
+}
+constexpr detectiontypeindex GetDetectionTypeIndex(const char *str,
+		size_t length) {
+	return (static_cast<detectiontypeindex>(FindStringValue(
+			detectiontypevalues, detectiontypeindex::detectiontypecount, str,
+			length)));
+}
+
+/**
+ * \brief detectionformats functions to convert a value index to a string
+ *
+ * Converts the provided index enum value to its string, usable at compile
+ * time
+ * \param index - The index enum value to convert
+ * \return Returns a pointer to the static null terminated string for the
+ * value, or an empty string for missing and unknown values
+ */
+constexpr const char * GetEventTypeValue(eventtypeindex index) {
+	return (((index >= eventtypeindex::earthquake)
+			&& (index <= eventtypeindex::eventtypecount)) ?
+			eventtypevalues[index] : "");
+}
+constexpr const char * GetEventTypeCertaintyValue(
+		eventtypecertaintyindex index) {
+	return (((index >= eventtypecertaintyindex::suspected)
+			&& (index <= eventtypecertaintyindex::eventtypecertaintycount)) ?
+			eventtypecertaintyvalues[index] : "");
+}
+constexpr const char * GetPolarityValue(polarityindex index) {
+	return (((index >= polarityindex::up)
+			&& (index <= polarityindex::polaritycount)) ?
+			polarityvalues[index] : "");
+}
+constexpr const char * GetOnsetValue(onsetindex index) {
+	return (((index >= onsetindex::impulsive)
+			&& (index <= onsetindex::onsetcount)) ? onsetvalues[index] : "");
+}
+constexpr const char * GetPickerValue(pickerindex index) {
+	return (((index >= pickerindex::manual)
+			&& (index <= pickerindex::pickercount)) ?
+			pickervalues[index] : "");
+}
+constexpr const char * GetDetectionTypeValue(detectiontypeindex index) {
+	return (((index >= detectiontypeindex::newdetection)
+			&& (index <= detectiontypeindex::detectiontypecount)) ?
+			detectiontypevalues[index] : "");
+}
+
+/**
+ * \brief detectionformats function to keep the text of an unknown value
+ *
+ * A string that is not in its values table converts to the unknown value,
+ * its text is kept so that the message is written back out as it was read,
+ * and stays invalid.
+ * \param index - The index enum value the string converted to
+ * \param str - A pointer to the string characters, which do not need to be
+ * null terminated
+ * \param length - The number of characters in the string
+ * \param text - A pointer to the std::string to set to the string if the
+ * index is the unknown value, -1, and to clear otherwise
+ */
+inline void SetUnknownText(int index, const char *str, size_t length,
+							std::string *text) {
+	if (index < 0) {
+		text->assign(str, length);
+	} else {
+		text->clear();
+	}
+}
+
+/**
+ * \brief detectionformats function to get the string to write for a value
+ * index
+ *
+ * \param value - The string of the index from its Get*Value() function
+ * \param index - The index enum value
+ * \param text - The text kept for an unknown index by SetUnknownText()
+ * \return Returns text if the index is the unknown value, -1, otherwise value
+ */
+inline const char * GetIndexText(const char *value, int index,
+									const std::string &text) {
+	return ((index < 0) ? text.c_str() : value);
+}
+
+/**
+ * \brief detectionformats function to set a json string to the string of a
+ * value index
+ *
+ * The value strings are static so they are not copied, the text of an
+ * unknown index is.
+ * \param json - The rapidjson::Value to set
+ * \param str - The string from GetIndexText()
+ * \param index - The index enum value
+ * \param allocator - The rapidjson allocator to copy the text with
+ */
+inline void SetIndexString(
+		rapidjson::Value &json, const char *str, int index, // NOLINT
+		rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) { // NOLINT
+	if (index < 0) {
+		json.SetString(str, allocator);
+	} else {
+		json.SetString(rapidjson::StringRef(str));
+	}
+}
 
 /**
  * \brief detectionformats format types
@@ -165,15 +371,26 @@ enum formattypes {
 };
 
 /**
- * \brief detectionformats function to check whether a string is valid json
+ * \brief detectionformats function to get the detection type for a provided
+ * json formatted string
  */
-bool IsJSONValid(std::string jsonstring);
+int GetDetectionType(std::string jsonstring);
 
 /**
  * \brief detectionformats function to get the detection type for a provided
- * json formatted string
+ * json formatted string without parsing it
+ *
+ * Scans the top level object for the Type member, stopping as soon as it is
+ * found. Other members, including nested objects and arrays, are skipped
+ * without being parsed, and nothing after the Type value is checked. Escaped
+ * Type keys and values are not unescaped.
+ * \param json - A pointer to the json formatted string
+ * \param length - The length of the json formatted string
+ * \return Returns the formattypes value of the Type, formattypes::unknown if
+ * it is missing or not known, formattypes::error if the string is not a json
+ * object
  */
-int GetDetectionType(std::string jsonstring);
+int GetDetectionType(const char *json, size_t length);
 
 /**
  * \brief detectionformats function to get the detection type for a provided
@@ -187,25 +404,91 @@ int GetDetectionType(rapidjson::Value &json); // NOLINT
  */
 bool IsStringAlpha(const std::string &s);
 
+/**
+ * \brief detectionformats function to validate that a character string
+ * contains just characters
+ */
+bool IsStringAlpha(const char *str, size_t length);
+
 /**
  * \brief detectionformats function to validate that a string contains an
  * iso8601 time
  */
 bool IsStringISO8601(const std::string &s);
 
+/**
+ * \brief Parse an iso8601 time string
+ *
+ * Validates the provided iso8601 time string and converts it to decimal
+ * epoch seconds in a single pass. Uses only integer arithmetic, so it does
+ * not allocate, does not touch the process time zone, and is safe to call
+ * from multiple threads.
+ * \param timestring - A pointer to the time string characters, which do not
+ * need to be null terminated
+ * \param length - The number of characters in the time string
+ * \param epochtime - A pointer to the double to hold the decimal epoch
+ * seconds, may be NULL to only validate
+ * \return Returns true if the string is a valid iso8601 time, false
+ * otherwise
+ */
+bool ParseISO8601(const char *timestring, size_t length, double *epochtime);
+
 /**
  * \brief Convert iso8601 time string to decimal epoch seconds
  *
  * Converts the provided iso8601 string to decimal epoch seconds
- * \return Returns a double containing the decimal epoch seconds
+ * \return Returns a double containing the decimal epoch seconds, or -1.0 if
+ * the string is not a valid iso8601 time
  */
 double ConvertISO8601ToEpochTime(std::string TimeString);
+double ConvertISO8601ToEpochTime(const char *timestring, size_t length);
+
+/**
+ * \brief Convert iso8601 time strings to decimal epoch seconds
+ *
+ * Converts an array of iso8601 strings to decimal epoch seconds. Safe to
+ * call from multiple threads, so large arrays can be split across workers.
+ * \param timestrings - A pointer to the first time string to convert
+ * \param count - The number of time strings to convert
+ * \param epochtimes - A pointer to an array of at least count doubles to hold
+ * the decimal epoch seconds, -1.0 for strings that are not valid
+ * \return Returns the number of strings that were converted
+ */
+int ConvertISO8601ToEpochTimes(const std::string *timestrings, int count,
+								double *epochtimes);
+
+/**
+ * \brief detectionformats function to validate that decimal epoch seconds
+ * can be represented as an iso8601 time
+ *
+ * \param epochtime - The decimal epoch seconds to check
+ * \return Returns true if the time is finite and, rounded to the
+ * millisecond, within the years 0000-9999, false otherwise
+ */
+bool IsEpochTimeValid(double epochtime);
+
+/**
+ * \brief Format decimal epoch seconds as an iso8601 time string
+ *
+ * Writes the decimal epoch seconds, rounded to the millisecond, into the
+ * provided buffer as a null terminated YYYY-MM-DDTHH:MM:SS.SSSZ string.
+ * Uses only integer arithmetic and a per thread cache of the last
+ * YYYY-MM-DDTHH:MM: prefix, so it does not allocate and is safe to call from
+ * multiple threads.
+ * \param epochtime - The decimal epoch seconds to format
+ * \param buffer - A pointer to at least ISO8601_BUFFERSIZE characters
+ * \return Returns the number of characters written, not counting the null
+ * terminator, or 0 if the time is not finite or is outside the years
+ * 0000-9999
+ */
+size_t FormatISO8601(double epochtime, char *buffer);
 
 /**
  * \brief Convert decimal epoch seconds to iso8601 time string
  *
  * Converts the  decimal epoch seconds to iso8601 time string
- * \return Returns a std::string containing iso8601 time string
+ * \return Returns a std::string containing iso8601 time string, or an empty
+ * string if the time cannot be formatted
  */
 std::string ConvertEpochTimeToISO8601(double epochtime);
 
@@ -0,0 +1,117 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_VALIDATOR_H
+#define DETECTION_VALIDATOR_H
+
+#include <cstdint>
+#include <string>
+
+#include "decoder.h" // NOLINT
+
+namespace detectionformats {
+/**
+ * \brief detectionformats SAX validator class
+ *
+ * The detectionformats validator class is a rapidjson SAX handler that checks
+ * a pick, correlation, detection, retract, stationInfo, or stationInfoRequest
+ * message as rapidjson::Reader events arrive, without decoding it into an
+ * object. Required keys, enum values, ranges, and ISO8601 times are checked
+ * with the same rules as the validate() function of each class, applied to
+ * the values the decoder would produce.
+ *
+ * Parsing stops at the first error. Errors inside a detection Data element
+ * stop parsing once the element's Type is known, at the end of the element.
+ * Duplicate keys are each checked, rather than only the last one.
+ */
+class validator {
+ public:
+	/**
+	 * \brief validator constructor
+	 *
+	 * The constructor for the validator class.
+	 * Initializes members to null values.
+	 */
+	validator();
+
+	/**
+	 * \brief validator destructor
+	 *
+	 * The destructor for the validator class.
+	 */
+	~validator();
+
+	/**
+	 * \brief Set the message type to validate
+	 *
+	 * Sets the type the next parsed json object is validated as, and clears
+	 * the result of the previous validation.
+	 * \param type - The formattypes value of the message
+	 */
+	void settype(int type);
+
+	/**
+	 * \brief Gets the validation result
+	 *
+	 * \return Returns true if the last parsed json object was a valid message
+	 * of the type set with settype(), false otherwise
+	 */
+	bool isvalid();
+
+	/**
+	 * \brief rapidjson SAX handler functions
+	 *
+	 * Called by rapidjson::Reader for each parsing event.
+	 * \return Returns true to continue parsing, false to stop because the
+	 * message is not valid
+	 */
+	bool Null();
+	bool Bool(bool value);
+	bool Int(int value);
+	bool Uint(unsigned value);
+	bool Int64(int64_t value);
+	bool Uint64(uint64_t value);
+	bool Double(double value);
+	bool RawNumber(const char *str, rapidjson::SizeType length, bool copy);
+	bool String(const char *str, rapidjson::SizeType length, bool copy);
+	bool StartObject();
+	bool Key(const char *str, rapidjson::SizeType length, bool copy);
+	bool EndObject(rapidjson::SizeType membercount);
+	bool StartArray();
+	bool EndArray(rapidjson::SizeType elementcount);
+
+ private:
+	/**
+	 * \brief validator stack frame
+	 *
+	 * One frame per json object or array currently being validated. A
+	 * detection Data element is checked as both a pick and a correlation
+	 * until its type is known, so a frame has two subjects.
+	 */
+	struct frame {
+		int kind[2];
+		int key[2];
+		uint64_t seen[2];
+		bool invalid[2];
+		int parentkey[2];
+		int parentkind;
+		int datatype;
+	};
+
+	bool value(int valuekind, const char *str, rapidjson::SizeType length,
+				double number, bool isint);
+	bool push(int kind0, int kind1);
+	bool fail();
+
+	int roottype;
+	frame stack[DECODER_MAXDEPTH];
+	int depth;
+	int skipdepth;
+	int datadepth;
+	bool valid;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_VALIDATOR_H
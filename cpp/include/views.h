@@ -0,0 +1,403 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_VIEWS_H
+#define DETECTION_VIEWS_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "arena.h" // NOLINT
+#include "codec.h" // NOLINT
+#include "pick.h" // NOLINT
+#include "correlation.h" // NOLINT
+#include "detection.h" // NOLINT
+
+namespace detectionformats {
+/**
+ * \brief detectionformats string view class
+ *
+ * A read only reference to characters owned by someone else, the subset of
+ * std::string_view that the message views need. The characters are not
+ * null terminated.
+ */
+class string_view {
+ public:
+	/**
+	 * \brief string_view constructor
+	 *
+	 * Initializes the view to the empty string.
+	 */
+	string_view()
+			: pointer(""),
+				count(0) {
+	}
+
+	/**
+	 * \brief string_view advanced constructor
+	 *
+	 * \param str - A pointer to the first character
+	 * \param length - The number of characters
+	 */
+	string_view(const char *str, size_t length)
+			: pointer(str),
+				count(length) {
+	}
+
+	const char * data() const {
+		return (pointer);
+	}
+
+	size_t size() const {
+		return (count);
+	}
+
+	size_t length() const {
+		return (count);
+	}
+
+	bool empty() const {
+		return (count == 0);
+	}
+
+	/**
+	 * \brief Copy the view
+	 *
+	 * \return Returns a std::string holding a copy of the characters
+	 */
+	std::string str() const {
+		return (std::string(pointer, count));
+	}
+
+	bool operator==(const string_view &other) const {
+		return ((count == other.count)
+				&& (std::memcmp(pointer, other.pointer, count) == 0));
+	}
+
+	bool operator==(const char *other) const {
+		return (*this == string_view(other, std::strlen(other)));
+	}
+
+	bool operator==(const std::string &other) const {
+		return (*this == string_view(other.data(), other.length()));
+	}
+
+	template<class T>
+	bool operator!=(const T &other) const {
+		return ((*this == other) == false);
+	}
+
+ private:
+	const char *pointer;
+	size_t count;
+};
+
+/**
+ * \brief detectionformats site view class
+ *
+ * The strings of a site as views into the parsed buffer, and its numbers.
+ */
+class site_view {
+ public:
+	site_view();
+
+	/**
+	 * \brief Read the view from a json object
+	 *
+	 * Resets the view and fills it from the provided object, the same way
+	 * the site class does.
+	 * \param json - A json object parsed in place
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view
+	 *
+	 * Resets the view and fills it from the provided object, copying the
+	 * strings into the arena.
+	 * \param object - The object to copy
+	 * \param memory - The message_arena to copy into
+	 */
+	void assign(const site &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * \return Returns a site holding copies of the view
+	 */
+	site tosite() const;
+
+	string_view station;
+	string_view channel;
+	string_view network;
+	string_view location;
+	double latitude;
+	double longitude;
+	double elevation;
+};
+
+/**
+ * \brief detectionformats source view class
+ *
+ * The strings of a source as views into the parsed buffer.
+ */
+class source_view {
+ public:
+	/**
+	 * \brief Read the view from a json object, see site_view::read()
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view, see site_view::assign()
+	 */
+	void assign(const source &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * \return Returns a source holding copies of the view
+	 */
+	source tosource() const;
+
+	string_view agencyid;
+	string_view author;
+};
+
+/**
+ * \brief detectionformats association view class
+ *
+ * The phase of an association as a view into the parsed buffer, and its
+ * numbers.
+ */
+class association_view {
+ public:
+	association_view();
+
+	/**
+	 * \brief Read the view from a json object, see site_view::read()
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view, see site_view::assign()
+	 */
+	void assign(const association &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * \return Returns an association holding copies of the view
+	 */
+	association toassociation() const;
+
+	string_view phase;
+	double distance;
+	double azimuth;
+	double residual;
+	double sigma;
+};
+
+/**
+ * \brief detectionformats pick view class
+ *
+ * A read only pick whose strings are views into a buffer parsed in place
+ * with FromJSONInsitu(), so reading a pick copies no strings. The enums,
+ * times, and all numeric members are decoded, the text of an enum value
+ * that is not valid is kept as a view.
+ *
+ * The filters and classification, which routers rarely read, are left as
+ * the parsed json, use topick() to decode them.
+ *
+ * A view is only valid while its buffer is, and its json members only until
+ * the codec_context that parsed it is next used. A view filled by assign()
+ * is valid until its message_arena is reset.
+ */
+class pick_view {
+ public:
+	pick_view();
+
+	/**
+	 * \brief Read the view from a json object
+	 *
+	 * Resets the view and fills it from the provided object, the same way
+	 * the pick class does.
+	 * \param json - A json object parsed in place
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view
+	 *
+	 * Resets the view and fills it from the provided object, copying the
+	 * strings into the arena and building the filters and classification
+	 * as json in the arena.
+	 * \param object - The object to copy
+	 * \param memory - The message_arena to copy into
+	 */
+	void assign(const pick &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * Copies the strings, and decodes the filters and classification.
+	 * \return Returns a pick holding copies of the view
+	 */
+	pick topick() const;
+
+	string_view type;
+	string_view id;
+	site_view site;
+	double time;
+	source_view source;
+	string_view phase;
+	polarityindex polarity;
+	onsetindex onset;
+	pickerindex picker;
+	string_view polaritytext;
+	string_view onsettext;
+	string_view pickertext;
+	detectionformats::amplitude amplitude;
+	detectionformats::beam beam;
+	association_view associationinfo;
+
+	/**
+	 * \brief the Filter array and ClassificationInfo object, NULL if
+	 * missing
+	 */
+	rapidjson::Value *filterdata;
+	rapidjson::Value *classificationinfo;
+};
+
+/**
+ * \brief detectionformats correlation view class
+ *
+ * A read only correlation whose strings are views into a buffer parsed in
+ * place, see pick_view.
+ */
+class correlation_view {
+ public:
+	correlation_view();
+
+	/**
+	 * \brief Read the view from a json object, see pick_view::read()
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view, see pick_view::assign()
+	 */
+	void assign(const correlation &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * \return Returns a correlation holding copies of the view
+	 */
+	correlation tocorrelation() const;
+
+	string_view type;
+	string_view id;
+	site_view site;
+	source_view source;
+	string_view phase;
+	double time;
+	double correlationvalue;
+	detectionformats::hypocenter hypocenter;
+	detectionformats::eventtype eventtype;
+	double magnitude;
+	double snr;
+	double zscore;
+	double detectionthreshold;
+	string_view thresholdtype;
+	association_view associationinfo;
+};
+
+/**
+ * \brief detectionformats detection view class
+ *
+ * A read only detection whose strings are views into a buffer parsed in
+ * place, see pick_view. The Data picks and correlations are views as well,
+ * their vectors keep their capacity when the view is read again.
+ *
+ * A detection_view constructed with a message_arena keeps its Data in the
+ * arena, and assign() copies a detection into the arena, so a whole
+ * candidate detection is released by resetting the arena instead of one
+ * free() per string and vector.
+ */
+class detection_view {
+ public:
+	detection_view();
+
+	/**
+	 * \brief detection_view arena constructor
+	 *
+	 * \param memory - The message_arena to keep the Data in
+	 */
+	explicit detection_view(message_arena *memory);
+
+	/**
+	 * \brief Read the view from a json object, see pick_view::read()
+	 */
+	void read(rapidjson::Value &json); // NOLINT
+
+	/**
+	 * \brief Copy an owning object into the view, see pick_view::assign()
+	 */
+	void assign(const detection &object, message_arena &memory); // NOLINT
+
+	/**
+	 * \brief Convert to the owning class
+	 *
+	 * \return Returns a detection holding copies of the view
+	 */
+	detection todetection() const;
+
+	string_view type;
+	string_view id;
+	source_view source;
+	detectionformats::hypocenter hypocenter;
+	detectiontypeindex detectiontype;
+	string_view detectiontypetext;
+	detectionformats::eventtype eventtype;
+	double bayes;
+	double minimumdistance;
+	double rms;
+	double gap;
+	double detectiontime;
+	std::vector<pick_view, arena_allocator<pick_view>> pickdata;
+	std::vector<correlation_view, arena_allocator<correlation_view>>
+			correlationdata;
+
+ private:
+	/**
+	 * \brief Reset the members, keeping the data capacity
+	 */
+	void clear();
+};
+
+/**
+ * \brief Convert from json buffer functions
+ *
+ * Parses the provided buffer in place with the context and reads the view
+ * from it, no strings are copied.
+ * \param jsonbuffer - A null terminated char buffer containing the
+ * serialized json, which is overwritten by the parse and must outlive the
+ * view
+ * \param view - The view to read
+ * \param context - The codec_context to parse with
+ * \return Returns a reference to the view, throws std::invalid_argument if
+ * the buffer is not a valid json object
+ */
+pick_view & FromJSONInsitu(char *jsonbuffer, pick_view &view,
+							codec_context &context); // NOLINT
+correlation_view & FromJSONInsitu(char *jsonbuffer, correlation_view &view,
+									codec_context &context); // NOLINT
+detection_view & FromJSONInsitu(char *jsonbuffer, detection_view &view,
+								codec_context &context); // NOLINT
+}  // namespace detectionformats
+#endif  // DETECTION_VIEWS_H
@@ -0,0 +1,96 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef DETECTION_WORKQUEUE_H
+#define DETECTION_WORKQUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+/**
+ * \brief default number of items a workqueue hands out at a time
+ */
+#define WORKQUEUE_CHUNKSIZE 256
+
+namespace detectionformats {
+/**
+ * \brief detectionformats work stealing queue class
+ *
+ * The detectionformats workqueue class splits the item indexes [0, count)
+ * into one contiguous range per worker. Each worker takes chunks from the
+ * front of its own range, and once that is empty steals the back half of the
+ * fullest range of another worker, so workers that finish early keep busy
+ * without any central queue. Items are handed out exactly once.
+ */
+class workqueue {
+ public:
+	/**
+	 * \brief workqueue constructor
+	 *
+	 * The constructor for the workqueue class.
+	 * \param count - The number of items to hand out
+	 * \param workers - The number of workers, at least one
+	 * \param chunksize - The number of items handed out at a time
+	 */
+	workqueue(size_t count, int workers,
+				size_t chunksize = WORKQUEUE_CHUNKSIZE);
+
+	/**
+	 * \brief workqueue destructor
+	 *
+	 * The destructor for the workqueue class.
+	 */
+	~workqueue();
+
+	workqueue(const workqueue &newqueue) = delete;
+	workqueue & operator=(const workqueue &newqueue) = delete;
+
+	/**
+	 * \brief Get the next chunk of items for a worker
+	 *
+	 * Takes the next chunk from the worker's own range, stealing from
+	 * another worker if that range is empty. Thread safe, as long as each
+	 * worker index is used by one thread at a time.
+	 * \param worker - The index of the worker, from 0 to getworkers() - 1
+	 * \param begin - Set to the index of the first item in the chunk
+	 * \param end - Set to one past the index of the last item in the chunk
+	 * \return Returns true if a chunk was taken, false if all items have
+	 * been handed out
+	 */
+	bool next(int worker, size_t *begin, size_t *end);
+
+	/**
+	 * \brief Gets the number of workers
+	 *
+	 * \return Returns the number of workers the items are split between
+	 */
+	int getworkers() const;
+
+ private:
+	/**
+	 * \brief the items not yet handed out to a worker
+	 */
+	struct range {
+		std::mutex lock;
+		size_t begin;
+		size_t end;
+	};
+
+	/**
+	 * \brief Steal the back half of the fullest other range into the
+	 * worker's own range
+	 *
+	 * \return Returns true if anything was stolen
+	 */
+	bool steal(int worker);
+
+	std::unique_ptr<range[]> ranges;
+	int workercount;
+	size_t chunk;
+};
+}  // namespace detectionformats
+#endif  // DETECTION_WORKQUEUE_H
@@ -1,14 +1,10 @@
 #include <amplitude.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
 #include <vector>
 
-// JSON Keys
-#define AMPLITUDE_KEY "Amplitude"
-#define PERIOD_KEY "Period"
-#define SNR_KEY "SNR"
-
 namespace detectionformats {
 amplitude::amplitude() {
 	ampvalue = std::numeric_limits<double>::quiet_NaN();
@@ -23,29 +19,45 @@ amplitude::amplitude(double newampvalue, double newperiod, double newsnr) {
 }
 
 amplitude::amplitude(rapidjson::Value &json) {
-	// optional values
-	// ampvalue
-	if ((json.HasMember(AMPLITUDE_KEY) == true)
-			&& (json[AMPLITUDE_KEY].IsNumber() == true)
-			&& (json[AMPLITUDE_KEY].IsDouble() == true))
-		ampvalue = json[AMPLITUDE_KEY].GetDouble();
-	else
-		ampvalue = std::numeric_limits<double>::quiet_NaN();
-
-	// period
-	if ((json.HasMember(PERIOD_KEY) == true)
-			&& (json[PERIOD_KEY].IsNumber() == true)
-			&& (json[PERIOD_KEY].IsDouble() == true))
-		period = json[PERIOD_KEY].GetDouble();
-	else
-		period = std::numeric_limits<double>::quiet_NaN();
+	// values that are missing from the json
+	ampvalue = std::numeric_limits<double>::quiet_NaN();
+	period = std::numeric_limits<double>::quiet_NaN();
+	snr = std::numeric_limits<double>::quiet_NaN();
 
-	// snr
-	if ((json.HasMember(SNR_KEY) == true) && (json[SNR_KEY].IsNumber() == true)
-			&& (json[SNR_KEY].IsDouble() == true))
-		snr = json[SNR_KEY].GetDouble();
-	else
-		snr = std::numeric_limits<double>::quiet_NaN();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (amplitudekeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// optional values
+			// ampvalue
+			case amplitudekeyindex::amplitudevaluekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					ampvalue = value.GetDouble();
+				}
+				break;
+
+			// period
+			case amplitudekeyindex::amplitudeperiodkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					period = value.GetDouble();
+				}
+				break;
+
+			// snr
+			case amplitudekeyindex::amplitudesnrkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					snr = value.GetDouble();
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
+	}
 }
 
 amplitude::amplitude(const amplitude & newamplitude) {
@@ -78,31 +90,77 @@ rapidjson::Value & amplitude::tojson(
 	return (json);
 }
 
-std::vector<std::string> amplitude::geterrors() {
-	std::vector<std::string> errorlist;
+void amplitude::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// optional values
+	// ampvalue
+	if (std::isnan(ampvalue) != true) {
+		writer.Key(AMPLITUDE_KEY);
+		writer.Double(ampvalue);
+	}
+
+	// period
+	if (std::isnan(period) != true) {
+		writer.Key(PERIOD_KEY);
+		writer.Double(period);
+	}
+
+	// snr
+	if (std::isnan(snr) != true) {
+		writer.Key(SNR_KEY);
+		writer.Double(snr);
+	}
+
+	writer.EndObject();
+}
+
+// amplitude validation error text, in amplitudeerror order
+static const char *amplitudeerrorvalues[] = {
+		"Invalid Period in Amplitude class.",
+		"SNR in Amplitude Class is not in the valid range of 0 to "
+			"9999999999.999" };
+
+errorcodes amplitude::validate() {
+	errorcodes errors = 0;
 
 	// optional data
 	// period
 	if (std::isnan(period) != true) {
 		if (period < 0) {
-			errorlist.push_back("Invalid Period in Amplitude class.");
+			errors |= ERRORCODE(amplitudeerror::amplitudeperiodinvalid);
 		}
 	}
 
 	// SNR
 	if (std::isnan(snr) != true) {
 		// Limit SNR to between 0 and 10 digits after the decimal point
-		if ((snr < 0) || (snr > 9999999999.999)) {
-			errorlist.push_back(
-					"SNR in Amplitude Class is not in the valid range of 0 to "
-					"9999999999.999");
+		if ((snr < 0) || (snr > SNR_MAXIMUM)) {
+			errors |= ERRORCODE(amplitudeerror::amplitudesnrinvalid);
 		}
 	}
 
+	return (errors);
+}
+
+std::vector<std::string> amplitude::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < amplitudeerror::amplitudeerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		errorlist.push_back(amplitudeerrorvalues[i]);
+	}
+
+	// return the list of errors
 	return (errorlist);
 }
 
-bool amplitude::isempty() {
+bool amplitude::isempty() const {
 	if (std::isnan(ampvalue) != true)
 		return (false);
 	if (std::isnan(period) != true)
@@ -0,0 +1,608 @@
+#include <archive.h>
+#include <binary.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace detectionformats {
+// the magic bytes that start every segment
+static const char archivemagic[4] = { 'D', 'F', 'A', 'R' };
+
+// the sizes of the segment parts, all numbers are little endian
+//
+// header: magic, version u32, record count u64, type table offset u64,
+// earliest time f64, latest time f64, type count u32, reserved u32
+// record: time f64, message length u32, binary message
+// type table entry: type u32, record count u64, first record offset u64,
+// records end offset u64, index entry count u64, index entries offset u64
+// index entry: time f64, record offset u64
+static const size_t headersize = 48;
+static const size_t recordheadersize = 12;
+static const size_t typeentrysize = 44;
+static const size_t indexentrysize = 16;
+
+static void putle(std::string &buffer, uint64_t value, int bytes) { // NOLINT
+	char data[sizeof(uint64_t)];
+	for (int i = 0; i < bytes; i++) {
+		data[i] = static_cast<char>(value >> (i * 8));
+	}
+	buffer.append(data, bytes);
+}
+
+static void putledouble(std::string &buffer, double value) { // NOLINT
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	putle(buffer, bits, sizeof(bits));
+}
+
+static uint64_t getle(const char *data, int bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < bytes; i++) {
+		value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i]))
+				<< (i * 8);
+	}
+	return (value);
+}
+
+static double getledouble(const char *data) {
+	uint64_t bits = getle(data, sizeof(bits));
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return (value);
+}
+
+// returns the file name of a segment, numbered with at least six digits
+// so that the names sort in order
+static std::string getsegmentname(const std::string &basepath,
+									size_t number) {
+	std::string digits = std::to_string(number);
+	if (digits.length() < 6) {
+		digits.insert(0, 6 - digits.length(), '0');
+	}
+	return (basepath + "." + digits + ARCHIVE_EXTENSION);
+}
+
+static bool fileexists(const std::string &filename) {
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	return (file.is_open());
+}
+
+// writes the contents to a new file and flushes it to the disk, so that
+// once the file is renamed its name never points to a partly written file,
+// also after a crash
+#ifdef _WIN32
+static bool writefile(const std::string &filename,
+						const std::string &contents) {
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, NULL,
+								CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return (false);
+	}
+
+	bool written = true;
+	size_t offset = 0;
+	while ((written == true) && (offset < contents.length())) {
+		DWORD length = static_cast<DWORD>(std::min(contents.length() - offset,
+				static_cast<size_t>(1) << 30));
+		DWORD done = 0;
+		written = (WriteFile(file, contents.data() + offset, length, &done,
+								NULL) != 0) && (done > 0);
+		offset += done;
+	}
+	written = written && (FlushFileBuffers(file) != 0);
+	return ((CloseHandle(file) != 0) && (written == true));
+}
+
+// Windows has no flush of a directory, the file flush is all it takes
+static void syncdirectory(const std::string &) {
+}
+#else
+static bool writefile(const std::string &filename,
+						const std::string &contents) {
+	int descriptor = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+							0644);
+	if (descriptor < 0) {
+		return (false);
+	}
+
+	bool written = true;
+	size_t offset = 0;
+	while ((written == true) && (offset < contents.length())) {
+		ssize_t done = write(descriptor, contents.data() + offset,
+								contents.length() - offset);
+		if ((done < 0) && (errno == EINTR)) {
+			continue;
+		}
+		written = (done > 0);
+		offset += (done > 0) ? static_cast<size_t>(done) : 0;
+	}
+	written = written && (fsync(descriptor) == 0);
+	return ((close(descriptor) == 0) && (written == true));
+}
+
+// flushes the directory holding a file, so that a rename into it lasts
+static void syncdirectory(const std::string &filename) {
+	size_t slash = filename.find_last_of('/');
+	std::string directory = (slash == std::string::npos) ? "." :
+			filename.substr(0, (slash == 0) ? 1 : slash);
+	int descriptor = open(directory.c_str(), O_RDONLY);
+	if (descriptor >= 0) {
+		fsync(descriptor);
+		close(descriptor);
+	}
+}
+#endif
+
+////////////// archive_writer //////////////
+
+archive_writer::archive_writer(const std::string &newbasepath,
+								size_t newsegmentrecords)
+		: basepath(newbasepath),
+			segmentrecords(newsegmentrecords > 0 ? newsegmentrecords : 1),
+			segmentnumber(0) {
+	// new records go after the segments already written
+	while (fileexists(getsegmentname(basepath, segmentnumber)) == true) {
+		segmentnumber++;
+	}
+}
+
+archive_writer::~archive_writer() {
+	// a destructor cannot throw, so records that cannot be written are lost
+	try {
+		seal();
+	} catch (const std::exception &) {
+	}
+}
+
+bool archive_writer::append(pick &object) { // NOLINT
+	ToBinary(object, buffer);
+	return (append(formattypes::picktype, object.time));
+}
+
+bool archive_writer::append(correlation &object) { // NOLINT
+	ToBinary(object, buffer);
+	return (append(formattypes::correlationtype, object.time));
+}
+
+bool archive_writer::append(detection &object) { // NOLINT
+	ToBinary(object, buffer);
+	return (append(formattypes::detectiontype, object.hypocenter.time));
+}
+
+bool archive_writer::append(int type, double time) {
+	if (std::isfinite(time) == false) {
+		return (false);
+	}
+
+	record newrecord = { type, time, data.length(), buffer.length() };
+	records.push_back(newrecord);
+	data.append(buffer);
+
+	if (records.size() >= segmentrecords) {
+		seal();
+	}
+	return (true);
+}
+
+void archive_writer::seal() {
+	if (records.empty() == true) {
+		return;
+	}
+
+	// sort by type and then time, records with the same time stay in the
+	// order they were appended
+	std::stable_sort(records.begin(), records.end(),
+						[](const record &first, const record &second) {
+							if (first.type != second.type) {
+								return (first.type < second.type);
+							}
+							return (first.time < second.time);
+						});
+
+	std::string segment;
+	segment.reserve(headersize + data.length()
+			+ records.size() * (recordheadersize + indexentrysize));
+	segment.append(headersize, '\0');
+
+	// the records, noting where each type starts and which are indexed
+	struct typerange {
+		int type;
+		size_t count;
+		size_t start;
+		size_t end;
+		std::string entries;
+	};
+	std::vector<typerange> types;
+	double mintime = records.front().time;
+	double maxtime = records.front().time;
+
+	for (const record &current : records) {
+		if ((types.empty() == true) || (types.back().type != current.type)) {
+			typerange range = { current.type, 0, segment.length(), 0, "" };
+			types.push_back(range);
+		}
+
+		typerange & range = types.back();
+		if (range.count % ARCHIVE_INDEXINTERVAL == 0) {
+			putledouble(range.entries, current.time);
+			putle(range.entries, segment.length(), sizeof(uint64_t));
+		}
+		range.count++;
+
+		putledouble(segment, current.time);
+		putle(segment, current.length, sizeof(uint32_t));
+		segment.append(data, current.offset, current.length);
+		range.end = segment.length();
+
+		mintime = std::min(mintime, current.time);
+		maxtime = std::max(maxtime, current.time);
+	}
+
+	// the type table, followed by the index entries of each type
+	size_t tableoffset = segment.length();
+	size_t entriesoffset = tableoffset + types.size() * typeentrysize;
+	for (const typerange &range : types) {
+		putle(segment, range.type, sizeof(uint32_t));
+		putle(segment, range.count, sizeof(uint64_t));
+		putle(segment, range.start, sizeof(uint64_t));
+		putle(segment, range.end, sizeof(uint64_t));
+		putle(segment, range.entries.length() / indexentrysize,
+				sizeof(uint64_t));
+		putle(segment, entriesoffset, sizeof(uint64_t));
+		entriesoffset += range.entries.length();
+	}
+	for (const typerange &range : types) {
+		segment.append(range.entries);
+	}
+
+	std::string header(archivemagic, sizeof(archivemagic));
+	putle(header, ARCHIVE_VERSION, sizeof(uint32_t));
+	putle(header, records.size(), sizeof(uint64_t));
+	putle(header, tableoffset, sizeof(uint64_t));
+	putledouble(header, mintime);
+	putledouble(header, maxtime);
+	putle(header, types.size(), sizeof(uint32_t));
+	putle(header, 0, sizeof(uint32_t));
+	segment.replace(0, headersize, header);
+
+	// write the segment under a temporary name, flushed to the disk, and
+	// rename it, so that a reader never maps a partly written segment
+	std::string filename = getsegmentname(basepath, segmentnumber);
+	std::string tempname = filename + ".tmp";
+	if ((writefile(tempname, segment) == false)
+			|| (std::rename(tempname.c_str(), filename.c_str()) != 0)) {
+		std::remove(tempname.c_str());
+		throw std::runtime_error("Could not write archive segment.");
+	}
+	syncdirectory(filename);
+
+	records.clear();
+	data.clear();
+	segmentnumber++;
+}
+
+size_t archive_writer::getsegmentnumber() const {
+	return (segmentnumber);
+}
+
+////////////// archive_reader::segment //////////////
+
+// a mapped segment file and its type table
+class archive_reader::segment {
+ public:
+	explicit segment(const std::string &filename);
+	~segment();
+
+	segment(const segment &newsegment) = delete;
+	segment & operator=(const segment &newsegment) = delete;
+
+	// the records of a type, and their index entries
+	struct typerange {
+		int type;
+		uint64_t start;
+		uint64_t end;
+		uint64_t entrycount;
+		uint64_t entries;
+	};
+
+	const char *data;
+	size_t length;
+	uint64_t recordcount;
+	double mintime;
+	double maxtime;
+	std::vector<typerange> types;
+
+ private:
+	void map(const std::string &filename);
+	void unmap();
+	void check();
+
+	void *address;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
+archive_reader::segment::segment(const std::string &filename)
+		: data(NULL),
+			length(0),
+			address(NULL) {
+	map(filename);
+	try {
+		check();
+	} catch (...) {
+		unmap();
+		throw;
+	}
+}
+
+archive_reader::segment::~segment() {
+	unmap();
+}
+
+#ifdef _WIN32
+void archive_reader::segment::map(const std::string &filename) {
+	mapping = NULL;
+	file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+						OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::invalid_argument("Could not open archive segment.");
+	}
+
+	LARGE_INTEGER size;
+	if ((GetFileSizeEx(file, &size) == 0) || (size.QuadPart == 0)) {
+		CloseHandle(file);
+		throw std::invalid_argument("Could not map archive segment.");
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping != NULL) {
+		address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (address == NULL) {
+		if (mapping != NULL) {
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		throw std::invalid_argument("Could not map archive segment.");
+	}
+	data = static_cast<const char *>(address);
+	length = static_cast<size_t>(size.QuadPart);
+}
+
+void archive_reader::segment::unmap() {
+	if (address != NULL) {
+		UnmapViewOfFile(address);
+		CloseHandle(mapping);
+		CloseHandle(file);
+		address = NULL;
+		data = NULL;
+	}
+}
+#else
+void archive_reader::segment::map(const std::string &filename) {
+	int descriptor = open(filename.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		throw std::invalid_argument("Could not open archive segment.");
+	}
+
+	// the mapping stays valid once the file is closed
+	struct stat status;
+	void *mapped = MAP_FAILED;
+	if ((fstat(descriptor, &status) == 0) && (status.st_size > 0)) {
+		mapped = mmap(NULL, static_cast<size_t>(status.st_size), PROT_READ,
+						MAP_PRIVATE, descriptor, 0);
+	}
+	close(descriptor);
+	if (mapped == MAP_FAILED) {
+		throw std::invalid_argument("Could not map archive segment.");
+	}
+
+	address = mapped;
+	data = static_cast<const char *>(address);
+	length = static_cast<size_t>(status.st_size);
+}
+
+void archive_reader::segment::unmap() {
+	if (address != NULL) {
+		munmap(address, length);
+		address = NULL;
+		data = NULL;
+	}
+}
+#endif
+
+// reads the header and type table, checking that everything they point to
+// is in the file
+void archive_reader::segment::check() {
+	if ((length < headersize)
+			|| (std::memcmp(data, archivemagic, sizeof(archivemagic)) != 0)
+			|| (getle(data + 4, sizeof(uint32_t)) != ARCHIVE_VERSION)) {
+		throw std::invalid_argument("Not an archive segment.");
+	}
+
+	recordcount = getle(data + 8, sizeof(uint64_t));
+	uint64_t tableoffset = getle(data + 16, sizeof(uint64_t));
+	mintime = getledouble(data + 24);
+	maxtime = getledouble(data + 32);
+	uint64_t typecount = getle(data + 40, sizeof(uint32_t));
+
+	if ((tableoffset < headersize) || (tableoffset > length)
+			|| (typecount > (length - tableoffset) / typeentrysize)) {
+		throw std::invalid_argument("Archive segment is corrupt.");
+	}
+
+	for (uint64_t i = 0; i < typecount; i++) {
+		const char *entry = data + tableoffset + i * typeentrysize;
+		typerange range;
+		range.type = static_cast<int>(getle(entry, sizeof(uint32_t)));
+		range.start = getle(entry + 12, sizeof(uint64_t));
+		range.end = getle(entry + 20, sizeof(uint64_t));
+		range.entrycount = getle(entry + 28, sizeof(uint64_t));
+		range.entries = getle(entry + 36, sizeof(uint64_t));
+
+		if ((range.start < headersize) || (range.start > range.end)
+				|| (range.end > tableoffset) || (range.entries > length)
+				|| (range.entrycount
+						> (length - range.entries) / indexentrysize)) {
+			throw std::invalid_argument("Archive segment is corrupt.");
+		}
+		types.push_back(range);
+	}
+}
+
+////////////// archive_reader //////////////
+
+archive_reader::archive_reader(const std::string &basepath) {
+	for (size_t number = 0;; number++) {
+		std::string filename = getsegmentname(basepath, number);
+		if (fileexists(filename) == false) {
+			break;
+		}
+
+		// a bad segment, such as one left empty by a crash, does not hide
+		// the segments after it
+		try {
+			segments.emplace_back(new segment(filename));
+		} catch (const std::invalid_argument &) {
+			skipped.push_back(filename);
+		}
+	}
+}
+
+archive_reader::~archive_reader() {
+}
+
+size_t archive_reader::find(int type, double starttime, double endtime,
+							std::vector<archive_record> *found) const {
+	size_t count = 0;
+	for (const std::unique_ptr<segment> &current : segments) {
+		if ((current->maxtime < starttime) || (current->mintime > endtime)) {
+			continue;
+		}
+
+		for (const segment::typerange &range : current->types) {
+			if (range.type != type) {
+				continue;
+			}
+
+			// find the first index entry at or after the start, the window
+			// starts after the entry before it
+			const char *entries = current->data + range.entries;
+			uint64_t low = 0;
+			uint64_t high = range.entrycount;
+			while (low < high) {
+				uint64_t middle = low + (high - low) / 2;
+				if (getledouble(entries + middle * indexentrysize)
+						< starttime) {
+					low = middle + 1;
+				} else {
+					high = middle;
+				}
+			}
+			uint64_t position = range.start;
+			if (low > 0) {
+				position = getle(entries + (low - 1) * indexentrysize + 8,
+									sizeof(uint64_t));
+			}
+
+			while ((position >= range.start) && (position <= range.end)
+					&& (range.end - position >= recordheadersize)) {
+				const char *header = current->data + position;
+				archive_record record;
+				record.type = type;
+				record.time = getledouble(header);
+				record.length = static_cast<size_t>(getle(header + 8,
+															sizeof(uint32_t)));
+				record.data = header + recordheadersize;
+				if ((record.time > endtime) || (record.length
+						> range.end - position - recordheadersize)) {
+					break;
+				}
+
+				if (record.time >= starttime) {
+					found->push_back(record);
+					count++;
+				}
+				position += recordheadersize + record.length;
+			}
+		}
+	}
+
+	return (count);
+}
+
+// decodes the records of the type in the window into the objects
+template<class T>
+static size_t readrecords(const archive_reader &reader, int type,
+							double starttime, double endtime,
+							std::vector<T> *objects) {
+	std::vector<archive_record> found;
+	reader.find(type, starttime, endtime, &found);
+
+	// the messages are decoded in place, a record that does not decode
+	// removes every message this call added
+	size_t first = objects->size();
+	objects->resize(first + found.size());
+	try {
+		for (size_t i = 0; i < found.size(); i++) {
+			FromBinary(found[i].data, found[i].length, (*objects)[first + i]);
+		}
+	} catch (...) {
+		objects->resize(first);
+		throw;
+	}
+	return (found.size());
+}
+
+size_t archive_reader::read(double starttime, double endtime,
+							std::vector<pick> *objects) const {
+	return (readrecords(*this, formattypes::picktype, starttime, endtime,
+						objects));
+}
+
+size_t archive_reader::read(double starttime, double endtime,
+							std::vector<correlation> *objects) const {
+	return (readrecords(*this, formattypes::correlationtype, starttime,
+						endtime, objects));
+}
+
+size_t archive_reader::read(double starttime, double endtime,
+							std::vector<detection> *objects) const {
+	return (readrecords(*this, formattypes::detectiontype, starttime,
+						endtime, objects));
+}
+
+size_t archive_reader::getsegmentcount() const {
+	return (segments.size());
+}
+
+const std::vector<std::string> & archive_reader::getskippedsegments() const {
+	return (skipped);
+}
+
+uint64_t archive_reader::size() const {
+	uint64_t count = 0;
+	for (const std::unique_ptr<segment> &current : segments) {
+		count += current->recordcount;
+	}
+	return (count);
+}
+}  // namespace detectionformats
@@ -0,0 +1,70 @@
+#include <arena.h>
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace detectionformats {
+////////////// message_arena //////////////
+
+message_arena::message_arena(size_t poolsize)
+		: poolbuffer(poolsize),
+			containerblocks(0) {
+	buildpool();
+}
+
+message_arena::~message_arena() {
+}
+
+void message_arena::buildpool() {
+	poolallocator.reset(
+			new rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>(
+					poolbuffer.data(), poolbuffer.size()));
+}
+
+void * message_arena::allocate(size_t size) {
+	return (poolallocator->Malloc(size));
+}
+
+const char * message_arena::copy(const char *str, size_t length) {
+	char *buffer = static_cast<char *>(allocate(length + 1));
+	std::memcpy(buffer, str, length);
+	buffer[length] = '\0';
+	return (buffer);
+}
+
+void message_arena::reset() {
+	// a container still holding arena memory would destroy its elements in
+	// the released pool
+	assert(containerblocks == 0);
+
+	// the pool overflowed into allocated chunks, grow it so the same amount
+	// fits next time
+	if (poolallocator->Capacity() > poolbuffer.size()) {
+		size_t poolsize = poolbuffer.size() + poolallocator->Capacity();
+		poolallocator.reset();
+		std::vector<char>(poolsize).swap(poolbuffer);
+		buildpool();
+	} else {
+		poolallocator->Clear();
+	}
+}
+
+size_t message_arena::getused() const {
+	return (poolallocator->Size());
+}
+
+size_t message_arena::getpoolsize() const {
+	return (poolbuffer.size());
+}
+
+size_t message_arena::getcontainerblocks() const {
+	return (containerblocks);
+}
+
+rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &
+		message_arena::getallocator() {
+	return (*poolallocator);
+}
+}  // namespace detectionformats
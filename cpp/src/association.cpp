@@ -1,16 +1,11 @@
 #include <association.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define PHASE_KEY "Phase"
-#define DISTANCE_KEY "Distance"
-#define AZIMUTH_KEY "Azimuth"
-#define RESIDUAL_KEY "Residual"
-#define SIGMA_KEY "Sigma"
-
 namespace detectionformats {
 association::association() {
 	phase = "";
@@ -23,7 +18,7 @@ association::association() {
 association::association(std::string newphase, double newdistance,
 						double newazimuth, double newresidual,
 						double newsigma) {
-	phase = newphase;
+	phase = std::move(newphase);
 	distance = newdistance;
 	azimuth = newazimuth;
 	residual = newresidual;
@@ -31,46 +26,61 @@ association::association(std::string newphase, double newdistance,
 }
 
 association::association(rapidjson::Value &json) {
-	// optional values
-	// phase
-	if ((json.HasMember(PHASE_KEY) == true)
-			&& (json[PHASE_KEY].IsString() == true))
-		phase = std::string(json[PHASE_KEY].GetString(),
-							json[PHASE_KEY].GetStringLength());
-	else
-		phase = "";
-
-	// distance
-	if ((json.HasMember(DISTANCE_KEY) == true)
-			&& (json[DISTANCE_KEY].IsNumber() == true)
-			&& (json[DISTANCE_KEY].IsDouble() == true))
-		distance = json[DISTANCE_KEY].GetDouble();
-	else
-		distance = std::numeric_limits<double>::quiet_NaN();
-
-	// azimuth
-	if ((json.HasMember(AZIMUTH_KEY) == true)
-			&& (json[AZIMUTH_KEY].IsNumber() == true)
-			&& (json[AZIMUTH_KEY].IsDouble() == true))
-		azimuth = json[AZIMUTH_KEY].GetDouble();
-	else
-		azimuth = std::numeric_limits<double>::quiet_NaN();
-
-	// residual
-	if ((json.HasMember(RESIDUAL_KEY) == true)
-			&& (json[RESIDUAL_KEY].IsNumber() == true)
-			&& (json[RESIDUAL_KEY].IsDouble() == true))
-		residual = json[RESIDUAL_KEY].GetDouble();
-	else
-		residual = std::numeric_limits<double>::quiet_NaN();
+	// values that are missing from the json
+	distance = std::numeric_limits<double>::quiet_NaN();
+	azimuth = std::numeric_limits<double>::quiet_NaN();
+	residual = std::numeric_limits<double>::quiet_NaN();
+	sigma = std::numeric_limits<double>::quiet_NaN();
 
-	// sigma
-	if ((json.HasMember(SIGMA_KEY) == true)
-			&& (json[SIGMA_KEY].IsNumber() == true)
-			&& (json[SIGMA_KEY].IsDouble() == true))
-		sigma = json[SIGMA_KEY].GetDouble();
-	else
-		sigma = std::numeric_limits<double>::quiet_NaN();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (associationkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// optional values
+			// phase
+			case associationkeyindex::associationphasekey:
+				if (value.IsString() == true) {
+					phase = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// distance
+			case associationkeyindex::associationdistancekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					distance = value.GetDouble();
+				}
+				break;
+
+			// azimuth
+			case associationkeyindex::associationazimuthkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					azimuth = value.GetDouble();
+				}
+				break;
+
+			// residual
+			case associationkeyindex::associationresidualkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					residual = value.GetDouble();
+				}
+				break;
+
+			// sigma
+			case associationkeyindex::associationsigmakey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					sigma = value.GetDouble();
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
+	}
 }
 
 association::association(const association & newassociation) {
@@ -116,35 +126,95 @@ rapidjson::Value & association::tojson(
 	return (json);
 }
 
-std::vector<std::string> association::geterrors() {
-	std::vector<std::string> errorlist;
+void association::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// optional values
+	// phase
+	if (phase.empty() == false) {
+		writer.Key(PHASE_KEY);
+		writer.String(phase.c_str(),
+						static_cast<rapidjson::SizeType>(phase.length()));
+	}
+
+	// distance
+	if (std::isnan(distance) != true) {
+		writer.Key(DISTANCE_KEY);
+		writer.Double(distance);
+	}
+
+	// azimuth
+	if (std::isnan(azimuth) != true) {
+		writer.Key(AZIMUTH_KEY);
+		writer.Double(azimuth);
+	}
+
+	// residual
+	if (std::isnan(residual) != true) {
+		writer.Key(RESIDUAL_KEY);
+		writer.Double(residual);
+	}
+
+	// sigma
+	if (std::isnan(sigma) != true) {
+		writer.Key(SIGMA_KEY);
+		writer.Double(sigma);
+	}
+
+	writer.EndObject();
+}
+
+// association validation error text, in associationerror order
+static const char *associationerrorvalues[] = {
+		"Phase did not validate in association object.",
+		"Invalid Distance in Association Class.",
+		"Invalid Azimuth in Association Class." };
+
+errorcodes association::validate() {
+	errorcodes errors = 0;
 
 	// optional keys
 	// phase
 	if ((phase.empty() == false) &&
 		(detectionformats::IsStringAlpha(phase) == false)) {
-		errorlist.push_back("Phase did not validate in association object.");
+		errors |= ERRORCODE(associationerror::associationphaseinvalid);
 	}
 
 	// distance
 	if (std::isnan(distance) != true) {
 		if (distance < 0) {
-			errorlist.push_back("Invalid Distance in Association Class.");
+			errors |= ERRORCODE(associationerror::associationdistanceinvalid);
 		}
 	}
 
 	// azimuth
 	if (std::isnan(azimuth) != true) {
 		if (azimuth < 0) {
-			errorlist.push_back("Invalid Azimuth in Association Class.");
+			errors |= ERRORCODE(associationerror::associationazimuthinvalid);
+		}
+	}
+
+	return (errors);
+}
+
+std::vector<std::string> association::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < associationerror::associationerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
 		}
+
+		errorlist.push_back(associationerrorvalues[i]);
 	}
 
 	// return the list of errors
 	return (errorlist);
 }
 
-bool association::isempty() {
+bool association::isempty() const {
 	if (phase.empty() == false)
 		return (false);
 	if (std::isnan(distance) != true)
@@ -3,6 +3,51 @@
 #include <vector>
 
 namespace detectionformats {
+// drives a jsonwriter through the jsonhandler interface
+class jsonwriterhandler : public jsonhandler {
+ public:
+	explicit jsonwriterhandler(jsonwriter *newwriter)
+			: writer(newwriter) {
+	}
+
+	bool StartObject() override {
+		return (writer->StartObject());
+	}
+
+	bool Key(const char *str, rapidjson::SizeType length,
+				bool copy) override {
+		return (writer->Key(str, length, copy));
+	}
+
+	bool EndObject(rapidjson::SizeType memberCount) override {
+		return (writer->EndObject(memberCount));
+	}
+
+	bool StartArray() override {
+		return (writer->StartArray());
+	}
+
+	bool EndArray(rapidjson::SizeType elementCount) override {
+		return (writer->EndArray(elementCount));
+	}
+
+	bool String(const char *str, rapidjson::SizeType length,
+				bool copy) override {
+		return (writer->String(str, length, copy));
+	}
+
+	bool Double(double d) override {
+		return (writer->Double(d));
+	}
+
+	bool Bool(bool b) override {
+		return (writer->Bool(b));
+	}
+
+ private:
+	jsonwriter *writer;
+};
+
 detectionbase::detectionbase() {
 	type = "";
 }
@@ -11,14 +56,40 @@ detectionbase::~detectionbase() {
 }
 
 bool detectionbase::isvalid() {
-	std::vector<std::string> errorlist = geterrors();
-	std::string errorstring = "";
-
-	if (errorlist.size() == 0) {
+	if (validate() == 0) {
 		// no errors
 		return (true);
 	} else {
 		return (false);
 	}
 }
+
+void detectionbase::write(jsonwriter &writer) {
+	jsonwriterhandler handler(&writer);
+	write(handler);
+}
+
+std::string detectionbase::getmembererror(const char *message,
+											detectionbase &member) { // NOLINT
+	std::string errorstring = message;
+
+	std::vector<std::string> membererrors = member.geterrors();
+	for (int i = 0; i < static_cast<int>(membererrors.size()); i++) {
+		errorstring += " " + membererrors[i];
+	}
+
+	return (errorstring);
+}
+
+std::string ToJSONString(detectionbase &object) { // NOLINT
+	// make the buffer
+	rapidjson::StringBuffer jsonbuffer;
+
+	// stream the class to the buffer
+	jsonwriter writer(jsonbuffer);
+	object.write(writer);
+
+	// write the json out as a string
+	return (std::string(jsonbuffer.GetString(), jsonbuffer.GetSize()));
+}
 }  // namespace detectionformats
@@ -0,0 +1,373 @@
+#include <batch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace detectionformats {
+// whether a code has a NUL character, which a site_key ends the code at
+static bool hasnul(const std::string &code) {
+	return (std::memchr(code.data(), '\0', code.length()) != NULL);
+}
+
+pick_batch::pick_batch() {
+}
+
+pick_batch::~pick_batch() {
+}
+
+size_t pick_batch::size() const {
+	return (presence.size());
+}
+
+bool pick_batch::empty() const {
+	return (presence.empty());
+}
+
+void pick_batch::clear() {
+	for (std::vector<double> &column : columns) {
+		column.clear();
+	}
+	sites.clear();
+	presence.clear();
+	polarities.clear();
+	onsets.clear();
+	pickers.clear();
+	text.clear();
+	ids.clear();
+	phases.clear();
+	agencyids.clear();
+	authors.clear();
+	associationphases.clear();
+	filters.clear();
+	filterends.clear();
+	rarerows.clear();
+}
+
+void pick_batch::reserve(size_t count) {
+	for (std::vector<double> &column : columns) {
+		column.reserve(count);
+	}
+	sites.reserve(count);
+	presence.reserve(count);
+	polarities.reserve(count);
+	onsets.reserve(count);
+	pickers.reserve(count);
+	ids.reserve(count);
+	phases.reserve(count);
+	agencyids.reserve(count);
+	authors.reserve(count);
+	associationphases.reserve(count);
+	filterends.reserve(count);
+}
+
+void pick_batch::push_back(const pick &object) {
+	columns[timecolumn].push_back(object.time);
+	columns[latitudecolumn].push_back(object.site.latitude);
+	columns[longitudecolumn].push_back(object.site.longitude);
+	columns[elevationcolumn].push_back(object.site.elevation);
+	columns[amplitudecolumn].push_back(object.amplitude.ampvalue);
+	columns[periodcolumn].push_back(object.amplitude.period);
+	columns[snrcolumn].push_back(object.amplitude.snr);
+	columns[backazimuthcolumn].push_back(object.beam.backazimuth);
+	columns[backazimutherrorcolumn].push_back(object.beam.backazimutherror);
+	columns[slownesscolumn].push_back(object.beam.slowness);
+	columns[slownesserrorcolumn].push_back(object.beam.slownesserror);
+	columns[powerratiocolumn].push_back(object.beam.powerratio);
+	columns[powerratioerrorcolumn].push_back(object.beam.powerratioerror);
+	columns[distancecolumn].push_back(object.associationinfo.distance);
+	columns[azimuthcolumn].push_back(object.associationinfo.azimuth);
+	columns[residualcolumn].push_back(object.associationinfo.residual);
+	columns[sigmacolumn].push_back(object.associationinfo.sigma);
+
+	site_key key(object);
+	sites.push_back(key);
+	polarities.push_back(static_cast<int8_t>(object.polarity));
+	onsets.push_back(static_cast<int8_t>(object.onset));
+	pickers.push_back(static_cast<int8_t>(object.picker));
+
+	ids.push_back(puttext(object.id));
+	phases.push_back(puttext(object.phase));
+	agencyids.push_back(puttext(object.source.agencyid));
+	authors.push_back(puttext(object.source.author));
+	associationphases.push_back(puttext(object.associationinfo.phase));
+
+	filters.insert(filters.end(), object.filterdata.begin(),
+					object.filterdata.end());
+	filterends.push_back(filters.size());
+
+	uint8_t bits = 0;
+	if (object.amplitude.isempty() == false) {
+		bits |= pickpresence::amplitudepresent;
+	}
+	if (object.beam.isempty() == false) {
+		bits |= pickpresence::beampresent;
+	}
+	if (object.associationinfo.isempty() == false) {
+		bits |= pickpresence::associationpresent;
+	}
+	if (object.classificationinfo.isempty() == false) {
+		bits |= pickpresence::classificationpresent;
+	}
+	if (object.filterdata.empty() == false) {
+		bits |= pickpresence::filterpresent;
+	}
+	presence.push_back(bits);
+
+	// the site codes are only kept when the key cannot give them back, a
+	// valid key holds codes that fit, which come back unless they have a NUL
+	bool sitefits = (key.isvalid() == true)
+			&& (hasnul(object.site.station) == false)
+			&& (hasnul(object.site.channel) == false)
+			&& (hasnul(object.site.network) == false)
+			&& (hasnul(object.site.location) == false);
+	bool hastext = (object.polarity < 0) || (object.onset < 0)
+			|| (object.picker < 0);
+	if (((bits & pickpresence::classificationpresent) != 0)
+			|| (object.type != PICK_TYPE) || (sitefits == false)
+			|| (hastext == true)) {
+		rarerow rare;
+		rare.row = presence.size() - 1;
+		rare.type = object.type;
+		rare.hassite = (sitefits == false);
+		if (rare.hassite == true) {
+			rare.site = object.site;
+		}
+		rare.classificationinfo = object.classificationinfo;
+		rare.polaritytext = object.polaritytext;
+		rare.onsettext = object.onsettext;
+		rare.pickertext = object.pickertext;
+		rarerows.push_back(std::move(rare));
+	}
+}
+
+void pick_batch::append(const pick *objects, size_t count) {
+	reserve(size() + count);
+	for (size_t i = 0; i < count; i++) {
+		push_back(objects[i]);
+	}
+}
+
+void pick_batch::append(const std::vector<pick> &objects) {
+	append(objects.data(), objects.size());
+}
+
+size_t pick_batch::decode(const std::string &ndjson, codec_context &context,
+							size_t *skipped) { // NOLINT
+	const char *position = ndjson.c_str();
+	const char *end = position + ndjson.length();
+	size_t added = 0;
+	size_t failed = 0;
+
+	while (position < end) {
+		const char *lineend = static_cast<const char *>(std::memchr(position,
+				'\n', end - position));
+		if (lineend == NULL) {
+			lineend = end;
+		}
+		size_t length = lineend - position;
+		const char *line = position;
+		position = lineend + 1;
+
+		// blank lines and other types are not counted
+		if (std::all_of(line, lineend, [](char character) {
+			return ((character == ' ') || (character == '\t')
+					|| (character == '\r'));
+		}) == true) {
+			continue;
+		}
+		if (GetDetectionType(line, length) != formattypes::picktype) {
+			continue;
+		}
+
+		// the buffer is null terminated, so the reader can stop at the end of
+		// the message instead of copying the line
+		rapidjson::StringStream stream(line);
+		context.getdecoder().settarget(&context.picktarget);
+		if ((context.getreader().Parse<rapidjson::kParseStopWhenDoneFlag>(
+				stream, context.getdecoder()).IsError() == true)
+				|| (stream.Tell() > length)) {
+			failed++;
+			continue;
+		}
+
+		push_back(context.picktarget);
+		added++;
+	}
+
+	if (skipped != NULL) {
+		*skipped += failed;
+	}
+	return (added);
+}
+
+pick & pick_batch::get(size_t row, pick &object) const { // NOLINT
+	auto rare = std::lower_bound(rarerows.begin(), rarerows.end(), row,
+			[](const rarerow &entry, size_t value) {
+				return (entry.row < value);
+			});
+	if ((rare != rarerows.end()) && (rare->row == row)) {
+		getrow(row, &(*rare), object);
+	} else {
+		getrow(row, NULL, object);
+	}
+	return (object);
+}
+
+size_t pick_batch::get(std::vector<pick> *objects) const {
+	size_t first = objects->size();
+	objects->resize(first + size());
+
+	// the rare rows are in row order, so walk them alongside
+	size_t next = 0;
+	for (size_t row = 0; row < size(); row++) {
+		const rarerow *rare = NULL;
+		if ((next < rarerows.size()) && (rarerows[next].row == row)) {
+			rare = &rarerows[next++];
+		}
+		getrow(row, rare, (*objects)[first + row]);
+	}
+	return (size());
+}
+
+const double * pick_batch::getcolumn(int column) const {
+	if ((column < 0) || (column >= pickcolumn::pickcolumncount)) {
+		return (NULL);
+	}
+	return (columns[column].data());
+}
+
+const site_key * pick_batch::getsites() const {
+	return (sites.data());
+}
+
+const uint8_t * pick_batch::getpresence() const {
+	return (presence.data());
+}
+
+const int8_t * pick_batch::getpolarities() const {
+	return (polarities.data());
+}
+
+const int8_t * pick_batch::getonsets() const {
+	return (onsets.data());
+}
+
+const int8_t * pick_batch::getpickers() const {
+	return (pickers.data());
+}
+
+std::string pick_batch::getid(size_t row) const {
+	std::string id;
+	gettext(ids[row], id);
+	return (id);
+}
+
+std::string pick_batch::getphase(size_t row) const {
+	std::string phase;
+	gettext(phases[row], phase);
+	return (phase);
+}
+
+size_t pick_batch::select(int column, double minimum, double maximum,
+							std::vector<size_t> *rows) const {
+	const double *values = getcolumn(column);
+	if (values == NULL) {
+		return (0);
+	}
+
+	// write every row and advance past the selected ones, NaN compares
+	// false so missing values are not selected
+	size_t first = rows->size();
+	size_t count = size();
+	rows->resize(first + count);
+	size_t *selected = rows->data() + first;
+	size_t found = 0;
+	for (size_t row = 0; row < count; row++) {
+		selected[found] = row;
+		found += static_cast<size_t>((values[row] >= minimum)
+				& (values[row] <= maximum));
+	}
+	rows->resize(first + found);
+	return (found);
+}
+
+pick_batch::textspan pick_batch::puttext(const std::string &str) {
+	textspan span;
+	span.offset = text.length();
+	span.length = str.length();
+	text.append(str);
+	return (span);
+}
+
+void pick_batch::gettext(const textspan &span,
+							std::string &str) const { // NOLINT
+	str.assign(text, span.offset, span.length);
+}
+
+void pick_batch::getrow(size_t row, const rarerow *rare,
+						pick &object) const { // NOLINT
+	if (rare != NULL) {
+		object.type = rare->type;
+		object.classificationinfo = rare->classificationinfo;
+	} else {
+		object.type = PICK_TYPE;
+		object.classificationinfo = classification();
+	}
+
+	if ((rare != NULL) && (rare->hassite == true)) {
+		object.site.station = rare->site.station;
+		object.site.channel = rare->site.channel;
+		object.site.network = rare->site.network;
+		object.site.location = rare->site.location;
+	} else {
+		object.site.station = sites[row].getstation();
+		object.site.channel = sites[row].getchannel();
+		object.site.network = sites[row].getnetwork();
+		object.site.location = sites[row].getlocation();
+	}
+	object.site.latitude = columns[latitudecolumn][row];
+	object.site.longitude = columns[longitudecolumn][row];
+	object.site.elevation = columns[elevationcolumn][row];
+
+	gettext(ids[row], object.id);
+	object.time = columns[timecolumn][row];
+	gettext(agencyids[row], object.source.agencyid);
+	gettext(authors[row], object.source.author);
+	gettext(phases[row], object.phase);
+	object.polarity = static_cast<polarityindex>(polarities[row]);
+	object.onset = static_cast<onsetindex>(onsets[row]);
+	object.picker = static_cast<pickerindex>(pickers[row]);
+	if (rare != NULL) {
+		object.polaritytext = rare->polaritytext;
+		object.onsettext = rare->onsettext;
+		object.pickertext = rare->pickertext;
+	} else {
+		object.polaritytext.clear();
+		object.onsettext.clear();
+		object.pickertext.clear();
+	}
+
+	size_t filterstart = (row == 0) ? 0 : filterends[row - 1];
+	object.filterdata.assign(filters.begin() + filterstart,
+								filters.begin() + filterends[row]);
+
+	object.amplitude.ampvalue = columns[amplitudecolumn][row];
+	object.amplitude.period = columns[periodcolumn][row];
+	object.amplitude.snr = columns[snrcolumn][row];
+	object.beam.backazimuth = columns[backazimuthcolumn][row];
+	object.beam.backazimutherror = columns[backazimutherrorcolumn][row];
+	object.beam.slowness = columns[slownesscolumn][row];
+	object.beam.slownesserror = columns[slownesserrorcolumn][row];
+	object.beam.powerratio = columns[powerratiocolumn][row];
+	object.beam.powerratioerror = columns[powerratioerrorcolumn][row];
+	gettext(associationphases[row], object.associationinfo.phase);
+	object.associationinfo.distance = columns[distancecolumn][row];
+	object.associationinfo.azimuth = columns[azimuthcolumn][row];
+	object.associationinfo.residual = columns[residualcolumn][row];
+	object.associationinfo.sigma = columns[sigmacolumn][row];
+}
+}  // namespace detectionformats
@@ -1,17 +1,10 @@
 #include <beam.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
 #include <vector>
 
-// JSON Keys
-#define BACKAZIMUTH_KEY "BackAzimuth"
-#define SLOWNESS_KEY "Slowness"
-#define POWERRATIO_KEY "PowerRatio"
-#define BACKAZIMUTHERROR_KEY "BackAzimuthError"
-#define SLOWNESSERROR_KEY "SlownessError"
-#define POWERRATIOERROR_KEY "PowerRatioError"
-
 namespace detectionformats {
 beam::beam() {
 	backazimuth = std::numeric_limits<double>::quiet_NaN();
@@ -34,55 +27,70 @@ beam::beam(double newbackazimuth, double newbackazimutherror,
 }
 
 beam::beam(rapidjson::Value &json) {
-	// required values
-	// backazimuth
-	if ((json.HasMember(BACKAZIMUTH_KEY) == true)
-			&& (json[BACKAZIMUTH_KEY].IsNumber() == true)
-			&& (json[BACKAZIMUTH_KEY].IsDouble() == true))
-		backazimuth = json[BACKAZIMUTH_KEY].GetDouble();
-	else
-		backazimuth = std::numeric_limits<double>::quiet_NaN();
+	// values that are missing from the json
+	backazimuth = std::numeric_limits<double>::quiet_NaN();
+	slowness = std::numeric_limits<double>::quiet_NaN();
+	powerratio = std::numeric_limits<double>::quiet_NaN();
+	backazimutherror = std::numeric_limits<double>::quiet_NaN();
+	slownesserror = std::numeric_limits<double>::quiet_NaN();
+	powerratioerror = std::numeric_limits<double>::quiet_NaN();
 
-	// slowness
-	if ((json.HasMember(SLOWNESS_KEY) == true)
-			&& (json[SLOWNESS_KEY].IsNumber() == true)
-			&& (json[SLOWNESS_KEY].IsDouble() == true))
-		slowness = json[SLOWNESS_KEY].GetDouble();
-	else
-		slowness = std::numeric_limits<double>::quiet_NaN();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
 
-	// optional values
-	// power ratio
-	if ((json.HasMember(POWERRATIO_KEY) == true)
-			&& (json[POWERRATIO_KEY].IsNumber() == true)
-			&& (json[POWERRATIO_KEY].IsDouble() == true))
-		powerratio = json[POWERRATIO_KEY].GetDouble();
-	else
-		powerratio = std::numeric_limits<double>::quiet_NaN();
+		switch (beamkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// backazimuth
+			case beamkeyindex::beambackazimuthkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					backazimuth = value.GetDouble();
+				}
+				break;
 
-	// backazimutherror
-	if ((json.HasMember(BACKAZIMUTHERROR_KEY) == true)
-			&& (json[BACKAZIMUTHERROR_KEY].IsNumber() == true)
-			&& (json[BACKAZIMUTHERROR_KEY].IsDouble() == true))
-		backazimutherror = json[BACKAZIMUTHERROR_KEY].GetDouble();
-	else
-		backazimutherror = std::numeric_limits<double>::quiet_NaN();
+			// slowness
+			case beamkeyindex::beamslownesskey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					slowness = value.GetDouble();
+				}
+				break;
 
-	// slownesserror
-	if ((json.HasMember(SLOWNESSERROR_KEY) == true)
-			&& (json[SLOWNESSERROR_KEY].IsNumber() == true)
-			&& (json[SLOWNESSERROR_KEY].IsDouble() == true))
-		slownesserror = json[SLOWNESSERROR_KEY].GetDouble();
-	else
-		slownesserror = std::numeric_limits<double>::quiet_NaN();
+			// optional values
+			// power ratio
+			case beamkeyindex::beampowerratiokey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					powerratio = value.GetDouble();
+				}
+				break;
 
-	// powerratioerror
-	if ((json.HasMember(POWERRATIOERROR_KEY) == true)
-			&& (json[POWERRATIOERROR_KEY].IsNumber() == true)
-			&& (json[POWERRATIOERROR_KEY].IsDouble() == true))
-		powerratioerror = json[POWERRATIOERROR_KEY].GetDouble();
-	else
-		powerratioerror = std::numeric_limits<double>::quiet_NaN();
+			// backazimutherror
+			case beamkeyindex::beambackazimutherrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					backazimutherror = value.GetDouble();
+				}
+				break;
+
+			// slownesserror
+			case beamkeyindex::beamslownesserrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					slownesserror = value.GetDouble();
+				}
+				break;
+
+			// powerratioerror
+			case beamkeyindex::beampowerratioerrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					powerratioerror = value.GetDouble();
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
+	}
 }
 
 beam::beam(const beam &newbeam) {
@@ -131,60 +139,131 @@ rapidjson::Value & beam::tojson(
 	return (json);
 }
 
-std::vector<std::string> beam::geterrors() {
-	std::vector<std::string> errorlist;
+void beam::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// backazimuth
+	if (std::isnan(backazimuth) != true) {
+		writer.Key(BACKAZIMUTH_KEY);
+		writer.Double(backazimuth);
+	}
+
+	// slowness
+	if (std::isnan(slowness) != true) {
+		writer.Key(SLOWNESS_KEY);
+		writer.Double(slowness);
+	}
+
+	// optional values
+	// powerratio
+	if (std::isnan(powerratio) != true) {
+		writer.Key(POWERRATIO_KEY);
+		writer.Double(powerratio);
+	}
+
+	// backazimutherror
+	if (std::isnan(backazimutherror) != true) {
+		writer.Key(BACKAZIMUTHERROR_KEY);
+		writer.Double(backazimutherror);
+	}
+
+	// slownesserror
+	if (std::isnan(slownesserror) != true) {
+		writer.Key(SLOWNESSERROR_KEY);
+		writer.Double(slownesserror);
+	}
+
+	// powerratioerror
+	if (std::isnan(powerratioerror) != true) {
+		writer.Key(POWERRATIOERROR_KEY);
+		writer.Double(powerratioerror);
+	}
+
+	writer.EndObject();
+}
+
+// beam validation error text, in beamerror order
+static const char *beamerrorvalues[] = {
+		"No BackAzimuth in beam class.",
+		"Invalid BackAzimuth in beam class.",
+		"No Slowness in beam class.",
+		"Invalid Slowness in beam class.",
+		"Invalid PowerRatio in beam class.",
+		"Invalid BackAzimuthError in beam class.",
+		"Invalid SlownessError in beam class.",
+		"Invalid PowerRatioError in beam class." };
+
+errorcodes beam::validate() {
+	errorcodes errors = 0;
 
 	// check required data
 	// backazimuth
 	if (std::isnan(backazimuth) == true) {
 		// backazimuth not found
-		errorlist.push_back("No BackAzimuth in beam class.");
+		errors |= ERRORCODE(beamerror::beambackazimuthmissing);
 	}
 	if (backazimuth < 0) {
-		errorlist.push_back("Invalid BackAzimuth in beam class.");
+		errors |= ERRORCODE(beamerror::beambackazimuthinvalid);
 	}
 
 	// slowness
 	if (std::isnan(slowness) == true) {
 		// slowness not found
-		errorlist.push_back("No Slowness in beam class.");
+		errors |= ERRORCODE(beamerror::beamslownessmissing);
 	}
 	if (slowness < 0) {
-		errorlist.push_back("Invalid Slowness in beam class.");
+		errors |= ERRORCODE(beamerror::beamslownessinvalid);
 	}
 
 	// optional data
 	// powerratio
 	if (std::isnan(powerratio) != true) {
 		if (powerratio < 0) {
-			errorlist.push_back("Invalid PowerRatio in beam class.");
+			errors |= ERRORCODE(beamerror::beampowerratioinvalid);
 		}
 	}
 
 	// backazimutherror
 	if (std::isnan(backazimutherror) != true) {
 		if (backazimutherror < 0) {
-			errorlist.push_back("Invalid BackAzimuthError in beam class.");
+			errors |= ERRORCODE(beamerror::beambackazimutherrorinvalid);
 		}
 	}
 	// slownesserror
 	if (std::isnan(slownesserror) != true) {
 		if (slownesserror < 0) {
-			errorlist.push_back("Invalid SlownessError in beam class.");
+			errors |= ERRORCODE(beamerror::beamslownesserrorinvalid);
 		}
 	}
 	// powerratioerror
 	if (std::isnan(powerratioerror) != true) {
 		if (powerratioerror < 0) {
-			errorlist.push_back("Invalid PowerRatioError in beam class.");
+			errors |= ERRORCODE(beamerror::beampowerratioerrorinvalid);
+		}
+	}
+
+	return (errors);
+}
+
+std::vector<std::string> beam::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < beamerror::beamerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
 		}
+
+		errorlist.push_back(beamerrorvalues[i]);
 	}
 
 	// return the list of errors
 	return (errorlist);
 }
 
-bool beam::isempty() {
+bool beam::isempty() const {
 	if (std::isnan(backazimuth) != true)
 		return (false);
 	if (std::isnan(slowness) != true)
@@ -0,0 +1,780 @@
+#include <binary.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace detectionformats {
+// the magic bytes that start every binary message
+static const char binarymagic[2] = { 'D', 'F' };
+
+// the flags byte bits, the optional members present in a pick or
+// correlation, the stationInfo booleans, and whether the type string differs
+// from the type of the message
+static const uint8_t hasamplitude = 0x01;
+static const uint8_t hasbeam = 0x02;
+static const uint8_t hasassociation = 0x04;
+static const uint8_t hasclassification = 0x08;
+static const uint8_t isenabled = 0x01;
+static const uint8_t isused = 0x02;
+static const uint8_t isusedforteleseismic = 0x04;
+static const uint8_t hastypename = 0x80;
+
+////////////// encoding //////////////
+
+// writes a message into a buffer already sized for it, so that no write
+// checks for room
+class binarywriter {
+ public:
+	explicit binarywriter(char *start)
+			: position(start) {
+	}
+
+	void putbyte(uint8_t value) {
+		*position++ = static_cast<char>(value);
+	}
+
+	void putdouble(double value) {
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		for (size_t i = 0; i < sizeof(bits); i++) {
+			position[i] = static_cast<char>(bits >> (i * 8));
+		}
+		position += sizeof(bits);
+	}
+
+	void putbytes(const char *data, size_t length) {
+		std::memcpy(position, data, length);
+		position += length;
+	}
+
+ private:
+	char *position;
+};
+
+// counts the bytes a binarywriter would write, to size the buffer
+class binarysizer {
+ public:
+	binarysizer()
+			: size(0) {
+	}
+
+	void putbyte(uint8_t) {
+		size += 1;
+	}
+
+	void putdouble(double) {
+		size += sizeof(uint64_t);
+	}
+
+	void putbytes(const char *, size_t length) {
+		size += length;
+	}
+
+	size_t getsize() const {
+		return (size);
+	}
+
+ private:
+	size_t size;
+};
+
+// the functions below encode with either a binarysizer or a binarywriter,
+// so that the two passes cannot disagree. Each takes the writer by value
+// and returns it, a writer being a single pointer or count, so that it
+// stays in a register rather than being reloaded after every character is
+// stored, which could change it through a reference
+template<class W>
+static W putlength(W writer, size_t length) {
+	while (length >= 0x80) {
+		writer.putbyte(static_cast<uint8_t>(length | 0x80));
+		length >>= 7;
+	}
+	writer.putbyte(static_cast<uint8_t>(length));
+	return (writer);
+}
+
+template<class W>
+static W putstring(W writer, const std::string &value) {
+	writer = putlength(writer, value.length());
+	writer.putbytes(value.data(), value.length());
+	return (writer);
+}
+
+// enums are written one up so that the unknown value, -1, is 0, and is
+// followed by the text of the unknown value
+template<class W>
+static W putenum(W writer, int value, const std::string &text) {
+	writer.putbyte(static_cast<uint8_t>(value + 1));
+	if (value < 0) {
+		writer = putstring(writer, text);
+	}
+	return (writer);
+}
+
+// the type string is only written when it is not the type of the message
+static uint8_t gettypeflag(const std::string &type, const char *messagetype) {
+	return ((type == messagetype) ? 0 : hastypename);
+}
+
+template<class W>
+static W putsite(W writer, const site &object) {
+	writer = putstring(writer, object.station);
+	writer = putstring(writer, object.channel);
+	writer = putstring(writer, object.network);
+	writer = putstring(writer, object.location);
+	writer.putdouble(object.latitude);
+	writer.putdouble(object.longitude);
+	writer.putdouble(object.elevation);
+	return (writer);
+}
+
+template<class W>
+static W putsource(W writer, const source &object) {
+	writer = putstring(writer, object.agencyid);
+	writer = putstring(writer, object.author);
+	return (writer);
+}
+
+template<class W>
+static W puteventtype(W writer, const eventtype &object) {
+	writer = putenum(writer, object.type, object.typetext);
+	writer = putenum(writer, object.certainty, object.certaintytext);
+	return (writer);
+}
+
+template<class W>
+static W puthypocenter(W writer, const hypocenter &object) {
+	writer.putdouble(object.latitude);
+	writer.putdouble(object.longitude);
+	writer.putdouble(object.time);
+	writer.putdouble(object.depth);
+	writer.putdouble(object.latitudeerror);
+	writer.putdouble(object.longitudeerror);
+	writer.putdouble(object.timeerror);
+	writer.putdouble(object.deptherror);
+	return (writer);
+}
+
+template<class W>
+static W putassociation(W writer, const association &object) {
+	writer = putstring(writer, object.phase);
+	writer.putdouble(object.distance);
+	writer.putdouble(object.azimuth);
+	writer.putdouble(object.residual);
+	writer.putdouble(object.sigma);
+	return (writer);
+}
+
+template<class W>
+static W putclassification(W writer, const classification &object) {
+	writer = putstring(writer, object.phase);
+	writer.putdouble(object.phaseprobability);
+	writer.putdouble(object.distance);
+	writer.putdouble(object.distanceprobability);
+	writer.putdouble(object.azimuth);
+	writer.putdouble(object.azimuthprobability);
+	writer.putdouble(object.magnitude);
+	writer = putstring(writer, object.magnitudetype);
+	writer.putdouble(object.magnitudeprobability);
+	writer.putdouble(object.depth);
+	writer.putdouble(object.depthprobability);
+	writer = puteventtype(writer, object.eventtype);
+	writer.putdouble(object.eventtypeprobability);
+	writer = putsource(writer, object.source);
+	return (writer);
+}
+
+template<class W>
+static W putpick(W writer, const pick &object) {
+	uint8_t flags = gettypeflag(object.type, PICK_TYPE);
+	if (object.amplitude.isempty() == false) {
+		flags |= hasamplitude;
+	}
+	if (object.beam.isempty() == false) {
+		flags |= hasbeam;
+	}
+	if (object.associationinfo.isempty() == false) {
+		flags |= hasassociation;
+	}
+	if (object.classificationinfo.isempty() == false) {
+		flags |= hasclassification;
+	}
+
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putstring(writer, object.id);
+	writer = putsite(writer, object.site);
+	writer.putdouble(object.time);
+	writer = putsource(writer, object.source);
+	writer = putstring(writer, object.phase);
+	writer = putenum(writer, object.polarity, object.polaritytext);
+	writer = putenum(writer, object.onset, object.onsettext);
+	writer = putenum(writer, object.picker, object.pickertext);
+
+	writer = putlength(writer, object.filterdata.size());
+	for (const filter &filterobject : object.filterdata) {
+		writer = putstring(writer, filterobject.type);
+		writer.putdouble(filterobject.highpass);
+		writer.putdouble(filterobject.lowpass);
+		writer = putstring(writer, filterobject.units);
+	}
+
+	if ((flags & hasamplitude) != 0) {
+		writer.putdouble(object.amplitude.ampvalue);
+		writer.putdouble(object.amplitude.period);
+		writer.putdouble(object.amplitude.snr);
+	}
+	if ((flags & hasbeam) != 0) {
+		writer.putdouble(object.beam.backazimuth);
+		writer.putdouble(object.beam.backazimutherror);
+		writer.putdouble(object.beam.slowness);
+		writer.putdouble(object.beam.slownesserror);
+		writer.putdouble(object.beam.powerratio);
+		writer.putdouble(object.beam.powerratioerror);
+	}
+	if ((flags & hasassociation) != 0) {
+		writer = putassociation(writer, object.associationinfo);
+	}
+	if ((flags & hasclassification) != 0) {
+		writer = putclassification(writer, object.classificationinfo);
+	}
+	return (writer);
+}
+
+template<class W>
+static W putcorrelation(W writer, const correlation &object) {
+	uint8_t flags = gettypeflag(object.type, CORRELATION_TYPE);
+	if (object.associationinfo.isempty() == false) {
+		flags |= hasassociation;
+	}
+
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putstring(writer, object.id);
+	writer = putsite(writer, object.site);
+	writer = putsource(writer, object.source);
+	writer = putstring(writer, object.phase);
+	writer.putdouble(object.time);
+	writer.putdouble(object.correlationvalue);
+	writer = puthypocenter(writer, object.hypocenter);
+	writer = puteventtype(writer, object.eventtype);
+	writer.putdouble(object.magnitude);
+	writer.putdouble(object.snr);
+	writer.putdouble(object.zscore);
+	writer.putdouble(object.detectionthreshold);
+	writer = putstring(writer, object.thresholdtype);
+
+	if ((flags & hasassociation) != 0) {
+		writer = putassociation(writer, object.associationinfo);
+	}
+	return (writer);
+}
+
+template<class W>
+static W putdetection(W writer, const detection &object) {
+	uint8_t flags = gettypeflag(object.type, DETECTION_TYPE);
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putstring(writer, object.id);
+	writer = putsource(writer, object.source);
+	writer = puthypocenter(writer, object.hypocenter);
+	writer = putenum(writer, object.detectiontype,
+			object.detectiontypetext);
+	writer = puteventtype(writer, object.eventtype);
+	writer.putdouble(object.bayes);
+	writer.putdouble(object.minimumdistance);
+	writer.putdouble(object.rms);
+	writer.putdouble(object.gap);
+	writer.putdouble(object.detectiontime);
+
+	writer = putlength(writer, object.pickdata.size());
+	for (const pick &pickobject : object.pickdata) {
+		writer = putpick(writer, pickobject);
+	}
+	writer = putlength(writer, object.correlationdata.size());
+	for (const correlation &correlationobject : object.correlationdata) {
+		writer = putcorrelation(writer, correlationobject);
+	}
+	return (writer);
+}
+
+template<class W>
+static W putretract(W writer, const retract &object) {
+	uint8_t flags = gettypeflag(object.type, RETRACT_TYPE);
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putstring(writer, object.id);
+	writer = putsource(writer, object.source);
+	return (writer);
+}
+
+template<class W>
+static W putstationinfo(W writer, const stationInfo &object) {
+	uint8_t flags = gettypeflag(object.type, STATIONINFO_TYPE);
+	if (object.enable == true) {
+		flags |= isenabled;
+	}
+	if (object.use == true) {
+		flags |= isused;
+	}
+	if (object.useforteleseismic == true) {
+		flags |= isusedforteleseismic;
+	}
+
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putsite(writer, object.site);
+	writer.putdouble(object.quality);
+	writer = putsource(writer, object.informationRequestor);
+	return (writer);
+}
+
+template<class W>
+static W putstationinforequest(W writer,
+								const stationInfoRequest &object) {
+	uint8_t flags = gettypeflag(object.type, STATIONINFOREQUEST_TYPE);
+	writer.putbyte(flags);
+	if ((flags & hastypename) != 0) {
+		writer = putstring(writer, object.type);
+	}
+	writer = putsite(writer, object.site);
+	writer = putsource(writer, object.source);
+	return (writer);
+}
+
+// sizes the buffer to the header and the provided length of members,
+// keeping its capacity, and writes the header, returning a writer for the
+// members after it
+static binarywriter putheader(std::string &buffer, int type, // NOLINT
+								size_t length) {
+	if (buffer.capacity() < BINARY_INITIALSIZE) {
+		buffer.reserve(BINARY_INITIALSIZE);
+	}
+	buffer.resize(BINARY_HEADERSIZE + length);
+
+	binarywriter writer(&buffer[0]);
+	writer.putbyte(binarymagic[0]);
+	writer.putbyte(binarymagic[1]);
+	writer.putbyte(BINARY_VERSION);
+	writer.putbyte(static_cast<uint8_t>(type));
+	return (writer);
+}
+
+////////////// decoding //////////////
+
+// the fewest bytes each array element takes, with its strings empty and
+// its optional members left out
+static const size_t minimumsitesize = 4 + 3 * sizeof(uint64_t);
+static const size_t minimumfiltersize = 2 + 2 * sizeof(uint64_t);
+static const size_t minimumpicksize = 2 + minimumsitesize
+		+ sizeof(uint64_t) + 2 + 1 + 3 + 1;
+static const size_t minimumcorrelationsize = 2 + minimumsitesize + 2 + 1
+		+ 14 * sizeof(uint64_t) + 2 + 1;
+
+// a position in a binary message and its end
+struct binaryreader {
+	const char *position;
+	const char *end;
+};
+
+// throws if fewer than length bytes are left
+static void need(const binaryreader &reader, size_t length) {
+	if (static_cast<size_t>(reader.end - reader.position) < length) {
+		throw std::invalid_argument("Binary message is truncated.");
+	}
+}
+
+static uint8_t getbyte(binaryreader &reader) { // NOLINT
+	need(reader, 1);
+	return (static_cast<uint8_t>(*reader.position++));
+}
+
+static double getdouble(binaryreader &reader) { // NOLINT
+	need(reader, sizeof(uint64_t));
+
+	uint64_t bits = 0;
+	for (size_t i = 0; i < sizeof(bits); i++) {
+		bits |= static_cast<uint64_t>(static_cast<uint8_t>(
+				reader.position[i])) << (i * 8);
+	}
+	reader.position += sizeof(bits);
+
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return (value);
+}
+
+// reads a length, which cannot be more than the bytes left divided by the
+// fewest bytes a character or array element takes, so that a bad length is
+// rejected before anything is sized to it
+static size_t getlength(binaryreader &reader, // NOLINT
+						size_t minimumsize = 1) {
+	uint64_t length = 0;
+	for (int shift = 0;; shift += 7) {
+		if (shift > 63) {
+			throw std::invalid_argument("Binary message has a bad length.");
+		}
+		uint8_t value = getbyte(reader);
+		length |= static_cast<uint64_t>(value & 0x7F) << shift;
+		if ((value & 0x80) == 0) {
+			break;
+		}
+	}
+
+	if (length > static_cast<size_t>(reader.end - reader.position)
+			/ minimumsize) {
+		throw std::invalid_argument("Binary message is truncated.");
+	}
+	return (static_cast<size_t>(length));
+}
+
+static void getstring(binaryreader &reader, std::string &value) { // NOLINT
+	size_t length = getlength(reader);
+	value.assign(reader.position, length);
+	reader.position += length;
+}
+
+// reads an enum written by putenum(), checking that it is one of the
+// values, the count, or unknown, and the text of an unknown value
+template<class T>
+static T getenum(binaryreader &reader, T count, // NOLINT
+					std::string &text) { // NOLINT
+	int value = static_cast<int>(getbyte(reader)) - 1;
+	if (value > static_cast<int>(count)) {
+		throw std::invalid_argument("Binary message has a bad enum value.");
+	}
+	if (value < 0) {
+		getstring(reader, text);
+	} else {
+		text.clear();
+	}
+	return (static_cast<T>(value));
+}
+
+// checks the header and returns a reader for the members that follow
+static binaryreader getheader(const char *data, size_t length, int type) {
+	if (GetBinaryType(data, length) != type) {
+		throw std::invalid_argument(
+				"Not a binary message of a supported version and this type.");
+	}
+	binaryreader reader = { data + BINARY_HEADERSIZE, data + length };
+	return (reader);
+}
+
+// reads the type string if the flags have it, otherwise sets the type of
+// the message
+static void gettype(binaryreader &reader, uint8_t flags, // NOLINT
+					std::string &type, const char *messagetype) { // NOLINT
+	if ((flags & hastypename) != 0) {
+		getstring(reader, type);
+	} else {
+		type = messagetype;
+	}
+}
+
+static void getsite(binaryreader &reader, site &object) { // NOLINT
+	getstring(reader, object.station);
+	getstring(reader, object.channel);
+	getstring(reader, object.network);
+	getstring(reader, object.location);
+	object.latitude = getdouble(reader);
+	object.longitude = getdouble(reader);
+	object.elevation = getdouble(reader);
+}
+
+static void getsource(binaryreader &reader, source &object) { // NOLINT
+	getstring(reader, object.agencyid);
+	getstring(reader, object.author);
+}
+
+static void geteventtype(binaryreader &reader, // NOLINT
+							eventtype &object) { // NOLINT
+	object.type = getenum(reader, eventtypeindex::eventtypecount,
+							object.typetext);
+	object.certainty = getenum(
+			reader, eventtypecertaintyindex::eventtypecertaintycount,
+			object.certaintytext);
+}
+
+static void gethypocenter(binaryreader &reader, // NOLINT
+							hypocenter &object) { // NOLINT
+	object.latitude = getdouble(reader);
+	object.longitude = getdouble(reader);
+	object.time = getdouble(reader);
+	object.depth = getdouble(reader);
+	object.latitudeerror = getdouble(reader);
+	object.longitudeerror = getdouble(reader);
+	object.timeerror = getdouble(reader);
+	object.deptherror = getdouble(reader);
+}
+
+static void getassociation(binaryreader &reader, // NOLINT
+							association &object) { // NOLINT
+	getstring(reader, object.phase);
+	object.distance = getdouble(reader);
+	object.azimuth = getdouble(reader);
+	object.residual = getdouble(reader);
+	object.sigma = getdouble(reader);
+}
+
+static void getclassification(binaryreader &reader, // NOLINT
+								classification &object) { // NOLINT
+	getstring(reader, object.phase);
+	object.phaseprobability = getdouble(reader);
+	object.distance = getdouble(reader);
+	object.distanceprobability = getdouble(reader);
+	object.azimuth = getdouble(reader);
+	object.azimuthprobability = getdouble(reader);
+	object.magnitude = getdouble(reader);
+	getstring(reader, object.magnitudetype);
+	object.magnitudeprobability = getdouble(reader);
+	object.depth = getdouble(reader);
+	object.depthprobability = getdouble(reader);
+	geteventtype(reader, object.eventtype);
+	object.eventtypeprobability = getdouble(reader);
+	getsource(reader, object.source);
+}
+
+static void getpick(binaryreader &reader, pick &object) { // NOLINT
+	uint8_t flags = getbyte(reader);
+	gettype(reader, flags, object.type, PICK_TYPE);
+	getstring(reader, object.id);
+	getsite(reader, object.site);
+	object.time = getdouble(reader);
+	getsource(reader, object.source);
+	getstring(reader, object.phase);
+	object.polarity = getenum(reader, polarityindex::polaritycount,
+								object.polaritytext);
+	object.onset = getenum(reader, onsetindex::onsetcount, object.onsettext);
+	object.picker = getenum(reader, pickerindex::pickercount,
+							object.pickertext);
+
+	object.filterdata.resize(getlength(reader, minimumfiltersize));
+	for (filter &filterobject : object.filterdata) {
+		getstring(reader, filterobject.type);
+		filterobject.highpass = getdouble(reader);
+		filterobject.lowpass = getdouble(reader);
+		getstring(reader, filterobject.units);
+	}
+
+	// members left out of the message are empty
+	if ((flags & hasamplitude) != 0) {
+		object.amplitude.ampvalue = getdouble(reader);
+		object.amplitude.period = getdouble(reader);
+		object.amplitude.snr = getdouble(reader);
+	} else {
+		object.amplitude = amplitude();
+	}
+	if ((flags & hasbeam) != 0) {
+		object.beam.backazimuth = getdouble(reader);
+		object.beam.backazimutherror = getdouble(reader);
+		object.beam.slowness = getdouble(reader);
+		object.beam.slownesserror = getdouble(reader);
+		object.beam.powerratio = getdouble(reader);
+		object.beam.powerratioerror = getdouble(reader);
+	} else {
+		object.beam = beam();
+	}
+	if ((flags & hasassociation) != 0) {
+		getassociation(reader, object.associationinfo);
+	} else {
+		object.associationinfo = association();
+	}
+	if ((flags & hasclassification) != 0) {
+		getclassification(reader, object.classificationinfo);
+	} else {
+		object.classificationinfo = classification();
+	}
+}
+
+static void getcorrelation(binaryreader &reader, // NOLINT
+							correlation &object) { // NOLINT
+	uint8_t flags = getbyte(reader);
+	gettype(reader, flags, object.type, CORRELATION_TYPE);
+	getstring(reader, object.id);
+	getsite(reader, object.site);
+	getsource(reader, object.source);
+	getstring(reader, object.phase);
+	object.time = getdouble(reader);
+	object.correlationvalue = getdouble(reader);
+	gethypocenter(reader, object.hypocenter);
+	geteventtype(reader, object.eventtype);
+	object.magnitude = getdouble(reader);
+	object.snr = getdouble(reader);
+	object.zscore = getdouble(reader);
+	object.detectionthreshold = getdouble(reader);
+	getstring(reader, object.thresholdtype);
+
+	if ((flags & hasassociation) != 0) {
+		getassociation(reader, object.associationinfo);
+	} else {
+		object.associationinfo = association();
+	}
+}
+
+// throws if bytes are left after the message
+static void done(const binaryreader &reader) {
+	if (reader.position != reader.end) {
+		throw std::invalid_argument("Binary message has trailing bytes.");
+	}
+}
+
+////////////// functions //////////////
+
+int GetBinaryType(const char *data, size_t length) {
+	if ((data == NULL) || (length < BINARY_HEADERSIZE)
+			|| (std::memcmp(data, binarymagic, sizeof(binarymagic)) != 0)) {
+		return (formattypes::unknown);
+	}
+
+	// older versions are read, newer ones are not
+	uint8_t version = static_cast<uint8_t>(data[2]);
+	uint8_t type = static_cast<uint8_t>(data[3]);
+	if ((version == 0) || (version > BINARY_VERSION)
+			|| (type > formattypes::stationinforequesttype)) {
+		return (formattypes::unknown);
+	}
+	return (type);
+}
+
+std::string & ToBinary(pick &object, std::string &buffer) { // NOLINT
+	size_t length = putpick(binarysizer(), object).getsize();
+	putpick(putheader(buffer, formattypes::picktype, length), object);
+	return (buffer);
+}
+
+std::string & ToBinary(correlation &object, std::string &buffer) { // NOLINT
+	size_t length = putcorrelation(binarysizer(), object).getsize();
+	putcorrelation(putheader(buffer, formattypes::correlationtype, length),
+					object);
+	return (buffer);
+}
+
+std::string & ToBinary(detection &object, std::string &buffer) { // NOLINT
+	size_t length = putdetection(binarysizer(), object).getsize();
+	putdetection(putheader(buffer, formattypes::detectiontype, length),
+					object);
+	return (buffer);
+}
+
+std::string & ToBinary(retract &object, std::string &buffer) { // NOLINT
+	size_t length = putretract(binarysizer(), object).getsize();
+	putretract(putheader(buffer, formattypes::retracttype, length), object);
+	return (buffer);
+}
+
+std::string & ToBinary(stationInfo &object, std::string &buffer) { // NOLINT
+	size_t length = putstationinfo(binarysizer(), object).getsize();
+	putstationinfo(putheader(buffer, formattypes::stationinfotype, length),
+					object);
+	return (buffer);
+}
+
+std::string & ToBinary(stationInfoRequest &object,
+						std::string &buffer) { // NOLINT
+	size_t length = putstationinforequest(binarysizer(), object).getsize();
+	putstationinforequest(putheader(buffer,
+									formattypes::stationinforequesttype,
+									length), object);
+	return (buffer);
+}
+
+pick & FromBinary(const char *data, size_t length, pick &object) { // NOLINT
+	binaryreader reader = getheader(data, length, formattypes::picktype);
+	getpick(reader, object);
+	done(reader);
+	return (object);
+}
+
+correlation & FromBinary(const char *data, size_t length,
+							correlation &object) { // NOLINT
+	binaryreader reader = getheader(data, length,
+									formattypes::correlationtype);
+	getcorrelation(reader, object);
+	done(reader);
+	return (object);
+}
+
+detection & FromBinary(const char *data, size_t length,
+						detection &object) { // NOLINT
+	binaryreader reader = getheader(data, length,
+									formattypes::detectiontype);
+	gettype(reader, getbyte(reader), object.type, DETECTION_TYPE);
+	getstring(reader, object.id);
+	getsource(reader, object.source);
+	gethypocenter(reader, object.hypocenter);
+	object.detectiontype = getenum(reader,
+									detectiontypeindex::detectiontypecount,
+									object.detectiontypetext);
+	geteventtype(reader, object.eventtype);
+	object.bayes = getdouble(reader);
+	object.minimumdistance = getdouble(reader);
+	object.rms = getdouble(reader);
+	object.gap = getdouble(reader);
+	object.detectiontime = getdouble(reader);
+
+	object.pickdata.resize(getlength(reader, minimumpicksize));
+	for (pick &pickobject : object.pickdata) {
+		getpick(reader, pickobject);
+	}
+	object.correlationdata.resize(getlength(reader,
+			minimumcorrelationsize));
+	for (correlation &correlationobject : object.correlationdata) {
+		getcorrelation(reader, correlationobject);
+	}
+
+	done(reader);
+	return (object);
+}
+
+retract & FromBinary(const char *data, size_t length,
+						retract &object) { // NOLINT
+	binaryreader reader = getheader(data, length, formattypes::retracttype);
+	gettype(reader, getbyte(reader), object.type, RETRACT_TYPE);
+	getstring(reader, object.id);
+	getsource(reader, object.source);
+	done(reader);
+	return (object);
+}
+
+stationInfo & FromBinary(const char *data, size_t length,
+							stationInfo &object) { // NOLINT
+	binaryreader reader = getheader(data, length,
+									formattypes::stationinfotype);
+	uint8_t flags = getbyte(reader);
+	gettype(reader, flags, object.type, STATIONINFO_TYPE);
+	getsite(reader, object.site);
+	object.quality = getdouble(reader);
+	getsource(reader, object.informationRequestor);
+	object.enable = ((flags & isenabled) != 0);
+	object.use = ((flags & isused) != 0);
+	object.useforteleseismic = ((flags & isusedforteleseismic) != 0);
+	done(reader);
+	return (object);
+}
+
+stationInfoRequest & FromBinary(const char *data, size_t length,
+								stationInfoRequest &object) { // NOLINT
+	binaryreader reader = getheader(data, length,
+									formattypes::stationinforequesttype);
+	gettype(reader, getbyte(reader), object.type, STATIONINFOREQUEST_TYPE);
+	getsite(reader, object.site);
+	getsource(reader, object.source);
+	done(reader);
+	return (object);
+}
+}  // namespace detectionformats
@@ -1,25 +1,11 @@
 #include <classification.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define PHASE_KEY "Phase"
-#define PHASEPROB_KEY "PhaseProbability"
-#define DISTANCE_KEY "Distance"
-#define DISTANCEPROB_KEY "DistanceProbability"
-#define AZIMUTH_KEY "Azimuth"
-#define AZIMUTHPROB_KEY "AzimuthProbability"
-#define MAGNITUDE_KEY "Magnitude"
-#define MAGNITUDETYPE_KEY "MagnitudeType"
-#define MAGNITUDEPROB_KEY "MagnitudeProbability"
-#define DEPTH_KEY "Depth"
-#define DEPTHPROB_KEY "DepthProbability"
-#define EVENTTYPE_KEY "EventType"
-#define EVENTTYPEPROB_KEY "EventTypeProbability"
-#define SOURCE_KEY "Source"
-
 namespace detectionformats {
 classification::classification() {
     phase = "";
@@ -45,21 +31,22 @@ classification::classification(std::string newphase, double newphaseprob,
             std::string neweventtype, std::string neweventtypecertainty,
             double neweventtypeprob, std::string newagencyid,
             std::string newauthor) {
-	phase = newphase;
+	phase = std::move(newphase);
     phaseprobability = newphaseprob;
 	distance = newdistance;
     distanceprobability = newdistanceprob;
 	azimuth = newazimuth;
     azimuthprobability = newazimuthprob;
 	magnitude = newmagnitude;
-    magnitudetype = newmagtype;
+    magnitudetype = std::move(newmagtype);
     magnitudeprobability = newmagprob;
 	depth = newdepth;
     depthprobability = newdepthprob;
-    eventtype = detectionformats::eventtype(neweventtype,
-        neweventtypecertainty);
+    eventtype = detectionformats::eventtype(std::move(neweventtype),
+        std::move(neweventtypecertainty));
     eventtypeprobability = neweventtypeprob;
-    classification::source = detectionformats::source(newagencyid, newauthor);
+    classification::source = detectionformats::source(std::move(newagencyid),
+            std::move(newauthor));
 }
 
 classification::classification(std::string newphase, double newphaseprob,
@@ -68,157 +55,155 @@ classification::classification(std::string newphase, double newphaseprob,
             double newmagprob, double newdepth, double newdepthprob,
             detectionformats::eventtype neweventtype, double neweventtypeprob,
             detectionformats::source newsource) {
-	phase = newphase;
+	phase = std::move(newphase);
     phaseprobability = newphaseprob;
 	distance = newdistance;
     distanceprobability = newdistanceprob;
 	azimuth = newazimuth;
     azimuthprobability = newazimuthprob;
 	magnitude = newmagnitude;
-    magnitudetype = newmagtype;
+    magnitudetype = std::move(newmagtype);
     magnitudeprobability = newmagprob;
 	depth = newdepth;
     depthprobability = newdepthprob;
-    eventtype = neweventtype;
+    eventtype = std::move(neweventtype);
     eventtypeprobability = neweventtypeprob;
-    classification::source = newsource;
+    classification::source = std::move(newsource);
 }
 
 classification::classification(rapidjson::Value &json) {
-	// optional values
-	// phase
-	if ((json.HasMember(PHASE_KEY) == true)
-			&& (json[PHASE_KEY].IsString() == true)) {
-		phase = std::string(json[PHASE_KEY].GetString(),
-							json[PHASE_KEY].GetStringLength());
-    } else {
-		phase = "";
-    }
-
-    // phase probability
-	if ((json.HasMember(PHASEPROB_KEY) == true)
-			&& (json[PHASEPROB_KEY].IsNumber() == true)
-			&& (json[PHASEPROB_KEY].IsDouble() == true)) {
-		phaseprobability = json[PHASEPROB_KEY].GetDouble();
-    } else {
-		phaseprobability = std::numeric_limits<double>::quiet_NaN();
-    }
-
-	// distance
-	if ((json.HasMember(DISTANCE_KEY) == true)
-			&& (json[DISTANCE_KEY].IsNumber() == true)) {
-		if (json[DISTANCE_KEY].IsDouble() == true) {
-			distance = json[DISTANCE_KEY].GetDouble();
-		} else if (json[DISTANCE_KEY].IsInt() == true) {
-			distance = static_cast<double>(json[DISTANCE_KEY].GetInt());
-		} else {
-			distance = std::numeric_limits<double>::quiet_NaN();
-		}
-	} else {
-		distance = std::numeric_limits<double>::quiet_NaN();
-	}
-
-    // distance probability
-	if ((json.HasMember(DISTANCEPROB_KEY) == true)
-			&& (json[DISTANCEPROB_KEY].IsNumber() == true)
-			&& (json[DISTANCEPROB_KEY].IsDouble() == true)) {
-		distanceprobability = json[DISTANCEPROB_KEY].GetDouble();
-    } else {
-		distanceprobability = std::numeric_limits<double>::quiet_NaN();
-    }
-
-	// azimuth
-	if ((json.HasMember(AZIMUTH_KEY) == true)
-			&& (json[AZIMUTH_KEY].IsNumber() == true)) {
-		if (json[AZIMUTH_KEY].IsDouble() == true) {
-			azimuth = json[AZIMUTH_KEY].GetDouble();
-		} else if (json[AZIMUTH_KEY].IsInt() == true) {
-			azimuth = static_cast<double>(json[AZIMUTH_KEY].GetInt());
-		} else {
-			azimuth = std::numeric_limits<double>::quiet_NaN();
+	// values that are missing from the json
+	phaseprobability = std::numeric_limits<double>::quiet_NaN();
+	distance = std::numeric_limits<double>::quiet_NaN();
+	distanceprobability = std::numeric_limits<double>::quiet_NaN();
+	azimuth = std::numeric_limits<double>::quiet_NaN();
+	azimuthprobability = std::numeric_limits<double>::quiet_NaN();
+	magnitude = std::numeric_limits<double>::quiet_NaN();
+	magnitudeprobability = std::numeric_limits<double>::quiet_NaN();
+	depth = std::numeric_limits<double>::quiet_NaN();
+	depthprobability = std::numeric_limits<double>::quiet_NaN();
+	eventtypeprobability = std::numeric_limits<double>::quiet_NaN();
+
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (classificationkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// optional values
+			// phase
+			case classificationkeyindex::classphasekey:
+				if (value.IsString() == true) {
+					phase = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// phase probability
+			case classificationkeyindex::classphaseprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					phaseprobability = value.GetDouble();
+				}
+				break;
+
+			// distance, also accepts integers
+			case classificationkeyindex::classdistancekey:
+				if (value.IsNumber() == true) {
+					if (value.IsDouble() == true) {
+						distance = value.GetDouble();
+					} else if (value.IsInt() == true) {
+						distance = static_cast<double>(value.GetInt());
+					}
+				}
+				break;
+
+			// distance probability
+			case classificationkeyindex::classdistanceprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					distanceprobability = value.GetDouble();
+				}
+				break;
+
+			// azimuth, also accepts integers
+			case classificationkeyindex::classazimuthkey:
+				if (value.IsNumber() == true) {
+					if (value.IsDouble() == true) {
+						azimuth = value.GetDouble();
+					} else if (value.IsInt() == true) {
+						azimuth = static_cast<double>(value.GetInt());
+					}
+				}
+				break;
+
+			// azimuth probability
+			case classificationkeyindex::classazimuthprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					azimuthprobability = value.GetDouble();
+				}
+				break;
+
+			// magnitude
+			case classificationkeyindex::classmagnitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					magnitude = value.GetDouble();
+				}
+				break;
+
+			// magnitude type
+			case classificationkeyindex::classmagnitudetypekey:
+				if (value.IsString() == true) {
+					magnitudetype = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// magnitude probability
+			case classificationkeyindex::classmagnitudeprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					magnitudeprobability = value.GetDouble();
+				}
+				break;
+
+			// depth
+			case classificationkeyindex::classdepthkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					depth = value.GetDouble();
+				}
+				break;
+
+			// depth probability
+			case classificationkeyindex::classdepthprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					depthprobability = value.GetDouble();
+				}
+				break;
+
+			// eventtype
+			case classificationkeyindex::classeventtypekey:
+				if (value.IsObject() == true) {
+					eventtype = detectionformats::eventtype(value);
+				}
+				break;
+
+			// event type probability
+			case classificationkeyindex::classeventtypeprobkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					eventtypeprobability = value.GetDouble();
+				}
+				break;
+
+			// source
+			case classificationkeyindex::classsourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
 		}
-	} else {
-		azimuth = std::numeric_limits<double>::quiet_NaN();
-	}
-
-    // azimuth probability
-	if ((json.HasMember(AZIMUTHPROB_KEY) == true)
-			&& (json[AZIMUTHPROB_KEY].IsNumber() == true)
-			&& (json[AZIMUTHPROB_KEY].IsDouble() == true)) {
-		azimuthprobability = json[AZIMUTHPROB_KEY].GetDouble();
-    } else {
-		azimuthprobability = std::numeric_limits<double>::quiet_NaN();
-    }
-
-	// magnitude
-	if ((json.HasMember(MAGNITUDE_KEY) == true)
-			&& (json[MAGNITUDE_KEY].IsNumber() == true)
-			&& (json[MAGNITUDE_KEY].IsDouble() == true)) {
-		magnitude = json[MAGNITUDE_KEY].GetDouble();
-	} else {
-		magnitude = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// magnitude type
-	if ((json.HasMember(MAGNITUDETYPE_KEY) == true)
-			&& (json[MAGNITUDETYPE_KEY].IsString() == true)) {
-		magnitudetype = std::string(json[MAGNITUDETYPE_KEY].GetString(),
-							json[MAGNITUDETYPE_KEY].GetStringLength());
-    } else {
-		magnitudetype = "";
-    }
-
-    // magnitude probability
-	if ((json.HasMember(MAGNITUDEPROB_KEY) == true)
-			&& (json[MAGNITUDEPROB_KEY].IsNumber() == true)
-			&& (json[MAGNITUDEPROB_KEY].IsDouble() == true)) {
-		magnitudeprobability = json[MAGNITUDEPROB_KEY].GetDouble();
-    } else {
-		magnitudeprobability = std::numeric_limits<double>::quiet_NaN();
-    }
-
-	// depth
-	if ((json.HasMember(DEPTH_KEY) == true)
-			&& (json[DEPTH_KEY].IsNumber() == true)
-			&& (json[DEPTH_KEY].IsDouble() == true)) {
-		depth = json[DEPTH_KEY].GetDouble();
-	} else {
-		depth = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// depth probability
-	if ((json.HasMember(DEPTHPROB_KEY) == true)
-			&& (json[DEPTHPROB_KEY].IsNumber() == true)
-			&& (json[DEPTHPROB_KEY].IsDouble() == true)) {
-		depthprobability = json[DEPTHPROB_KEY].GetDouble();
-    } else {
-		depthprobability = std::numeric_limits<double>::quiet_NaN();
-    }
-
-	// eventtype
-	if ((json.HasMember(EVENTTYPE_KEY) == true)
-			&& (json[EVENTTYPE_KEY].IsObject() == true)) {
-		rapidjson::Value & eventtypevalue = json[EVENTTYPE_KEY];
-		eventtype = detectionformats::eventtype(eventtypevalue);
-	} else {
-		eventtype = detectionformats::eventtype();
-	}
-
-	// event type probability
-	if ((json.HasMember(EVENTTYPEPROB_KEY) == true)
-			&& (json[EVENTTYPEPROB_KEY].IsNumber() == true)
-			&& (json[EVENTTYPEPROB_KEY].IsDouble() == true))
-		eventtypeprobability = json[EVENTTYPEPROB_KEY].GetDouble();
-	else
-		eventtypeprobability = std::numeric_limits<double>::quiet_NaN();
-
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
 	}
 }
 
@@ -330,82 +315,191 @@ rapidjson::Value & classification::tojson(
 	return (json);
 }
 
-std::vector<std::string> classification::geterrors() {
-	std::vector<std::string> errorlist;
+void classification::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// optional values
+	// phase
+	if (phase.empty() == false) {
+		writer.Key(PHASE_KEY);
+		writer.String(phase.c_str(),
+						static_cast<rapidjson::SizeType>(phase.length()));
+	}
+
+	// phaseprobability
+	if (std::isnan(phaseprobability) != true) {
+		writer.Key(PHASEPROB_KEY);
+		writer.Double(phaseprobability);
+	}
+
+	// distance
+	if (std::isnan(distance) != true) {
+		writer.Key(DISTANCE_KEY);
+		writer.Double(distance);
+	}
+
+	// distanceprobability
+	if (std::isnan(distanceprobability) != true) {
+		writer.Key(DISTANCEPROB_KEY);
+		writer.Double(distanceprobability);
+	}
+
+	// azimuth
+	if (std::isnan(azimuth) != true) {
+		writer.Key(AZIMUTH_KEY);
+		writer.Double(azimuth);
+	}
+
+	// azimuthprobability
+	if (std::isnan(azimuthprobability) != true) {
+		writer.Key(AZIMUTHPROB_KEY);
+		writer.Double(azimuthprobability);
+	}
+
+	// magnitude
+	if (std::isnan(magnitude) != true) {
+		writer.Key(MAGNITUDE_KEY);
+		writer.Double(magnitude);
+	}
+
+	// magnitude type
+	if (magnitudetype.empty() == false) {
+		writer.Key(MAGNITUDETYPE_KEY);
+		writer.String(magnitudetype.c_str(),
+						static_cast<rapidjson::SizeType>(magnitudetype.length()));
+	}
+
+	// magnitudeprobability
+	if (std::isnan(magnitudeprobability) != true) {
+		writer.Key(MAGNITUDEPROB_KEY);
+		writer.Double(magnitudeprobability);
+	}
+
+	// depth
+	if (std::isnan(depth) != true) {
+		writer.Key(DEPTH_KEY);
+		writer.Double(depth);
+	}
+
+	// depthprobability
+	if (std::isnan(depthprobability) != true) {
+		writer.Key(DEPTHPROB_KEY);
+		writer.Double(depthprobability);
+	}
+
+	// eventtype
+	if (eventtype.isempty() == false) {
+		writer.Key(EVENTTYPE_KEY);
+		eventtype.write(writer);
+	}
+
+	// eventtypeprobability
+	if (std::isnan(eventtypeprobability) != true) {
+		writer.Key(EVENTTYPEPROB_KEY);
+		writer.Double(eventtypeprobability);
+	}
+
+	// source
+	if (source.isempty() == false) {
+		writer.Key(SOURCE_KEY);
+		source.write(writer);
+	}
+
+	writer.EndObject();
+}
+
+// classification validation error text, in classerror order
+static const char *classerrorvalues[] = {
+		"Invalid phase in classification object.",
+		"Invalid distance in classification object.",
+		"Invalid azimuth in classification object.",
+		"Invalid magnitude in classification object.",
+		"Invalid depth in classification object.",
+		"EventType object did not validate in classification object:",
+		"Source object did not validate in classification object:" };
+
+errorcodes classification::validate() {
+	errorcodes errors = 0;
 
 	// optional keys
 	// phase
 	if ((phase.empty() == false) &&
 		(detectionformats::IsStringAlpha(phase) == false)) {
-		errorlist.push_back("Invalid phase in classification object.");
+		errors |= ERRORCODE(classerror::classphaseinvalid);
 	}
 
 	// distance
 	if (std::isnan(distance) == false) {
-		if ((distance < 0) || (distance >= 180)) {
-			errorlist.push_back("Invalid distance in classification object.");
+		if ((distance < 0) || (distance >= DISTANCE_MAXIMUM)) {
+			errors |= ERRORCODE(classerror::classdistanceinvalid);
 		}
 	}
 
 	// azimuth
 	if (std::isnan(azimuth) == false) {
-		if ((azimuth < 0) || (azimuth >= 360)) {
-			errorlist.push_back("Invalid azimuth in classification object.");
+		if ((azimuth < 0) || (azimuth >= AZIMUTH_MAXIMUM)) {
+			errors |= ERRORCODE(classerror::classazimuthinvalid);
 		}
 	}
 
 	// magnitude
 	if (std::isnan(magnitude) == false) {
-		if ((magnitude < -2) || (magnitude > 10)) {
-			errorlist.push_back("Invalid magnitude in classification object.");
+		if ((magnitude < MAGNITUDE_MINIMUM)
+				|| (magnitude > MAGNITUDE_MAXIMUM)) {
+			errors |= ERRORCODE(classerror::classmagnitudeinvalid);
 		}
 	}
 
 	// depth
 	if (std::isnan(depth) == false) {
-		if ((depth < -100) || (depth > 1500)) {
-			errorlist.push_back("Invalid depth in classification object.");
+		if ((depth < DEPTH_MINIMUM) || (depth > DEPTH_MAXIMUM)) {
+			errors |= ERRORCODE(classerror::classdepthinvalid);
 		}
 	}
 
 	// eventtype
-	if (eventtype.isempty() == false) {
-		if (eventtype.isvalid() != true) {
-			std::vector<std::string> eventtypeErrors = eventtype.geterrors();
-
-			std::string errorString =
-					"EventType object did not validate in classification object:";
-
-			for (int i = 0; i < eventtypeErrors.size(); i++) {
-				errorString += " " + eventtypeErrors[i];
-			}
-
-			// bad eventtype
-			errorlist.push_back(errorString);
-		}
+	if ((eventtype.isempty() == false) && (eventtype.isvalid() != true)) {
+		errors |= ERRORCODE(classerror::classeventtypeinvalid);
 	}
 
 	// source
-	if (source.isempty() == false) {
-		if (source.isvalid() != true) {
-			std::vector<std::string> sourceErrors = source.geterrors();
+	if ((source.isempty() == false) && (source.isvalid() != true)) {
+		errors |= ERRORCODE(classerror::classsourceinvalid);
+	}
 
-			std::string errorString =
-					"Source object did not validate in classification object:";
+	return (errors);
+}
+
+std::vector<std::string> classification::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
 
-			for (int i = 0; i < sourceErrors.size(); i++) {
-				errorString += " " + sourceErrors[i];
-			}
+	// render the text for each error found
+	for (int i = 0; i < classerror::classerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
 
-			// bad source
-			errorlist.push_back(errorString);
+		switch (i) {
+			case classerror::classeventtypeinvalid:
+				errorlist.push_back(
+						getmembererror(classerrorvalues[i], eventtype));
+				break;
+			case classerror::classsourceinvalid:
+				errorlist.push_back(
+						getmembererror(classerrorvalues[i], source));
+				break;
+			default:
+				errorlist.push_back(classerrorvalues[i]);
+				break;
 		}
 	}
+
 	// return the list of errors
 	return (errorlist);
 }
 
-bool classification::isempty() {
+bool classification::isempty() const {
 	if (phase.empty() == false) {
 		return (false);
 	}
@@ -0,0 +1,205 @@
+#include <codec.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace detectionformats {
+////////////// codec_context //////////////
+
+codec_context::codec_context(size_t poolsize)
+		: poolbuffer(poolsize),
+			writer(buffer) {
+	buildpool();
+}
+
+codec_context::~codec_context() {
+}
+
+void codec_context::buildpool() {
+	// the document is destroyed first, it refers to the allocator
+	document.reset();
+	poolallocator.reset(
+			new rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>(
+					poolbuffer.data(), poolbuffer.size()));
+
+	// the document takes both its values and its parse stack from the pool
+	document.reset(new codecdocument(poolallocator.get(),
+						CODEC_STACKSIZE,
+						poolallocator.get()));
+}
+
+void codec_context::reset() {
+	// drop the previous message, the pool does not free values
+	document->SetNull();
+
+	// the pool overflowed into allocated chunks, grow it so the next message
+	// of this size fits
+	if (poolallocator->Capacity() > poolbuffer.size()) {
+		size_t poolsize = poolbuffer.size() + poolallocator->Capacity();
+		document.reset();
+		poolallocator.reset();
+		std::vector<char>(poolsize).swap(poolbuffer);
+		buildpool();
+	} else {
+		poolallocator->Clear();
+	}
+}
+
+codecdocument & codec_context::parse(const std::string &jsonstring) {
+	reset();
+	document->Parse(jsonstring.c_str());
+	return (*document);
+}
+
+codecdocument & codec_context::parseinsitu(char *jsonbuffer) {
+	reset();
+	document->ParseInsitu(jsonbuffer);
+	return (*document);
+}
+
+jsonwriter & codec_context::startwriting() {
+	buffer.Clear();
+	writer.Reset(buffer);
+	return (writer);
+}
+
+size_t codec_context::getpoolsize() const {
+	return (poolbuffer.size());
+}
+
+codecdocument & codec_context::getdocument() {
+	return (*document);
+}
+
+rapidjson::Reader & codec_context::getreader() {
+	return (reader);
+}
+
+decoder & codec_context::getdecoder() {
+	return (handler);
+}
+
+validator & codec_context::getvalidator() {
+	return (checker);
+}
+
+rapidjson::StringBuffer & codec_context::getbuffer() {
+	return (buffer);
+}
+
+////////////// functions //////////////
+
+codec_context & GetCodecContext() {
+	static thread_local codec_context context;
+	return (context);
+}
+
+bool IsJSONValid(const std::string &jsonstring) {
+	return (IsJSONValid(jsonstring, GetCodecContext()));
+}
+
+bool IsJSONValid(const std::string &jsonstring,
+					codec_context &context) { // NOLINT
+	codecdocument & jsondocument = context.parse(jsonstring);
+
+	// parse error
+	if (jsondocument.HasParseError()) {
+		return (false);
+	}
+
+	// make sure we got a valid json object
+	if (jsondocument.IsObject() == false) {
+		return (false);
+	}
+
+	return (true);
+}
+
+codecdocument & FromJSONString(const std::string &jsonstring,
+								codec_context &context) { // NOLINT
+	codecdocument & jsondocument = context.parse(jsonstring);
+
+	// parse the json into a document
+	if (jsondocument.HasParseError()) {
+		throw std::invalid_argument("Error parsing JSON string into document.");
+	}
+
+	// make sure we got valid json
+	if (jsondocument.IsObject() == false) {
+		throw std::invalid_argument(
+				"JSON string did not parse into valid JSON.");
+	}
+
+	return (jsondocument);
+}
+
+// parses the provided string into the decoder target with the context reader
+static void parse(const std::string &jsonstring,
+					codec_context &context) { // NOLINT
+	rapidjson::StringStream stream(jsonstring.c_str());
+
+	// parse the json directly into the object
+	if (context.getreader().Parse(stream, context.getdecoder()).IsError()) {
+		throw std::invalid_argument("Error parsing JSON string into object.");
+	}
+}
+
+pick & FromJSONString(const std::string &jsonstring, pick &object,
+						codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+correlation & FromJSONString(const std::string &jsonstring,
+								correlation &object,
+								codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+detection & FromJSONString(const std::string &jsonstring, detection &object,
+							codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+retract & FromJSONString(const std::string &jsonstring, retract &object,
+							codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+stationInfo & FromJSONString(const std::string &jsonstring,
+								stationInfo &object,
+								codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+stationInfoRequest & FromJSONString(const std::string &jsonstring,
+									stationInfoRequest &object,
+									codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	parse(jsonstring, context);
+	return (object);
+}
+
+const char * ToJSONString(detectionbase &object,
+							codec_context &context) { // NOLINT
+	object.write(context.startwriting());
+	return (context.getbuffer().GetString());
+}
+
+const char * ToJSONString(rapidjson::Value &json,
+							codec_context &context) { // NOLINT
+	json.Accept(context.startwriting());
+	return (context.getbuffer().GetString());
+}
+}  // namespace detectionformats
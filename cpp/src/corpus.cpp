@@ -0,0 +1,565 @@
+#include <corpus.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// the station networks, channels, and locations the station list is drawn
+// from
+#define CORPUS_NETWORKS { "US", "UU", "CI", "NC", "AK", "IU", "LB", "NN" }
+#define CORPUS_NETWORKCOUNT 8
+#define CORPUS_CHANNELS { "HHZ", "BHZ", "EHZ", "HNZ" }
+#define CORPUS_CHANNELCOUNT 4
+#define CORPUS_LOCATIONS { "00", "01", "10", "" }
+#define CORPUS_LOCATIONCOUNT 4
+
+// the phases and authors messages are drawn from
+#define CORPUS_PHASES { "P", "S", "Pn", "Pg", "Sn", "Lg", "PKP", "pP" }
+#define CORPUS_PHASECOUNT 8
+#define CORPUS_AUTHORS { "TestAuthor", "glass3", "hydra", "picker" }
+#define CORPUS_AUTHORCOUNT 4
+
+// 2015-12-28T00:00:00.000Z
+#define CORPUS_STARTTIME 1451260800.0
+
+namespace detectionformats {
+static const double missing = std::numeric_limits<double>::quiet_NaN();
+static const double degrees = 180.0 / 3.14159265358979323846;
+
+// rounds a value to the provided number of decimal places, so messages hold
+// realistic numbers of digits
+static double roundto(double value, int places) {
+	double scale = std::pow(10.0, places);
+	return (std::round(value * scale) / scale);
+}
+
+// computes the distance and azimuth in degrees from the origin to the point
+static void delaz(double originlatitude, double originlongitude,
+					double latitude, double longitude, double *distance,
+					double *azimuth) {
+	double lat1 = originlatitude / degrees;
+	double lat2 = latitude / degrees;
+	double dlon = (longitude - originlongitude) / degrees;
+
+	double cosdelta = (std::sin(lat1) * std::sin(lat2))
+			+ (std::cos(lat1) * std::cos(lat2) * std::cos(dlon));
+	cosdelta = std::max(-1.0, std::min(1.0, cosdelta));
+	*distance = std::acos(cosdelta) * degrees;
+
+	*azimuth = std::atan2(std::sin(dlon) * std::cos(lat2),
+							(std::cos(lat1) * std::sin(lat2))
+							- (std::sin(lat1) * std::cos(lat2)
+							* std::cos(dlon))) * degrees;
+	if (*azimuth < 0) {
+		*azimuth += 360.0;
+	}
+}
+
+////////////// corpusoptions //////////////
+
+corpusoptions::corpusoptions() {
+	seed = 1;
+
+	mix[formattypes::picktype] = 0.85;
+	mix[formattypes::correlationtype] = 0.04;
+	mix[formattypes::detectiontype] = 0.02;
+	mix[formattypes::retracttype] = 0.01;
+	mix[formattypes::stationinfotype] = 0.07;
+	mix[formattypes::stationinforequesttype] = 0.01;
+
+	minimumdetectionpicks = 10;
+	maximumdetectionpicks = 2000;
+	optionaldensity = 0.5;
+	errorrate = 0;
+	stationcount = 2000;
+	starttime = CORPUS_STARTTIME;
+	interval = 0.05;
+}
+
+////////////// corpusgenerator //////////////
+
+corpusgenerator::corpusgenerator(const corpusoptions &newoptions)
+		: options(newoptions),
+			engine(newoptions.seed) {
+	if (options.stationcount > CORPUS_MAXSTATIONS) {
+		throw std::invalid_argument(
+				"Station count is above the station code limit.");
+	}
+	clock = options.starttime;
+	nextdetectionid = 0;
+	lasttype = formattypes::unknown;
+	lastvalid = true;
+
+	// the station list
+	static const char *networks[] = CORPUS_NETWORKS;
+	static const char *channels[] = CORPUS_CHANNELS;
+	static const char *locations[] = CORPUS_LOCATIONS;
+	int count = std::max(options.stationcount, 1);
+	stations.reserve(count);
+
+	for (int i = 0; i < count; i++) {
+		// station codes are unique, five characters at most
+		std::string station = "S";
+		for (int code = i; code > 0 || station.length() == 1; code /= 36) {
+			station += "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[code % 36];
+		}
+
+		// stations are spread over the globe, at realistic elevations
+		double latitude = roundto(std::asin(uniform(-1, 1)) * degrees, 4);
+		double longitude = roundto(uniform(-180, 180), 4);
+		double elevation = roundto(uniform(-100, 3000), 1);
+
+		stations.push_back(site(station,
+								channels[index(CORPUS_CHANNELCOUNT)],
+								networks[index(CORPUS_NETWORKCOUNT)],
+								locations[index(CORPUS_LOCATIONCOUNT)],
+								latitude, longitude, elevation));
+	}
+}
+
+corpusgenerator::~corpusgenerator() {
+}
+
+double corpusgenerator::uniform(double minimum, double maximum) {
+	// the top 53 bits of the engine, which produces the same sequence on
+	// every platform, unlike the std distributions
+	double fraction = static_cast<double>(engine() >> 11)
+			* (1.0 / 9007199254740992.0);
+	return (minimum + ((maximum - minimum) * fraction));
+}
+
+int corpusgenerator::index(int count) {
+	if (count <= 1) {
+		return (0);
+	}
+	return (static_cast<int>(engine() % static_cast<uint64_t>(count)));
+}
+
+bool corpusgenerator::chance(double probability) {
+	return (uniform(0, 1) < probability);
+}
+
+std::string corpusgenerator::makeid() {
+	static const char *digits = "0123456789ABCDEF";
+	uint64_t value = engine();
+	std::string id(16, '0');
+
+	for (int i = 15; i >= 0; i--) {
+		id[i] = digits[value & 0xF];
+		value >>= 4;
+	}
+
+	return (id);
+}
+
+double corpusgenerator::advance() {
+	clock += uniform(0, 2 * options.interval);
+	return (roundto(clock, 3));
+}
+
+source corpusgenerator::makesource() {
+	static const char *networks[] = CORPUS_NETWORKS;
+	static const char *authors[] = CORPUS_AUTHORS;
+
+	return (source(networks[index(CORPUS_NETWORKCOUNT)],
+					authors[index(CORPUS_AUTHORCOUNT)]));
+}
+
+eventtype corpusgenerator::makeeventtype() {
+	// mostly earthquakes
+	int type = eventtypeindex::earthquake;
+	if (chance(0.1) == true) {
+		type = index(eventtypeindex::eventtypecount);
+	}
+
+	return (eventtype(eventtypevalues[type],
+			eventtypecertaintyvalues[index(
+					eventtypecertaintyindex::eventtypecertaintycount)]));
+}
+
+hypocenter corpusgenerator::makehypocenter(double time) {
+	// mostly shallow
+	double depth = uniform(0, 35);
+	if (chance(0.1) == true) {
+		depth = uniform(35, 700);
+	}
+
+	return (hypocenter(roundto(std::asin(uniform(-1, 1)) * degrees, 4),
+						roundto(uniform(-180, 180), 4), time, roundto(depth, 2),
+						roundto(uniform(0, 20), 2), roundto(uniform(0, 20), 2),
+						roundto(uniform(0, 5), 3), roundto(uniform(0, 10), 2)));
+}
+
+pick corpusgenerator::makepick(const site &station, double time,
+								const hypocenter *origin) {
+	static const char *phases[] = CORPUS_PHASES;
+	double density = options.optionaldensity;
+
+	std::string phase = "";
+	if (chance(density) == true) {
+		phase = phases[index(CORPUS_PHASECOUNT)];
+	}
+
+	std::string polarity = "";
+	if (chance(density) == true) {
+		polarity = polarityvalues[index(polarityindex::polaritycount)];
+	}
+
+	std::string onset = "";
+	if (chance(density) == true) {
+		onset = onsetvalues[index(onsetindex::onsetcount)];
+	}
+
+	std::string picker = "";
+	if (chance(density) == true) {
+		picker = pickervalues[index(pickerindex::pickercount)];
+	}
+
+	std::vector<filter> filterdata;
+	if (chance(density) == true) {
+		int count = 1 + index(2);
+		for (int i = 0; i < count; i++) {
+			double highpass = roundto(uniform(0.01, 2), 2);
+			filterdata.push_back(filter("BandPass", highpass,
+										roundto(highpass + uniform(1, 10), 2),
+										"Hz"));
+		}
+	}
+
+	amplitude pickamplitude;
+	if (chance(density) == true) {
+		pickamplitude = amplitude(roundto(uniform(0.01, 1000), 3),
+									roundto(uniform(0.05, 20), 3),
+									roundto(uniform(1, 500), 2));
+	}
+
+	beam pickbeam;
+	if (chance(density * 0.2) == true) {
+		pickbeam = beam(roundto(uniform(0, 360), 2), roundto(uniform(0, 10), 2),
+						roundto(uniform(0, 20), 3), roundto(uniform(0, 2), 3),
+						roundto(uniform(0, 50), 2), roundto(uniform(0, 5), 3));
+	}
+
+	classification pickclassification;
+	if (chance(density * 0.2) == true) {
+		pickclassification = classification(phases[index(CORPUS_PHASECOUNT)],
+				roundto(uniform(0, 1), 3), roundto(uniform(0, 179), 3),
+				roundto(uniform(0, 1), 3), roundto(uniform(0, 359), 3),
+				roundto(uniform(0, 1), 3), roundto(uniform(-1, 8), 2), "Mb",
+				roundto(uniform(0, 1), 3), roundto(uniform(0, 700), 2),
+				roundto(uniform(0, 1), 3), makeeventtype(),
+				roundto(uniform(0, 1), 3), source());
+	}
+
+	// picks made for a detection are associated with its hypocenter
+	association pickassociation;
+	if (origin != NULL) {
+		double distance;
+		double azimuth;
+		delaz(origin->latitude, origin->longitude, station.latitude,
+				station.longitude, &distance, &azimuth);
+
+		if (phase.empty() == true) {
+			phase = (distance < 15) ? "Pn" : "P";
+		}
+		pickassociation = association(phase, roundto(distance, 4),
+										roundto(azimuth, 4),
+										roundto(uniform(-2, 2), 3),
+										roundto(uniform(0.5, 2), 3));
+	}
+
+	return (pick(makeid(), station, time, makesource(), phase, polarity,
+					onset, picker, filterdata, pickamplitude, pickbeam,
+					pickassociation, pickclassification));
+}
+
+bool corpusgenerator::makeinvalid(int type) {
+	lasttype = type;
+	lastvalid = (chance(options.errorrate) == false);
+	return (lastvalid == false);
+}
+
+std::string corpusgenerator::next() {
+	// choose the type from the mix
+	double total = 0;
+	for (int i = 0; i < 6; i++) {
+		total += std::max(options.mix[i], 0.0);
+	}
+
+	double choice = uniform(0, total);
+	int type = formattypes::picktype;
+	for (int i = 0; i < 6; i++) {
+		double weight = std::max(options.mix[i], 0.0);
+		if ((weight > 0) && (choice < weight)) {
+			type = i;
+			break;
+		}
+		choice -= weight;
+	}
+
+	switch (type) {
+		case formattypes::correlationtype: {
+			correlation message = nextcorrelation();
+			return (ToJSONString(message));
+		}
+		case formattypes::detectiontype: {
+			detection message = nextdetection();
+			return (ToJSONString(message));
+		}
+		case formattypes::retracttype: {
+			retract message = nextretract();
+			return (ToJSONString(message));
+		}
+		case formattypes::stationinfotype: {
+			stationInfo message = nextstationinfo();
+			return (ToJSONString(message));
+		}
+		case formattypes::stationinforequesttype: {
+			stationInfoRequest message = nextrequest();
+			return (ToJSONString(message));
+		}
+		default: {
+			pick message = nextpick();
+			return (ToJSONString(message));
+		}
+	}
+}
+
+size_t corpusgenerator::write(std::ostream &stream, size_t count) {
+	size_t bytes = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		std::string message = next();
+		stream << message << '\n';
+		bytes += message.length() + 1;
+	}
+
+	return (bytes);
+}
+
+pick corpusgenerator::nextpick() {
+	double time = advance();
+	pick message = makepick(stations[index(stations.size())], time, NULL);
+
+	if (makeinvalid(formattypes::picktype) == true) {
+		if (chance(0.5) == true) {
+			message.id = "";
+		} else {
+			message.phase = "P1";
+		}
+	}
+
+	return (message);
+}
+
+correlation corpusgenerator::makecorrelation(const site &station,
+												double time,
+												const hypocenter &origin) {
+	static const char *phases[] = CORPUS_PHASES;
+	double density = options.optionaldensity;
+
+	eventtype correlationeventtype;
+	if (chance(density) == true) {
+		correlationeventtype = makeeventtype();
+	}
+
+	double magnitude = missing;
+	if (chance(density) == true) {
+		magnitude = roundto(uniform(-1, 7), 2);
+	}
+
+	double snr = missing;
+	double zscore = missing;
+	if (chance(density) == true) {
+		snr = roundto(uniform(1, 100), 2);
+		zscore = roundto(uniform(0, 50), 2);
+	}
+
+	double threshold = missing;
+	std::string thresholdtype = "";
+	if (chance(density) == true) {
+		threshold = roundto(uniform(0.5, 5), 2);
+		thresholdtype = "minimum";
+	}
+
+	return (correlation(makeid(), station, makesource(),
+						phases[index(CORPUS_PHASECOUNT)], time,
+						roundto(uniform(0, 5), 3), origin,
+						correlationeventtype, magnitude, snr, zscore,
+						threshold, thresholdtype));
+}
+
+correlation corpusgenerator::nextcorrelation() {
+	double time = advance();
+	const site &station = stations[index(stations.size())];
+	correlation message = makecorrelation(station, time,
+			makehypocenter(roundto(time - uniform(10, 600), 3)));
+
+	if (makeinvalid(formattypes::correlationtype) == true) {
+		if (chance(0.5) == true) {
+			message.correlationvalue = -1;
+		} else {
+			message.hypocenter.latitude = missing;
+		}
+	}
+
+	return (message);
+}
+
+detection corpusgenerator::nextdetection() {
+	static const char *detectiontypes[] = { "New", "Update", "Final" };
+	double density = options.optionaldensity;
+	double time = advance();
+
+	// the picks arrive after the origin
+	hypocenter origin = makehypocenter(roundto(time - uniform(60, 900), 3));
+
+	std::string detectiontype = "";
+	double detectiontime = missing;
+	if (chance(density) == true) {
+		detectiontype = detectiontypes[index(3)];
+		detectiontime = time;
+	}
+
+	eventtype detectioneventtype;
+	if (chance(density) == true) {
+		detectioneventtype = makeeventtype();
+	}
+
+	bool statistics = chance(density);
+
+	// associated picks, timed by a rough travel time for their distance
+	int minimum = std::max(options.minimumdetectionpicks, 0);
+	int maximum = std::max(options.maximumdetectionpicks, minimum);
+	int count = minimum + index(maximum - minimum + 1);
+
+	std::vector<pick> pickdata;
+	pickdata.reserve(count);
+	double closest = 180;
+	for (int i = 0; i < count; i++) {
+		const site &station = stations[index(stations.size())];
+		double distance;
+		double azimuth;
+		delaz(origin.latitude, origin.longitude, station.latitude,
+				station.longitude, &distance, &azimuth);
+		closest = std::min(closest, distance);
+
+		double picktime = roundto(origin.time + (distance * 12.0)
+								+ uniform(-1, 1), 3);
+		pickdata.push_back(makepick(station, picktime, &origin));
+	}
+
+	std::vector<correlation> correlationdata;
+	if (chance(density * 0.2) == true) {
+		correlationdata.push_back(makecorrelation(
+				stations[index(stations.size())], time, origin));
+	}
+
+	double bayes = missing;
+	double minimumdistance = missing;
+	double rms = missing;
+	double gap = missing;
+	if (statistics == true) {
+		bayes = roundto(uniform(0, 100), 2);
+		minimumdistance = roundto(closest, 3);
+		rms = roundto(uniform(0, 3), 3);
+		gap = roundto(uniform(0, 360), 2);
+	}
+
+	std::string id = makeid();
+	detection message(id, makesource(), origin, detectiontype, detectiontime,
+						detectioneventtype, bayes, minimumdistance, rms, gap,
+						pickdata, correlationdata);
+
+	// a ring of the recent ids, for retracts
+	if (detectionids.size() < CORPUS_RETRACTIDS) {
+		detectionids.push_back(id);
+	} else {
+		detectionids[nextdetectionid] = id;
+	}
+	nextdetectionid = (nextdetectionid + 1) % CORPUS_RETRACTIDS;
+
+	if (makeinvalid(formattypes::detectiontype) == true) {
+		if ((message.pickdata.empty() == false) && (chance(0.5) == true)) {
+			message.pickdata[index(message.pickdata.size())].id = "";
+		} else {
+			message.hypocenter.latitude = 95;
+		}
+	}
+
+	return (message);
+}
+
+retract corpusgenerator::nextretract() {
+	advance();
+
+	// retract an earlier detection
+	std::string id;
+	if (detectionids.empty() == false) {
+		id = detectionids[index(detectionids.size())];
+	} else {
+		id = makeid();
+	}
+
+	retract message(id, makesource());
+
+	if (makeinvalid(formattypes::retracttype) == true) {
+		message.source.author = "";
+	}
+
+	return (message);
+}
+
+stationInfo corpusgenerator::nextstationinfo() {
+	advance();
+	const site &station = stations[index(stations.size())];
+
+	source requestor;
+	if (chance(options.optionaldensity) == true) {
+		requestor = makesource();
+	}
+
+	stationInfo message(station, roundto(uniform(0, 1), 2), chance(0.95),
+						chance(0.9), chance(0.5), requestor);
+
+	if (makeinvalid(formattypes::stationinfotype) == true) {
+		if (chance(0.5) == true) {
+			message.site.elevation = missing;
+		} else {
+			message.site.latitude = 91;
+		}
+	}
+
+	return (message);
+}
+
+stationInfoRequest corpusgenerator::nextrequest() {
+	advance();
+	const site &station = stations[index(stations.size())];
+
+	stationInfoRequest message(site(station.station, station.channel,
+									station.network, station.location),
+								makesource());
+
+	if (makeinvalid(formattypes::stationinforequesttype) == true) {
+		message.site.station = "";
+	}
+
+	return (message);
+}
+
+int corpusgenerator::getlasttype() const {
+	return (lasttype);
+}
+
+bool corpusgenerator::getlastvalid() const {
+	return (lastvalid);
+}
+
+const std::vector<site> & corpusgenerator::getstations() const {
+	return (stations);
+}
+}  // namespace detectionformats
@@ -1,25 +1,11 @@
 #include <correlation.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define ID_KEY "ID"
-#define SITE_KEY "Site"
-#define SOURCE_KEY "Source"
-#define PHASE_KEY "Phase"
-#define TIME_KEY "Time"
-#define CORRELATION_KEY "Correlation"
-#define HYPOCENTER_KEY "Hypocenter"
-#define EVENTTYPE_KEY "EventType"
-#define MAGNITUDE_KEY "Magnitude"
-#define SNR_KEY "SNR"
-#define ZSCORE_KEY "ZScore"
-#define DETECTIONTHRESHOLD_KEY "DetectionThreshold"
-#define THRESHOLDTYPE_KEY "ThresholdType"
-#define ASSOCIATIONINFO_KEY "AssociationInfo"
-
 namespace detectionformats {
 correlation::correlation() {
 	type = CORRELATION_TYPE;
@@ -55,11 +41,12 @@ correlation::correlation(std::string newid, std::string newstation,
 							double newdetectionthreshold,
 							std::string newthresholdtype) {
 	type = CORRELATION_TYPE;
-	id = newid;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation);
-	source = detectionformats::source(newagencyid, newauthor);
-	phase = newphase;
+	id = std::move(newid);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation));
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
+	phase = std::move(newphase);
 	time = newtime;
 	correlationvalue = newcorrelation;
 	hypocenter = detectionformats::hypocenter(newlatitude, newlongitude,
@@ -67,12 +54,13 @@ correlation::correlation(std::string newid, std::string newstation,
 												newlatitudeerror,
 												newlongitudeerror, newtimeerror,
 												newdeptherror);
-	eventtype = detectionformats::eventtype(neweventtype, neweventtypecertainty);
+	eventtype = detectionformats::eventtype(std::move(neweventtype),
+			std::move(neweventtypecertainty));
 	magnitude = newmagnitude;
 	snr = newsnr;
 	zscore = newzscore;
 	detectionthreshold = newdetectionthreshold;
-	thresholdtype = newthresholdtype;
+	thresholdtype = std::move(newthresholdtype);
 	associationinfo = detectionformats::association();
 }
 
@@ -97,11 +85,12 @@ correlation::correlation(std::string newid, std::string newstation,
 							double newassociationresidual,
 							double newassociationsigma) {
 	type = CORRELATION_TYPE;
-	id = newid;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation);
-	source = detectionformats::source(newagencyid, newauthor);
-	phase = newphase;
+	id = std::move(newid);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation));
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
+	phase = std::move(newphase);
 	time = newtime;
 	correlationvalue = newcorrelation;
 	hypocenter = detectionformats::hypocenter(newlatitude, newlongitude,
@@ -109,17 +98,16 @@ correlation::correlation(std::string newid, std::string newstation,
 												newlatitudeerror,
 												newlongitudeerror, newtimeerror,
 												newdeptherror);
-	eventtype = detectionformats::eventtype(neweventtype, neweventtypecertainty);
+	eventtype = detectionformats::eventtype(std::move(neweventtype),
+			std::move(neweventtypecertainty));
 	magnitude = newmagnitude;
 	snr = newsnr;
 	zscore = newzscore;
 	detectionthreshold = newdetectionthreshold;
-	thresholdtype = newthresholdtype;
-	associationinfo = detectionformats::association(newassociationphase,
-													newassociationdistance,
-													newassociationazimuth,
-													newassociationresidual,
-													newassociationsigma);
+	thresholdtype = std::move(newthresholdtype);
+	associationinfo = detectionformats::association(
+			std::move(newassociationphase), newassociationdistance,
+			newassociationazimuth, newassociationresidual, newassociationsigma);
 }
 
 correlation::correlation(std::string newid, detectionformats::site newsite,
@@ -132,19 +120,19 @@ correlation::correlation(std::string newid, detectionformats::site newsite,
 							double newdetectionthreshold,
 							std::string newthresholdtype) {
 	type = CORRELATION_TYPE;
-	id = newid;
-	site = newsite;
-	source = newsource;
-	phase = newphase;
+	id = std::move(newid);
+	site = std::move(newsite);
+	source = std::move(newsource);
+	phase = std::move(newphase);
 	time = newtime;
 	correlationvalue = newcorrelation;
-	hypocenter = newhypocenter;
-	eventtype = neweventtype;
+	hypocenter = std::move(newhypocenter);
+	eventtype = std::move(neweventtype);
 	magnitude = newmagnitude;
 	snr = newsnr;
 	zscore = newzscore;
 	detectionthreshold = newdetectionthreshold;
-	thresholdtype = newthresholdtype;
+	thresholdtype = std::move(newthresholdtype);
 	associationinfo = detectionformats::association();
 }
 
@@ -159,160 +147,160 @@ correlation::correlation(std::string newid, detectionformats::site newsite,
 							std::string newthresholdtype,
 							detectionformats::association newassociation) {
 	type = CORRELATION_TYPE;
-	id = newid;
-	site = newsite;
-	source = newsource;
-	phase = newphase;
+	id = std::move(newid);
+	site = std::move(newsite);
+	source = std::move(newsource);
+	phase = std::move(newphase);
 	time = newtime;
 	correlationvalue = newcorrelation;
-	hypocenter = newhypocenter;
-	eventtype = neweventtype;
+	hypocenter = std::move(newhypocenter);
+	eventtype = std::move(neweventtype);
 	magnitude = newmagnitude;
 	snr = newsnr;
 	zscore = newzscore;
 	detectionthreshold = newdetectionthreshold;
-	thresholdtype = newthresholdtype;
-	associationinfo = newassociation;
+	thresholdtype = std::move(newthresholdtype);
+	associationinfo = std::move(newassociation);
 }
 
 correlation::correlation(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true))
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	else
-		type = "";
-
-	// id
-	if ((json.HasMember(ID_KEY) == true) && (json[ID_KEY].IsString() == true))
-		id = std::string(json[ID_KEY].GetString(),
-							json[ID_KEY].GetStringLength());
-	else
-		id = "";
-
-	// site
-	if ((json.HasMember(SITE_KEY) == true)
-			&& (json[SITE_KEY].IsObject() == true)) {
-		rapidjson::Value & sitevalue = json["Site"];
-		site = detectionformats::site(sitevalue);
-	} else {
-		site = detectionformats::site();
-	}
-
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
-	}
-
-	// phase
-	if ((json.HasMember(PHASE_KEY) == true)
-			&& (json[PHASE_KEY].IsString() == true)) {
-		phase = std::string(json[PHASE_KEY].GetString(),
-							json[PHASE_KEY].GetStringLength());
-	} else {
-		phase = "";
-	}
-
-	// time
-	if ((json.HasMember(TIME_KEY) == true)
-			&& (json[TIME_KEY].IsString() == true)) {
-		time = detectionformats::ConvertISO8601ToEpochTime(
-				std::string(json[TIME_KEY].GetString(),
-							json[TIME_KEY].GetStringLength()));
-	} else {
-		time = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// correlation
-	if ((json.HasMember(CORRELATION_KEY) == true)
-			&& (json[CORRELATION_KEY].IsNumber() == true)
-			&& (json[CORRELATION_KEY].IsDouble() == true)) {
-		correlationvalue = json[CORRELATION_KEY].GetDouble();
-	} else {
-		correlationvalue = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// hypocenter
-	if ((json.HasMember(HYPOCENTER_KEY) == true)
-			&& (json[HYPOCENTER_KEY].IsObject() == true)) {
-		rapidjson::Value & hypocentervalue = json[HYPOCENTER_KEY];
-		hypocenter = detectionformats::hypocenter(hypocentervalue);
-	} else {
-		hypocenter = detectionformats::hypocenter();
-	}
-
-	// optional values
-	// eventtype
-	if ((json.HasMember(EVENTTYPE_KEY) == true)
-			&& (json[EVENTTYPE_KEY].IsObject() == true)) {
-		rapidjson::Value & eventtypevalue = json[EVENTTYPE_KEY];
-		eventtype = detectionformats::eventtype(eventtypevalue);
-	} else {
-		eventtype = detectionformats::eventtype();
-	}
-
-	// magnitude
-	if ((json.HasMember(MAGNITUDE_KEY) == true)
-			&& (json[MAGNITUDE_KEY].IsNumber() == true)
-			&& (json[MAGNITUDE_KEY].IsDouble() == true)) {
-		magnitude = json[MAGNITUDE_KEY].GetDouble();
-	} else {
-		magnitude = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// snr
-	if ((json.HasMember(SNR_KEY) == true) && (json[SNR_KEY].IsNumber() == true)
-			&& (json[SNR_KEY].IsDouble() == true)) {
-		snr = json[SNR_KEY].GetDouble();
-	} else {
-		snr = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// zscore
-	if ((json.HasMember(ZSCORE_KEY) == true)
-			&& (json[ZSCORE_KEY].IsNumber() == true)
-			&& (json[ZSCORE_KEY].IsDouble() == true)) {
-		zscore = json[ZSCORE_KEY].GetDouble();
-	} else {
-		zscore = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// detectionthreshold
-	if ((json.HasMember(DETECTIONTHRESHOLD_KEY) == true)
-			&& (json[DETECTIONTHRESHOLD_KEY].IsNumber() == true)
-			&& (json[DETECTIONTHRESHOLD_KEY].IsDouble() == true)) {
-		detectionthreshold = json[DETECTIONTHRESHOLD_KEY].GetDouble();
-	} else {
-		detectionthreshold = std::numeric_limits<double>::quiet_NaN();
-	}
-
-	// thresholdtype
-	if ((json.HasMember(THRESHOLDTYPE_KEY) == true)
-			&& (json[THRESHOLDTYPE_KEY].IsString() == true)) {
-		thresholdtype = std::string(json[THRESHOLDTYPE_KEY].GetString(),
-									json[THRESHOLDTYPE_KEY].GetStringLength());
-	} else {
-		thresholdtype = "";
-	}
+	// values that are missing from the json
+	type = "";
+	time = std::numeric_limits<double>::quiet_NaN();
+	correlationvalue = std::numeric_limits<double>::quiet_NaN();
+	magnitude = std::numeric_limits<double>::quiet_NaN();
+	snr = std::numeric_limits<double>::quiet_NaN();
+	zscore = std::numeric_limits<double>::quiet_NaN();
+	detectionthreshold = std::numeric_limits<double>::quiet_NaN();
 
-	// association
-	if ((json.HasMember(ASSOCIATIONINFO_KEY) == true)
-			&& (json[ASSOCIATIONINFO_KEY].IsObject() == true)) {
-		rapidjson::Value & associationvalue = json[ASSOCIATIONINFO_KEY];
-		associationinfo = detectionformats::association(associationvalue);
-	} else {
-		associationinfo = detectionformats::association();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (correlationkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case correlationkeyindex::correlationtypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// id
+			case correlationkeyindex::correlationidkey:
+				if (value.IsString() == true) {
+					id = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// site
+			case correlationkeyindex::correlationsitekey:
+				if (value.IsObject() == true) {
+					site = detectionformats::site(value);
+				}
+				break;
+
+			// source
+			case correlationkeyindex::correlationsourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
+
+			// phase
+			case correlationkeyindex::correlationphasekey:
+				if (value.IsString() == true) {
+					phase = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// time
+			case correlationkeyindex::correlationtimekey:
+				if (value.IsString() == true) {
+					time = detectionformats::ConvertISO8601ToEpochTime(
+							value.GetString(), value.GetStringLength());
+				}
+				break;
+
+			// correlation
+			case correlationkeyindex::correlationvaluekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					correlationvalue = value.GetDouble();
+				}
+				break;
+
+			// hypocenter
+			case correlationkeyindex::correlationhypocenterkey:
+				if (value.IsObject() == true) {
+					hypocenter = detectionformats::hypocenter(value);
+				}
+				break;
+
+			// optional values
+			// eventtype
+			case correlationkeyindex::correlationeventtypekey:
+				if (value.IsObject() == true) {
+					eventtype = detectionformats::eventtype(value);
+				}
+				break;
+
+			// magnitude
+			case correlationkeyindex::correlationmagnitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					magnitude = value.GetDouble();
+				}
+				break;
+
+			// snr
+			case correlationkeyindex::correlationsnrkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					snr = value.GetDouble();
+				}
+				break;
+
+			// zscore
+			case correlationkeyindex::correlationzscorekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					zscore = value.GetDouble();
+				}
+				break;
+
+			// detectionthreshold
+			case correlationkeyindex::correlationthresholdkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					detectionthreshold = value.GetDouble();
+				}
+				break;
+
+			// thresholdtype
+			case correlationkeyindex::correlationthresholdtypekey:
+				if (value.IsString() == true) {
+					thresholdtype = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// association
+			case correlationkeyindex::correlationassociationkey:
+				if (value.IsObject() == true) {
+					associationinfo = detectionformats::association(value);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
 correlation::correlation(const correlation &newcorrelation) {
-	type = CORRELATION_TYPE;
+	type = newcorrelation.type;
 	id = newcorrelation.id;
 	site = newcorrelation.site;
 	source = newcorrelation.source;
@@ -368,11 +356,12 @@ rapidjson::Value & correlation::tojson(
 	}
 
 	// time
-	if (std::isnan(time) != true) {
-		std::string timestring = detectionformats::ConvertEpochTimeToISO8601(
-				time);
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
 		rapidjson::Value timevalue;
-		timevalue.SetString(rapidjson::StringRef(timestring.c_str()),
+		timevalue.SetString(timestring,
+							static_cast<rapidjson::SizeType>(timelength),
 							allocator);
 		json.AddMember(TIME_KEY, timevalue, allocator);
 	}
@@ -428,117 +417,204 @@ rapidjson::Value & correlation::tojson(
 	return (json);
 }
 
-std::vector<std::string> correlation::geterrors() {
-	std::vector<std::string> errorlist;
+void correlation::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// id
+	if (id.empty() == false) {
+		writer.Key(ID_KEY);
+		writer.String(id.c_str(),
+						static_cast<rapidjson::SizeType>(id.length()));
+	}
+
+	// site
+	writer.Key(SITE_KEY);
+	site.write(writer);
+
+	// source
+	writer.Key(SOURCE_KEY);
+	source.write(writer);
+
+	// phase
+	if (phase.empty() == false) {
+		writer.Key(PHASE_KEY);
+		writer.String(phase.c_str(),
+						static_cast<rapidjson::SizeType>(phase.length()));
+	}
+
+	// time
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
+		writer.Key(TIME_KEY);
+		writer.String(timestring, static_cast<rapidjson::SizeType>(timelength));
+	}
+
+	// correlation
+	if (std::isnan(correlationvalue) != true) {
+		writer.Key(CORRELATION_KEY);
+		writer.Double(correlationvalue);
+	}
+
+	// hypocenter
+	writer.Key(HYPOCENTER_KEY);
+	hypocenter.write(writer);
+
+	// optional values
+	// eventtype
+	if (eventtype.isempty() == false) {
+		writer.Key(EVENTTYPE_KEY);
+		eventtype.write(writer);
+	}
+
+	// magnitude
+	if (std::isnan(magnitude) != true) {
+		writer.Key(MAGNITUDE_KEY);
+		writer.Double(magnitude);
+	}
+
+	// snr
+	if (std::isnan(snr) != true) {
+		writer.Key(SNR_KEY);
+		writer.Double(snr);
+	}
+
+	// zscore
+	if (std::isnan(zscore) != true) {
+		writer.Key(ZSCORE_KEY);
+		writer.Double(zscore);
+	}
+
+	// detectionthreshold
+	if (std::isnan(detectionthreshold) != true) {
+		writer.Key(DETECTIONTHRESHOLD_KEY);
+		writer.Double(detectionthreshold);
+	}
+
+	// thresholdtype
+	if (thresholdtype.empty() == false) {
+		writer.Key(THRESHOLDTYPE_KEY);
+		writer.String(thresholdtype.c_str(),
+						static_cast<rapidjson::SizeType>(thresholdtype.length()));
+	}
+
+	// association
+	if (associationinfo.isempty() == false) {
+		writer.Key(ASSOCIATIONINFO_KEY);
+		associationinfo.write(writer);
+	}
+
+	writer.EndObject();
+}
+
+// correlation validation error text, in correlationerror order
+static const char *correlationerrorvalues[] = {
+		"Non-correlation type in correlation class.",
+		"Empty ID in correlation class.",
+		"Site object did not validate in correlation class.",
+		"Source object did not validate in correlation class.",
+		"Empty Phase in correlation class.",
+		"Phase did not validate in correlation class.",
+		"Time is missing in correlation class.",
+		"Time did not validate in correlation class.",
+		"No Correlation in correlation class.",
+		"Invalid Correlation in correlation class.",
+		"hypocenter object did not validate in correlation class.",
+		"EventType object did not validate in detection class:",
+		"Invalid Magnitude in correlation class.",
+		"SNR in correlation class is not in the valid range of 0 to "
+			"9999999999.999",
+		"AssociationInfo object did not validate in correlation class." };
+
+errorcodes correlation::validate() {
+	errorcodes errors = 0;
 
 	// check required data
 	// Type
 	if (type != CORRELATION_TYPE) {
 		// wrong type
-		errorlist.push_back("Non-correlation type in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationtypeinvalid);
 	}
 
 	// id
 	if (id.empty() == true) {
 		// empty id
-		errorlist.push_back("Empty ID in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationidmissing);
 	}
 
 	// site
 	if (site.isvalid() != true) {
 		// site not found
-		errorlist.push_back(
-				"Site object did not validate in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationsiteinvalid);
 	}
 
 	// source
 	if (source.isvalid() != true) {
 		// bad source
-		errorlist.push_back(
-				"Source object did not validate in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationsourceinvalid);
 	}
 
 	// phase
 	if (phase.empty() == true) {
-		errorlist.push_back("Empty Phase in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationphasemissing);
 	}
 	if (detectionformats::IsStringAlpha(phase) == false) {
-		errorlist.push_back("Phase did not validate in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationphaseinvalid);
 	}
 
 	// time
 	if (std::isnan(time) == true) {
-		errorlist.push_back("Time is missing in correlation class.");
-	} else {
-		try {
-			if (detectionformats::IsStringISO8601(
-					detectionformats::ConvertEpochTimeToISO8601(time))
-					== false) {
-				errorlist.push_back(
-						"Time did not validate in correlation class.");
-			}
-		} catch (const std::exception & e) {
-			errorlist.push_back(std::string(e.what()));
-		}
+		errors |= ERRORCODE(correlationerror::correlationtimemissing);
+	} else if (detectionformats::IsEpochTimeValid(time) == false) {
+		errors |= ERRORCODE(correlationerror::correlationtimeinvalid);
 	}
 
 	// correlationvalue
 	if (std::isnan(correlationvalue) == true) {
 		// correlationvalue not found
-		errorlist.push_back("No Correlation in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationvaluemissing);
 	}
 	if (correlationvalue < 0) {
-		errorlist.push_back("Invalid Correlation in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationvalueinvalid);
 	}
 
 	// hypocenter
 	if (hypocenter.isvalid() != true) {
 		// hypocenter not found
-		errorlist.push_back(
-				"hypocenter object did not validate in correlation class.");
+		errors |= ERRORCODE(correlationerror::correlationhypocenterinvalid);
 	}
 
 	// optional data
 	// eventtype
-	if (eventtype.isempty() == false) {
-		if (eventtype.isvalid() != true) {
-			std::vector<std::string> eventtypeErrors = eventtype.geterrors();
-
-			std::string errorString =
-					"EventType object did not validate in detection class:";
-
-			for (int i = 0; i < eventtypeErrors.size(); i++) {
-				errorString += " " + eventtypeErrors[i];
-			}
-
-			// bad eventtype
-			errorlist.push_back(errorString);
-		}
+	if ((eventtype.isempty() == false) && (eventtype.isvalid() != true)) {
+		errors |= ERRORCODE(correlationerror::correlationeventtypeinvalid);
 	}
 
 	// magnitude
 	if (std::isnan(magnitude) != true) {
-		if ((magnitude < -2) || (magnitude > 10)) {
-			errorlist.push_back("Invalid Magnitude in correlation class.");
+		if ((magnitude < MAGNITUDE_MINIMUM)
+				|| (magnitude > MAGNITUDE_MAXIMUM)) {
+			errors |= ERRORCODE(correlationerror::correlationmagnitudeinvalid);
 		}
 	}
 
 	if (std::isnan(snr) != true) {
 		// Limit SNR to between 0 and 10 digits after the decimal point
-		if ((snr < 0) || (snr > 9999999999.999)) {
-			errorlist.push_back(
-					"SNR in correlation class is not in the valid range of 0 to "
-					"9999999999.999");
+		if ((snr < 0) || (snr > SNR_MAXIMUM)) {
+			errors |= ERRORCODE(correlationerror::correlationsnrinvalid);
 		}
 	}
 
 	// association
-	if (associationinfo.isempty() == false) {
-		if (associationinfo.isvalid() != true) {
-			// site not found
-			errorlist.push_back(
-					"AssociationInfo object did not validate in correlation class.");
-		}
+	if ((associationinfo.isempty() == false)
+			&& (associationinfo.isvalid() != true)) {
+		errors |= ERRORCODE(correlationerror::correlationassociationinvalid);
 	}
 
 	// since thresholdtype is a free text string, and snr, zscore, and
@@ -547,6 +623,30 @@ std::vector<std::string> correlation::geterrors() {
 	// valid, and that snr, zscore, and detectionthreshold were within expected
 	// bounds.
 
+	return (errors);
+}
+
+std::vector<std::string> correlation::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < correlationerror::correlationerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		switch (i) {
+			case correlationerror::correlationeventtypeinvalid:
+				errorlist.push_back(
+						getmembererror(correlationerrorvalues[i], eventtype));
+				break;
+			default:
+				errorlist.push_back(correlationerrorvalues[i]);
+				break;
+		}
+	}
+
 	// return the list of errors
 	return (errorlist);
 }
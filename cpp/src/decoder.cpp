@@ -0,0 +1,1010 @@
+#include <decoder.h>
+#include <codec.h>
+#include <keys.h>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace detectionformats {
+////////////// key lookup //////////////
+
+int FindObjectKey(int kind, const char *str, rapidjson::SizeType length) {
+	switch (kind) {
+		case objectkind::pickkind:
+			return (pickkeytable.find(str, length));
+		case objectkind::correlationkind:
+			return (correlationkeytable.find(str, length));
+		case objectkind::detectionkind:
+			return (detectionkeytable.find(str, length));
+		case objectkind::retractkind:
+			return (retractkeytable.find(str, length));
+		case objectkind::stationinfokind:
+			return (stationinfokeytable.find(str, length));
+		case objectkind::stationinforequestkind:
+			return (requestkeytable.find(str, length));
+		case objectkind::sitekind:
+			return (sitekeytable.find(str, length));
+		case objectkind::sourcekind:
+			return (sourcekeytable.find(str, length));
+		case objectkind::filterkind:
+			return (filterkeytable.find(str, length));
+		case objectkind::amplitudekind:
+			return (amplitudekeytable.find(str, length));
+		case objectkind::beamkind:
+			return (beamkeytable.find(str, length));
+		case objectkind::associationkind:
+			return (associationkeytable.find(str, length));
+		case objectkind::classificationkind:
+			return (classificationkeytable.find(str, length));
+		case objectkind::hypocenterkind:
+			return (hypocenterkeytable.find(str, length));
+		case objectkind::eventtypekind:
+			return (eventtypekeytable.find(str, length));
+		default:
+			return (-1);
+	}
+}
+
+////////////// member routing //////////////
+// each of these returns a pointer to the member identified by kind and key,
+// or NULL if the key does not identify a member of that type
+
+static std::string * stringmember(int kind, void *target, int key) {
+	switch (kind) {
+		case objectkind::pickkind: {
+			pick *object = static_cast<pick *>(target);
+			switch (key) {
+				case pickkeyindex::picktypekey: return (&object->type);
+				case pickkeyindex::pickidkey: return (&object->id);
+				case pickkeyindex::pickphasekey: return (&object->phase);
+				default: return (NULL);
+			}
+		}
+		case objectkind::correlationkind: {
+			correlation *object = static_cast<correlation *>(target);
+			switch (key) {
+				case correlationkeyindex::correlationtypekey:
+					return (&object->type);
+				case correlationkeyindex::correlationidkey:
+					return (&object->id);
+				case correlationkeyindex::correlationphasekey:
+					return (&object->phase);
+				case correlationkeyindex::correlationthresholdtypekey:
+					return (&object->thresholdtype);
+				default: return (NULL);
+			}
+		}
+		case objectkind::detectionkind: {
+			detection *object = static_cast<detection *>(target);
+			switch (key) {
+				case detectionkeyindex::detectiontypekey:
+					return (&object->type);
+				case detectionkeyindex::detectionidkey: return (&object->id);
+				default: return (NULL);
+			}
+		}
+		case objectkind::retractkind: {
+			retract *object = static_cast<retract *>(target);
+			switch (key) {
+				case retractkeyindex::retracttypekey: return (&object->type);
+				case retractkeyindex::retractidkey: return (&object->id);
+				default: return (NULL);
+			}
+		}
+		case objectkind::stationinfokind: {
+			stationInfo *object = static_cast<stationInfo *>(target);
+			if (key == stationinfokeyindex::stationinfotypekey) {
+				return (&object->type);
+			}
+			return (NULL);
+		}
+		case objectkind::stationinforequestkind: {
+			stationInfoRequest *object =
+					static_cast<stationInfoRequest *>(target);
+			if (key == stationinforequestkeyindex::requesttypekey) {
+				return (&object->type);
+			}
+			return (NULL);
+		}
+		case objectkind::sitekind: {
+			site *object = static_cast<site *>(target);
+			switch (key) {
+				case sitekeyindex::sitestationkey: return (&object->station);
+				case sitekeyindex::sitechannelkey: return (&object->channel);
+				case sitekeyindex::sitenetworkkey: return (&object->network);
+				case sitekeyindex::sitelocationkey: return (&object->location);
+				default: return (NULL);
+			}
+		}
+		case objectkind::sourcekind: {
+			source *object = static_cast<source *>(target);
+			switch (key) {
+				case sourcekeyindex::sourceagencyidkey:
+					return (&object->agencyid);
+				case sourcekeyindex::sourceauthorkey: return (&object->author);
+				default: return (NULL);
+			}
+		}
+		case objectkind::filterkind: {
+			filter *object = static_cast<filter *>(target);
+			switch (key) {
+				case filterkeyindex::filtertypekey: return (&object->type);
+				case filterkeyindex::filterunitskey: return (&object->units);
+				default: return (NULL);
+			}
+		}
+		case objectkind::associationkind: {
+			association *object = static_cast<association *>(target);
+			if (key == associationkeyindex::associationphasekey) {
+				return (&object->phase);
+			}
+			return (NULL);
+		}
+		case objectkind::classificationkind: {
+			classification *object = static_cast<classification *>(target);
+			switch (key) {
+				case classificationkeyindex::classphasekey:
+					return (&object->phase);
+				case classificationkeyindex::classmagnitudetypekey:
+					return (&object->magnitudetype);
+				default: return (NULL);
+			}
+		}
+		default:
+			return (NULL);
+	}
+}
+
+// sets the enum member identified by kind and key from its string value,
+// returns false if the key does not identify an enum member
+static bool setenummember(int kind, void *target, int key, const char *str,
+							rapidjson::SizeType length) {
+	switch (kind) {
+		case objectkind::pickkind: {
+			pick *object = static_cast<pick *>(target);
+			switch (key) {
+				case pickkeyindex::pickpolaritykey:
+					object->polarity = GetPolarityIndex(str, length);
+					SetUnknownText(object->polarity, str, length,
+									&object->polaritytext);
+					return (true);
+				case pickkeyindex::pickonsetkey:
+					object->onset = GetOnsetIndex(str, length);
+					SetUnknownText(object->onset, str, length,
+									&object->onsettext);
+					return (true);
+				case pickkeyindex::pickpickerkey:
+					object->picker = GetPickerIndex(str, length);
+					SetUnknownText(object->picker, str, length,
+									&object->pickertext);
+					return (true);
+				default: return (false);
+			}
+		}
+		case objectkind::detectionkind:
+			if (key == detectionkeyindex::detectiondetectiontypekey) {
+				detection *object = static_cast<detection *>(target);
+				object->detectiontype = GetDetectionTypeIndex(str, length);
+				SetUnknownText(object->detectiontype, str, length,
+								&object->detectiontypetext);
+				return (true);
+			}
+			return (false);
+		case objectkind::eventtypekind: {
+			eventtype *object = static_cast<eventtype *>(target);
+			switch (key) {
+				case eventtypekeyindex::eventtypetypekey:
+					object->type = GetEventTypeIndex(str, length);
+					SetUnknownText(object->type, str, length,
+									&object->typetext);
+					return (true);
+				case eventtypekeyindex::eventtypecertaintykey:
+					object->certainty = GetEventTypeCertaintyIndex(str, length);
+					SetUnknownText(object->certainty, str, length,
+									&object->certaintytext);
+					return (true);
+				default: return (false);
+			}
+		}
+		default:
+			return (false);
+	}
+}
+
+static double * timemember(int kind, void *target, int key) {
+	switch (kind) {
+		case objectkind::pickkind:
+			if (key == pickkeyindex::picktimekey) {
+				return (&static_cast<pick *>(target)->time);
+			}
+			return (NULL);
+		case objectkind::correlationkind:
+			if (key == correlationkeyindex::correlationtimekey) {
+				return (&static_cast<correlation *>(target)->time);
+			}
+			return (NULL);
+		case objectkind::detectionkind:
+			if (key == detectionkeyindex::detectiontimekey) {
+				return (&static_cast<detection *>(target)->detectiontime);
+			}
+			return (NULL);
+		case objectkind::hypocenterkind:
+			if (key == hypocenterkeyindex::hypotimekey) {
+				return (&static_cast<hypocenter *>(target)->time);
+			}
+			return (NULL);
+		default:
+			return (NULL);
+	}
+}
+
+static double * numbermember(int kind, void *target, int key) {
+	switch (kind) {
+		case objectkind::correlationkind: {
+			correlation *object = static_cast<correlation *>(target);
+			switch (key) {
+				case correlationkeyindex::correlationvaluekey:
+					return (&object->correlationvalue);
+				case correlationkeyindex::correlationmagnitudekey:
+					return (&object->magnitude);
+				case correlationkeyindex::correlationsnrkey:
+					return (&object->snr);
+				case correlationkeyindex::correlationzscorekey:
+					return (&object->zscore);
+				case correlationkeyindex::correlationthresholdkey:
+					return (&object->detectionthreshold);
+				default: return (NULL);
+			}
+		}
+		case objectkind::detectionkind: {
+			detection *object = static_cast<detection *>(target);
+			switch (key) {
+				case detectionkeyindex::detectionbayeskey:
+					return (&object->bayes);
+				case detectionkeyindex::detectionmindistkey:
+					return (&object->minimumdistance);
+				case detectionkeyindex::detectionrmskey: return (&object->rms);
+				case detectionkeyindex::detectiongapkey: return (&object->gap);
+				default: return (NULL);
+			}
+		}
+		case objectkind::stationinfokind:
+			if (key == stationinfokeyindex::stationinfoqualitykey) {
+				return (&static_cast<stationInfo *>(target)->quality);
+			}
+			return (NULL);
+		case objectkind::sitekind: {
+			site *object = static_cast<site *>(target);
+			switch (key) {
+				case sitekeyindex::sitelatitudekey: return (&object->latitude);
+				case sitekeyindex::sitelongitudekey:
+					return (&object->longitude);
+				case sitekeyindex::siteelevationkey:
+					return (&object->elevation);
+				default: return (NULL);
+			}
+		}
+		case objectkind::filterkind: {
+			filter *object = static_cast<filter *>(target);
+			switch (key) {
+				case filterkeyindex::filterhighpasskey:
+					return (&object->highpass);
+				case filterkeyindex::filterlowpasskey:
+					return (&object->lowpass);
+				default: return (NULL);
+			}
+		}
+		case objectkind::amplitudekind: {
+			amplitude *object = static_cast<amplitude *>(target);
+			switch (key) {
+				case amplitudekeyindex::amplitudevaluekey:
+					return (&object->ampvalue);
+				case amplitudekeyindex::amplitudeperiodkey:
+					return (&object->period);
+				case amplitudekeyindex::amplitudesnrkey: return (&object->snr);
+				default: return (NULL);
+			}
+		}
+		case objectkind::beamkind: {
+			beam *object = static_cast<beam *>(target);
+			switch (key) {
+				case beamkeyindex::beambackazimuthkey:
+					return (&object->backazimuth);
+				case beamkeyindex::beamslownesskey: return (&object->slowness);
+				case beamkeyindex::beampowerratiokey:
+					return (&object->powerratio);
+				case beamkeyindex::beambackazimutherrorkey:
+					return (&object->backazimutherror);
+				case beamkeyindex::beamslownesserrorkey:
+					return (&object->slownesserror);
+				case beamkeyindex::beampowerratioerrorkey:
+					return (&object->powerratioerror);
+				default: return (NULL);
+			}
+		}
+		case objectkind::associationkind: {
+			association *object = static_cast<association *>(target);
+			switch (key) {
+				case associationkeyindex::associationdistancekey:
+					return (&object->distance);
+				case associationkeyindex::associationazimuthkey:
+					return (&object->azimuth);
+				case associationkeyindex::associationresidualkey:
+					return (&object->residual);
+				case associationkeyindex::associationsigmakey:
+					return (&object->sigma);
+				default: return (NULL);
+			}
+		}
+		case objectkind::classificationkind: {
+			classification *object = static_cast<classification *>(target);
+			switch (key) {
+				case classificationkeyindex::classphaseprobkey:
+					return (&object->phaseprobability);
+				case classificationkeyindex::classdistancekey:
+					return (&object->distance);
+				case classificationkeyindex::classdistanceprobkey:
+					return (&object->distanceprobability);
+				case classificationkeyindex::classazimuthkey:
+					return (&object->azimuth);
+				case classificationkeyindex::classazimuthprobkey:
+					return (&object->azimuthprobability);
+				case classificationkeyindex::classmagnitudekey:
+					return (&object->magnitude);
+				case classificationkeyindex::classmagnitudeprobkey:
+					return (&object->magnitudeprobability);
+				case classificationkeyindex::classdepthkey:
+					return (&object->depth);
+				case classificationkeyindex::classdepthprobkey:
+					return (&object->depthprobability);
+				case classificationkeyindex::classeventtypeprobkey:
+					return (&object->eventtypeprobability);
+				default: return (NULL);
+			}
+		}
+		case objectkind::hypocenterkind: {
+			hypocenter *object = static_cast<hypocenter *>(target);
+			switch (key) {
+				case hypocenterkeyindex::hypolatitudekey:
+					return (&object->latitude);
+				case hypocenterkeyindex::hypolongitudekey:
+					return (&object->longitude);
+				case hypocenterkeyindex::hypodepthkey: return (&object->depth);
+				case hypocenterkeyindex::hypolatitudeerrorkey:
+					return (&object->latitudeerror);
+				case hypocenterkeyindex::hypolongitudeerrorkey:
+					return (&object->longitudeerror);
+				case hypocenterkeyindex::hypodeptherrorkey:
+					return (&object->deptherror);
+				case hypocenterkeyindex::hypotimeerrorkey:
+					return (&object->timeerror);
+				default: return (NULL);
+			}
+		}
+		default:
+			return (NULL);
+	}
+}
+
+static bool * boolmember(int kind, void *target, int key) {
+	if (kind != objectkind::stationinfokind) {
+		return (NULL);
+	}
+
+	stationInfo *object = static_cast<stationInfo *>(target);
+	switch (key) {
+		case stationinfokeyindex::stationinfoenablekey:
+			return (&object->enable);
+		case stationinfokeyindex::stationinfousekey:
+			return (&object->use);
+		case stationinfokeyindex::stationinfoteleseismickey:
+			return (&object->useforteleseismic);
+		default:
+			return (NULL);
+	}
+}
+
+// returns the sub-object identified by kind and key, setting childkind to
+// its object kind, or NULL if the key does not identify an object member
+static void * objectmember(int kind, void *target, int key, int *childkind) {
+	*childkind = objectkind::unknownkind;
+
+	switch (kind) {
+		case objectkind::pickkind: {
+			pick *object = static_cast<pick *>(target);
+			switch (key) {
+				case pickkeyindex::picksitekey:
+					*childkind = objectkind::sitekind;
+					return (&object->site);
+				case pickkeyindex::picksourcekey:
+					*childkind = objectkind::sourcekind;
+					return (&object->source);
+				case pickkeyindex::pickamplitudekey:
+					*childkind = objectkind::amplitudekind;
+					return (&object->amplitude);
+				case pickkeyindex::pickbeamkey:
+					*childkind = objectkind::beamkind;
+					return (&object->beam);
+				case pickkeyindex::pickassociationkey:
+					*childkind = objectkind::associationkind;
+					return (&object->associationinfo);
+				case pickkeyindex::pickclassificationkey:
+					*childkind = objectkind::classificationkind;
+					return (&object->classificationinfo);
+				default: return (NULL);
+			}
+		}
+		case objectkind::correlationkind: {
+			correlation *object = static_cast<correlation *>(target);
+			switch (key) {
+				case correlationkeyindex::correlationsitekey:
+					*childkind = objectkind::sitekind;
+					return (&object->site);
+				case correlationkeyindex::correlationsourcekey:
+					*childkind = objectkind::sourcekind;
+					return (&object->source);
+				case correlationkeyindex::correlationhypocenterkey:
+					*childkind = objectkind::hypocenterkind;
+					return (&object->hypocenter);
+				case correlationkeyindex::correlationeventtypekey:
+					*childkind = objectkind::eventtypekind;
+					return (&object->eventtype);
+				case correlationkeyindex::correlationassociationkey:
+					*childkind = objectkind::associationkind;
+					return (&object->associationinfo);
+				default: return (NULL);
+			}
+		}
+		case objectkind::detectionkind: {
+			detection *object = static_cast<detection *>(target);
+			switch (key) {
+				case detectionkeyindex::detectionsourcekey:
+					*childkind = objectkind::sourcekind;
+					return (&object->source);
+				case detectionkeyindex::detectionhypocenterkey:
+					*childkind = objectkind::hypocenterkind;
+					return (&object->hypocenter);
+				case detectionkeyindex::detectioneventtypekey:
+					*childkind = objectkind::eventtypekind;
+					return (&object->eventtype);
+				default: return (NULL);
+			}
+		}
+		case objectkind::retractkind:
+			if (key == retractkeyindex::retractsourcekey) {
+				*childkind = objectkind::sourcekind;
+				return (&static_cast<retract *>(target)->source);
+			}
+			return (NULL);
+		case objectkind::stationinfokind: {
+			stationInfo *object = static_cast<stationInfo *>(target);
+			switch (key) {
+				case stationinfokeyindex::stationinfositekey:
+					*childkind = objectkind::sitekind;
+					return (&object->site);
+				case stationinfokeyindex::stationinforequestorkey:
+					*childkind = objectkind::sourcekind;
+					return (&object->informationRequestor);
+				default: return (NULL);
+			}
+		}
+		case objectkind::stationinforequestkind: {
+			stationInfoRequest *object =
+					static_cast<stationInfoRequest *>(target);
+			switch (key) {
+				case stationinforequestkeyindex::requestsitekey:
+					*childkind = objectkind::sitekind;
+					return (&object->site);
+				case stationinforequestkeyindex::requestsourcekey:
+					*childkind = objectkind::sourcekind;
+					return (&object->source);
+				default: return (NULL);
+			}
+		}
+		case objectkind::classificationkind: {
+			classification *object = static_cast<classification *>(target);
+			switch (key) {
+				case classificationkeyindex::classeventtypekey:
+					*childkind = objectkind::eventtypekind;
+					return (&object->eventtype);
+				case classificationkeyindex::classsourcekey:
+					*childkind = objectkind::sourcekind;
+					return (&object->source);
+				default: return (NULL);
+			}
+		}
+		default:
+			return (NULL);
+	}
+}
+
+// returns the array member identified by kind and key, setting childkind to
+// its array kind, or NULL if the key does not identify an array member
+static void * arraymember(int kind, void *target, int key, int *childkind) {
+	*childkind = objectkind::unknownkind;
+
+	if ((kind == objectkind::pickkind)
+			&& (key == pickkeyindex::pickfilterkey)) {
+		*childkind = objectkind::filterarraykind;
+		return (&static_cast<pick *>(target)->filterdata);
+	} else if ((kind == objectkind::detectionkind)
+			&& (key == detectionkeyindex::detectiondatakey)) {
+		*childkind = objectkind::dataarraykind;
+		return (target);
+	}
+
+	return (NULL);
+}
+
+// empty objects that targets are reset from, copy assignment keeps the
+// capacity of the strings and vectors being reset
+static const pick emptypick;
+static const correlation emptycorrelation;
+static const detection emptydetection;
+static const retract emptyretract;
+static const stationInfo emptystationinfo;
+static const stationInfoRequest emptyrequest;
+
+// resets a top level object to the values its rapidjson::Value constructor
+// produces for an empty json object
+static void resetobject(int kind, void *target) {
+	switch (kind) {
+		case objectkind::pickkind:
+			*static_cast<pick *>(target) = emptypick;
+			static_cast<pick *>(target)->type = "";
+			break;
+		case objectkind::correlationkind:
+			*static_cast<correlation *>(target) = emptycorrelation;
+			static_cast<correlation *>(target)->type = "";
+			break;
+		case objectkind::detectionkind: {
+			// the Data elements are kept so that they are decoded into again,
+			// the decoder truncates them to the number decoded
+			detection *object = static_cast<detection *>(target);
+			std::vector<pick> pickdata;
+			std::vector<correlation> correlationdata;
+			pickdata.swap(object->pickdata);
+			correlationdata.swap(object->correlationdata);
+			*object = emptydetection;
+			object->type = "";
+			object->pickdata.swap(pickdata);
+			object->correlationdata.swap(correlationdata);
+			break;
+		}
+		case objectkind::retractkind:
+			*static_cast<retract *>(target) = emptyretract;
+			static_cast<retract *>(target)->type = "";
+			break;
+		case objectkind::stationinfokind:
+			*static_cast<stationInfo *>(target) = emptystationinfo;
+			static_cast<stationInfo *>(target)->type = "";
+			break;
+		case objectkind::stationinforequestkind:
+			*static_cast<stationInfoRequest *>(target) = emptyrequest;
+			static_cast<stationInfoRequest *>(target)->type = "";
+			break;
+		default:
+			break;
+	}
+}
+
+// returns the data element at index reset to empty, adding the spare
+// element if the detection does not have one there yet. Resetting by copy
+// assignment keeps the capacity of the strings and vectors of the element
+template<class T>
+static T * getdataelement(std::vector<T> *data, size_t index, // NOLINT
+							T *spare, const T &empty) {
+	if (index >= data->size()) {
+		data->push_back(std::move(*spare));
+	}
+	T *element = &(*data)[index];
+	*element = empty;
+	element->type = "";
+	return (element);
+}
+
+// truncates the data elements to count, keeping the first element past
+// count as the spare, so that it is not freed and allocated again by the
+// next detection
+template<class T>
+static void truncatedataelements(std::vector<T> *data, size_t count, // NOLINT
+									T *spare) {
+	if (data->size() > count) {
+		std::swap((*data)[count], *spare);
+		data->resize(count);
+	}
+}
+
+////////////// decoder //////////////
+
+decoder::decoder() {
+	rootkind = objectkind::unknownkind;
+	roottarget = NULL;
+	depth = 0;
+	skipdepth = 0;
+	datapickcount = 0;
+	datacorrelationcount = 0;
+	datapicktarget = NULL;
+	datacorrelationtarget = NULL;
+}
+
+decoder::~decoder() {
+}
+
+void decoder::settarget(pick *object) {
+	rootkind = objectkind::pickkind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+void decoder::settarget(correlation *object) {
+	rootkind = objectkind::correlationkind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+void decoder::settarget(detection *object) {
+	rootkind = objectkind::detectionkind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+void decoder::settarget(retract *object) {
+	rootkind = objectkind::retractkind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+void decoder::settarget(stationInfo *object) {
+	rootkind = objectkind::stationinfokind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+void decoder::settarget(stationInfoRequest *object) {
+	rootkind = objectkind::stationinforequestkind;
+	roottarget = object;
+	depth = 0;
+	skipdepth = 0;
+}
+
+bool decoder::push(int kind, void *target) {
+	// too deep, skip this object or array
+	if (depth >= DECODER_MAXDEPTH) {
+		skipdepth++;
+		return (true);
+	}
+
+	frame & newframe = stack[depth++];
+	newframe.kind = kind;
+	newframe.target = target;
+	newframe.memberkind = kind;
+	newframe.member = target;
+	newframe.key = -1;
+
+	return (true);
+}
+
+bool decoder::Null() {
+	if ((skipdepth == 0) && (depth > 0)) {
+		stack[depth - 1].key = -1;
+	}
+
+	// null values leave members at their defaults
+	return (depth > 0);
+}
+
+bool decoder::Bool(bool value) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+	bool *member = boolmember(current.memberkind, current.member, current.key);
+	if (member != NULL) {
+		*member = value;
+	}
+	current.key = -1;
+
+	return (true);
+}
+
+bool decoder::Int(int value) {
+	return (number(static_cast<double>(value), false, true));
+}
+
+bool decoder::Uint(unsigned value) {
+	return (number(static_cast<double>(value), false,
+					value <= static_cast<unsigned>(
+						std::numeric_limits<int>::max())));
+}
+
+bool decoder::Int64(int64_t value) {
+	return (number(static_cast<double>(value), false, false));
+}
+
+bool decoder::Uint64(uint64_t value) {
+	return (number(static_cast<double>(value), false, false));
+}
+
+bool decoder::Double(double value) {
+	return (number(value, true, false));
+}
+
+bool decoder::RawNumber(const char *, rapidjson::SizeType, bool) {
+	// only called with kParseNumbersAsStringsFlag, which the decoder does not
+	// use
+	return (false);
+}
+
+bool decoder::number(double value, bool isdouble, bool isint) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+	double *member = numbermember(current.memberkind, current.member,
+									current.key);
+	if (member != NULL) {
+		if (isdouble == true) {
+			*member = value;
+		} else if ((isint == true)
+				&& (current.memberkind == objectkind::classificationkind)
+				&& ((current.key == classificationkeyindex::classdistancekey)
+				|| (current.key == classificationkeyindex::classazimuthkey))) {
+			// classification distance and azimuth also accept integers
+			*member = value;
+		}
+	}
+	current.key = -1;
+
+	return (true);
+}
+
+bool decoder::String(const char *str, rapidjson::SizeType length, bool) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+	std::string *member = stringmember(current.memberkind, current.member,
+										current.key);
+	if (member != NULL) {
+		member->assign(str, length);
+	} else if (setenummember(current.memberkind, current.member, current.key,
+								str, length) == false) {
+		double *time = timemember(current.memberkind, current.member,
+									current.key);
+		if (time != NULL) {
+			*time = detectionformats::ConvertISO8601ToEpochTime(str, length);
+		}
+	}
+	current.key = -1;
+
+	return (true);
+}
+
+bool decoder::StartObject() {
+	if (skipdepth > 0) {
+		skipdepth++;
+		return (true);
+	}
+
+	// root object
+	if (depth == 0) {
+		if (roottarget == NULL) {
+			return (false);
+		}
+		resetobject(rootkind, roottarget);
+		datapickcount = 0;
+		datacorrelationcount = 0;
+		return (push(rootkind, roottarget));
+	}
+
+	frame & current = stack[depth - 1];
+
+	// array elements
+	if (current.kind == objectkind::filterarraykind) {
+		std::vector<filter> *filterdata =
+				static_cast<std::vector<filter> *>(current.target);
+		filterdata->push_back(filter());
+		return (push(objectkind::filterkind, &filterdata->back()));
+	} else if (current.kind == objectkind::dataarraykind) {
+		// the type of a data element is not known until its Type key is
+		// found, so decode into both the next pick and the next correlation
+		// of the detection, only the one of its type is kept
+		detection *object = static_cast<detection *>(current.target);
+		datapicktarget = getdataelement(&object->pickdata, datapickcount,
+										&datapick, emptypick);
+		datacorrelationtarget = getdataelement(&object->correlationdata,
+												datacorrelationcount,
+												&datacorrelation,
+												emptycorrelation);
+		return (push(objectkind::datakind, current.target));
+	}
+
+	// object members
+	int childkind;
+	void *child = objectmember(current.memberkind, current.member,
+								current.key, &childkind);
+	current.key = -1;
+
+	if (child == NULL) {
+		// unknown or mistyped member, skip it
+		skipdepth++;
+		return (true);
+	}
+
+	return (push(childkind, child));
+}
+
+bool decoder::Key(const char *str, rapidjson::SizeType length, bool) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+
+	frame & current = stack[depth - 1];
+
+	if (current.kind == objectkind::datakind) {
+		// keys shared by picks and correlations are decoded into the pick and
+		// moved if the element turns out to be a correlation
+		current.key = FindObjectKey(objectkind::pickkind, str, length);
+		if (current.key >= 0) {
+			current.memberkind = objectkind::pickkind;
+			current.member = datapicktarget;
+		} else {
+			current.key = FindObjectKey(objectkind::correlationkind, str,
+										length);
+			current.memberkind = objectkind::correlationkind;
+			current.member = datacorrelationtarget;
+		}
+	} else {
+		current.key = FindObjectKey(current.kind, str, length);
+	}
+
+	return (true);
+}
+
+bool decoder::EndObject(rapidjson::SizeType) {
+	if (skipdepth > 0) {
+		skipdepth--;
+		return (true);
+	}
+
+	frame & current = stack[--depth];
+
+	// route finished data elements based on their type
+	if (current.kind == objectkind::datakind) {
+		// the pick is reset when the next element starts, so the members
+		// shared with a correlation are swapped rather than copied
+		pick *element = datapicktarget;
+		correlation *correlationelement = datacorrelationtarget;
+		if (element->type == PICK_TYPE) {
+			datapickcount++;
+		} else if (element->type == CORRELATION_TYPE) {
+			std::swap(correlationelement->type, element->type);
+			std::swap(correlationelement->id, element->id);
+			std::swap(correlationelement->site, element->site);
+			std::swap(correlationelement->source, element->source);
+			std::swap(correlationelement->phase, element->phase);
+			correlationelement->time = element->time;
+			std::swap(correlationelement->associationinfo,
+						element->associationinfo);
+			datacorrelationcount++;
+		}
+	} else if ((depth == 0) && (current.kind == objectkind::detectionkind)) {
+		// truncated here as well, for a detection without a Data array
+		truncatedata(static_cast<detection *>(current.target));
+	}
+
+	return (true);
+}
+
+void decoder::truncatedata(detection *object) {
+	truncatedataelements(&object->pickdata, datapickcount, &datapick);
+	truncatedataelements(&object->correlationdata, datacorrelationcount,
+							&datacorrelation);
+}
+
+bool decoder::StartArray() {
+	if (skipdepth > 0) {
+		skipdepth++;
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+
+	// nested arrays are not part of any format
+	if ((current.kind == objectkind::filterarraykind)
+			|| (current.kind == objectkind::dataarraykind)) {
+		skipdepth++;
+		return (true);
+	}
+
+	int childkind;
+	void *child = arraymember(current.memberkind, current.member, current.key,
+								&childkind);
+	current.key = -1;
+
+	if (child == NULL) {
+		// unknown or mistyped member, skip it
+		skipdepth++;
+		return (true);
+	}
+
+	return (push(childkind, child));
+}
+
+bool decoder::EndArray(rapidjson::SizeType) {
+	if (skipdepth > 0) {
+		skipdepth--;
+		return (true);
+	}
+
+	frame & current = stack[--depth];
+
+	// drop the elements left from a longer Data array decoded before
+	if (current.kind == objectkind::dataarraykind) {
+		truncatedata(static_cast<detection *>(current.target));
+	}
+
+	return (true);
+}
+
+////////////// functions //////////////
+
+// the functions without a context decode with the decoder and reader of the
+// thread context, so that its scratch pick and correlation are built once
+pick & FromJSONString(const std::string &jsonstring, pick &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+
+correlation & FromJSONString(const std::string &jsonstring,
+								correlation &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+
+detection & FromJSONString(const std::string &jsonstring,
+							detection &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+
+retract & FromJSONString(const std::string &jsonstring,
+							retract &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+
+stationInfo & FromJSONString(const std::string &jsonstring,
+								stationInfo &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+
+stationInfoRequest & FromJSONString(const std::string &jsonstring,
+									stationInfoRequest &object) { // NOLINT
+	return (FromJSONString(jsonstring, object, GetCodecContext()));
+}
+}  // namespace detectionformats
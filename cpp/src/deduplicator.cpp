@@ -0,0 +1,229 @@
+#include <deduplicator.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace detectionformats {
+// folds characters into a 64 bit FNV-1a hash
+static uint64_t hashbytes(uint64_t hash, const char *str, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		hash ^= static_cast<unsigned char>(str[i]);
+		hash *= 0x100000001B3ULL;
+	}
+
+	// separate the strings, so that moving characters between them changes
+	// the hash
+	hash ^= 0xFF;
+	hash *= 0x100000001B3ULL;
+	return (hash);
+}
+
+// hashes the phase and source of a pick
+static uint64_t hashtag(const char *phase, size_t phaselength,
+						const char *agencyid, size_t agencyidlength,
+						const char *author, size_t authorlength) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hash = hashbytes(hash, phase, phaselength);
+	hash = hashbytes(hash, agencyid, agencyidlength);
+	hash = hashbytes(hash, author, authorlength);
+	return (hash);
+}
+
+// mixes a key, tag, and bucket into a table position, see the murmur3
+// finalizer
+static uint64_t hashslot(const site_key &key, uint64_t tag, int64_t bucket) {
+	uint64_t hash = key.gethash() ^ tag
+			^ (static_cast<uint64_t>(bucket) * 0x9E3779B97F4A7C15ULL);
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	return (hash);
+}
+
+// the largest time bucket number, well inside an int64_t so that the buckets
+// next to it are too
+static const double maximumbucket = 4.0e18;
+
+////////////// generation //////////////
+
+void pick_deduplicator::generation::clear() {
+	stamp++;
+	count = 0;
+	starttime = std::numeric_limits<double>::quiet_NaN();
+}
+
+////////////// pick_deduplicator //////////////
+
+pick_deduplicator::pick_deduplicator(double newtolerance, double newwindow,
+										size_t newmaxentries)
+		: tolerance(newtolerance),
+			window(newwindow),
+			maxentries(newmaxentries > 0 ? newmaxentries : 1),
+			currenttable(0),
+			offered(0),
+			duplicates(0) {
+	// the time is divided by the tolerance for its bucket, and compared with
+	// the window, so both need to be positive numbers
+	if ((std::isfinite(tolerance) == false) || (tolerance <= 0)) {
+		throw std::invalid_argument(
+				"Deduplicator tolerance must be a positive number.");
+	}
+	if ((std::isfinite(window) == false) || (window <= 0)) {
+		throw std::invalid_argument(
+				"Deduplicator window must be a positive number.");
+	}
+	if (maxentries > (std::numeric_limits<size_t>::max() / 4)
+			/ sizeof(entry)) {
+		throw std::invalid_argument(
+				"Deduplicator largest number of picks is too large.");
+	}
+
+	// keep each generation at most half full
+	size_t slots = 2;
+	while (slots < maxentries * 2) {
+		slots *= 2;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		// new entries are zeroed, so stamp 0 marks them empty
+		tables[i].mask = slots - 1;
+		tables[i].stamp = 0;
+		tables[i].entries.reset(new entry[slots]());
+		tables[i].clear();
+	}
+}
+
+pick_deduplicator::~pick_deduplicator() {
+}
+
+bool pick_deduplicator::offer(const pick &object, uint64_t *retained) {
+	return (offer(site_key(object.site),
+					hashtag(object.phase.data(), object.phase.length(),
+							object.source.agencyid.data(),
+							object.source.agencyid.length(),
+							object.source.author.data(),
+							object.source.author.length()),
+					object.time, retained));
+}
+
+bool pick_deduplicator::offer(const pick_view &view, uint64_t *retained) {
+	return (offer(site_key(view.site),
+					hashtag(view.phase.data(), view.phase.size(),
+							view.source.agencyid.data(),
+							view.source.agencyid.size(),
+							view.source.author.data(),
+							view.source.author.size()),
+					view.time, retained));
+}
+
+const pick_deduplicator::entry * pick_deduplicator::find(
+		const generation &table, const site_key &key, uint64_t tag,
+		double time) const {
+	if (table.count == 0) {
+		return (NULL);
+	}
+
+	// a duplicate is in this bucket or one next to it
+	int64_t bucket = static_cast<int64_t>(std::floor(time / tolerance));
+	for (int64_t candidate = bucket - 1; candidate <= bucket + 1;
+			candidate++) {
+		for (size_t i = hashslot(key, tag, candidate) & table.mask;;
+				i = (i + 1) & table.mask) {
+			const entry & slot = table.entries[i];
+			if (slot.stamp != table.stamp) {
+				break;
+			}
+			if ((slot.bucket == candidate) && (slot.tag == tag)
+					&& (slot.key == key)) {
+				if (std::fabs(slot.time - time) <= tolerance) {
+					return (&slot);
+				}
+				break;
+			}
+		}
+	}
+
+	return (NULL);
+}
+
+bool pick_deduplicator::offer(const site_key &key, uint64_t tag, double time,
+								uint64_t *retained) {
+	uint64_t number = offered++;
+	if (retained != NULL) {
+		*retained = number;
+	}
+
+	// picks without a time or site cannot be compared, nor can times too
+	// far out to number their bucket
+	if ((std::isfinite(time) == false) || (key.isvalid() == false)
+			|| (std::fabs(time / tolerance) >= maximumbucket)) {
+		return (true);
+	}
+
+	// the older generation is checked first, it holds the earlier picks
+	const entry *original = find(tables[1 - currenttable], key, tag, time);
+	if (original == NULL) {
+		original = find(tables[currenttable], key, tag, time);
+	}
+	if (original != NULL) {
+		duplicates++;
+		if (retained != NULL) {
+			*retained = original->number;
+		}
+		return (false);
+	}
+
+	// start a new generation once the current one spans the window or is
+	// full, dropping the previous one
+	generation *current = &tables[currenttable];
+	if ((current->count >= maxentries)
+			|| (time - current->starttime > window)) {
+		currenttable = 1 - currenttable;
+		current = &tables[currenttable];
+		current->clear();
+	}
+	if (current->count == 0) {
+		current->starttime = time;
+	}
+
+	int64_t bucket = static_cast<int64_t>(std::floor(time / tolerance));
+	for (size_t i = hashslot(key, tag, bucket) & current->mask;;
+			i = (i + 1) & current->mask) {
+		entry & slot = current->entries[i];
+		if (slot.stamp != current->stamp) {
+			slot.key = key;
+			slot.tag = tag;
+			slot.bucket = bucket;
+			slot.time = time;
+			slot.number = number;
+			slot.stamp = current->stamp;
+			current->count++;
+			break;
+		}
+	}
+
+	return (true);
+}
+
+void pick_deduplicator::clear() {
+	tables[0].clear();
+	tables[1].clear();
+	currenttable = 0;
+	offered = 0;
+	duplicates = 0;
+}
+
+uint64_t pick_deduplicator::getoffered() const {
+	return (offered);
+}
+
+uint64_t pick_deduplicator::getduplicates() const {
+	return (duplicates);
+}
+
+size_t pick_deduplicator::size() const {
+	return (tables[0].count + tables[1].count);
+}
+}  // namespace detectionformats
@@ -6,70 +6,206 @@
 #include <correlation.h>
 #include <stationInfo.h>
 #include <stationInfoRequest.h>
+#include <codec.h>
+#include <workqueue.h>
 
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 namespace detectionformats {
 ////////////// functions //////////////
 
 bool ValidateJSON(const std::string & jsonstring) {
-    std::string errorstring = ValidateJSONErrors(jsonstring);
-
-	if (errorstring.length() == 0) {
-        return(true);
-    } else {
-        return(false);
-    }
+	return (ValidateJSON(jsonstring, GetCodecContext()));
 }
 
 std::string ValidateJSONErrors(const std::string & jsonstring) {
-    rapidjson::Document jsondocument;
+	return (ValidateJSONErrors(jsonstring, GetCodecContext()));
+}
+
+// checks that the json parses, without building anything
+static bool isparseable(const std::string & jsonstring,
+						codec_context &context) { // NOLINT
+	rapidjson::StringStream stream(jsonstring.c_str());
+	rapidjson::BaseReaderHandler<> handler;
+
+	return (context.getreader().Parse(stream, handler).IsError() == false);
+}
 
-	// parse the json into a document
-	if (jsondocument.Parse(jsonstring.c_str()).HasParseError()) {
+// finds the type of the json by scanning for it, then decodes the json
+// straight into the context target for that type in a single parse, returns
+// the validation error text if the json could not be decoded, NULL otherwise
+static const char * decodetarget(const std::string & jsonstring,
+									codec_context &context, // NOLINT
+									detectionbase **target) {
+	*target = NULL;
+	int type = GetDetectionType(jsonstring.c_str(), jsonstring.length());
+
+	// the type was not found, parse errors are reported first
+	if (type < 0) {
+		if (isparseable(jsonstring, context) == false) {
+			return ("Parse Error");
+		}
+		if (type == formattypes::unknown) {
+			return ("Unknown Format");
+		}
+
+		// not a json object, nothing to validate
+		return (NULL);
+	}
+
+	try {
+		if (type == formattypes::picktype) {
+			*target = &FromJSONString(jsonstring, context.picktarget, context);
+		} else if (type == formattypes::correlationtype) {
+			*target = &FromJSONString(jsonstring, context.correlationtarget,
+										context);
+		} else if (type == formattypes::detectiontype) {
+			*target = &FromJSONString(jsonstring, context.detectiontarget,
+										context);
+		} else if (type == formattypes::retracttype) {
+			*target = &FromJSONString(jsonstring, context.retracttarget,
+										context);
+		} else if (type == formattypes::stationinfotype) {
+			*target = &FromJSONString(jsonstring, context.stationinfotarget,
+										context);
+		} else if (type == formattypes::stationinforequesttype) {
+			*target = &FromJSONString(jsonstring, context.requesttarget,
+										context);
+		}
+	} catch (const std::invalid_argument &) {
+		*target = NULL;
 		return ("Parse Error");
 	}
 
-	int type = GetDetectionType(jsondocument);
+	return (NULL);
+}
 
+bool ValidateJSON(const std::string & jsonstring,
+					codec_context &context) { // NOLINT
+	int type = GetDetectionType(jsonstring.c_str(), jsonstring.length());
+
+	// the type was not found
 	if (type == formattypes::unknown) {
-		return("Unknown Format");
+		return (false);
+	} else if (type < 0) {
+		// not a json object, nothing to validate
+		return (isparseable(jsonstring, context));
 	}
 
-    std::vector<std::string> errorlist;
-    std::string errorstring = "";
-
-	if (type == formattypes::picktype) {
-        detectionformats::pick testpick(jsondocument);
-        errorlist = testpick.geterrors();
-	} else if (type == formattypes::correlationtype) {
-        detectionformats::correlation testcorrelation(jsondocument);
-        errorlist = testcorrelation.geterrors();
-	} else if (type == formattypes::detectiontype) {
-        detectionformats::detection testdetection(jsondocument);
-        errorlist = testdetection.geterrors();
-	} else if (type == formattypes::retracttype) {
-        detectionformats::retract testretract(jsondocument);
-        errorlist = testretract.geterrors();
-	} else if (type == formattypes::stationinfotype) {
-        detectionformats::stationInfo teststationinfo(jsondocument);
-        errorlist = teststationinfo.geterrors();
-	} else if (type == formattypes::stationinforequesttype) {
-        detectionformats::stationInfoRequest testrequest(jsondocument);
-        errorlist = testrequest.geterrors();
+	// check the json as it is parsed, stopping at the first error
+	rapidjson::StringStream stream(jsonstring.c_str());
+	validator & checker = context.getvalidator();
+	checker.settype(type);
+
+	if (context.getreader().Parse(stream, checker).IsError() == true) {
+		return (false);
 	}
 
-    // no errors
-    if (errorlist.size() == 0) {
+	return (checker.isvalid());
+}
+
+std::string ValidateJSONErrors(const std::string & jsonstring,
+								codec_context &context) { // NOLINT
+	detectionbase *target;
+	const char *decodeerror = decodetarget(jsonstring, context, &target);
+	if (decodeerror != NULL) {
+		return (decodeerror);
+	}
+
+	// no errors
+	if ((target == NULL) || (target->isvalid() == true)) {
 		return ("");
 	}
 
-    for (int i = 0; i < errorlist.size(); i++) {
-        errorstring += " " + errorlist[i];
-    }
+	std::vector<std::string> errorlist = target->geterrors();
+	std::string errorstring = "";
+
+	for (int i = 0; i < static_cast<int>(errorlist.size()); i++) {
+		errorstring += " " + errorlist[i];
+	}
+
+	return (errorstring);
+}
+
+// validates the chunks of messages handed to the worker until the queue is
+// empty
+static void validatebatch(workqueue &queue, int worker, // NOLINT
+							const std::string *messages, bool *results,
+							codec_context &context) { // NOLINT
+	size_t begin;
+	size_t end;
 
-    return(errorstring);
+	while (queue.next(worker, &begin, &end) == true) {
+		for (size_t i = begin; i < end; i++) {
+			results[i] = ValidateJSON(messages[i], context);
+		}
+	}
 }
 
+// joins the worker threads when it goes out of scope, so that an exception
+// thrown while starting them or by the calling thread's own validation does
+// not destroy joinable threads
+struct workerthreads {
+	~workerthreads() {
+		for (int i = 0; i < static_cast<int>(threads.size()); i++) {
+			threads[i].join();
+		}
+	}
+
+	std::vector<std::thread> threads;
+};
+
+std::vector<bool> ValidateJSONBatch(const std::string *messages,
+									size_t count, int threads) {
+	if (threads <= 0) {
+		threads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+
+	// no more threads than chunks of work
+	size_t chunks = (count + WORKQUEUE_CHUNKSIZE - 1) / WORKQUEUE_CHUNKSIZE;
+	if (static_cast<size_t>(threads) > chunks) {
+		threads = static_cast<int>(chunks);
+	}
+	if (threads < 1) {
+		threads = 1;
+	}
+
+	// results are written by index, so they stay in input order
+	std::unique_ptr<bool[]> results(new bool[count]);
+	{
+		workqueue queue(count, threads);
+		workerthreads workers;
+
+		for (int i = 1; i < threads; i++) {
+			try {
+				workers.threads.emplace_back([&queue, i, messages, &results]() {
+					codec_context context;
+					validatebatch(queue, i, messages, results.get(), context);
+				});
+			} catch (const std::system_error &) {
+				// the workers that did start steal the unstarted workers' items
+				break;
+			}
+		}
+
+		// the calling thread is worker 0, with a context of its own so that
+		// anything the caller parsed with the thread's context stays valid
+		codec_context context;
+		validatebatch(queue, 0, messages, results.get(), context);
+
+		// the workers are joined here, before the results are read
+	}
+
+	return (std::vector<bool>(results.get(), results.get() + count));
+}
+
+std::vector<bool> ValidateJSONBatch(const std::vector<std::string> &messages,
+									int threads) {
+	return (ValidateJSONBatch(messages.data(), messages.size(), threads));
+}
 }  // namespace detectionformats
@@ -1,29 +1,18 @@
 #include <detection.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define ID_KEY "ID"
-#define SOURCE_KEY "Source"
-#define HYPOCENTER_KEY "Hypocenter"
-#define DETECTIONTYPE_KEY "DetectionType"
-#define DETECTIONTIME_KEY "DetectionTime"
-#define EVENTTYPE_KEY "EventType"
-#define BAYES_KEY "Bayes"
-#define MINIMUMDISTANCE_KEY "MinimumDistance"
-#define RMS_KEY "RMS"
-#define GAP_KEY "Gap"
-#define DATA_KEY "Data"
-
 namespace detectionformats {
 detection::detection() {
 	type = DETECTION_TYPE;
 	id = "";
 	source = detectionformats::source();
 	hypocenter = detectionformats::hypocenter();
-	detectiontype = "";
+	detectiontype = detectiontypeindex::detectiontypecount;
 	detectiontime = std::numeric_limits<double>::quiet_NaN();
 	eventtype = detectionformats::eventtype();
 	bayes = std::numeric_limits<double>::quiet_NaN();
@@ -45,31 +34,30 @@ detection::detection(
 		std::vector<detectionformats::pick> newpickdata,
 		std::vector<detectionformats::correlation> newcorrelationdata) {
 	type = DETECTION_TYPE;
-	id = newid;
-	detection::source = detectionformats::source(newagencyid, newauthor);
+	id = std::move(newid);
+	detection::source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
 	hypocenter = detectionformats::hypocenter(newlatitude, newlongitude,
 												newtime, newdepth,
 												newlatitudeerror,
 												newlongitudeerror, newtimeerror,
 												newdeptherror);
-	detectiontype = newdetectiontype;
+	detectiontype = GetDetectionTypeIndex(newdetectiontype.c_str(),
+											newdetectiontype.length());
+	SetUnknownText(detectiontype, newdetectiontype.c_str(),
+			newdetectiontype.length(), &detectiontypetext);
 	detectiontime = newdetectiontime;
-	eventtype = detectionformats::eventtype(neweventtype, neweventtypecertainty);
+	eventtype = detectionformats::eventtype(std::move(neweventtype),
+			std::move(neweventtypecertainty));
 	bayes = newbayes;
 	minimumdistance = newminimumdistance;
 	rms = newrms;
 	gap = newgap;
 
-	// copy data
-	pickdata.clear();
-	for (int i = 0; i < static_cast<int>(newpickdata.size()); i++) {
-		pickdata.push_back(newpickdata[i]);
-	}
+	// move data
+	pickdata = std::move(newpickdata);
 
-	correlationdata.clear();
-	for (int i = 0; i < static_cast<int>(newcorrelationdata.size()); i++) {
-		correlationdata.push_back(newcorrelationdata[i]);
-	}
+	correlationdata = std::move(newcorrelationdata);
 }
 
 detection::detection(
@@ -81,188 +69,167 @@ detection::detection(
 		std::vector<detectionformats::pick> newpickdata,
 		std::vector<detectionformats::correlation> newcorrelationdata) {
 	type = DETECTION_TYPE;
-	id = newid;
-	detection::source = newsource;
-	hypocenter = newhypocenter;
-	detectiontype = newdetectiontype;
+	id = std::move(newid);
+	detection::source = std::move(newsource);
+	hypocenter = std::move(newhypocenter);
+	detectiontype = GetDetectionTypeIndex(newdetectiontype.c_str(),
+											newdetectiontype.length());
+	SetUnknownText(detectiontype, newdetectiontype.c_str(),
+			newdetectiontype.length(), &detectiontypetext);
 	detectiontime = newdetectiontime;
-	eventtype = neweventtype;
+	eventtype = std::move(neweventtype);
 	bayes = newbayes;
 	minimumdistance = newminimumdistance;
 	rms = newrms;
 	gap = newgap;
 
-	// copy data
-	pickdata.clear();
-	for (int i = 0; i < static_cast<int>(newpickdata.size()); i++) {
-		pickdata.push_back(newpickdata[i]);
-	}
+	// move data
+	pickdata = std::move(newpickdata);
 
-	correlationdata.clear();
-	for (int i = 0; i < static_cast<int>(newcorrelationdata.size()); i++) {
-		correlationdata.push_back(newcorrelationdata[i]);
-	}
+	correlationdata = std::move(newcorrelationdata);
 }
 
 detection::detection(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	} else {
-		type = "";
-	}
-
-	// id
-	if ((json.HasMember(ID_KEY) == true) && (json[ID_KEY].IsString() == true)) {
-		id = std::string(json[ID_KEY].GetString(),
-							json[ID_KEY].GetStringLength());
-	} else {
-		id = "";
-	}
+	// values that are missing from the json
+	type = "";
+	detectiontype = detectiontypeindex::detectiontypecount;
+	detectiontime = std::numeric_limits<double>::quiet_NaN();
+	bayes = std::numeric_limits<double>::quiet_NaN();
+	minimumdistance = std::numeric_limits<double>::quiet_NaN();
+	rms = std::numeric_limits<double>::quiet_NaN();
+	gap = std::numeric_limits<double>::quiet_NaN();
+	pickdata.clear();
+	correlationdata.clear();
 
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
-	}
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (detectionkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case detectionkeyindex::detectiontypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// hypocenter
-	if ((json.HasMember(HYPOCENTER_KEY) == true)
-			&& (json[HYPOCENTER_KEY].IsObject() == true)) {
-		rapidjson::Value & hypocentervalue = json[HYPOCENTER_KEY];
-		hypocenter = detectionformats::hypocenter(hypocentervalue);
-	} else {
-		hypocenter = detectionformats::hypocenter();
-	}
+			// id
+			case detectionkeyindex::detectionidkey:
+				if (value.IsString() == true) {
+					id = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// optional values
-	// detectiontype
-	if ((json.HasMember(DETECTIONTYPE_KEY) == true)
-			&& (json[DETECTIONTYPE_KEY].IsString() == true)) {
-		detectiontype = std::string(json[DETECTIONTYPE_KEY].GetString(),
-									json[DETECTIONTYPE_KEY].GetStringLength());
-	} else {
-		detectiontype = "";
-	}
+			// source
+			case detectionkeyindex::detectionsourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
 
-	// detectiontime
-	if ((json.HasMember(DETECTIONTIME_KEY) == true)
-			&& (json[DETECTIONTIME_KEY].IsString() == true)) {
-		detectiontime = detectionformats::ConvertISO8601ToEpochTime(
-				std::string(json[DETECTIONTIME_KEY].GetString(),
-							json[DETECTIONTIME_KEY].GetStringLength()));
-	} else {
-		detectiontime = std::numeric_limits<double>::quiet_NaN();
-	}
+			// hypocenter
+			case detectionkeyindex::detectionhypocenterkey:
+				if (value.IsObject() == true) {
+					hypocenter = detectionformats::hypocenter(value);
+				}
+				break;
 
-	// eventtype
-	if ((json.HasMember(EVENTTYPE_KEY) == true)
-			&& (json[EVENTTYPE_KEY].IsObject() == true)) {
-		rapidjson::Value & eventtypevalue = json[EVENTTYPE_KEY];
-		eventtype = detectionformats::eventtype(eventtypevalue);
-	} else {
-		eventtype = detectionformats::eventtype();
-	}
+			// optional values
+			// detectiontype
+			case detectionkeyindex::detectiondetectiontypekey:
+				if (value.IsString() == true) {
+					detectiontype = GetDetectionTypeIndex(value.GetString(),
+							value.GetStringLength());
+					SetUnknownText(detectiontype, value.GetString(),
+							value.GetStringLength(), &detectiontypetext);
+				}
+				break;
 
-	// bayes
-	if ((json.HasMember(BAYES_KEY) == true)
-			&& (json[BAYES_KEY].IsNumber() == true)
-			&& (json[BAYES_KEY].IsDouble() == true)) {
-		bayes = json[BAYES_KEY].GetDouble();
-	} else {
-		bayes = std::numeric_limits<double>::quiet_NaN();
-	}
+			// detectiontime
+			case detectionkeyindex::detectiontimekey:
+				if (value.IsString() == true) {
+					detectiontime = detectionformats::ConvertISO8601ToEpochTime(
+							value.GetString(), value.GetStringLength());
+				}
+				break;
 
-	// minimumdistance
-	if ((json.HasMember(MINIMUMDISTANCE_KEY) == true)
-			&& (json[MINIMUMDISTANCE_KEY].IsNumber() == true)
-			&& (json[MINIMUMDISTANCE_KEY].IsDouble() == true)) {
-		minimumdistance = json[MINIMUMDISTANCE_KEY].GetDouble();
-	} else {
-		minimumdistance = std::numeric_limits<double>::quiet_NaN();
-	}
+			// eventtype
+			case detectionkeyindex::detectioneventtypekey:
+				if (value.IsObject() == true) {
+					eventtype = detectionformats::eventtype(value);
+				}
+				break;
 
-	// rms
-	if ((json.HasMember(RMS_KEY) == true) && (json[RMS_KEY].IsNumber() == true)
-			&& (json[RMS_KEY].IsDouble() == true)) {
-		rms = json[RMS_KEY].GetDouble();
-	} else {
-		rms = std::numeric_limits<double>::quiet_NaN();
-	}
+			// bayes
+			case detectionkeyindex::detectionbayeskey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					bayes = value.GetDouble();
+				}
+				break;
 
-	// gap
-	if ((json.HasMember(GAP_KEY) == true) && (json[GAP_KEY].IsNumber() == true)
-			&& (json[GAP_KEY].IsDouble() == true)) {
-		gap = json[GAP_KEY].GetDouble();
-	} else {
-		gap = std::numeric_limits<double>::quiet_NaN();
-	}
+			// minimumdistance
+			case detectionkeyindex::detectionmindistkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					minimumdistance = value.GetDouble();
+				}
+				break;
 
-	// data
-	pickdata.clear();
-	correlationdata.clear();
+			// rms
+			case detectionkeyindex::detectionrmskey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					rms = value.GetDouble();
+				}
+				break;
 
-	if ((json.HasMember(DATA_KEY) == true)
-			&& (json[DATA_KEY].IsArray() == true)) {
-		rapidjson::Value dataarray;
-		dataarray = json[DATA_KEY].GetArray();
-
-		for (rapidjson::SizeType i = 0; i < dataarray.Size(); i++) {
-			rapidjson::Value & datavalue = dataarray[i];
-			if (datavalue.HasMember(TYPE_KEY) == false) {
-				continue;
-			}
-
-			// route based on typestring
-			std::string typestring = std::string(
-					datavalue["Type"].GetString(),
-					datavalue["Type"].GetStringLength());
-			if (typestring == PICK_TYPE) {
-				detectionformats::pick newpickdata(datavalue);
-
-				// add to vector
-				pickdata.push_back(newpickdata);
-			} else if (typestring == CORRELATION_TYPE) {
-				detectionformats::correlation newcorrelationdata(datavalue);
-
-				// add to vector
-				correlationdata.push_back(newcorrelationdata);
-			} else {
-				continue;
-			}
-		}
-	}
-}
+			// gap
+			case detectionkeyindex::detectiongapkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					gap = value.GetDouble();
+				}
+				break;
 
-detection::detection(const detection & newdetection) {
-	type = DETECTION_TYPE;
-	id = newdetection.id;
-	detection::source = newdetection.source;
-	hypocenter = newdetection.hypocenter;
-	detectiontype = newdetection.detectiontype;
-	detectiontime = newdetection.detectiontime;
-	eventtype = newdetection.eventtype;
-	bayes = newdetection.bayes;
-	minimumdistance = newdetection.minimumdistance;
-	rms = newdetection.rms;
-	gap = newdetection.gap;
-
-	// copy data
-	pickdata.clear();
-	for (int i = 0; i < static_cast<int>(newdetection.pickdata.size()); i++) {
-		pickdata.push_back(newdetection.pickdata[i]);
-	}
+			// data
+			case detectionkeyindex::detectiondatakey:
+				if (value.IsArray() == true) {
+					for (rapidjson::SizeType i = 0; i < value.Size(); i++) {
+						rapidjson::Value & datavalue = value[i];
+						if (datavalue.IsObject() == false) {
+							continue;
+						}
+
+						rapidjson::Value::MemberIterator typemember =
+								datavalue.FindMember(TYPE_KEY);
+						if ((typemember == datavalue.MemberEnd())
+								|| (typemember->value.IsString() == false)) {
+							continue;
+						}
+
+						// route based on typestring
+						std::string typestring = std::string(
+								typemember->value.GetString(),
+								typemember->value.GetStringLength());
+						if (typestring == PICK_TYPE) {
+							// add to vector
+							pickdata.push_back(
+									detectionformats::pick(datavalue));
+						} else if (typestring == CORRELATION_TYPE) {
+							// add to vector
+							correlationdata.push_back(
+									detectionformats::correlation(datavalue));
+						}
+					}
+				}
+				break;
 
-	correlationdata.clear();
-	for (int i = 0; i < static_cast<int>(newdetection.correlationdata.size());
-			i++) {
-		correlationdata.push_back(newdetection.correlationdata[i]);
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
@@ -301,19 +268,23 @@ rapidjson::Value & detection::tojson(
 
 	// optional values
 	// detectiontype
-	if (detectiontype != "") {
+	const char *detectiontypestring = GetIndexText(
+			GetDetectionTypeValue(detectiontype), detectiontype,
+			detectiontypetext);
+	if (detectiontypestring[0] != '\0') {
 		rapidjson::Value detectiontypevalue;
-		detectiontypevalue.SetString(
-				rapidjson::StringRef(detectiontype.c_str()), allocator);
+		SetIndexString(detectiontypevalue, detectiontypestring, detectiontype,
+				allocator);
 		json.AddMember(DETECTIONTYPE_KEY, detectiontypevalue, allocator);
 	}
 
 	// detectiontime
-	if (std::isnan(detectiontime) != true) {
-		std::string timestring = detectionformats::ConvertEpochTimeToISO8601(
-				detectiontime);
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(detectiontime, timestring);
+	if (timelength > 0) {
 		rapidjson::Value timevalue;
-		timevalue.SetString(rapidjson::StringRef(timestring.c_str()),
+		timevalue.SetString(timestring,
+							static_cast<rapidjson::SizeType>(timelength),
 							allocator);
 		json.AddMember(DETECTIONTIME_KEY, timevalue, allocator);
 	}
@@ -372,166 +343,254 @@ rapidjson::Value & detection::tojson(
 	return (json);
 }
 
-std::vector<std::string> detection::geterrors() {
-	std::vector<std::string> errorlist;
+void detection::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// id
+	if (id.empty() == false) {
+		writer.Key(ID_KEY);
+		writer.String(id.c_str(),
+						static_cast<rapidjson::SizeType>(id.length()));
+	}
+
+	// source
+	writer.Key(SOURCE_KEY);
+	source.write(writer);
+
+	// hypocenter
+	writer.Key(HYPOCENTER_KEY);
+	hypocenter.write(writer);
+
+	// optional values
+	// detectiontype
+	const char *detectiontypestring = GetIndexText(
+			GetDetectionTypeValue(detectiontype), detectiontype,
+			detectiontypetext);
+	if (detectiontypestring[0] != '\0') {
+		writer.Key(DETECTIONTYPE_KEY);
+		writer.String(detectiontypestring);
+	}
+
+	// detectiontime
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(detectiontime, timestring);
+	if (timelength > 0) {
+		writer.Key(DETECTIONTIME_KEY);
+		writer.String(timestring, static_cast<rapidjson::SizeType>(timelength));
+	}
+
+	// eventtype
+	if (eventtype.isempty() == false) {
+		writer.Key(EVENTTYPE_KEY);
+		eventtype.write(writer);
+	}
+
+	// bayes
+	if (std::isnan(bayes) != true) {
+		writer.Key(BAYES_KEY);
+		writer.Double(bayes);
+	}
+
+	// minimumdistance
+	if (std::isnan(minimumdistance) != true) {
+		writer.Key(MINIMUMDISTANCE_KEY);
+		writer.Double(minimumdistance);
+	}
+
+	// rms
+	if (std::isnan(rms) != true) {
+		writer.Key(RMS_KEY);
+		writer.Double(rms);
+	}
+
+	// gap
+	if (std::isnan(gap) != true) {
+		writer.Key(GAP_KEY);
+		writer.Double(gap);
+	}
+
+	// data, the picks followed by the correlations
+	if ((pickdata.size() > 0) || (correlationdata.size() > 0)) {
+		writer.Key(DATA_KEY);
+		writer.StartArray();
+
+		// pickdata
+		for (int i = 0; i < static_cast<int>(pickdata.size()); i++) {
+			pickdata[i].write(writer);
+		}
+
+		// correlationdata
+		for (int i = 0; i < static_cast<int>(correlationdata.size()); i++) {
+			correlationdata[i].write(writer);
+		}
+
+		writer.EndArray();
+	}
+
+	writer.EndObject();
+}
+
+// detection validation error text, in detectionerror order
+static const char *detectionerrorvalues[] = {
+		"Non-detection type in detection class.",
+		"Empty ID in detection class.",
+		"Source object did not validate in detection class:",
+		"Hypocenter object did not validate in detection class:",
+		"Invalid DetectionType in detection class.",
+		"Detection Time did not validate in detection class.",
+		"EventType object did not validate in detection class:",
+		"Invalid Bayes in detection class.",
+		"Invalid MinimumDistance in detection class.",
+		"Invalid RMS in detection class.",
+		"Invalid Gap in detection class.",
+		"Invalid pick in detection class:",
+		"Invalid correlation in detection class:" };
+
+errorcodes detection::validate() {
+	errorcodes errors = 0;
 
 	// check required data
 	// Type
 	if (type != DETECTION_TYPE) {
 		// wrong type
-		errorlist.push_back("Non-detection type in detection class.");
+		errors |= ERRORCODE(detectionerror::detectiontypeinvalid);
 	}
 
 	// id
 	if (id.empty() == true) {
 		// empty id
-		errorlist.push_back("Empty ID in detection class.");
+		errors |= ERRORCODE(detectionerror::detectionidmissing);
 	}
 
 	// source
 	if (source.isvalid() != true) {
-		std::vector<std::string> sourceErrors = source.geterrors();
-
-		std::string errorString =
-				"Source object did not validate in detection class:";
-
-		for (int i = 0; i < sourceErrors.size(); i++) {
-			errorString += " " + sourceErrors[i];
-		}
-
 		// bad source
-		errorlist.push_back(errorString);
+		errors |= ERRORCODE(detectionerror::detectionsourceinvalid);
 	}
 
 	// hypocenter
 	if (hypocenter.isvalid() != true) {
-		std::vector<std::string> hypoErrors = hypocenter.geterrors();
-
-		std::string errorString =
-				"Hypocenter object did not validate in detection class:";
-
-		for (int i = 0; i < hypoErrors.size(); i++) {
-			errorString += " " + hypoErrors[i];
-		}
-
 		// bad hypo
-		errorlist.push_back(errorString);
+		errors |= ERRORCODE(detectionerror::detectionhypocenterinvalid);
 	}
 
 	// optional keys
 	// detectiontype
-	if (detectiontype.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::detectiontypeindex::newdetection;
-				i < detectionformats::detectiontypeindex::detectiontypecount;
-				i++) {
-			if (detectiontype == detectionformats::detectiontypevalues[i]) {
-				match = true;
-				break;
-			}
-		}
-
-		if (match == false) {
-			errorlist.push_back("Invalid DetectionType in detection class.");
-		}
+	if ((detectiontype < detectiontypeindex::newdetection)
+			|| (detectiontype > detectiontypeindex::detectiontypecount)) {
+		errors |= ERRORCODE(detectionerror::detectiondetectiontypeinvalid);
 	}
 
 	// detectiontime
 	if (std::isnan(detectiontime) != true) {
-		try {
-			if (detectionformats::IsStringISO8601(
-					detectionformats::ConvertEpochTimeToISO8601(detectiontime))
-					== false) {
-				errorlist.push_back(
-						"Detection Time did not validate in detection class.");
-			}
-		} catch (const std::exception & e) {
-			errorlist.push_back(std::string(e.what()));
+		if (detectionformats::IsEpochTimeValid(detectiontime) == false) {
+			errors |= ERRORCODE(detectionerror::detectiontimeinvalid);
 		}
 	}
 
 	// eventtype
-	if (eventtype.isempty() == false) {
-		if (eventtype.isvalid() != true) {
-			std::vector<std::string> eventtypeErrors = eventtype.geterrors();
-
-			std::string errorString =
-					"EventType object did not validate in detection class:";
-
-			for (int i = 0; i < eventtypeErrors.size(); i++) {
-				errorString += " " + eventtypeErrors[i];
-			}
-
-			// bad eventtype
-			errorlist.push_back(errorString);
-		}
+	if ((eventtype.isempty() == false) && (eventtype.isvalid() != true)) {
+		errors |= ERRORCODE(detectionerror::detectioneventtypeinvalid);
 	}
 
 	// bayes
 	if (std::isnan(bayes) != true) {
 		if (bayes < 0) {
-			errorlist.push_back("Invalid Bayes in detection class.");
+			errors |= ERRORCODE(detectionerror::detectionbayesinvalid);
 		}
 	}
 
 	// minimumdistance
 	if (std::isnan(minimumdistance) != true) {
 		if (minimumdistance < 0) {
-			errorlist.push_back("Invalid MinimumDistance in detection class.");
+			errors |= ERRORCODE(detectionerror::detectionmindistinvalid);
 		}
 	}
 
 	// rms
 	if (std::isnan(rms) != true) {
-		if (rms < -10000) {
-			errorlist.push_back("Invalid RMS in detection class.");
+		if (rms < RMS_MINIMUM) {
+			errors |= ERRORCODE(detectionerror::detectionrmsinvalid);
 		}
 	}
 
 	// gap
 	if (std::isnan(gap) != true) {
-		if ((gap < 0) || (gap > 360)) {
-			errorlist.push_back("Invalid Gap in detection class.");
+		if ((gap < 0) || (gap > AZIMUTH_MAXIMUM)) {
+			errors |= ERRORCODE(detectionerror::detectiongapinvalid);
 		}
 	}
 
 	// data
 	// pickdata
-	if (pickdata.size() > 0) {
-		for (int i = 0; i < static_cast<int>(pickdata.size()); i++) {
-			if (pickdata[i].isvalid() != true) {
-				std::vector<std::string> pickErrors = pickdata[i].geterrors();
-
-				std::string errorString = "Invalid pick in detection class:";
-
-				for (int j = 0; j < pickErrors.size(); j++) {
-					errorString += " " + pickErrors[j];
-				}
-
-				// bad pick
-				errorlist.push_back(errorString);
-			}
+	for (int i = 0; i < static_cast<int>(pickdata.size()); i++) {
+		if (pickdata[i].isvalid() != true) {
+			// bad pick
+			errors |= ERRORCODE(detectionerror::detectionpickinvalid);
+			break;
 		}
 	}
 
 	// correlationdata
-	if (correlationdata.size() > 0) {
-		for (int i = 0; i < static_cast<int>(correlationdata.size()); i++) {
-			if (correlationdata[i].isvalid() != true) {
-				std::vector<std::string> corrErrors = correlationdata[i]
-						.geterrors();
+	for (int i = 0; i < static_cast<int>(correlationdata.size()); i++) {
+		if (correlationdata[i].isvalid() != true) {
+			// bad correlation
+			errors |= ERRORCODE(detectionerror::detectioncorrelationinvalid);
+			break;
+		}
+	}
 
-				std::string errorString =
-						"Invalid correlation in detection class:";
+	return (errors);
+}
 
-				for (int j = 0; j < corrErrors.size(); j++) {
-					errorString += " " + corrErrors[j];
-				}
+std::vector<std::string> detection::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
 
-				// bad pick
-				errorlist.push_back(errorString);
-			}
+	// render the text for each error found
+	for (int i = 0; i < detectionerror::detectionerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		switch (i) {
+			case detectionerror::detectionsourceinvalid:
+				errorlist.push_back(
+						getmembererror(detectionerrorvalues[i], source));
+				break;
+			case detectionerror::detectionhypocenterinvalid:
+				errorlist.push_back(
+						getmembererror(detectionerrorvalues[i], hypocenter));
+				break;
+			case detectionerror::detectioneventtypeinvalid:
+				errorlist.push_back(
+						getmembererror(detectionerrorvalues[i], eventtype));
+				break;
+			case detectionerror::detectionpickinvalid:
+				for (int j = 0; j < static_cast<int>(pickdata.size()); j++) {
+					if (pickdata[j].isvalid() != true) {
+						errorlist.push_back(
+								getmembererror(detectionerrorvalues[i], pickdata[j]));
+					}
+				}
+				break;
+			case detectionerror::detectioncorrelationinvalid:
+				for (int j = 0; j < static_cast<int>(correlationdata.size()); j++) {
+					if (correlationdata[j].isvalid() != true) {
+						errorlist.push_back(
+								getmembererror(detectionerrorvalues[i], correlationdata[j]));
+					}
+				}
+				break;
+			default:
+				errorlist.push_back(detectionerrorvalues[i]);
+				break;
 		}
 	}
 
@@ -1,47 +1,70 @@
 #include <eventtype.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
 #include <vector>
 
-// JSON Keys
-#define CERTAINTY_KEY "Certainty"
-
 namespace detectionformats {
 eventtype::eventtype() {
-	type = "";
-	certainty = "";
+	type = eventtypeindex::eventtypecount;
+	certainty = eventtypecertaintyindex::eventtypecertaintycount;
 }
 
 eventtype::eventtype(std::string newtype, std::string newcertainty) {
-	type = newtype;
-	certainty = newcertainty;
+	type = GetEventTypeIndex(newtype.c_str(), newtype.length());
+	certainty = GetEventTypeCertaintyIndex(newcertainty.c_str(),
+											newcertainty.length());
+	SetUnknownText(type, newtype.c_str(), newtype.length(), &typetext);
+	SetUnknownText(certainty, newcertainty.c_str(), newcertainty.length(),
+			&certaintytext);
 }
 
 eventtype::eventtype(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-								json[TYPE_KEY].GetStringLength());
-	} else {
-		type = "";
-	}
+	// values that are missing from the json
+	type = eventtypeindex::eventtypecount;
+	certainty = eventtypecertaintyindex::eventtypecertaintycount;
+
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (eventtypekeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case eventtypekeyindex::eventtypetypekey:
+				if (value.IsString() == true) {
+					type = GetEventTypeIndex(value.GetString(),
+							value.GetStringLength());
+					SetUnknownText(type, value.GetString(),
+							value.GetStringLength(), &typetext);
+				}
+				break;
 
-	// author
-	if ((json.HasMember(CERTAINTY_KEY) == true)
-			&& (json[CERTAINTY_KEY].IsString() == true)) {
-		certainty = std::string(json[CERTAINTY_KEY].GetString(),
-								json[CERTAINTY_KEY].GetStringLength());
-	} else {
-		certainty = "";
+			// certainty
+			case eventtypekeyindex::eventtypecertaintykey:
+				if (value.IsString() == true) {
+					certainty = GetEventTypeCertaintyIndex(value.GetString(),
+							value.GetStringLength());
+					SetUnknownText(certainty, value.GetString(),
+							value.GetStringLength(), &certaintytext);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
 eventtype::eventtype(const eventtype & neweventtype) {
 	type = neweventtype.type;
 	certainty = neweventtype.certainty;
+	typetext = neweventtype.typetext;
+	certaintytext = neweventtype.certaintytext;
 }
 
 eventtype::~eventtype() {
@@ -53,71 +76,96 @@ rapidjson::Value & eventtype::tojson(
 	json.SetObject();
 
 	// required values
-	// type
-	if (type != "") {
+	// type, the value strings are static so they are not copied, the
+	// text of an unknown type is
+	const char *typestring = GetIndexText(
+			GetEventTypeValue(type), type, typetext);
+	if (typestring[0] != '\0') {
 		rapidjson::Value typeidvalue;
-		typeidvalue.SetString(rapidjson::StringRef(type.c_str()),
-								allocator);
+		SetIndexString(typeidvalue, typestring, type, allocator);
 		json.AddMember(TYPE_KEY, typeidvalue, allocator);
 	}
 
 	// certainty
-	if (certainty != "") {
+	const char *certaintystring = GetIndexText(
+			GetEventTypeCertaintyValue(certainty), certainty, certaintytext);
+	if (certaintystring[0] != '\0') {
 		rapidjson::Value certaintyvalue;
-		certaintyvalue.SetString(rapidjson::StringRef(certainty.c_str()),
-            allocator);
+		SetIndexString(certaintyvalue, certaintystring, certainty, allocator);
 		json.AddMember(CERTAINTY_KEY, certaintyvalue, allocator);
 	}
 
 	return (json);
 }
 
-std::vector<std::string> eventtype::geterrors() {
-	std::vector<std::string> errorlist;
+void eventtype::write(jsonhandler &writer) {
+	writer.StartObject();
 
-    // type
-	if (type.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::eventtypeindex::earthquake;
-				i < detectionformats::eventtypeindex::eventtypecount; i++) {
-			if (type == eventtypevalues[i]) {
-				match = true;
-				break;
-			}
-		}
+	// required values
+	// type, the value strings are static so they are not copied, the
+	// text of an unknown type is
+	const char *typestring = GetIndexText(
+			GetEventTypeValue(type), type, typetext);
+	if (typestring[0] != '\0') {
+		writer.Key(TYPE_KEY);
+		writer.String(typestring);
+	}
 
-		if (match == false) {
-			errorlist.push_back("Invalid Type in eventtype class.");
-		}
+	// certainty
+	const char *certaintystring = GetIndexText(
+			GetEventTypeCertaintyValue(certainty), certainty, certaintytext);
+	if (certaintystring[0] != '\0') {
+		writer.Key(CERTAINTY_KEY);
+		writer.String(certaintystring);
+	}
+
+	writer.EndObject();
+}
+
+// eventtype validation error text, in eventtypeerror order
+static const char *eventtypeerrorvalues[] = {
+		"Invalid Type in eventtype class.",
+		"Invalid Certainty in eventtype class." };
+
+errorcodes eventtype::validate() {
+	errorcodes errors = 0;
+
+	// type, the count value means no type
+	if ((type < eventtypeindex::earthquake)
+			|| (type > eventtypeindex::eventtypecount)) {
+		errors |= ERRORCODE(eventtypeerror::eventtypetypeinvalid);
 	}
 
 	// certainty
-	if (certainty.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::eventtypecertaintyindex::suspected;
-				i < detectionformats::eventtypecertaintyindex::eventtypecertaintycount; // NOLINT
-                i++) {
-			if (certainty == eventtypecertaintyvalues[i]) {
-				match = true;
-				break;
-			}
-		}
+	if ((certainty < eventtypecertaintyindex::suspected)
+			|| (certainty > eventtypecertaintyindex::eventtypecertaintycount)) {
+		errors |= ERRORCODE(eventtypeerror::eventtypecertaintyinvalid);
+	}
+
+	return (errors);
+}
 
-		if (match == false) {
-			errorlist.push_back("Invalid Certainty in eventtype class.");
+std::vector<std::string> eventtype::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < eventtypeerror::eventtypeerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
 		}
+
+		errorlist.push_back(eventtypeerrorvalues[i]);
 	}
 
 	// return the list of errors
 	return (errorlist);
 }
 
-bool eventtype::isempty() {
-	if (type.empty() == false)
+bool eventtype::isempty() const {
+	if (type != eventtypeindex::eventtypecount)
 		return (false);
-	if (certainty.empty() == false)
+	if (certainty != eventtypecertaintyindex::eventtypecertaintycount)
 		return (false);
 
 	return (true);
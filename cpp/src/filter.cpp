@@ -1,14 +1,11 @@
 #include <filter.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define HIGHPASS_KEY "HighPass"
-#define LOWPASS_KEY "LowPass"
-#define UNITS_KEY "Units"
-
 namespace detectionformats {
 filter::filter() {
 	type = "";
@@ -19,49 +16,61 @@ filter::filter() {
 
 filter::filter(std::string newtype, double newhighpass, double newlowpass,
 		std::string newunits) {
-	type = newtype;
+	type = std::move(newtype);
 	highpass = newhighpass;
 	lowpass = newlowpass;
-	units = newunits;
+	units = std::move(newunits);
 }
 
 filter::filter(rapidjson::Value &json) {
-	// optional values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-    } else {
-		type = "";
-    }
-
-	// highpass
-	if ((json.HasMember(HIGHPASS_KEY) == true)
-			&& (json[HIGHPASS_KEY].IsNumber() == true)
-			&& (json[HIGHPASS_KEY].IsDouble() == true)) {
-		highpass = json[HIGHPASS_KEY].GetDouble();
-	} else {
-		highpass = std::numeric_limits<double>::quiet_NaN();
-	}
+	// values that are missing from the json
+	type = "";
+	highpass = std::numeric_limits<double>::quiet_NaN();
+	lowpass = std::numeric_limits<double>::quiet_NaN();
 
-	// lowpass
-	if ((json.HasMember(LOWPASS_KEY) == true)
-			&& (json[LOWPASS_KEY].IsNumber() == true)
-			&& (json[LOWPASS_KEY].IsDouble() == true)) {
-		lowpass = json[LOWPASS_KEY].GetDouble();
-	} else {
-		lowpass = std::numeric_limits<double>::quiet_NaN();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (filterkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// optional values
+			// type
+			case filterkeyindex::filtertypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// highpass
+			case filterkeyindex::filterhighpasskey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					highpass = value.GetDouble();
+				}
+				break;
+
+			// lowpass
+			case filterkeyindex::filterlowpasskey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					lowpass = value.GetDouble();
+				}
+				break;
+
+			// units
+			case filterkeyindex::filterunitskey:
+				if (value.IsString() == true) {
+					units = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
-
-	// units
-	if ((json.HasMember(UNITS_KEY) == true)
-			&& (json[UNITS_KEY].IsString() == true)) {
-		units = std::string(json[UNITS_KEY].GetString(),
-							json[UNITS_KEY].GetStringLength());
-    } else {
-		units = "";
-    }
 }
 
 filter::filter(const filter & newfilter) {
@@ -107,12 +116,50 @@ rapidjson::Value & filter::tojson(
 	return (json);
 }
 
+void filter::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// optional values
+	// type
+	if (type.empty() == false) {
+		writer.Key(TYPE_KEY);
+		writer.String(type.c_str(),
+						static_cast<rapidjson::SizeType>(type.length()));
+	}
+
+	// highpass
+	if (std::isnan(highpass) != true) {
+		writer.Key(HIGHPASS_KEY);
+		writer.Double(highpass);
+	}
+
+	// lowpass
+	if (std::isnan(lowpass) != true) {
+		writer.Key(LOWPASS_KEY);
+		writer.Double(lowpass);
+	}
+
+	// units
+	if (units.empty() == false) {
+		writer.Key(UNITS_KEY);
+		writer.String(units.c_str(),
+						static_cast<rapidjson::SizeType>(units.length()));
+	}
+
+	writer.EndObject();
+}
+
+errorcodes filter::validate() {
+	// nothing to check
+	return (0);
+}
+
 std::vector<std::string> filter::geterrors() {
 	// nothing to check
 	return (std::vector<std::string>());
 }
 
-bool filter::isempty() {
+bool filter::isempty() const {
 	if (type.empty() == false) {
 		return (false);
 	}
@@ -1,19 +1,10 @@
 #include <hypocenter.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
 #include <vector>
 
-// JSON Keys
-#define LATITUDE_KEY "Latitude"
-#define LONGITUDE_KEY "Longitude"
-#define DEPTH_KEY "Depth"
-#define TIME_KEY "Time"
-#define LATITUDE_ERROR_KEY "LatitudeError"
-#define LONGITUDE_ERROR_KEY "LongitudeError"
-#define DEPTH_ERROR_KEY "DepthError"
-#define TIME_ERROR_KEY "TimeError"
-
 namespace detectionformats {
 
 hypocenter::hypocenter() {
@@ -42,72 +33,87 @@ hypocenter::hypocenter(double newlatitude, double newlongitude, double newtime,
 }
 
 hypocenter::hypocenter(rapidjson::Value &json) {
-	// required values
-	// latitude
-	if ((json.HasMember(LATITUDE_KEY) == true)
-			&& (json[LATITUDE_KEY].IsNumber() == true)
-			&& (json[LATITUDE_KEY].IsDouble() == true))
-		latitude = json[LATITUDE_KEY].GetDouble();
-	else
-		latitude = std::numeric_limits<double>::quiet_NaN();
-
-	// longitude
-	if ((json.HasMember(LONGITUDE_KEY) == true)
-			&& (json[LONGITUDE_KEY].IsNumber() == true)
-			&& (json[LONGITUDE_KEY].IsDouble() == true))
-		longitude = json[LONGITUDE_KEY].GetDouble();
-	else
-		longitude = std::numeric_limits<double>::quiet_NaN();
-
-	// time
-	if ((json.HasMember(TIME_KEY) == true)
-			&& (json[TIME_KEY].IsString() == true))
-		time = detectionformats::ConvertISO8601ToEpochTime(
-				std::string(json[TIME_KEY].GetString(),
-							json[TIME_KEY].GetStringLength()));
-	else
-		time = std::numeric_limits<double>::quiet_NaN();
-
-	// depth
-	if ((json.HasMember(DEPTH_KEY) == true)
-			&& (json[DEPTH_KEY].IsNumber() == true)
-			&& (json[DEPTH_KEY].IsDouble() == true))
-		depth = json[DEPTH_KEY].GetDouble();
-	else
-		depth = std::numeric_limits<double>::quiet_NaN();
-
-	// optional values
-	// latitude error
-	if ((json.HasMember(LATITUDE_ERROR_KEY) == true)
-			&& (json[LATITUDE_ERROR_KEY].IsNumber() == true)
-			&& (json[LATITUDE_ERROR_KEY].IsDouble() == true))
-		latitudeerror = json[LATITUDE_ERROR_KEY].GetDouble();
-	else
-		latitudeerror = std::numeric_limits<double>::quiet_NaN();
-
-	// longitude error
-	if ((json.HasMember(LONGITUDE_ERROR_KEY) == true)
-			&& (json[LONGITUDE_ERROR_KEY].IsNumber() == true)
-			&& (json[LONGITUDE_ERROR_KEY].IsDouble() == true))
-		longitudeerror = json[LONGITUDE_ERROR_KEY].GetDouble();
-	else
-		longitudeerror = std::numeric_limits<double>::quiet_NaN();
-
-	// time error
-	if ((json.HasMember(TIME_ERROR_KEY) == true)
-			&& (json[TIME_ERROR_KEY].IsNumber() == true)
-			&& (json[TIME_ERROR_KEY].IsDouble() == true))
-		timeerror = json[TIME_ERROR_KEY].GetDouble();
-	else
-		timeerror = std::numeric_limits<double>::quiet_NaN();
+	// values that are missing from the json
+	latitude = std::numeric_limits<double>::quiet_NaN();
+	longitude = std::numeric_limits<double>::quiet_NaN();
+	time = std::numeric_limits<double>::quiet_NaN();
+	depth = std::numeric_limits<double>::quiet_NaN();
+	latitudeerror = std::numeric_limits<double>::quiet_NaN();
+	longitudeerror = std::numeric_limits<double>::quiet_NaN();
+	timeerror = std::numeric_limits<double>::quiet_NaN();
+	deptherror = std::numeric_limits<double>::quiet_NaN();
 
-	// depth error
-	if ((json.HasMember(DEPTH_ERROR_KEY) == true)
-			&& (json[DEPTH_ERROR_KEY].IsNumber() == true)
-			&& (json[DEPTH_ERROR_KEY].IsDouble() == true))
-		deptherror = json[DEPTH_ERROR_KEY].GetDouble();
-	else
-		deptherror = std::numeric_limits<double>::quiet_NaN();
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (hypocenterkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// latitude
+			case hypocenterkeyindex::hypolatitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					latitude = value.GetDouble();
+				}
+				break;
+
+			// longitude
+			case hypocenterkeyindex::hypolongitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					longitude = value.GetDouble();
+				}
+				break;
+
+			// time
+			case hypocenterkeyindex::hypotimekey:
+				if (value.IsString() == true) {
+					time = detectionformats::ConvertISO8601ToEpochTime(
+							value.GetString(), value.GetStringLength());
+				}
+				break;
+
+			// depth
+			case hypocenterkeyindex::hypodepthkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					depth = value.GetDouble();
+				}
+				break;
+
+			// optional values
+			// latitude error
+			case hypocenterkeyindex::hypolatitudeerrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					latitudeerror = value.GetDouble();
+				}
+				break;
+
+			// longitude error
+			case hypocenterkeyindex::hypolongitudeerrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					longitudeerror = value.GetDouble();
+				}
+				break;
+
+			// time error
+			case hypocenterkeyindex::hypotimeerrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					timeerror = value.GetDouble();
+				}
+				break;
+
+			// depth error
+			case hypocenterkeyindex::hypodeptherrorkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					deptherror = value.GetDouble();
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
+	}
 }
 
 hypocenter::hypocenter(const hypocenter & newhypocenter) {
@@ -139,11 +145,12 @@ rapidjson::Value & hypocenter::tojson(
 		json.AddMember(LONGITUDE_KEY, longitude, allocator);
 
 	// time
-	if (std::isnan(time) != true) {
-		std::string timestring = detectionformats::ConvertEpochTimeToISO8601(
-				time);
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
 		rapidjson::Value timevalue;
-		timevalue.SetString(rapidjson::StringRef(timestring.c_str()),
+		timevalue.SetString(timestring,
+							static_cast<rapidjson::SizeType>(timelength),
 							allocator);
 		json.AddMember(TIME_KEY, timevalue, allocator);
 	}
@@ -172,54 +179,131 @@ rapidjson::Value & hypocenter::tojson(
 	return (json);
 }
 
-std::vector<std::string> hypocenter::geterrors() {
-	std::vector<std::string> errorlist;
+void hypocenter::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// latitude
+	if (std::isnan(latitude) != true) {
+		writer.Key(LATITUDE_KEY);
+		writer.Double(latitude);
+	}
+
+	// longitude
+	if (std::isnan(longitude) != true) {
+		writer.Key(LONGITUDE_KEY);
+		writer.Double(longitude);
+	}
+
+	// time
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
+		writer.Key(TIME_KEY);
+		writer.String(timestring, static_cast<rapidjson::SizeType>(timelength));
+	}
+
+	// depth
+	if (std::isnan(depth) != true) {
+		writer.Key(DEPTH_KEY);
+		writer.Double(depth);
+	}
+
+	// optional values
+	// latitude error
+	if (std::isnan(latitudeerror) != true) {
+		writer.Key(LATITUDE_ERROR_KEY);
+		writer.Double(latitudeerror);
+	}
+
+	// longitude error
+	if (std::isnan(longitudeerror) != true) {
+		writer.Key(LONGITUDE_ERROR_KEY);
+		writer.Double(longitudeerror);
+	}
+
+	// time error
+	if (std::isnan(timeerror) != true) {
+		writer.Key(TIME_ERROR_KEY);
+		writer.Double(timeerror);
+	}
+
+	// depth error
+	if (std::isnan(deptherror) != true) {
+		writer.Key(DEPTH_ERROR_KEY);
+		writer.Double(deptherror);
+	}
+
+	writer.EndObject();
+}
+
+// hypocenter validation error text, in hypoerror order
+static const char *hypoerrorvalues[] = {
+		"No Latitude in hypocenter class.",
+		"Invalid Latitude in hypocenter class.",
+		"No Longitude in hypocenter class.",
+		"Invalid Longitude in hypocenter class.",
+		"Time is missing in hypocenter class.",
+		"Time did not validate in hypocenter class.",
+		"No Depth in hypocenter class.",
+		"Invalid Depth in hypocenter class." };
+
+errorcodes hypocenter::validate() {
+	errorcodes errors = 0;
 
 	// check required data
 	// latitude
 	if (std::isnan(latitude) == true) {
 		// latitude not found
-		errorlist.push_back("No Latitude in hypocenter class.");
-	} else if ((latitude < -90) || (latitude > 90)) {
-		errorlist.push_back("Invalid Latitude in hypocenter class.");
+		errors |= ERRORCODE(hypoerror::hypolatitudemissing);
+	} else if ((latitude < LATITUDE_MINIMUM) || (latitude > LATITUDE_MAXIMUM)) {
+		errors |= ERRORCODE(hypoerror::hypolatitudeinvalid);
 	}
 
 	// longitude
 	if (std::isnan(longitude) == true) {
 		// longitude not found
-		errorlist.push_back("No Longitude in hypocenter class.");
-	} else if ((longitude < -180) || (longitude > 180)) {
-		errorlist.push_back("Invalid Longitude in hypocenter class.");
+		errors |= ERRORCODE(hypoerror::hypolongitudemissing);
+	} else if ((longitude < LONGITUDE_MINIMUM)
+			|| (longitude > LONGITUDE_MAXIMUM)) {
+		errors |= ERRORCODE(hypoerror::hypolongitudeinvalid);
 	}
 
 	// time
 	if (std::isnan(time) == true) {
-		errorlist.push_back("Time is missing in hypocenter class.");
-	} else {
-		try {
-			if (detectionformats::IsStringISO8601(
-					detectionformats::ConvertEpochTimeToISO8601(time))
-					== false) {
-				errorlist.push_back(
-						"Time did not validate in hypocenter class.");
-			}
-		} catch (const std::exception & e) {
-			errorlist.push_back(std::string(e.what()));
-		}
+		errors |= ERRORCODE(hypoerror::hypotimemissing);
+	} else if (detectionformats::IsEpochTimeValid(time) == false) {
+		errors |= ERRORCODE(hypoerror::hypotimeinvalid);
 	}
 
 	// depth
 	if (std::isnan(depth) == true) {
 		// depth not found
-		errorlist.push_back("No Depth in hypocenter class.");
-	} else if ((depth < -100) || (depth > 1500)) {
-		errorlist.push_back("Invalid Depth in hypocenter class.");
+		errors |= ERRORCODE(hypoerror::hypodepthmissing);
+	} else if ((depth < DEPTH_MINIMUM) || (depth > DEPTH_MAXIMUM)) {
+		errors |= ERRORCODE(hypoerror::hypodepthinvalid);
 	}
 
 	// optional keys
 	// Currently no validation criteria for optional values LatitudeError,
 	// LongitudeError, TimeError, and DepthError.
 
+	return (errors);
+}
+
+std::vector<std::string> hypocenter::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < hypoerror::hypoerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		errorlist.push_back(hypoerrorvalues[i]);
+	}
+
 	// return the list of errors
 	return (errorlist);
 }
@@ -0,0 +1,968 @@
+#include <packed.h>
+#include <keys.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace detectionformats {
+// whether a double can be written as a single precision float exactly
+static bool fitsfloat(double value) {
+	if ((std::isfinite(value) == false)
+			|| (std::fabs(value) > std::numeric_limits<float>::max())) {
+		return (false);
+	}
+	return (static_cast<double>(static_cast<float>(value)) == value);
+}
+
+static uint32_t getfloatbits(double value) {
+	float single = static_cast<float>(value);
+	uint32_t bits;
+	std::memcpy(&bits, &single, sizeof(bits));
+	return (bits);
+}
+
+static uint64_t getdoublebits(double value) {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return (bits);
+}
+
+////////////// packedwriter //////////////
+
+// writes bytes into the room of a buffer, all of its capacity being used as
+// room, so that most messages are written without growing it
+class packedwriter {
+ public:
+	explicit packedwriter(std::string *newbuffer)
+			: buffer(newbuffer) {
+		buffer->resize(std::max(buffer->capacity(),
+								static_cast<size_t>(PACKED_INITIALSIZE)));
+		position = &(*buffer)[0];
+		end = position + buffer->size();
+	}
+
+	// trims the buffer to the written message
+	std::string & finish() {
+		buffer->resize(getoffset());
+		return (*buffer);
+	}
+
+	// the number of bytes written so far
+	size_t getoffset() const {
+		return (position - &(*buffer)[0]);
+	}
+
+ protected:
+	// makes room for at least length more bytes
+	void room(size_t length) {
+		if (static_cast<size_t>(end - position) < length) {
+			size_t used = getoffset();
+			buffer->resize(std::max(buffer->size() * 2, used + length));
+			position = &(*buffer)[0] + used;
+			end = &(*buffer)[0] + buffer->size();
+		}
+	}
+
+	// writes a type byte and a big endian value of the provided number of
+	// bytes after it
+	void puttyped(uint8_t type, uint64_t value, int bytes) {
+		room(1 + bytes);
+		*position++ = static_cast<char>(type);
+		for (int i = 0; i < bytes; i++) {
+			position[i] = static_cast<char>(value >> ((bytes - 1 - i) * 8));
+		}
+		position += bytes;
+	}
+
+	void putbyte(uint8_t value) {
+		room(1);
+		*position++ = static_cast<char>(value);
+	}
+
+	void putbytes(const char *data, size_t length) {
+		room(length);
+		std::memcpy(position, data, length);
+		position += length;
+	}
+
+	// replaces the one byte header at the offset with a type byte and a big
+	// endian value of the provided number of bytes, moving the bytes after
+	// it along
+	void widen(size_t offset, uint8_t type, uint64_t value, int bytes) {
+		room(bytes);
+		char *start = &(*buffer)[0] + offset;
+		std::memmove(start + 1 + bytes, start + 1, position - (start + 1));
+		start[0] = static_cast<char>(type);
+		for (int i = 0; i < bytes; i++) {
+			start[1 + i] = static_cast<char>(value >> ((bytes - 1 - i) * 8));
+		}
+		position += bytes;
+	}
+
+	std::string *buffer;
+	char *position;
+	char *end;
+};
+
+////////////// msgpackwriter //////////////
+
+// writes values as MessagePack
+class msgpackwriter : public packedwriter {
+ public:
+	explicit msgpackwriter(std::string *newbuffer)
+			: packedwriter(newbuffer) {
+	}
+
+	void null() {
+		putbyte(0xC0);
+	}
+
+	void boolean(bool value) {
+		putbyte(value ? 0xC3 : 0xC2);
+	}
+
+	void unsignedinteger(uint64_t value) {
+		if (value < 0x80) {
+			putbyte(static_cast<uint8_t>(value));
+		} else if (value <= 0xFF) {
+			puttyped(0xCC, value, 1);
+		} else if (value <= 0xFFFF) {
+			puttyped(0xCD, value, 2);
+		} else if (value <= 0xFFFFFFFF) {
+			puttyped(0xCE, value, 4);
+		} else {
+			puttyped(0xCF, value, 8);
+		}
+	}
+
+	void integer(int64_t value) {
+		if (value >= 0) {
+			unsignedinteger(static_cast<uint64_t>(value));
+		} else if (value >= -32) {
+			putbyte(static_cast<uint8_t>(value));
+		} else if (value >= std::numeric_limits<int8_t>::min()) {
+			puttyped(0xD0, static_cast<uint64_t>(value), 1);
+		} else if (value >= std::numeric_limits<int16_t>::min()) {
+			puttyped(0xD1, static_cast<uint64_t>(value), 2);
+		} else if (value >= std::numeric_limits<int32_t>::min()) {
+			puttyped(0xD2, static_cast<uint64_t>(value), 4);
+		} else {
+			puttyped(0xD3, static_cast<uint64_t>(value), 8);
+		}
+	}
+
+	void number(double value) {
+		if (fitsfloat(value) == true) {
+			puttyped(0xCA, getfloatbits(value), 4);
+		} else {
+			puttyped(0xCB, getdoublebits(value), 8);
+		}
+	}
+
+	void string(const char *str, size_t length) {
+		if (length < 32) {
+			putbyte(static_cast<uint8_t>(0xA0 | length));
+		} else if (length <= 0xFF) {
+			puttyped(0xD9, length, 1);
+		} else if (length <= 0xFFFF) {
+			puttyped(0xDA, length, 2);
+		} else {
+			puttyped(0xDB, length, 4);
+		}
+		putbytes(str, length);
+	}
+
+	// starts a map or array whose count is not known yet, with room for a
+	// fixmap or fixarray, returns its offset
+	size_t startmap() {
+		size_t start = getoffset();
+		putbyte(0x80);
+		return (start);
+	}
+
+	size_t startarray() {
+		size_t start = getoffset();
+		putbyte(0x90);
+		return (start);
+	}
+
+	// sets the count of a map or array once it is known
+	void endmap(size_t start, size_t count) {
+		putcount(start, count, 0x80, 0xDE);
+	}
+
+	void endarray(size_t start, size_t count) {
+		putcount(start, count, 0x90, 0xDC);
+	}
+
+ private:
+	// sets the header at the offset, a count too large for the fixed type
+	// widening it to the 16 bit type, or the 32 bit one that follows it
+	void putcount(size_t start, size_t count, uint8_t fixtype,
+					uint8_t type) {
+		if (count < 16) {
+			(*buffer)[start] = static_cast<char>(fixtype | count);
+		} else if (count <= 0xFFFF) {
+			widen(start, type, count, 2);
+		} else {
+			widen(start, type + 1, count, 4);
+		}
+	}
+};
+
+////////////// cborwriter //////////////
+
+// writes values as CBOR
+class cborwriter : public packedwriter {
+ public:
+	explicit cborwriter(std::string *newbuffer)
+			: packedwriter(newbuffer) {
+	}
+
+	void null() {
+		putbyte(0xF6);
+	}
+
+	void boolean(bool value) {
+		putbyte(value ? 0xF5 : 0xF4);
+	}
+
+	void unsignedinteger(uint64_t value) {
+		puthead(0, value);
+	}
+
+	void integer(int64_t value) {
+		if (value >= 0) {
+			puthead(0, static_cast<uint64_t>(value));
+		} else {
+			// negative integers are written as -1 - value
+			puthead(1, ~static_cast<uint64_t>(value));
+		}
+	}
+
+	void number(double value) {
+		if (fitsfloat(value) == true) {
+			puttyped(0xFA, getfloatbits(value), 4);
+		} else {
+			puttyped(0xFB, getdoublebits(value), 8);
+		}
+	}
+
+	void string(const char *str, size_t length) {
+		puthead(3, length);
+		putbytes(str, length);
+	}
+
+	// starts a map or array whose count is not known yet, with room for a
+	// count below 24, returns its offset
+	size_t startmap() {
+		size_t start = getoffset();
+		putbyte(0xA0);
+		return (start);
+	}
+
+	size_t startarray() {
+		size_t start = getoffset();
+		putbyte(0x80);
+		return (start);
+	}
+
+	// sets the count of a map or array once it is known
+	void endmap(size_t start, size_t count) {
+		putcount(start, 5, count);
+	}
+
+	void endarray(size_t start, size_t count) {
+		putcount(start, 4, count);
+	}
+
+ private:
+	// writes a major type and its argument in the shortest form
+	void puthead(int major, uint64_t value) {
+		uint8_t type = static_cast<uint8_t>(major << 5);
+		if (value < 24) {
+			putbyte(static_cast<uint8_t>(type | value));
+		} else if (value <= 0xFF) {
+			puttyped(type | 24, value, 1);
+		} else if (value <= 0xFFFF) {
+			puttyped(type | 25, value, 2);
+		} else if (value <= 0xFFFFFFFF) {
+			puttyped(type | 26, value, 4);
+		} else {
+			puttyped(type | 27, value, 8);
+		}
+	}
+
+	// sets the head at the offset, a count of 24 or more widening it
+	void putcount(size_t start, int major, uint64_t count) {
+		uint8_t type = static_cast<uint8_t>(major << 5);
+		if (count < 24) {
+			(*buffer)[start] = static_cast<char>(type | count);
+		} else if (count <= 0xFF) {
+			widen(start, type | 24, count, 1);
+		} else if (count <= 0xFFFF) {
+			widen(start, type | 25, count, 2);
+		} else if (count <= 0xFFFFFFFF) {
+			widen(start, type | 26, count, 4);
+		} else {
+			widen(start, type | 27, count, 8);
+		}
+	}
+};
+
+////////////// packedhandler //////////////
+
+// takes the json events of write() or rapidjson's Accept() and writes them
+// with a MessagePack or CBOR writer. Maps and arrays are started before
+// their counts are known, so the values written into each are counted and
+// its header is set when it ends
+template<class W>
+class packedhandler final : public jsonhandler {
+ public:
+	explicit packedhandler(std::string *buffer)
+			: writer(buffer),
+				depth(0) {
+	}
+
+	std::string & finish() {
+		return (writer.finish());
+	}
+
+	bool Null() {
+		count();
+		writer.null();
+		return (true);
+	}
+
+	bool Bool(bool b) override {
+		count();
+		writer.boolean(b);
+		return (true);
+	}
+
+	bool Int(int i) {
+		return (Int64(i));
+	}
+
+	bool Uint(unsigned u) {
+		return (Uint64(u));
+	}
+
+	bool Int64(int64_t i) {
+		count();
+		writer.integer(i);
+		return (true);
+	}
+
+	bool Uint64(uint64_t u) {
+		count();
+		writer.unsignedinteger(u);
+		return (true);
+	}
+
+	bool Double(double d) override {
+		count();
+		writer.number(d);
+		return (true);
+	}
+
+	bool String(const char *str, rapidjson::SizeType length,
+				bool) override {
+		count();
+		writer.string(str, length);
+		return (true);
+	}
+
+	// a key is not counted, the member is counted by its value
+	bool Key(const char *str, rapidjson::SizeType length,
+				bool) override {
+		writer.string(str, length);
+		return (true);
+	}
+
+	bool StartObject() override {
+		start(writer.startmap());
+		return (true);
+	}
+
+	bool EndObject(rapidjson::SizeType) override {
+		depth--;
+		writer.endmap(starts[depth], counts[depth]);
+		return (true);
+	}
+
+	bool StartArray() override {
+		start(writer.startarray());
+		return (true);
+	}
+
+	bool EndArray(rapidjson::SizeType) override {
+		depth--;
+		writer.endarray(starts[depth], counts[depth]);
+		return (true);
+	}
+
+ private:
+	// counts a value in the map or array it is written into
+	void count() {
+		if (depth > 0) {
+			counts[depth - 1]++;
+		}
+	}
+
+	// counts a map or array, then makes it the one values are written into,
+	// no deeper than the readers accept
+	void start(size_t offset) {
+		if (depth == PACKED_MAXDEPTH) {
+			throw std::invalid_argument(
+					"Value is nested too deeply to be packed.");
+		}
+		count();
+		starts[depth] = offset;
+		counts[depth] = 0;
+		depth++;
+	}
+
+	W writer;
+	size_t starts[PACKED_MAXDEPTH];
+	size_t counts[PACKED_MAXDEPTH];
+	int depth;
+};
+
+////////////// reading //////////////
+
+// a position in a packed message, its end, and the current nesting
+struct packedreader {
+	const char *position;
+	const char *end;
+	int depth;
+};
+
+// reads a big endian value of the provided number of bytes
+static bool getbig(packedreader &reader, int bytes, // NOLINT
+					uint64_t *value) {
+	if (reader.end - reader.position < bytes) {
+		return (false);
+	}
+	*value = 0;
+	for (int i = 0; i < bytes; i++) {
+		*value = (*value << 8) | static_cast<uint8_t>(reader.position[i]);
+	}
+	reader.position += bytes;
+	return (true);
+}
+
+// takes a string of the provided length from the message
+static bool getstring(packedreader &reader, uint64_t length, // NOLINT
+						const char **str) {
+	if ((static_cast<uint64_t>(reader.end - reader.position) < length)
+			|| (length > std::numeric_limits<rapidjson::SizeType>::max())) {
+		return (false);
+	}
+	*str = reader.position;
+	reader.position += length;
+	return (true);
+}
+
+// sends integers to the handler the same way the json reader does
+template<class Handler>
+static bool sendunsigned(Handler &handler, uint64_t value) { // NOLINT
+	if (value <= std::numeric_limits<unsigned>::max()) {
+		return (handler.Uint(static_cast<unsigned>(value)));
+	}
+	return (handler.Uint64(value));
+}
+
+template<class Handler>
+static bool sendsigned(Handler &handler, int64_t value) { // NOLINT
+	if (value >= 0) {
+		return (sendunsigned(handler, static_cast<uint64_t>(value)));
+	}
+	if (value >= std::numeric_limits<int>::min()) {
+		return (handler.Int(static_cast<int>(value)));
+	}
+	return (handler.Int64(value));
+}
+
+template<class Handler>
+static bool sendfloat(Handler &handler, uint64_t bits) { // NOLINT
+	uint32_t singlebits = static_cast<uint32_t>(bits);
+	float single;
+	std::memcpy(&single, &singlebits, sizeof(single));
+	return (handler.Double(static_cast<double>(single)));
+}
+
+template<class Handler>
+static bool senddouble(Handler &handler, uint64_t bits) { // NOLINT
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return (handler.Double(value));
+}
+
+////////////// MessagePack //////////////
+
+// reads a MessagePack string header, for the type already read, and its
+// string, returns false if the type is not a string
+static bool getmsgpackstring(packedreader &reader, uint8_t type, // NOLINT
+								const char **str, size_t *length) {
+	uint64_t value;
+	if ((type & 0xE0) == 0xA0) {
+		value = type & 0x1F;
+	} else if ((type < 0xD9) || (type > 0xDB)
+			|| (getbig(reader, 1 << (type - 0xD9), &value) == false)) {
+		return (false);
+	}
+
+	*length = static_cast<size_t>(value);
+	return (getstring(reader, value, str));
+}
+
+template<class Handler>
+static bool readmsgpack(packedreader &reader, Handler &handler) { // NOLINT
+	uint64_t value;
+	if (getbig(reader, 1, &value) == false) {
+		return (false);
+	}
+	uint8_t type = static_cast<uint8_t>(value);
+
+	// the fixed types
+	if (type < 0x80) {
+		return (sendunsigned(handler, type));
+	}
+	if (type >= 0xE0) {
+		return (handler.Int(static_cast<int8_t>(type)));
+	}
+
+	const char *str;
+	size_t length;
+	if (getmsgpackstring(reader, type, &str, &length) == true) {
+		return (handler.String(str, static_cast<rapidjson::SizeType>(length),
+								true));
+	}
+
+	uint64_t count;
+	bool ismap;
+	if (type < 0xA0) {
+		ismap = (type < 0x90);
+		count = type & 0x0F;
+	} else if ((type >= 0xDC) && (type <= 0xDF)) {
+		ismap = (type >= 0xDE);
+		if (getbig(reader, ((type & 0x01) == 0) ? 2 : 4, &count) == false) {
+			return (false);
+		}
+	} else {
+		switch (type) {
+			case 0xC0:
+				return (handler.Null());
+			case 0xC2:
+				return (handler.Bool(false));
+			case 0xC3:
+				return (handler.Bool(true));
+			case 0xCA:
+				return (getbig(reader, 4, &value)
+						&& sendfloat(handler, value));
+			case 0xCB:
+				return (getbig(reader, 8, &value)
+						&& senddouble(handler, value));
+			case 0xCC:
+			case 0xCD:
+			case 0xCE:
+			case 0xCF:
+				return (getbig(reader, 1 << (type - 0xCC), &value)
+						&& sendunsigned(handler, value));
+			case 0xD0:
+				return (getbig(reader, 1, &value)
+						&& sendsigned(handler, static_cast<int8_t>(value)));
+			case 0xD1:
+				return (getbig(reader, 2, &value)
+						&& sendsigned(handler, static_cast<int16_t>(value)));
+			case 0xD2:
+				return (getbig(reader, 4, &value)
+						&& sendsigned(handler, static_cast<int32_t>(value)));
+			case 0xD3:
+				return (getbig(reader, 8, &value)
+						&& sendsigned(handler, static_cast<int64_t>(value)));
+			default:
+				// binary, extension, and unused types have no json
+				return (false);
+		}
+	}
+
+	if (++reader.depth > PACKED_MAXDEPTH) {
+		return (false);
+	}
+
+	if (ismap == true) {
+		if (handler.StartObject() == false) {
+			return (false);
+		}
+		for (uint64_t i = 0; i < count; i++) {
+			// keys must be strings, as in json
+			if ((getbig(reader, 1, &value) == false)
+					|| (getmsgpackstring(reader, static_cast<uint8_t>(value),
+											&str, &length) == false)
+					|| (handler.Key(str,
+									static_cast<rapidjson::SizeType>(length),
+									true) == false)
+					|| (readmsgpack(reader, handler) == false)) {
+				return (false);
+			}
+		}
+		reader.depth--;
+		return (handler.EndObject(static_cast<rapidjson::SizeType>(count)));
+	}
+
+	if (handler.StartArray() == false) {
+		return (false);
+	}
+	for (uint64_t i = 0; i < count; i++) {
+		if (readmsgpack(reader, handler) == false) {
+			return (false);
+		}
+	}
+	reader.depth--;
+	return (handler.EndArray(static_cast<rapidjson::SizeType>(count)));
+}
+
+////////////// CBOR //////////////
+
+// the byte that ends an indefinite length array or map
+static const uint8_t cborbreak = 0xFF;
+
+// converts a CBOR half precision float
+static double gethalf(uint64_t bits) {
+	int exponent = static_cast<int>((bits >> 10) & 0x1F);
+	double mantissa = static_cast<double>(bits & 0x3FF);
+	double value;
+	if (exponent == 0) {
+		value = std::ldexp(mantissa, -24);
+	} else if (exponent == 31) {
+		value = (mantissa == 0) ? std::numeric_limits<double>::infinity()
+				: std::numeric_limits<double>::quiet_NaN();
+	} else {
+		value = std::ldexp(mantissa + 1024, exponent - 25);
+	}
+	return (((bits & 0x8000) != 0) ? -value : value);
+}
+
+// reads the argument of a CBOR head, returns false if it is indefinite or
+// reserved
+static bool getcborargument(packedreader &reader, int info, // NOLINT
+							uint64_t *value) {
+	if (info < 24) {
+		*value = static_cast<uint64_t>(info);
+		return (true);
+	}
+	if (info > 27) {
+		return (false);
+	}
+	return (getbig(reader, 1 << (info - 24), value));
+}
+
+// reads a CBOR text string of definite length
+static bool getcborstring(packedreader &reader, const char **str, // NOLINT
+							size_t *length) {
+	uint64_t value;
+	if ((getbig(reader, 1, &value) == false) || ((value >> 5) != 3)
+			|| (getcborargument(reader, static_cast<int>(value & 0x1F),
+								&value) == false)) {
+		return (false);
+	}
+
+	*length = static_cast<size_t>(value);
+	return (getstring(reader, value, str));
+}
+
+// whether the next byte ends an indefinite length array or map, which is
+// skipped if so
+static bool getcborbreak(packedreader &reader) { // NOLINT
+	if ((reader.position < reader.end)
+			&& (static_cast<uint8_t>(*reader.position) == cborbreak)) {
+		reader.position++;
+		return (true);
+	}
+	return (false);
+}
+
+template<class Handler>
+static bool readcbor(packedreader &reader, Handler &handler) { // NOLINT
+	uint64_t value;
+	if (getbig(reader, 1, &value) == false) {
+		return (false);
+	}
+	int major = static_cast<int>(value >> 5);
+	int info = static_cast<int>(value & 0x1F);
+
+	if (major == 7) {
+		switch (info) {
+			case 20:
+				return (handler.Bool(false));
+			case 21:
+				return (handler.Bool(true));
+			case 22:
+			case 23:
+				// null and undefined
+				return (handler.Null());
+			case 25:
+				return (getbig(reader, 2, &value)
+						&& handler.Double(gethalf(value)));
+			case 26:
+				return (getbig(reader, 4, &value)
+						&& sendfloat(handler, value));
+			case 27:
+				return (getbig(reader, 8, &value)
+						&& senddouble(handler, value));
+			default:
+				return (false);
+		}
+	}
+
+	// only arrays and maps may have an indefinite length
+	bool indefinite = ((info == 31) && ((major == 4) || (major == 5)));
+	uint64_t count = 0;
+	if ((indefinite == false)
+			&& (getcborargument(reader, info, &value) == false)) {
+		return (false);
+	}
+
+	const char *str;
+	size_t length;
+	switch (major) {
+		case 0:
+			return (sendunsigned(handler, value));
+		case 1:
+			if (value > static_cast<uint64_t>(
+					std::numeric_limits<int64_t>::max())) {
+				return (false);
+			}
+			return (sendsigned(handler, -1 - static_cast<int64_t>(value)));
+		case 2:
+			// byte strings have no json
+			return (false);
+		case 3:
+			length = static_cast<size_t>(value);
+			return (getstring(reader, value, &str)
+					&& handler.String(str,
+							static_cast<rapidjson::SizeType>(length), true));
+		case 6:
+			// tags only describe the item that follows
+			if (++reader.depth > PACKED_MAXDEPTH) {
+				return (false);
+			}
+			if (readcbor(reader, handler) == false) {
+				return (false);
+			}
+			reader.depth--;
+			return (true);
+		default:
+			break;
+	}
+
+	if (++reader.depth > PACKED_MAXDEPTH) {
+		return (false);
+	}
+
+	if (major == 5) {
+		if (handler.StartObject() == false) {
+			return (false);
+		}
+		for (; (indefinite == true) ? (getcborbreak(reader) == false)
+				: (count < value); count++) {
+			// keys must be strings, as in json
+			if ((getcborstring(reader, &str, &length) == false)
+					|| (handler.Key(str,
+									static_cast<rapidjson::SizeType>(length),
+									true) == false)
+					|| (readcbor(reader, handler) == false)) {
+				return (false);
+			}
+		}
+		reader.depth--;
+		return (handler.EndObject(static_cast<rapidjson::SizeType>(count)));
+	}
+
+	if (handler.StartArray() == false) {
+		return (false);
+	}
+	for (; (indefinite == true) ? (getcborbreak(reader) == false)
+			: (count < value); count++) {
+		if (readcbor(reader, handler) == false) {
+			return (false);
+		}
+	}
+	reader.depth--;
+	return (handler.EndArray(static_cast<rapidjson::SizeType>(count)));
+}
+
+////////////// functions //////////////
+
+// sends the single value in the message to the handler
+template<class Handler>
+static bool readpacked(const char *data, size_t length, bool iscbor,
+						Handler &handler) { // NOLINT
+	if (data == NULL) {
+		return (false);
+	}
+
+	packedreader reader = { data, data + length, 0 };
+	bool result = (iscbor == true) ? readcbor(reader, handler)
+			: readmsgpack(reader, handler);
+
+	// nothing may follow the value
+	return ((result == true) && (reader.position == reader.end));
+}
+
+// reads a message into a document, see rapidjson::Document::Populate()
+class packedgenerator {
+ public:
+	packedgenerator(const char *newdata, size_t newlength, bool newiscbor)
+			: data(newdata),
+				length(newlength),
+				iscbor(newiscbor),
+				result(false) {
+	}
+
+	bool operator()(codecdocument &handler) { // NOLINT
+		result = readpacked(data, length, iscbor, handler);
+		return (result);
+	}
+
+	const char *data;
+	size_t length;
+	bool iscbor;
+	bool result;
+};
+
+static codecdocument & readdocument(const char *data, size_t length,
+									bool iscbor,
+									codec_context &context) { // NOLINT
+	context.reset();
+	packedgenerator generator(data, length, iscbor);
+	codecdocument & document = context.getdocument();
+	document.Populate(generator);
+
+	if ((generator.result == false) || (document.IsObject() == false)) {
+		throw std::invalid_argument(
+				"Packed message did not read into a valid object.");
+	}
+	return (document);
+}
+
+template<class T>
+static T & readobject(const char *data, size_t length, bool iscbor,
+						T &object, codec_context &context) { // NOLINT
+	context.getdecoder().settarget(&object);
+	if (readpacked(data, length, iscbor, context.getdecoder()) == false) {
+		throw std::invalid_argument(
+				"Error reading packed message into object.");
+	}
+	return (object);
+}
+
+std::string & ToMessagePack(detectionbase &object,
+							std::string &buffer) { // NOLINT
+	packedhandler<msgpackwriter> handler(&buffer);
+	object.write(handler);
+	return (handler.finish());
+}
+
+std::string & ToMessagePack(const rapidjson::Value &json,
+							std::string &buffer) { // NOLINT
+	packedhandler<msgpackwriter> handler(&buffer);
+	json.Accept(handler);
+	return (handler.finish());
+}
+
+std::string & ToCBOR(detectionbase &object, std::string &buffer) { // NOLINT
+	packedhandler<cborwriter> handler(&buffer);
+	object.write(handler);
+	return (handler.finish());
+}
+
+std::string & ToCBOR(const rapidjson::Value &json,
+						std::string &buffer) { // NOLINT
+	packedhandler<cborwriter> handler(&buffer);
+	json.Accept(handler);
+	return (handler.finish());
+}
+
+codecdocument & FromMessagePack(const char *data, size_t length,
+								codec_context &context) { // NOLINT
+	return (readdocument(data, length, false, context));
+}
+
+codecdocument & FromCBOR(const char *data, size_t length,
+							codec_context &context) { // NOLINT
+	return (readdocument(data, length, true, context));
+}
+
+pick & FromMessagePack(const char *data, size_t length, pick &object,
+						codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+correlation & FromMessagePack(const char *data, size_t length,
+								correlation &object,
+								codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+detection & FromMessagePack(const char *data, size_t length,
+							detection &object,
+							codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+retract & FromMessagePack(const char *data, size_t length, retract &object,
+							codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+stationInfo & FromMessagePack(const char *data, size_t length,
+								stationInfo &object,
+								codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+stationInfoRequest & FromMessagePack(const char *data, size_t length,
+										stationInfoRequest &object,
+										codec_context &context) { // NOLINT
+	return (readobject(data, length, false, object, context));
+}
+
+pick & FromCBOR(const char *data, size_t length, pick &object,
+				codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+
+correlation & FromCBOR(const char *data, size_t length, correlation &object,
+						codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+
+detection & FromCBOR(const char *data, size_t length, detection &object,
+						codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+
+retract & FromCBOR(const char *data, size_t length, retract &object,
+					codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+
+stationInfo & FromCBOR(const char *data, size_t length, stationInfo &object,
+						codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+
+stationInfoRequest & FromCBOR(const char *data, size_t length,
+								stationInfoRequest &object,
+								codec_context &context) { // NOLINT
+	return (readobject(data, length, true, object, context));
+}
+}  // namespace detectionformats
@@ -1,24 +1,11 @@
 #include <pick.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define ID_KEY "ID"
-#define SITE_KEY "Site"
-#define SOURCE_KEY "Source"
-#define TIME_KEY "Time"
-#define PHASE_KEY "Phase"
-#define POLARITY_KEY "Polarity"
-#define ONSET_KEY "Onset"
-#define PICKER_KEY "Picker"
-#define FILTER_KEY "Filter"
-#define AMPLITUDE_KEY "Amplitude"
-#define BEAM_KEY "Beam"
-#define ASSOCIATIONINFO_KEY "AssociationInfo"
-#define CLASSIFICATIONINFO_KEY "ClassificationInfo"
-
 namespace detectionformats {
 pick::pick() {
 	type = PICK_TYPE;
@@ -27,9 +14,9 @@ pick::pick() {
 	time = std::numeric_limits<double>::quiet_NaN();
 	source = detectionformats::source();
 	phase = "";
-	polarity = "";
-	onset = "";
-	picker = "";
+	polarity = polarityindex::polaritycount;
+	onset = onsetindex::onsetcount;
+	picker = pickerindex::pickercount;
 	filterdata.clear();
 	amplitude = detectionformats::amplitude();
 	beam = detectionformats::beam();
@@ -62,19 +49,24 @@ pick::pick(std::string newid, std::string newstation, std::string newchannel,
 			std::string newclassificationagencyid,
             std::string newclassificationauthor) {
 	type = PICK_TYPE;
-	id = newid;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation);
+	id = std::move(newid);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation));
 	time = newtime;
-	source = detectionformats::source(newagencyid, newauthor);
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
 	filterdata.clear();
-	filterdata.push_back(detectionformats::filter(newfiltertype, newhighpass,
-		newlowpass, newfilterunits));
+	filterdata.push_back(detectionformats::filter(std::move(newfiltertype),
+			newhighpass, newlowpass, std::move(newfilterunits)));
 
 	amplitude = detectionformats::amplitude(newamplitude, newperiod, newsnr);
 
@@ -82,20 +74,20 @@ pick::pick(std::string newid, std::string newstation, std::string newchannel,
 									newslowness, newslownesserror,
 									newpowerratio, newpowerratioerror);
 
-	associationinfo = detectionformats::association(newassociationphase,
-													newassociationdistance,
-													newassociationazimuth,
-													newassociationresidual,
-													newassociationsigma);
+	associationinfo = detectionformats::association(
+			std::move(newassociationphase), newassociationdistance,
+			newassociationazimuth, newassociationresidual, newassociationsigma);
 	classificationinfo = detectionformats::classification(
-			newclassificationphase, newclassificationphaseprob,
-            newclassificationdistance, newclassificationdistanceprob,
+			std::move(newclassificationphase), newclassificationphaseprob,
+			newclassificationdistance, newclassificationdistanceprob,
 			newclassificationazimuth, newclassificationazimuthprob,
-			newclassificationmagnitude, newclassificationmagtype,
-            newclassificationmagprob, newclassificationdepth,
-			newclassificationdepthprob,	newclassificationeventtype,
-			newclassificationeventtypecertainty, newclassificationeventtypeprob,
-			newclassificationagencyid, newclassificationauthor);
+			newclassificationmagnitude, std::move(newclassificationmagtype),
+			newclassificationmagprob, newclassificationdepth,
+			newclassificationdepthprob, std::move(newclassificationeventtype),
+			std::move(newclassificationeventtypecertainty),
+			newclassificationeventtypeprob,
+			std::move(newclassificationagencyid),
+			std::move(newclassificationauthor));
 }
 
 pick::pick(std::string newid, std::string newstation, std::string newchannel,
@@ -109,19 +101,24 @@ pick::pick(std::string newid, std::string newstation, std::string newchannel,
 			double newslowness, double newslownesserror, double newpowerratio,
 			double newpowerratioerror) {
 	type = PICK_TYPE;
-	id = newid;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation);
+	id = std::move(newid);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation));
 	time = newtime;
-	source = detectionformats::source(newagencyid, newauthor);
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
 	filterdata.clear();
-	filterdata.push_back(detectionformats::filter(newfiltertype, newhighpass,
-		newlowpass, newfilterunits));
+	filterdata.push_back(detectionformats::filter(std::move(newfiltertype),
+			newhighpass, newlowpass, std::move(newfilterunits)));
 
 	amplitude = detectionformats::amplitude(newamplitude, newperiod, newsnr);
 
@@ -141,23 +138,24 @@ pick::pick(std::string newid, detectionformats::site newsite, double newtime,
 			detectionformats::amplitude newamplitude,
 			detectionformats::beam newbeam) {
 	type = PICK_TYPE;
-	id = newid;
-	pick::site = newsite;
+	id = std::move(newid);
+	pick::site = std::move(newsite);
 	time = newtime;
-	pick::source = newsource;
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	pick::source = std::move(newsource);
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
-	filterdata.clear();
-	for (int i = 0; i < static_cast<int>(newfilterdata.size()); i++) {
-		filterdata.push_back(newfilterdata[i]);
-	}
+	filterdata = std::move(newfilterdata);
 
-	pick::amplitude = newamplitude;
+	pick::amplitude = std::move(newamplitude);
 
-	pick::beam = newbeam;
+	pick::beam = std::move(newbeam);
 
 	pick::associationinfo = detectionformats::association();
 
@@ -173,27 +171,28 @@ pick::pick(std::string newid, detectionformats::site newsite, double newtime,
 			detectionformats::beam newbeam,
 			detectionformats::classification newclassification) {
 	type = PICK_TYPE;
-	id = newid;
-	pick::site = newsite;
+	id = std::move(newid);
+	pick::site = std::move(newsite);
 	time = newtime;
-	pick::source = newsource;
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	pick::source = std::move(newsource);
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
-	filterdata.clear();
-	for (int i = 0; i < static_cast<int>(newfilterdata.size()); i++) {
-		filterdata.push_back(newfilterdata[i]);
-	}
+	filterdata = std::move(newfilterdata);
 
-	pick::amplitude = newamplitude;
+	pick::amplitude = std::move(newamplitude);
 
-	pick::beam = newbeam;
+	pick::beam = std::move(newbeam);
 
 	pick::associationinfo = detectionformats::association();
 
-	classificationinfo = newclassification;
+	classificationinfo = std::move(newclassification);
 }
 
 pick::pick(std::string newid, detectionformats::site newsite, double newtime,
@@ -205,25 +204,26 @@ pick::pick(std::string newid, detectionformats::site newsite, double newtime,
 			detectionformats::beam newbeam,
 			detectionformats::association newassociation) {
 	type = PICK_TYPE;
-	id = newid;
-	site = newsite;
+	id = std::move(newid);
+	site = std::move(newsite);
 	time = newtime;
-	source = newsource;
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	source = std::move(newsource);
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
-	filterdata.clear();
-	for (int i = 0; i < static_cast<int>(newfilterdata.size()); i++) {
-		filterdata.push_back(newfilterdata[i]);
-	}
+	filterdata = std::move(newfilterdata);
 
-	amplitude = newamplitude;
+	amplitude = std::move(newamplitude);
 
-	pick::beam = newbeam;
+	pick::beam = std::move(newbeam);
 
-	associationinfo = newassociation;
+	associationinfo = std::move(newassociation);
 
 	classificationinfo = detectionformats::classification();
 }
@@ -238,190 +238,169 @@ pick::pick(std::string newid, detectionformats::site newsite, double newtime,
 			detectionformats::association newassociation,
 			detectionformats::classification newclassification) {
 	type = PICK_TYPE;
-	id = newid;
-	site = newsite;
+	id = std::move(newid);
+	site = std::move(newsite);
 	time = newtime;
-	source = newsource;
-	phase = newphase;
-	polarity = newpolarity;
-	onset = newonset;
-	picker = newpicker;
+	source = std::move(newsource);
+	phase = std::move(newphase);
+	polarity = GetPolarityIndex(newpolarity.c_str(), newpolarity.length());
+	SetUnknownText(polarity, newpolarity.c_str(), newpolarity.length(),
+			&polaritytext);
+	onset = GetOnsetIndex(newonset.c_str(), newonset.length());
+	SetUnknownText(onset, newonset.c_str(), newonset.length(), &onsettext);
+	picker = GetPickerIndex(newpicker.c_str(), newpicker.length());
+	SetUnknownText(picker, newpicker.c_str(), newpicker.length(), &pickertext);
 
-	filterdata.clear();
-	for (int i = 0; i < static_cast<int>(newfilterdata.size()); i++) {
-		filterdata.push_back(newfilterdata[i]);
-	}
+	filterdata = std::move(newfilterdata);
 
-	amplitude = newamplitude;
+	amplitude = std::move(newamplitude);
 
-	pick::beam = newbeam;
+	pick::beam = std::move(newbeam);
 
-	associationinfo = newassociation;
+	associationinfo = std::move(newassociation);
 
-	classificationinfo = newclassification;
+	classificationinfo = std::move(newclassification);
 }
 
 pick::pick(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	} else {
-		type = "";
-	}
+	// values that are missing from the json
+	type = "";
+	id = "";
+	time = std::numeric_limits<double>::quiet_NaN();
+	polarity = polarityindex::polaritycount;
+	onset = onsetindex::onsetcount;
+	picker = pickerindex::pickercount;
+	filterdata.clear();
 
-	// id
-	if ((json.HasMember(ID_KEY) == true) && (json[ID_KEY].IsString() == true)) {
-		id = std::string(json[ID_KEY].GetString(),
-							json[ID_KEY].GetStringLength());
-	} else {
-		id = "";
-	}
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (pickkeytable.find(member->name.GetString(),
+									member->name.GetStringLength())) {
+			// required values
+			// type
+			case pickkeyindex::picktypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(), value.GetStringLength());
+				}
+				break;
 
-	// site
-	if ((json.HasMember(SITE_KEY) == true)
-			&& (json[SITE_KEY].IsObject() == true)) {
-		rapidjson::Value & sitevalue = json["Site"];
-		site = detectionformats::site(sitevalue);
-	} else {
-		site = detectionformats::site();
-	}
+			// id
+			case pickkeyindex::pickidkey:
+				if (value.IsString() == true) {
+					id = std::string(value.GetString(), value.GetStringLength());
+				}
+				break;
 
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
-	}
+			// site
+			case pickkeyindex::picksitekey:
+				if (value.IsObject() == true) {
+					site = detectionformats::site(value);
+				}
+				break;
 
-	// time
-	if ((json.HasMember(TIME_KEY) == true)
-			&& (json[TIME_KEY].IsString() == true)) {
-		time = detectionformats::ConvertISO8601ToEpochTime(
-				std::string(json[TIME_KEY].GetString(),
-							json[TIME_KEY].GetStringLength()));
-	} else {
-		time = std::numeric_limits<double>::quiet_NaN();
-	}
+			// source
+			case pickkeyindex::picksourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
 
-	// optional values
-	// phase
-	if ((json.HasMember(PHASE_KEY) == true)
-			&& (json[PHASE_KEY].IsString() == true)) {
-		phase = std::string(json[PHASE_KEY].GetString(),
-							json[PHASE_KEY].GetStringLength());
-	} else {
-		phase = "";
-	}
+			// time
+			case pickkeyindex::picktimekey:
+				if (value.IsString() == true) {
+					time = detectionformats::ConvertISO8601ToEpochTime(
+							value.GetString(), value.GetStringLength());
+				}
+				break;
 
-	// polarity
-	if ((json.HasMember(POLARITY_KEY) == true)
-			&& (json[POLARITY_KEY].IsString() == true)) {
-		polarity = std::string(json[POLARITY_KEY].GetString(),
-								json[POLARITY_KEY].GetStringLength());
-	} else {
-		polarity = "";
-	}
+			// optional values
+			// phase
+			case pickkeyindex::pickphasekey:
+				if (value.IsString() == true) {
+					phase = std::string(value.GetString(),
+										value.GetStringLength());
+				}
+				break;
 
-	// onset
-	if ((json.HasMember(ONSET_KEY) == true)
-			&& (json[ONSET_KEY].IsString() == true)) {
-		onset = std::string(json[ONSET_KEY].GetString(),
-							json[ONSET_KEY].GetStringLength());
-	} else {
-		onset = "";
-	}
+			// polarity
+			case pickkeyindex::pickpolaritykey:
+				if (value.IsString() == true) {
+					polarity = GetPolarityIndex(value.GetString(),
+												value.GetStringLength());
+					SetUnknownText(polarity, value.GetString(),
+							value.GetStringLength(), &polaritytext);
+				}
+				break;
 
-	// picker
-	if ((json.HasMember(PICKER_KEY) == true)
-			&& (json[PICKER_KEY].IsString() == true)) {
-		picker = std::string(json[PICKER_KEY].GetString(),
-								json[PICKER_KEY].GetStringLength());
-	} else {
-		picker = "";
-	}
+			// onset
+			case pickkeyindex::pickonsetkey:
+				if (value.IsString() == true) {
+					onset = GetOnsetIndex(value.GetString(),
+											value.GetStringLength());
+					SetUnknownText(onset, value.GetString(),
+							value.GetStringLength(), &onsettext);
+				}
+				break;
 
-	// filter
-	filterdata.clear();
-	if ((json.HasMember(FILTER_KEY) == true)
-			&& (json[FILTER_KEY].IsArray() == true)) {
-		rapidjson::Value dataarray;
-		dataarray = json[FILTER_KEY].GetArray();
-
-		for (rapidjson::SizeType i = 0; i < dataarray.Size(); i++) {
-			// parse
-			rapidjson::Value & datavalue = dataarray[i];
-			detectionformats::filter newfilter(datavalue);
-
-			// add to vector
-			filterdata.push_back(newfilter);
-		}
-	}
+			// picker
+			case pickkeyindex::pickpickerkey:
+				if (value.IsString() == true) {
+					picker = GetPickerIndex(value.GetString(),
+											value.GetStringLength());
+					SetUnknownText(picker, value.GetString(),
+							value.GetStringLength(), &pickertext);
+				}
+				break;
 
-	// amplitude
-	if ((json.HasMember(AMPLITUDE_KEY) == true)
-			&& (json[AMPLITUDE_KEY].IsObject() == true)) {
-		rapidjson::Value & amplitudevalue = json[AMPLITUDE_KEY];
-		amplitude = detectionformats::amplitude(amplitudevalue);
-	} else {
-		amplitude = detectionformats::amplitude();
-	}
+			// filter
+			case pickkeyindex::pickfilterkey:
+				if (value.IsArray() == true) {
+					for (rapidjson::SizeType i = 0; i < value.Size(); i++) {
+						// only filter objects can be parsed
+						if (value[i].IsObject() == true) {
+							filterdata.push_back(
+									detectionformats::filter(value[i]));
+						}
+					}
+				}
+				break;
 
-	// beam
-	if ((json.HasMember(BEAM_KEY) == true)
-			&& (json[BEAM_KEY].IsObject() == true)) {
-		rapidjson::Value & beamvalue = json[BEAM_KEY];
-		beam = detectionformats::beam(beamvalue);
-	} else {
-		beam = detectionformats::beam();
-	}
+			// amplitude
+			case pickkeyindex::pickamplitudekey:
+				if (value.IsObject() == true) {
+					amplitude = detectionformats::amplitude(value);
+				}
+				break;
 
-	// association
-	if ((json.HasMember(ASSOCIATIONINFO_KEY) == true)
-			&& (json[ASSOCIATIONINFO_KEY].IsObject() == true)) {
-		rapidjson::Value & associationvalue = json[ASSOCIATIONINFO_KEY];
-		associationinfo = detectionformats::association(associationvalue);
-	} else {
-		associationinfo = detectionformats::association();
-	}
+			// beam
+			case pickkeyindex::pickbeamkey:
+				if (value.IsObject() == true) {
+					beam = detectionformats::beam(value);
+				}
+				break;
 
-	// classification
-	if ((json.HasMember(CLASSIFICATIONINFO_KEY) == true)
-			&& (json[CLASSIFICATIONINFO_KEY].IsObject() == true)) {
-		rapidjson::Value & associationvalue = json[CLASSIFICATIONINFO_KEY];
-		classificationinfo = detectionformats::classification(associationvalue);
-	} else {
-		classificationinfo = detectionformats::classification();
-	}
-}
+			// association
+			case pickkeyindex::pickassociationkey:
+				if (value.IsObject() == true) {
+					associationinfo = detectionformats::association(value);
+				}
+				break;
 
-pick::pick(const pick &newpick) {
-	type = PICK_TYPE;
-	id = newpick.id;
-	site = newpick.site;
-	time = newpick.time;
-	source = newpick.source;
-	phase = newpick.phase;
-	polarity = newpick.polarity;
-	onset = newpick.onset;
-	picker = newpick.picker;
+			// classification
+			case pickkeyindex::pickclassificationkey:
+				if (value.IsObject() == true) {
+					classificationinfo = detectionformats::classification(value);
+				}
+				break;
 
-	filterdata.clear();
-	for (int i = 0; i < static_cast<int>(newpick.filterdata.size()); i++) {
-		filterdata.push_back(newpick.filterdata[i]);
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
-
-	amplitude = newpick.amplitude;
-
-	beam = newpick.beam;
-
-	associationinfo = newpick.associationinfo;
-
-	classificationinfo = newpick.classificationinfo;
 }
 
 pick::~pick() {
@@ -456,11 +435,12 @@ rapidjson::Value & pick::tojson(
 	json.AddMember(SOURCE_KEY, sourcevalue, allocator);
 
 	// time
-	if (std::isnan(time) != true) {
-		std::string timestring = detectionformats::ConvertEpochTimeToISO8601(
-				time);
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
 		rapidjson::Value timevalue;
-		timevalue.SetString(rapidjson::StringRef(timestring.c_str()),
+		timevalue.SetString(timestring,
+							static_cast<rapidjson::SizeType>(timelength),
 							allocator);
 		json.AddMember(TIME_KEY, timevalue, allocator);
 	}
@@ -473,25 +453,31 @@ rapidjson::Value & pick::tojson(
 		json.AddMember(PHASE_KEY, phasevalue, allocator);
 	}
 
-	// polarity
-	if (polarity.empty() == false) {
+	// polarity, the value strings are static so they are not copied, the
+	// text of an unknown polarity is
+	const char *polaritystring = GetIndexText(
+			GetPolarityValue(polarity), polarity, polaritytext);
+	if (polaritystring[0] != '\0') {
 		rapidjson::Value polarityvalue;
-		polarityvalue.SetString(rapidjson::StringRef(polarity.c_str()),
-								allocator);
+		SetIndexString(polarityvalue, polaritystring, polarity, allocator);
 		json.AddMember(POLARITY_KEY, polarityvalue, allocator);
 	}
 
 	// onset
-	if (onset.empty() == false) {
+	const char *onsetstring = GetIndexText(
+			GetOnsetValue(onset), onset, onsettext);
+	if (onsetstring[0] != '\0') {
 		rapidjson::Value onsetvalue;
-		onsetvalue.SetString(rapidjson::StringRef(onset.c_str()), allocator);
+		SetIndexString(onsetvalue, onsetstring, onset, allocator);
 		json.AddMember(ONSET_KEY, onsetvalue, allocator);
 	}
 
 	// picker
-	if (picker.empty() == false) {
+	const char *pickerstring = GetIndexText(
+			GetPickerValue(picker), picker, pickertext);
+	if (pickerstring[0] != '\0') {
 		rapidjson::Value pickervalue;
-		pickervalue.SetString(rapidjson::StringRef(picker.c_str()), allocator);
+		SetIndexString(pickervalue, pickerstring, picker, allocator);
 		json.AddMember(PICKER_KEY, pickervalue, allocator);
 	}
 
@@ -521,7 +507,7 @@ rapidjson::Value & pick::tojson(
 	// beam
 	if (pick::beam.isempty() == false) {
 		rapidjson::Value beamvalue(rapidjson::kObjectType);
-		amplitude.tojson(beamvalue, allocator);
+		beam.tojson(beamvalue, allocator);
 		json.AddMember(BEAM_KEY, beamvalue, allocator);
 	}
 
@@ -542,210 +528,215 @@ rapidjson::Value & pick::tojson(
 	return (json);
 }
 
-std::vector<std::string> pick::geterrors() {
-	std::vector<std::string> errorlist;
+void pick::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// id
+	if (id.empty() == false) {
+		writer.Key(ID_KEY);
+		writer.String(id.c_str(),
+						static_cast<rapidjson::SizeType>(id.length()));
+	}
+
+	// site
+	writer.Key(SITE_KEY);
+	site.write(writer);
+
+	// source
+	writer.Key(SOURCE_KEY);
+	source.write(writer);
+
+	// time
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t timelength = detectionformats::FormatISO8601(time, timestring);
+	if (timelength > 0) {
+		writer.Key(TIME_KEY);
+		writer.String(timestring, static_cast<rapidjson::SizeType>(timelength));
+	}
+
+	// optional values
+	// phase
+	if (phase.empty() == false) {
+		writer.Key(PHASE_KEY);
+		writer.String(phase.c_str(),
+						static_cast<rapidjson::SizeType>(phase.length()));
+	}
+
+	// polarity, the value strings are static so they are not copied, the
+	// text of an unknown polarity is
+	const char *polaritystring = GetIndexText(
+			GetPolarityValue(polarity), polarity, polaritytext);
+	if (polaritystring[0] != '\0') {
+		writer.Key(POLARITY_KEY);
+		writer.String(polaritystring);
+	}
+
+	// onset
+	const char *onsetstring = GetIndexText(
+			GetOnsetValue(onset), onset, onsettext);
+	if (onsetstring[0] != '\0') {
+		writer.Key(ONSET_KEY);
+		writer.String(onsetstring);
+	}
+
+	// picker
+	const char *pickerstring = GetIndexText(
+			GetPickerValue(picker), picker, pickertext);
+	if (pickerstring[0] != '\0') {
+		writer.Key(PICKER_KEY);
+		writer.String(pickerstring);
+	}
+
+	// filter
+	if (filterdata.size() > 0) {
+		writer.Key(FILTER_KEY);
+		writer.StartArray();
+
+		for (int i = 0; i < static_cast<int>(filterdata.size()); i++) {
+			filterdata[i].write(writer);
+		}
+
+		writer.EndArray();
+	}
+
+	// amplitude
+	if (amplitude.isempty() == false) {
+		writer.Key(AMPLITUDE_KEY);
+		amplitude.write(writer);
+	}
+
+	// beam
+	if (beam.isempty() == false) {
+		writer.Key(BEAM_KEY);
+		beam.write(writer);
+	}
+
+	// association
+	if (associationinfo.isempty() == false) {
+		writer.Key(ASSOCIATIONINFO_KEY);
+		associationinfo.write(writer);
+	}
+
+	// classification
+	if (classificationinfo.isempty() == false) {
+		writer.Key(CLASSIFICATIONINFO_KEY);
+		classificationinfo.write(writer);
+	}
+
+	writer.EndObject();
+}
+
+// pick validation error text, in pickerror order
+static const char *pickerrorvalues[] = {
+		"Non-pick type in pick class.",
+		"Empty ID in pick class.",
+		"Site object did not validate in pick class:",
+		"Source object did not validate in pick class:",
+		"Time is missing in pick class.",
+		"Time did not validate in pick class.",
+		"Phase did not validate in pick class.",
+		"Invalid Polarity in pick class.",
+		"Invalid Onset in pick class.",
+		"Invalid Picker in pick class.",
+		"Invalid filter object in pick class:",
+		"Amplitude object did not validate in pick class:",
+		"Beam object did not validate in pick class:",
+		"AssociationInfo object did not validate in pick class:",
+		"ClassificationInfo object did not validate in pick class:" };
+
+errorcodes pick::validate() {
+	errorcodes errors = 0;
 
 	// check for required data
 	// Type
 	if (type != PICK_TYPE) {
 		// wrong type
-		errorlist.push_back("Non-pick type in pick class.");
+		errors |= ERRORCODE(pickerror::picktypeinvalid);
 	}
 
 	// id
 	if (id.empty() == true) {
 		// empty id
-		errorlist.push_back("Empty ID in pick class.");
+		errors |= ERRORCODE(pickerror::pickidmissing);
 	}
 
 	// site
 	if (site.isvalid() != true) {
-		std::vector<std::string> siteErrors = site.geterrors();
-
-		std::string errorString = "Site object did not validate in pick class:";
-
-		for (int i = 0; i < siteErrors.size(); i++) {
-			errorString += " " + siteErrors[i];
-		}
-
 		// bad site
-		errorlist.push_back(errorString);
+		errors |= ERRORCODE(pickerror::picksiteinvalid);
 	}
 
 	// source
 	if (source.isvalid() != true) {
-		std::vector<std::string> sourceErrors = source.geterrors();
-
-		std::string errorString =
-				"Source object did not validate in pick class:";
-
-		for (int i = 0; i < sourceErrors.size(); i++) {
-			errorString += " " + sourceErrors[i];
-		}
-
 		// bad source
-		errorlist.push_back(errorString);
+		errors |= ERRORCODE(pickerror::picksourceinvalid);
 	}
 
 	// time
 	if (std::isnan(time) == true) {
-		errorlist.push_back("Time is missing in pick class.");
-	} else {
-		try {
-			if (detectionformats::IsStringISO8601(
-					detectionformats::ConvertEpochTimeToISO8601(time))
-					== false) {
-				errorlist.push_back("Time did not validate in pick class.");
-			}
-		} catch (const std::exception & e) {
-			errorlist.push_back(std::string(e.what()));
-		}
+		errors |= ERRORCODE(pickerror::picktimemissing);
+	} else if (detectionformats::IsEpochTimeValid(time) == false) {
+		errors |= ERRORCODE(pickerror::picktimeinvalid);
 	}
 
 	// optional data
 	// phase
-	if (phase.empty() == false) {
-		if (detectionformats::IsStringAlpha(phase) == false) {
-			errorlist.push_back("Phase did not validate in pick class.");
-		}
+	if ((phase.empty() == false) &&
+		(detectionformats::IsStringAlpha(phase) == false)) {
+		errors |= ERRORCODE(pickerror::pickphaseinvalid);
 	}
 
-	// polarity
-	if (polarity.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::polarityindex::up;
-				i < detectionformats::polarityindex::polaritycount; i++) {
-			if (polarity == polarityvalues[i]) {
-				match = true;
-				break;
-			}
-		}
-
-		if (match == false) {
-			errorlist.push_back("Invalid Polarity in pick class.");
-		}
+	// polarity, the count value means no polarity
+	if ((polarity < polarityindex::up)
+			|| (polarity > polarityindex::polaritycount)) {
+		errors |= ERRORCODE(pickerror::pickpolarityinvalid);
 	}
 
 	// onset
-	if (onset.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::onsetindex::impulsive;
-				i < detectionformats::onsetindex::onsetcount; i++) {
-			if (onset == onsetvalues[i]) {
-				match = true;
-				break;
-			}
-		}
-
-		if (match == false) {
-			errorlist.push_back("Invalid Onset in pick class.");
-		}
+	if ((onset < onsetindex::impulsive) || (onset > onsetindex::onsetcount)) {
+		errors |= ERRORCODE(pickerror::pickonsetinvalid);
 	}
 
 	// picker
-	if (picker.empty() == false) {
-		bool match = false;
-		// check all the valid types to see if this string matches
-		for (int i = detectionformats::pickerindex::manual;
-				i < detectionformats::pickerindex::pickercount; i++) {
-			if (picker == pickervalues[i]) {
-				match = true;
-				break;
-			}
-		}
-
-		if (match == false) {
-			errorlist.push_back("Invalid Picker in pick class.");
-		}
+	if ((picker < pickerindex::manual) || (picker > pickerindex::pickercount)) {
+		errors |= ERRORCODE(pickerror::pickpickerinvalid);
 	}
 
 	// filter
-	if (filterdata.size() > 0) {
-		for (int i = 0; i < static_cast<int>(filterdata.size()); i++) {
-			if (filterdata[i].isvalid() != true) {
-				std::vector<std::string> filterErrors =
-						filterdata[i].geterrors();
-
-				std::string errorString = "Invalid filter object in pick class:";
-
-				for (int j = 0; j < filterErrors.size(); j++) {
-					errorString += " " + filterErrors[j];
-				}
-
-				// bad filter
-				errorlist.push_back(errorString);
-			}
+	for (int i = 0; i < static_cast<int>(filterdata.size()); i++) {
+		if (filterdata[i].isvalid() != true) {
+			// bad filter
+			errors |= ERRORCODE(pickerror::pickfilterinvalid);
+			break;
 		}
 	}
 
 	// amplitude
-	if (amplitude.isempty() == false) {
-		if (amplitude.isvalid() != true) {
-			std::vector<std::string> ampErrors = amplitude.geterrors();
-
-			std::string errorString =
-					"Amplitude object did not validate in pick class:";
-
-			for (int i = 0; i < ampErrors.size(); i++) {
-				errorString += " " + ampErrors[i];
-			}
-
-			// bad amplitude
-			errorlist.push_back(errorString);
-		}
+	if ((amplitude.isempty() == false) && (amplitude.isvalid() != true)) {
+		errors |= ERRORCODE(pickerror::pickamplitudeinvalid);
 	}
 
 	// beam
-	if (beam.isempty() == false) {
-		if (beam.isvalid() != true) {
-			std::vector<std::string> beamErrors = beam.geterrors();
-
-			std::string errorString =
-					"Beam object did not validate in pick class:";
-
-			for (int i = 0; i < beamErrors.size(); i++) {
-				errorString += " " + beamErrors[i];
-			}
-
-			// bad beam
-			errorlist.push_back(errorString);
-		}
+	if ((beam.isempty() == false) && (beam.isvalid() != true)) {
+		errors |= ERRORCODE(pickerror::pickbeaminvalid);
 	}
 
 	// association
-	if (associationinfo.isempty() == false) {
-		if (associationinfo.isvalid() != true) {
-			std::vector<std::string> assocErrors = associationinfo.geterrors();
-
-			std::string errorString =
-					"AssociationInfo object did not validate in pick class:";
-
-			for (int i = 0; i < assocErrors.size(); i++) {
-				errorString += " " + assocErrors[i];
-			}
-
-			// bad association
-			errorlist.push_back(errorString);
-		}
+	if ((associationinfo.isempty() == false)
+			&& (associationinfo.isvalid() != true)) {
+		errors |= ERRORCODE(pickerror::pickassociationinvalid);
 	}
 
 	// classification
-	if (classificationinfo.isempty() == false) {
-		if (classificationinfo.isvalid() != true) {
-			std::vector<std::string> classErrors = classificationinfo.geterrors();
-
-			std::string errorString =
-					"ClassificationInfo object did not validate in pick class:";
-
-			for (int i = 0; i < classErrors.size(); i++) {
-				errorString += " " + classErrors[i];
-			}
-
-			// bad association
-			errorlist.push_back(errorString);
-		}
+	if ((classificationinfo.isempty() == false)
+			&& (classificationinfo.isvalid() != true)) {
+		errors |= ERRORCODE(pickerror::pickclassificationinvalid);
 	}
 
 	// since id and phase are free text strings, no further validation is
@@ -753,6 +744,58 @@ std::vector<std::string> pick::geterrors() {
 	// NOTE: Further validation COULD be done to confirm that phase is a valid
 	// phase name
 
+	return (errors);
+}
+
+std::vector<std::string> pick::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < pickerror::pickerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		switch (i) {
+			case pickerror::picksiteinvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], site));
+				break;
+			case pickerror::picksourceinvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], source));
+				break;
+			case pickerror::pickfilterinvalid:
+				for (int j = 0; j < static_cast<int>(filterdata.size()); j++) {
+					if (filterdata[j].isvalid() != true) {
+						errorlist.push_back(
+								getmembererror(pickerrorvalues[i], filterdata[j]));
+					}
+				}
+				break;
+			case pickerror::pickamplitudeinvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], amplitude));
+				break;
+			case pickerror::pickbeaminvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], beam));
+				break;
+			case pickerror::pickassociationinvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], associationinfo));
+				break;
+			case pickerror::pickclassificationinvalid:
+				errorlist.push_back(
+						getmembererror(pickerrorvalues[i], classificationinfo));
+				break;
+			default:
+				errorlist.push_back(pickerrorvalues[i]);
+				break;
+		}
+	}
+
 	// return the list of errors
 	return (errorlist);
 }
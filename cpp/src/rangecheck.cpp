@@ -0,0 +1,285 @@
+#include <rangecheck.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// SSE2 is part of x86-64, AVX2 is checked for when the level is chosen
+#if defined(__x86_64__) || defined(_M_X64)
+#define RANGECHECK_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RANGECHECK_AVX2
+#else
+#define RANGECHECK_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace detectionformats {
+////////////// kernels //////////////
+
+// a column to check, the maximum being the largest valid value
+struct rangecolumn {
+	const double *values;
+	double minimum;
+	double maximum;
+	errorcodes invalidcode;
+	errorcodes missingcode;
+};
+
+// makes a column to check, an excluded maximum is replaced by the largest
+// double below it, which gives the same result for every value
+static rangecolumn makecolumn(const double *values, double minimum,
+								double maximum, bool includemaximum,
+								errorcodes invalidcode,
+								errorcodes missingcode) {
+	rangecolumn column;
+	column.values = values;
+	column.minimum = minimum;
+	column.maximum = (includemaximum == true) ? maximum :
+			std::nextafter(maximum, -HUGE_VAL);
+	column.invalidcode = invalidcode;
+	column.missingcode = missingcode;
+	return (column);
+}
+
+// the kernels check every column of a group of rows and OR the codes into
+// the error bitmasks once, so the bitmasks are read and written once
+// however many columns there are
+static void checkscalar(const rangecolumn *columns, int columncount,
+						size_t first, size_t count, errorcodes *errors) {
+	for (size_t i = first; i < count; i++) {
+		errorcodes codes = 0;
+		for (int c = 0; c < columncount; c++) {
+			double value = columns[c].values[i];
+			errorcodes missing = static_cast<errorcodes>(std::isnan(value));
+			errorcodes valid = static_cast<errorcodes>(
+					(value >= columns[c].minimum)
+					& (value <= columns[c].maximum));
+
+			// turn the flags into all ones or all zeros masks
+			codes |= ((0 - missing) & columns[c].missingcode)
+					| ((0 - ((valid | missing) ^ 1)) & columns[c].invalidcode);
+		}
+		errors[i] |= codes;
+	}
+}
+
+#ifdef RANGECHECK_X86
+// the compares of doubles give all ones or all zeros lanes, so the codes
+// are masked with them and ORed into the 64 bit error bitmasks directly
+static void checksse2(const rangecolumn *columns, int columncount,
+						size_t count, errorcodes *errors) {
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m128d codes = _mm_setzero_pd();
+		for (int c = 0; c < columncount; c++) {
+			const rangecolumn &column = columns[c];
+			__m128d value = _mm_loadu_pd(column.values + i);
+			__m128d isnan = _mm_cmpunord_pd(value, value);
+			__m128d inrange = _mm_and_pd(
+					_mm_cmpge_pd(value, _mm_set1_pd(column.minimum)),
+					_mm_cmple_pd(value, _mm_set1_pd(column.maximum)));
+			__m128d invalid = _mm_castsi128_pd(_mm_set1_epi64x(
+					static_cast<int64_t>(column.invalidcode)));
+			__m128d missing = _mm_castsi128_pd(_mm_set1_epi64x(
+					static_cast<int64_t>(column.missingcode)));
+			codes = _mm_or_pd(codes, _mm_or_pd(
+					_mm_andnot_pd(_mm_or_pd(inrange, isnan), invalid),
+					_mm_and_pd(isnan, missing)));
+		}
+
+		__m128i *bitmasks = reinterpret_cast<__m128i *>(errors + i);
+		_mm_storeu_si128(bitmasks, _mm_or_si128(_mm_loadu_si128(bitmasks),
+				_mm_castpd_si128(codes)));
+	}
+
+	checkscalar(columns, columncount, i, count, errors);
+}
+
+RANGECHECK_AVX2 static void checkavx2(const rangecolumn *columns,
+										int columncount, size_t count,
+										errorcodes *errors) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d codes = _mm256_setzero_pd();
+		for (int c = 0; c < columncount; c++) {
+			const rangecolumn &column = columns[c];
+			__m256d value = _mm256_loadu_pd(column.values + i);
+			__m256d isnan = _mm256_cmp_pd(value, value, _CMP_UNORD_Q);
+			__m256d inrange = _mm256_and_pd(
+					_mm256_cmp_pd(value, _mm256_set1_pd(column.minimum),
+									_CMP_GE_OQ),
+					_mm256_cmp_pd(value, _mm256_set1_pd(column.maximum),
+									_CMP_LE_OQ));
+			__m256d invalid = _mm256_castsi256_pd(_mm256_set1_epi64x(
+					static_cast<int64_t>(column.invalidcode)));
+			__m256d missing = _mm256_castsi256_pd(_mm256_set1_epi64x(
+					static_cast<int64_t>(column.missingcode)));
+			codes = _mm256_or_pd(codes, _mm256_or_pd(
+					_mm256_andnot_pd(_mm256_or_pd(inrange, isnan), invalid),
+					_mm256_and_pd(isnan, missing)));
+		}
+
+		__m256i *bitmasks = reinterpret_cast<__m256i *>(errors + i);
+		_mm256_storeu_si256(bitmasks, _mm256_or_si256(
+				_mm256_loadu_si256(bitmasks), _mm256_castpd_si256(codes)));
+	}
+
+	checkscalar(columns, columncount, i, count, errors);
+}
+#endif
+
+////////////// dispatch //////////////
+
+// finds the best level the processor supports
+static int getsupportedlevel() {
+#ifdef RANGECHECK_X86
+#ifdef _MSC_VER
+	// AVX2 needs the processor to support it and the system to save the
+	// AVX registers
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return (rangechecklevel::sse2level);
+	}
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	if ((osxsave == true) && (avx2 == true)
+			&& ((_xgetbv(0) & 0x6) == 0x6)) {
+		return (rangechecklevel::avx2level);
+	}
+	return (rangechecklevel::sse2level);
+#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return (rangechecklevel::avx2level);
+	}
+	return (rangechecklevel::sse2level);
+#endif
+#else
+	return (rangechecklevel::scalarlevel);
+#endif
+}
+
+static int getbestlevel() {
+	static const int best = getsupportedlevel();
+	return (best);
+}
+
+static std::atomic<int> & getlevel() {
+	static std::atomic<int> level(getbestlevel());
+	return (level);
+}
+
+int GetRangeCheckLevel() {
+	return (getlevel().load(std::memory_order_relaxed));
+}
+
+int SetRangeCheckLevel(int level) {
+	level = std::max(static_cast<int>(rangechecklevel::scalarlevel),
+						std::min(level, getbestlevel()));
+	getlevel().store(level, std::memory_order_relaxed);
+	return (level);
+}
+
+// checks the columns with the kernel of the level in use
+static void check(const rangecolumn *columns, int columncount, size_t count,
+					errorcodes *errors) {
+	switch (GetRangeCheckLevel()) {
+#ifdef RANGECHECK_X86
+		case rangechecklevel::avx2level:
+			checkavx2(columns, columncount, count, errors);
+			break;
+		case rangechecklevel::sse2level:
+			checksse2(columns, columncount, count, errors);
+			break;
+#endif
+		default:
+			checkscalar(columns, columncount, 0, count, errors);
+			break;
+	}
+}
+
+////////////// functions //////////////
+
+void CheckRange(const double *values, size_t count, double minimum,
+				double maximum, bool includemaximum, errorcodes invalidcode,
+				errorcodes missingcode, errorcodes *errors) {
+	rangecolumn column = makecolumn(values, minimum, maximum, includemaximum,
+									invalidcode, missingcode);
+	check(&column, 1, count, errors);
+}
+
+void CheckSiteRanges(const double *latitudes, const double *longitudes,
+						const double *elevations, size_t count,
+						errorcodes *errors) {
+	rangecolumn columns[3] = {
+		makecolumn(latitudes, LATITUDE_MINIMUM, LATITUDE_MAXIMUM, true,
+					ERRORCODE(siteerror::sitelatitudeinvalid), 0),
+		makecolumn(longitudes, LONGITUDE_MINIMUM, LONGITUDE_MAXIMUM, true,
+					ERRORCODE(siteerror::sitelongitudeinvalid), 0),
+		makecolumn(elevations, ELEVATION_MINIMUM, ELEVATION_MAXIMUM, true,
+					ERRORCODE(siteerror::siteelevationinvalid), 0)
+	};
+	check(columns, 3, count, errors);
+}
+
+void CheckClassificationRanges(const double *distances,
+								const double *azimuths,
+								const double *magnitudes,
+								const double *depths, size_t count,
+								errorcodes *errors) {
+	rangecolumn columns[4] = {
+		makecolumn(distances, 0, DISTANCE_MAXIMUM, false,
+					ERRORCODE(classerror::classdistanceinvalid), 0),
+		makecolumn(azimuths, 0, AZIMUTH_MAXIMUM, false,
+					ERRORCODE(classerror::classazimuthinvalid), 0),
+		makecolumn(magnitudes, MAGNITUDE_MINIMUM, MAGNITUDE_MAXIMUM, true,
+					ERRORCODE(classerror::classmagnitudeinvalid), 0),
+		makecolumn(depths, DEPTH_MINIMUM, DEPTH_MAXIMUM, true,
+					ERRORCODE(classerror::classdepthinvalid), 0)
+	};
+	check(columns, 4, count, errors);
+}
+
+void CheckCorrelationRanges(const double *magnitudes, const double *snrs,
+							size_t count, errorcodes *errors) {
+	rangecolumn columns[2] = {
+		makecolumn(magnitudes, MAGNITUDE_MINIMUM, MAGNITUDE_MAXIMUM, true,
+					ERRORCODE(correlationerror::correlationmagnitudeinvalid),
+					0),
+		makecolumn(snrs, 0, SNR_MAXIMUM, true,
+					ERRORCODE(correlationerror::correlationsnrinvalid), 0)
+	};
+	check(columns, 2, count, errors);
+}
+
+void CheckStationInfoRanges(const double *latitudes,
+							const double *longitudes,
+							const double *elevations, size_t count,
+							errorcodes *errors) {
+	rangecolumn columns[3] = {
+		makecolumn(latitudes, LATITUDE_MINIMUM, LATITUDE_MAXIMUM, true,
+				ERRORCODE(stationinfoerror::stationinfolatitudeinvalid),
+				ERRORCODE(stationinfoerror::stationinfolatitudemissing)),
+		makecolumn(longitudes, LONGITUDE_MINIMUM, LONGITUDE_MAXIMUM, true,
+				ERRORCODE(stationinfoerror::stationinfolongitudeinvalid),
+				ERRORCODE(stationinfoerror::stationinfolongitudemissing)),
+		makecolumn(elevations, ELEVATION_MINIMUM, ELEVATION_MAXIMUM, true,
+				ERRORCODE(stationinfoerror::stationinfoelevationinvalid),
+				ERRORCODE(stationinfoerror::stationinfoelevationmissing))
+	};
+	check(columns, 3, count, errors);
+}
+
+void CheckSiteRanges(const pick_batch &batch, errorcodes *errors) {
+	CheckSiteRanges(batch.getcolumn(pickcolumn::latitudecolumn),
+					batch.getcolumn(pickcolumn::longitudecolumn),
+					batch.getcolumn(pickcolumn::elevationcolumn),
+					batch.size(), errors);
+}
+}  // namespace detectionformats
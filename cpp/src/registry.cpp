@@ -0,0 +1,317 @@
+#include <registry.h>
+#include <codec.h>
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detectionformats {
+// the reader slot of a thread, holding the epoch it started its lookup in,
+// or 0 between lookups. Slots are padded to a cache line so that readers
+// do not share one, and are shared by every registry
+struct readerslot {
+	std::atomic<uint64_t> epoch;
+	readerslot *next;
+	std::atomic<bool> inuse;
+	char padding[64 - sizeof(std::atomic<uint64_t>) - sizeof(readerslot *)
+			- sizeof(std::atomic<bool>)];
+};
+
+// the epoch writers advance, and the list of every slot ever made. Slots
+// are reused by new threads rather than freed, so the list only grows to
+// the most threads that were reading at once
+static std::atomic<uint64_t> globalepoch(1);
+static std::atomic<readerslot *> slotlist(NULL);
+
+// claims a free slot, or makes a new one
+static readerslot * claimslot() {
+	for (readerslot *slot = slotlist.load(); slot != NULL;
+			slot = slot->next) {
+		bool expected = false;
+		if ((slot->inuse.load(std::memory_order_relaxed) == false)
+				&& (slot->inuse.compare_exchange_strong(expected, true))) {
+			return (slot);
+		}
+	}
+
+	readerslot *slot = new readerslot();
+	slot->epoch.store(0);
+	slot->inuse.store(true);
+	slot->next = slotlist.load();
+	while (slotlist.compare_exchange_weak(slot->next, slot) == false) {
+	}
+	return (slot);
+}
+
+// holds the slot of a thread, giving it back when the thread exits
+struct slotholder {
+	slotholder()
+			: slot(claimslot()) {
+	}
+
+	~slotholder() {
+		slot->inuse.store(false, std::memory_order_release);
+	}
+
+	readerslot *slot;
+};
+
+static readerslot * getslot() {
+	static thread_local slotholder holder;
+	return (holder.slot);
+}
+
+////////////// station_record //////////////
+
+station_record::station_record() {
+	latitude = std::numeric_limits<double>::quiet_NaN();
+	longitude = std::numeric_limits<double>::quiet_NaN();
+	elevation = std::numeric_limits<double>::quiet_NaN();
+	quality = std::numeric_limits<double>::quiet_NaN();
+	enable = false;
+	use = false;
+	useforteleseismic = false;
+}
+
+////////////// station_registry //////////////
+
+station_registry::table::table(size_t newslots)
+		: mask(newslots - 1),
+			slots(new std::atomic<const station_record *>[newslots]) {
+	for (size_t i = 0; i < newslots; i++) {
+		slots[i].store(NULL, std::memory_order_relaxed);
+	}
+}
+
+station_registry::station_registry(size_t slots)
+		: stationcount(0),
+			version(0) {
+	size_t tableslots = 2;
+	while (tableslots < slots) {
+		tableslots *= 2;
+	}
+	current.store(new table(tableslots));
+}
+
+station_registry::~station_registry() {
+	table *records = current.load();
+	for (size_t i = 0; i <= records->mask; i++) {
+		delete (records->slots[i].load());
+	}
+	delete (records);
+
+	for (const station_record *record : retiredrecords) {
+		delete (record);
+	}
+	for (table *retired : retiredtables) {
+		delete (retired);
+	}
+}
+
+bool station_registry::find(const site_key &key,
+							station_record *record) const {
+	// store the epoch in this thread's slot, every pointer loaded below
+	// stays allocated until the slot is cleared. The fence orders the store
+	// before the loads, so a writer either sees the slot or this reader
+	// sees what the writer published, see synchronize()
+	readerslot *reader = getslot();
+	reader->epoch.store(globalepoch.load(std::memory_order_acquire),
+						std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	const table *records = current.load(std::memory_order_acquire);
+	bool found = false;
+	for (size_t i = key.gethash() & records->mask;;
+			i = (i + 1) & records->mask) {
+		const station_record *slot = records->slots[i].load(
+				std::memory_order_acquire);
+		if (slot == NULL) {
+			break;
+		}
+		if (slot->key == key) {
+			*record = *slot;
+			found = true;
+			break;
+		}
+	}
+
+	reader->epoch.store(0, std::memory_order_release);
+	return (found);
+}
+
+void station_registry::insert(station_record *record) {
+	table *records = current.load();
+
+	// keep the table at most half full so that probes stay short
+	if ((stationcount.load() + 1) * 2 > records->mask + 1) {
+		table *grown = new table((records->mask + 1) * 2);
+		for (size_t i = 0; i <= records->mask; i++) {
+			const station_record *slot = records->slots[i].load();
+			if (slot == NULL) {
+				continue;
+			}
+			size_t j = slot->key.gethash() & grown->mask;
+			while (grown->slots[j].load(std::memory_order_relaxed) != NULL) {
+				j = (j + 1) & grown->mask;
+			}
+			grown->slots[j].store(slot, std::memory_order_relaxed);
+		}
+
+		// the records move to the grown table, only the old slots retire
+		current.store(grown);
+		retiredtables.push_back(records);
+		records = grown;
+	}
+
+	for (size_t i = record->key.gethash() & records->mask;;
+			i = (i + 1) & records->mask) {
+		const station_record *slot = records->slots[i].load();
+		if (slot == NULL) {
+			records->slots[i].store(record);
+			stationcount.fetch_add(1);
+			return;
+		}
+		if (slot->key == record->key) {
+			records->slots[i].store(record);
+			retiredrecords.push_back(slot);
+			return;
+		}
+	}
+}
+
+void station_registry::synchronize() {
+	if ((retiredrecords.empty() == true) && (retiredtables.empty() == true)) {
+		return;
+	}
+
+	// readers that store the new epoch, or that store an older one after
+	// the fence, load only the new pointers, so only the slots holding an
+	// older epoch are waited for. Clearing a slot releases the reads of the
+	// lookup, so they finish before anything is freed
+	uint64_t epoch = globalepoch.fetch_add(1) + 1;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	for (readerslot *slot = slotlist.load(); slot != NULL;
+			slot = slot->next) {
+		for (;;) {
+			uint64_t readerepoch = slot->epoch.load(
+					std::memory_order_acquire);
+			if ((readerepoch == 0) || (readerepoch >= epoch)) {
+				break;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	for (const station_record *record : retiredrecords) {
+		delete (record);
+	}
+	for (table *retired : retiredtables) {
+		delete (retired);
+	}
+	retiredrecords.clear();
+	retiredtables.clear();
+}
+
+bool station_registry::update(stationInfo &object) { // NOLINT
+	return (update(&object, 1) == 1);
+}
+
+size_t station_registry::update(stationInfo *objects, size_t count) {
+	std::lock_guard<std::mutex> guard(writelock);
+
+	size_t added = 0;
+	for (size_t i = 0; i < count; i++) {
+		stationInfo & object = objects[i];
+		site_key key(object);
+		if ((key.isvalid() == false) || (object.isvalid() == false)) {
+			continue;
+		}
+
+		station_record *record = new station_record();
+		record->key = key;
+		record->latitude = object.site.latitude;
+		record->longitude = object.site.longitude;
+		record->elevation = object.site.elevation;
+		record->quality = object.quality;
+		record->enable = object.enable;
+		record->use = object.use;
+		record->useforteleseismic = object.useforteleseismic;
+
+		insert(record);
+		added++;
+	}
+
+	if (added > 0) {
+		version.fetch_add(1);
+	}
+	synchronize();
+
+	return (added);
+}
+
+size_t station_registry::load(std::istream &stream) { // NOLINT
+	std::string text((std::istreambuf_iterator<char>(stream)),
+						std::istreambuf_iterator<char>());
+
+	// decode each message straight into a stationInfo
+	codec_context & context = GetCodecContext();
+	std::vector<stationInfo> objects;
+	size_t offset = 0;
+
+	while (true) {
+		while ((offset < text.length())
+				&& (std::isspace(static_cast<unsigned char>(text[offset])))) {
+			offset++;
+		}
+		if (offset >= text.length()) {
+			break;
+		}
+
+		stationInfo object;
+		context.getdecoder().settarget(&object);
+		rapidjson::StringStream messagestream(text.c_str() + offset);
+		rapidjson::ParseResult result = context.getreader()
+				.Parse<rapidjson::kParseStopWhenDoneFlag>(messagestream,
+						context.getdecoder());
+
+		if (result.IsError()) {
+			// skip the rest of the line with the broken message
+			size_t end = text.find('\n', offset + result.Offset());
+			offset = (end == std::string::npos) ? text.length() : end + 1;
+			continue;
+		}
+
+		offset += messagestream.Tell();
+		if (object.type == STATIONINFO_TYPE) {
+			objects.push_back(object);
+		}
+	}
+
+	if (objects.empty() == true) {
+		return (0);
+	}
+	return (update(objects.data(), objects.size()));
+}
+
+size_t station_registry::load(const std::string &filename) {
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if (file.is_open() == false) {
+		throw std::invalid_argument("Could not open station file.");
+	}
+	return (load(file));
+}
+
+size_t station_registry::size() const {
+	return (stationcount.load());
+}
+
+uint64_t station_registry::getversion() const {
+	return (version.load());
+}
+}  // namespace detectionformats
@@ -1,12 +1,10 @@
 #include <retract.h>
+#include <keys.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define ID_KEY "ID"
-#define SOURCE_KEY "Source"
-
 namespace detectionformats {
 retract::retract() {
 	type = RETRACT_TYPE;
@@ -17,47 +15,61 @@ retract::retract() {
 retract::retract(std::string newid, std::string newagencyid,
 					std::string newauthor) {
 	type = RETRACT_TYPE;
-	id = newid;
-	source = detectionformats::source(newagencyid, newauthor);
+	id = std::move(newid);
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
 }
 
 retract::retract(std::string newid, detectionformats::source newsource) {
 	type = RETRACT_TYPE;
-	id = newid;
-	source = newsource;
+	id = std::move(newid);
+	source = std::move(newsource);
 }
 
 retract::retract(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	} else {
-		type = "";
-	}
-
-	// id
-	if ((json.HasMember(ID_KEY) == true) && (json[ID_KEY].IsString() == true)) {
-		id = std::string(json[ID_KEY].GetString(),
-							json[ID_KEY].GetStringLength());
-	} else {
-		id = "";
-	}
-
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
+	// values that are missing from the json
+	type = "";
+
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (retractkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case retractkeyindex::retracttypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// id
+			case retractkeyindex::retractidkey:
+				if (value.IsString() == true) {
+					id = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// source
+			case retractkeyindex::retractsourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
 retract::retract(const retract & newretract) {
-	type = RETRACT_TYPE;
+	type = newretract.type;
 	id = newretract.id;
 	source = newretract.source;
 }
@@ -91,35 +103,79 @@ rapidjson::Value & retract::tojson(
 	return (json);
 }
 
-std::vector<std::string> retract::geterrors() {
-	std::vector<std::string> errorlist;
+void retract::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// id
+	if (id.empty() == false) {
+		writer.Key(ID_KEY);
+		writer.String(id.c_str(),
+						static_cast<rapidjson::SizeType>(id.length()));
+	}
+
+	// source
+	writer.Key(SOURCE_KEY);
+	source.write(writer);
+
+	writer.EndObject();
+}
+
+// retract validation error text, in retracterror order
+static const char *retracterrorvalues[] = {
+		"Non-retract type in retract class.",
+		"Empty ID in retract class.",
+		"Source object did not validate in retract class:" };
+
+errorcodes retract::validate() {
+	errorcodes errors = 0;
 
 	// check for requried keys
 	// Type
 	if (type != RETRACT_TYPE) {
 		// wrong type
-		errorlist.push_back("Non-retract type in retract class.");
+		errors |= ERRORCODE(retracterror::retracttypeinvalid);
 	}
 
 	// id
 	if (id.empty() == true) {
 		// empty id
-		errorlist.push_back("Empty ID in retract class.");
+		errors |= ERRORCODE(retracterror::retractidmissing);
 	}
 
 	// source
 	if (source.isvalid() != true) {
-		std::vector<std::string> sourceErrors = source.geterrors();
+		// bad source
+		errors |= ERRORCODE(retracterror::retractsourceinvalid);
+	}
+
+	return (errors);
+}
 
-		std::string errorString =
-				"Source object did not validate in retract class:";
+std::vector<std::string> retract::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
 
-		for (int i = 0; i < sourceErrors.size(); i++) {
-			errorString += " " + sourceErrors[i];
+	// render the text for each error found
+	for (int i = 0; i < retracterror::retracterrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
 		}
 
-		// bad source
-		errorlist.push_back(errorString);
+		switch (i) {
+			case retracterror::retractsourceinvalid:
+				errorlist.push_back(
+						getmembererror(retracterrorvalues[i], source));
+				break;
+			default:
+				errorlist.push_back(retracterrorvalues[i]);
+				break;
+		}
 	}
 
 	// return the list of errors
@@ -1,18 +1,11 @@
 #include <site.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define STATION_KEY "Station"
-#define CHANNEL_KEY "Channel"
-#define NETWORK_KEY "Network"
-#define LOCATION_KEY "Location"
-#define LATITUDE_KEY "Latitude"
-#define LONGITUDE_KEY "Longitude"
-#define ELEVATION_KEY "Elevation"
-
 namespace detectionformats {
 site::site() {
 	station = "";
@@ -26,10 +19,10 @@ site::site() {
 
 site::site(std::string newstation, std::string newchannel,
 			std::string newnetwork, std::string newlocation) {
-	station = newstation;
-	channel = newchannel;
-	network = newnetwork;
-	location = newlocation;
+	station = std::move(newstation);
+	channel = std::move(newchannel);
+	network = std::move(newnetwork);
+	location = std::move(newlocation);
 	latitude = std::numeric_limits<double>::quiet_NaN();
 	longitude = std::numeric_limits<double>::quiet_NaN();
 	elevation = std::numeric_limits<double>::quiet_NaN();
@@ -38,79 +31,87 @@ site::site(std::string newstation, std::string newchannel,
 site::site(std::string newstation, std::string newchannel,
 			std::string newnetwork, std::string newlocation, double newlatitude,
 			double newlongitude, double newelevation) {
-	station = newstation;
-	channel = newchannel;
-	network = newnetwork;
-	location = newlocation;
+	station = std::move(newstation);
+	channel = std::move(newchannel);
+	network = std::move(newnetwork);
+	location = std::move(newlocation);
 	latitude = newlatitude;
 	longitude = newlongitude;
 	elevation = newelevation;
 }
 
 site::site(rapidjson::Value &json) {
-	// required values
-	// station
-	if ((json.HasMember(STATION_KEY) == true)
-			&& (json[STATION_KEY].IsString() == true)) {
-		station = std::string(json[STATION_KEY].GetString(),
-								json[STATION_KEY].GetStringLength());
-	} else {
-		station = "";
-	}
+	// values that are missing from the json
+	latitude = std::numeric_limits<double>::quiet_NaN();
+	longitude = std::numeric_limits<double>::quiet_NaN();
+	elevation = std::numeric_limits<double>::quiet_NaN();
 
-	// network
-	if ((json.HasMember(NETWORK_KEY) == true)
-			&& (json[NETWORK_KEY].IsString() == true)) {
-		network = std::string(json[NETWORK_KEY].GetString(),
-								json[NETWORK_KEY].GetStringLength());
-	} else {
-		network = "";
-	}
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
 
-	// optional values
-	// channel
-	if ((json.HasMember(CHANNEL_KEY) == true)
-			&& (json[CHANNEL_KEY].IsString() == true)) {
-		channel = std::string(json[CHANNEL_KEY].GetString(),
-								json[CHANNEL_KEY].GetStringLength());
-	} else {
-		channel = "";
-	}
+		switch (sitekeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// station
+			case sitekeyindex::sitestationkey:
+				if (value.IsString() == true) {
+					station = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// location
-	if ((json.HasMember(LOCATION_KEY) == true)
-			&& (json[LOCATION_KEY].IsString() == true)) {
-		location = std::string(json[LOCATION_KEY].GetString(),
-								json[LOCATION_KEY].GetStringLength());
-	} else {
-		location = "";
-	}
+			// network
+			case sitekeyindex::sitenetworkkey:
+				if (value.IsString() == true) {
+					network = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// latitude
-	if ((json.HasMember(LATITUDE_KEY) == true)
-			&& (json[LATITUDE_KEY].IsNumber() == true)
-			&& (json[LATITUDE_KEY].IsDouble() == true)) {
-		latitude = json[LATITUDE_KEY].GetDouble();
-	} else {
-		latitude = std::numeric_limits<double>::quiet_NaN();
-	}
+			// optional values
+			// channel
+			case sitekeyindex::sitechannelkey:
+				if (value.IsString() == true) {
+					channel = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// longitude
-	if ((json.HasMember(LONGITUDE_KEY) == true)
-			&& (json[LONGITUDE_KEY].IsNumber() == true)
-			&& (json[LONGITUDE_KEY].IsDouble() == true)) {
-		longitude = json[LONGITUDE_KEY].GetDouble();
-	} else {
-		longitude = std::numeric_limits<double>::quiet_NaN();
-	}
+			// location
+			case sitekeyindex::sitelocationkey:
+				if (value.IsString() == true) {
+					location = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// elevation
-	if ((json.HasMember(ELEVATION_KEY) == true)
-			&& (json[ELEVATION_KEY].IsNumber() == true)
-			&& (json[ELEVATION_KEY].IsDouble() == true)) {
-		elevation = json[ELEVATION_KEY].GetDouble();
-	} else {
-		elevation = std::numeric_limits<double>::quiet_NaN();
+			// latitude
+			case sitekeyindex::sitelatitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					latitude = value.GetDouble();
+				}
+				break;
+
+			// longitude
+			case sitekeyindex::sitelongitudekey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					longitude = value.GetDouble();
+				}
+				break;
+
+			// elevation
+			case sitekeyindex::siteelevationkey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					elevation = value.GetDouble();
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
@@ -183,43 +184,104 @@ rapidjson::Value & site::tojson(
 	return (json);
 }
 
-std::vector<std::string> site::geterrors() {
-	std::vector<std::string> errorlist;
+void site::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// station
+	if (station.empty() == false) {
+		writer.Key(STATION_KEY);
+		writer.String(station.c_str(),
+						static_cast<rapidjson::SizeType>(station.length()));
+	}
+
+	// network
+	if (network.empty() == false) {
+		writer.Key(NETWORK_KEY);
+		writer.String(network.c_str(),
+						static_cast<rapidjson::SizeType>(network.length()));
+	}
+
+	// optional values
+	// channel
+	if (channel.empty() == false) {
+		writer.Key(CHANNEL_KEY);
+		writer.String(channel.c_str(),
+						static_cast<rapidjson::SizeType>(channel.length()));
+	}
+
+	// location
+	if (location.empty() == false) {
+		writer.Key(LOCATION_KEY);
+		writer.String(location.c_str(),
+						static_cast<rapidjson::SizeType>(location.length()));
+	}
+
+	// latitude
+	if (std::isnan(latitude) != true) {
+		writer.Key(LATITUDE_KEY);
+		writer.Double(latitude);
+	}
+
+	// longitude
+	if (std::isnan(longitude) != true) {
+		writer.Key(LONGITUDE_KEY);
+		writer.Double(longitude);
+	}
+
+	// elevation
+	if (std::isnan(elevation) != true) {
+		writer.Key(ELEVATION_KEY);
+		writer.Double(elevation);
+	}
+
+	writer.EndObject();
+}
+
+// site validation error text, in siteerror order
+static const char *siteerrorvalues[] = {
+		"Empty Station in site class.",
+		"Empty Network in site class.",
+		"Latitude in site class not in the range of -90 to 90 degrees.",
+		"Longitude in site class not in the range of -180 to 180 degrees.",
+		"Elevation in site class not in the range of -500 to 8900 meters." };
+
+errorcodes site::validate() {
+	errorcodes errors = 0;
 
 	// check for required keys
 	// Station
 	if (station.empty() == true) {
 		// empty Station
-		errorlist.push_back("Empty Station in site class.");
+		errors |= ERRORCODE(siteerror::sitestationmissing);
 	}
 
 	// Network
 	if (network.empty() == true) {
 		// empty network
-		errorlist.push_back("Empty Network in site class.");
+		errors |= ERRORCODE(siteerror::sitenetworkmissing);
 	}
 
 	// latitude
 	if (std::isnan(latitude) != true) {
-		if ((latitude < -90) || (latitude > 90)) {
-			errorlist.push_back("Latitude in site class not in the range of -90 to "
-				"90 degrees.");
+		if ((latitude < LATITUDE_MINIMUM) || (latitude > LATITUDE_MAXIMUM)) {
+			errors |= ERRORCODE(siteerror::sitelatitudeinvalid);
 		}
 	}
 
 	// longitude
 	if (std::isnan(longitude) != true) {
-		if ((longitude < -180) || (longitude > 180)) {
-			errorlist.push_back("Longitude in site class not in the range of -180 "
-				"to 180 degrees.");
+		if ((longitude < LONGITUDE_MINIMUM)
+				|| (longitude > LONGITUDE_MAXIMUM)) {
+			errors |= ERRORCODE(siteerror::sitelongitudeinvalid);
 		}
 	}
 
 	// elevation
 	if (std::isnan(elevation) != true) {
-		if ((elevation < -500) || (elevation > 8900)) {
-			errorlist.push_back("Elevation in site class not in the range of -500 "
-				"to 8900 meters.");
+		if ((elevation < ELEVATION_MINIMUM)
+				|| (elevation > ELEVATION_MAXIMUM)) {
+			errors |= ERRORCODE(siteerror::siteelevationinvalid);
 		}
 	}
 
@@ -228,6 +290,22 @@ std::vector<std::string> site::geterrors() {
 	// NOTE: Further validation COULD be done to confirm that values matched
 	// seed standards.
 
+	return (errors);
+}
+
+std::vector<std::string> site::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < siteerror::siteerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		errorlist.push_back(siteerrorvalues[i]);
+	}
+
 	// return the list of errors
 	return (errorlist);
 }
@@ -0,0 +1,193 @@
+#include <sitekey.h>
+#include <keys.h>
+
+#include <cstring>
+#include <string>
+
+namespace detectionformats {
+// the offsets of the codes in the packed bytes
+#define SITEKEY_STATIONOFFSET 0
+#define SITEKEY_CHANNELOFFSET (SITEKEY_STATIONOFFSET + SITEKEY_STATIONWIDTH)
+#define SITEKEY_NETWORKOFFSET (SITEKEY_CHANNELOFFSET + SITEKEY_CHANNELWIDTH)
+#define SITEKEY_LOCATIONOFFSET (SITEKEY_NETWORKOFFSET + SITEKEY_NETWORKWIDTH)
+#define SITEKEY_CODEBYTES (SITEKEY_LOCATIONOFFSET + SITEKEY_LOCATIONWIDTH)
+
+// copies a code into the packed bytes, returns false if it does not fit
+static bool packcode(char *bytes, int offset, int width, const char *str,
+						size_t length) {
+	if (length > static_cast<size_t>(width)) {
+		return (false);
+	}
+	std::memcpy(bytes + offset, str, length);
+	return (true);
+}
+
+// mixes the packed codes into a 32 bit hash, see the murmur3 finalizer
+static uint32_t hashcodes(uint64_t first, uint64_t second) {
+	uint64_t hash = first ^ (second * 0x9E3779B97F4A7C15ULL);
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+	return (static_cast<uint32_t>(hash));
+}
+
+////////////// site_key //////////////
+
+site_key::site_key() {
+	pack("", 0, "", 0, "", 0, "", 0);
+}
+
+site_key::site_key(const std::string &station, const std::string &channel,
+					const std::string &network, const std::string &location) {
+	pack(station.data(), station.length(), channel.data(), channel.length(),
+			network.data(), network.length(), location.data(),
+			location.length());
+}
+
+site_key::site_key(const site &object)
+		: site_key(object.station, object.channel, object.network,
+					object.location) {
+}
+
+site_key::site_key(const site_view &view) {
+	pack(view.station.data(), view.station.size(), view.channel.data(),
+			view.channel.size(), view.network.data(), view.network.size(),
+			view.location.data(), view.location.size());
+}
+
+site_key::site_key(const pick &object)
+		: site_key(object.site) {
+}
+
+site_key::site_key(const correlation &object)
+		: site_key(object.site) {
+}
+
+site_key::site_key(const stationInfo &object)
+		: site_key(object.site) {
+}
+
+site_key::site_key(const stationInfoRequest &object)
+		: site_key(object.site) {
+}
+
+site_key::site_key(rapidjson::Value &json) { // NOLINT
+	// a message holds the codes in its Site
+	rapidjson::Value *sitejson = &json;
+	if (json.IsObject() == true) {
+		rapidjson::Value::MemberIterator sitemember = json.FindMember(SITE_KEY);
+		if ((sitemember != json.MemberEnd())
+				&& (sitemember->value.IsObject() == true)) {
+			sitejson = &sitemember->value;
+		}
+	}
+
+	// read the codes, the same way the site class does
+	const char *codes[4] = { "", "", "", "" };
+	size_t lengths[4] = { 0, 0, 0, 0 };
+	if (sitejson->IsObject() == true) {
+		for (rapidjson::Value::MemberIterator member = sitejson->MemberBegin();
+				member != sitejson->MemberEnd(); ++member) {
+			if (member->value.IsString() == false) {
+				continue;
+			}
+
+			int key = sitekeytable.find(member->name.GetString(),
+										member->name.GetStringLength());
+
+			// the code keys are the first four site keys
+			if ((key >= sitekeyindex::sitestationkey)
+					&& (key <= sitekeyindex::sitelocationkey)) {
+				codes[key] = member->value.GetString();
+				lengths[key] = member->value.GetStringLength();
+			}
+		}
+	}
+
+	pack(codes[sitekeyindex::sitestationkey],
+			lengths[sitekeyindex::sitestationkey],
+			codes[sitekeyindex::sitechannelkey],
+			lengths[sitekeyindex::sitechannelkey],
+			codes[sitekeyindex::sitenetworkkey],
+			lengths[sitekeyindex::sitenetworkkey],
+			codes[sitekeyindex::sitelocationkey],
+			lengths[sitekeyindex::sitelocationkey]);
+}
+
+void site_key::pack(const char *station, size_t stationlength,
+					const char *channel, size_t channellength,
+					const char *network, size_t networklength,
+					const char *location, size_t locationlength) {
+	char bytes[SITEKEY_CODEBYTES];
+	std::memset(bytes, 0, sizeof(bytes));
+
+	bool fits = packcode(bytes, SITEKEY_STATIONOFFSET, SITEKEY_STATIONWIDTH,
+							station, stationlength)
+			&& packcode(bytes, SITEKEY_CHANNELOFFSET, SITEKEY_CHANNELWIDTH,
+						channel, channellength)
+			&& packcode(bytes, SITEKEY_NETWORKOFFSET, SITEKEY_NETWORKWIDTH,
+						network, networklength)
+			&& packcode(bytes, SITEKEY_LOCATIONOFFSET, SITEKEY_LOCATIONWIDTH,
+						location, locationlength);
+
+	// codes that do not fit make the invalid key, which no codes can pack to
+	if (fits == false) {
+		std::memset(bytes, 0xFF, sizeof(bytes));
+	}
+
+	uint32_t last;
+	std::memcpy(&words[0], bytes, sizeof(uint64_t));
+	std::memcpy(&last, bytes + sizeof(uint64_t), sizeof(uint32_t));
+	words[1] = last;
+	words[1] |= static_cast<uint64_t>(hashcodes(words[0], words[1])) << 32;
+}
+
+std::string site_key::getcode(int offset, int width) const {
+	char bytes[SITEKEY_CODEBYTES];
+	uint32_t last = static_cast<uint32_t>(words[1]);
+	std::memcpy(bytes, &words[0], sizeof(uint64_t));
+	std::memcpy(bytes + sizeof(uint64_t), &last, sizeof(uint32_t));
+
+	// the invalid key has no codes
+	if (static_cast<unsigned char>(bytes[0]) == 0xFF) {
+		return ("");
+	}
+
+	size_t length = 0;
+	while ((length < static_cast<size_t>(width))
+			&& (bytes[offset + length] != '\0')) {
+		length++;
+	}
+	return (std::string(bytes + offset, length));
+}
+
+bool site_key::isvalid() const {
+	char bytes[SITEKEY_CODEBYTES];
+	uint32_t last = static_cast<uint32_t>(words[1]);
+	std::memcpy(bytes, &words[0], sizeof(uint64_t));
+	std::memcpy(bytes + sizeof(uint64_t), &last, sizeof(uint32_t));
+
+	// the invalid key, or a missing station or network
+	return ((static_cast<unsigned char>(bytes[0]) != 0xFF)
+			&& (bytes[SITEKEY_STATIONOFFSET] != '\0')
+			&& (bytes[SITEKEY_NETWORKOFFSET] != '\0'));
+}
+
+std::string site_key::getstation() const {
+	return (getcode(SITEKEY_STATIONOFFSET, SITEKEY_STATIONWIDTH));
+}
+
+std::string site_key::getchannel() const {
+	return (getcode(SITEKEY_CHANNELOFFSET, SITEKEY_CHANNELWIDTH));
+}
+
+std::string site_key::getnetwork() const {
+	return (getcode(SITEKEY_NETWORKOFFSET, SITEKEY_NETWORKWIDTH));
+}
+
+std::string site_key::getlocation() const {
+	return (getcode(SITEKEY_LOCATIONOFFSET, SITEKEY_LOCATIONWIDTH));
+}
+}  // namespace detectionformats
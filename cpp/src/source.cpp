@@ -1,13 +1,11 @@
 #include <source.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define AGENCYID_KEY "AgencyID"
-#define AUTHOR_KEY "Author"
-
 namespace detectionformats {
 source::source() {
 	agencyid = "";
@@ -15,28 +13,39 @@ source::source() {
 }
 
 source::source(std::string newagencyid, std::string newauthor) {
-	agencyid = newagencyid;
-	author = newauthor;
+	agencyid = std::move(newagencyid);
+	author = std::move(newauthor);
 }
 
 source::source(rapidjson::Value &json) {
-	// required values
-	// agencyid
-	if ((json.HasMember(AGENCYID_KEY) == true)
-			&& (json[AGENCYID_KEY].IsString() == true)) {
-		agencyid = std::string(json[AGENCYID_KEY].GetString(),
-								json[AGENCYID_KEY].GetStringLength());
-	} else {
-		agencyid = "";
-	}
-
-	// author
-	if ((json.HasMember(AUTHOR_KEY) == true)
-			&& (json[AUTHOR_KEY].IsString() == true)) {
-		author = std::string(json[AUTHOR_KEY].GetString(),
-								json[AUTHOR_KEY].GetStringLength());
-	} else {
-		author = "";
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (sourcekeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// agencyid
+			case sourcekeyindex::sourceagencyidkey:
+				if (value.IsString() == true) {
+					agencyid = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// author
+			case sourcekeyindex::sourceauthorkey:
+				if (value.IsString() == true) {
+					author = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
@@ -72,27 +81,69 @@ rapidjson::Value & source::tojson(
 	return (json);
 }
 
-std::vector<std::string> source::geterrors() {
-	std::vector<std::string> errorlist;
+void source::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// siteid
+	if (agencyid.empty() == false) {
+		writer.Key(AGENCYID_KEY);
+		writer.String(agencyid.c_str(),
+						static_cast<rapidjson::SizeType>(agencyid.length()));
+	}
+
+	// author
+	if (author.empty() == false) {
+		writer.Key(AUTHOR_KEY);
+		writer.String(author.c_str(),
+						static_cast<rapidjson::SizeType>(author.length()));
+	}
+
+	writer.EndObject();
+}
+
+// source validation error text, in sourceerror order
+static const char *sourceerrorvalues[] = {
+		"Empty AgencyID in source class.",
+		"Empty Author in source class." };
+
+errorcodes source::validate() {
+	errorcodes errors = 0;
 
 	if (agencyid.empty() == true) {
 		// empty agencyid
-		errorlist.push_back("Empty AgencyID in source class.");
+		errors |= ERRORCODE(sourceerror::sourceagencyidmissing);
 	}
 
 	if (author.empty() == true) {
 		// empty author
-		errorlist.push_back("Empty Author in source class.");
+		errors |= ERRORCODE(sourceerror::sourceauthormissing);
 	}
 
 	// since agencyid and author are free text strings, no further validation is
 	// required.
 
+	return (errors);
+}
+
+std::vector<std::string> source::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < sourceerror::sourceerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		errorlist.push_back(sourceerrorvalues[i]);
+	}
+
 	// return the list of errors
 	return (errorlist);
 }
 
-bool source::isempty() {
+bool source::isempty() const {
 	if (agencyid.empty() == false)
 		return (false);
 	if (author.empty() == false)
@@ -1,17 +1,11 @@
 #include <stationInfo.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define SITE_KEY "Site"
-#define QUALITY_KEY "Quality"
-#define ENABLE_KEY "Enable"
-#define USE_KEY "Use"
-#define USEFORTELESEISMIC_KEY "UseForTeleseismic"
-#define INFORMATIONREQUESTOR_KEY "InformationRequestor"
-
 namespace detectionformats {
 stationInfo::stationInfo() {
 	type = STATIONINFO_TYPE;
@@ -31,13 +25,15 @@ stationInfo::stationInfo(std::string newstation, std::string newchannel,
 							bool newuseforteleseismic, std::string newagencyid,
 							std::string newauthor) {
 	type = STATIONINFO_TYPE;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation, newlatitude, newlongitude, newelevation);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation), newlatitude,
+			newlongitude, newelevation);
 	quality = newquality;
 	enable = newenable;
 	use = newuse;
 	useforteleseismic = newuseforteleseismic;
-	informationRequestor = detectionformats::source(newagencyid, newauthor);
+	informationRequestor = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
 }
 
 stationInfo::stationInfo(detectionformats::site newsite,
@@ -45,79 +41,90 @@ stationInfo::stationInfo(detectionformats::site newsite,
 							bool newuseforteleseismic,
 							detectionformats::source newinformationrequestor) {
 	type = STATIONINFO_TYPE;
-	stationInfo::site = newsite;
+	stationInfo::site = std::move(newsite);
 	quality = newquality;
 	enable = newenable;
 	use = newuse;
 	useforteleseismic = newuseforteleseismic;
-	informationRequestor = newinformationrequestor;
+	informationRequestor = std::move(newinformationrequestor);
 }
 
 stationInfo::stationInfo(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true))
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	else
-		type = "";
+	// values that are missing from the json
+	type = "";
+	quality = std::numeric_limits<double>::quiet_NaN();
+	enable = true;
+	use = true;
+	useforteleseismic = false;
 
-	// site
-	if ((json.HasMember(SITE_KEY) == true)
-			&& (json[SITE_KEY].IsObject() == true)) {
-		rapidjson::Value & sitevalue = json["Site"];
-		site = detectionformats::site(sitevalue);
-	} else {
-		site = detectionformats::site();
-	}
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
 
-	// optional values
-	// quality
-	if ((json.HasMember(QUALITY_KEY) == true)
-			&& (json[QUALITY_KEY].IsNumber() == true)
-			&& (json[QUALITY_KEY].IsDouble() == true)) {
-		quality = json[QUALITY_KEY].GetDouble();
-	} else {
-		quality = std::numeric_limits<double>::quiet_NaN();
-	}
+		switch (stationinfokeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case stationinfokeyindex::stationinfotypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
 
-	// enable
-	if ((json.HasMember(ENABLE_KEY) == true)
-			&& (json[ENABLE_KEY].IsBool() == true)) {
-		enable = json[ENABLE_KEY].GetBool();
-	} else {
-		enable = true;
-	}
+			// site
+			case stationinfokeyindex::stationinfositekey:
+				if (value.IsObject() == true) {
+					site = detectionformats::site(value);
+				}
+				break;
 
-	// use
-	if ((json.HasMember(USE_KEY) == true)
-			&& (json[USE_KEY].IsBool() == true)) {
-		use = json[USE_KEY].GetBool();
-	} else {
-		use = true;
-	}
+			// optional values
+			// quality
+			case stationinfokeyindex::stationinfoqualitykey:
+				if ((value.IsNumber() == true) && (value.IsDouble() == true)) {
+					quality = value.GetDouble();
+				}
+				break;
 
-	// useforteleseismic
-	if ((json.HasMember(USEFORTELESEISMIC_KEY) == true)
-			&& (json[USEFORTELESEISMIC_KEY].IsBool() == true)) {
-		useforteleseismic = json[USEFORTELESEISMIC_KEY].GetBool();
-	} else {
-		useforteleseismic = false;
-	}
+			// enable
+			case stationinfokeyindex::stationinfoenablekey:
+				if (value.IsBool() == true) {
+					enable = value.GetBool();
+				}
+				break;
 
-	// informationRequestor
-	if ((json.HasMember(INFORMATIONREQUESTOR_KEY) == true)
-			&& (json[INFORMATIONREQUESTOR_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[INFORMATIONREQUESTOR_KEY];
-		informationRequestor = detectionformats::source(sourcevalue);
-	} else {
-		informationRequestor = detectionformats::source();
+			// use
+			case stationinfokeyindex::stationinfousekey:
+				if (value.IsBool() == true) {
+					use = value.GetBool();
+				}
+				break;
+
+			// useforteleseismic
+			case stationinfokeyindex::stationinfoteleseismickey:
+				if (value.IsBool() == true) {
+					useforteleseismic = value.GetBool();
+				}
+				break;
+
+			// informationRequestor
+			case stationinfokeyindex::stationinforequestorkey:
+				if (value.IsObject() == true) {
+					informationRequestor = detectionformats::source(value);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
 stationInfo::stationInfo(const stationInfo &newstation) {
-	type = STATIONINFO_TYPE;
+	type = newstation.type;
 	site = newstation.site;
 	quality = newstation.quality;
 	enable = newstation.enable;
@@ -169,48 +176,100 @@ rapidjson::Value & stationInfo::tojson(
 	return (json);
 }
 
-std::vector<std::string> stationInfo::geterrors() {
-	std::vector<std::string> errorlist;
+void stationInfo::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// site
+	writer.Key(SITE_KEY);
+	site.write(writer);
+
+	// optional values
+	// quality
+	if (std::isnan(quality) != true) {
+		writer.Key(QUALITY_KEY);
+		writer.Double(quality);
+	}
+
+	// enable
+	writer.Key(ENABLE_KEY);
+	writer.Bool(enable);
+
+	// use
+	writer.Key(USE_KEY);
+	writer.Bool(use);
+
+	// useforteleseismic
+	writer.Key(USEFORTELESEISMIC_KEY);
+	writer.Bool(useforteleseismic);
+
+	// informationRequestor
+	if (informationRequestor.isempty() == false) {
+		writer.Key(INFORMATIONREQUESTOR_KEY);
+		informationRequestor.write(writer);
+	}
+
+	writer.EndObject();
+}
+
+// stationInfo validation error text, in stationinfoerror order
+static const char *stationinfoerrorvalues[] = {
+		"Non-stationInfo type in stationInfo class.",
+		"Site object did not validate in stationInfo class.",
+		"No Latitude in stationInfo class.",
+		"Latitude in stationInfo class not in the range of -90 to 90.",
+		"No Longitude in stationInfo class.",
+		"Longitude in stationInfo class not in the range of -180 to 180.",
+		"No Elevation in stationInfo class.",
+		"Elevation in stationInfo class not in the range of -500 to 8900.",
+		"InformationRequestor object did not validate in stationInfo class." };
+
+errorcodes stationInfo::validate() {
+	errorcodes errors = 0;
 
 	// check for required data
 	// Type
 	if (type != STATIONINFO_TYPE) {
 		// wrong type
-		errorlist.push_back("Non-stationInfo type in stationInfo class.");
+		errors |= ERRORCODE(stationinfoerror::stationinfotypeinvalid);
 	}
 
 	// site
 	if (site.isvalid() != true) {
 		// site not found
-		errorlist.push_back(
-				"Site object did not validate in stationInfo class.");
+		errors |= ERRORCODE(stationinfoerror::stationinfositeinvalid);
 	}
 
 	// latitude
 	if (std::isnan(site.latitude) == true) {
 		// latitude not found
-		errorlist.push_back("No Latitude in stationInfo class.");
-	} else if ((site.latitude < -90) || (site.latitude > 90)) {
-		errorlist.push_back("Latitude in stationInfo class not in the range of -90 "
-				"to 90.");
+		errors |= ERRORCODE(stationinfoerror::stationinfolatitudemissing);
+	} else if ((site.latitude < LATITUDE_MINIMUM)
+			|| (site.latitude > LATITUDE_MAXIMUM)) {
+		errors |= ERRORCODE(stationinfoerror::stationinfolatitudeinvalid);
 	}
 
 	// longitude
 	if (std::isnan(site.longitude) == true) {
 		// longitude not found
-		errorlist.push_back("No Longitude in stationInfo class.");
-	} else if ((site.longitude < -180) || (site.longitude > 180)) {
-		errorlist.push_back("Longitude in stationInfo class not in the range of -180 "
-				"to 180.");
+		errors |= ERRORCODE(stationinfoerror::stationinfolongitudemissing);
+	} else if ((site.longitude < LONGITUDE_MINIMUM)
+			|| (site.longitude > LONGITUDE_MAXIMUM)) {
+		errors |= ERRORCODE(stationinfoerror::stationinfolongitudeinvalid);
 	}
 
 	// elevation
 	if (std::isnan(site.elevation) == true) {
 		// elevation not found
-		errorlist.push_back("No Elevation in stationInfo class.");
-	} else if ((site.elevation < -500) || (site.elevation > 8900)) {
-			errorlist.push_back("Elevation in stationInfo class not in the range of "
-				"-500 to 8900.");
+		errors |= ERRORCODE(stationinfoerror::stationinfoelevationmissing);
+	} else if ((site.elevation < ELEVATION_MINIMUM)
+			|| (site.elevation > ELEVATION_MAXIMUM)) {
+		errors |= ERRORCODE(stationinfoerror::stationinfoelevationinvalid);
 	}
 
 	// optional data
@@ -218,12 +277,25 @@ std::vector<std::string> stationInfo::geterrors() {
 	// Enable, Use, and UseForTeleseismic.
 
 	// informationRequestor
-	if (informationRequestor.isempty() != true) {
-		if (informationRequestor.isvalid() != true) {
-			// site not found
-			errorlist.push_back(
-					"InformationRequestor object did not validate in stationInfo class.");
+	if ((informationRequestor.isempty() != true)
+			&& (informationRequestor.isvalid() != true)) {
+		errors |= ERRORCODE(stationinfoerror::stationinforequestorinvalid);
+	}
+
+	return (errors);
+}
+
+std::vector<std::string> stationInfo::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < stationinfoerror::stationinfoerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
 		}
+
+		errorlist.push_back(stationinfoerrorvalues[i]);
 	}
 
 	// return the list of errors
@@ -1,13 +1,11 @@
 #include <stationInfoRequest.h>
+#include <keys.h>
 
 #include <string>
 #include <limits>
+#include <utility>
 #include <vector>
 
-// JSON Keys
-#define SITE_KEY "Site"
-#define SOURCE_KEY "Source"
-
 namespace detectionformats {
 stationInfoRequest::stationInfoRequest() {
 	type = STATIONINFOREQUEST_TYPE;
@@ -22,50 +20,62 @@ stationInfoRequest::stationInfoRequest(std::string newstation,
 										std::string newagencyid,
 										std::string newauthor) {
 	type = STATIONINFOREQUEST_TYPE;
-	site = detectionformats::site(newstation, newchannel, newnetwork,
-									newlocation);
-	source = detectionformats::source(newagencyid, newauthor);
+	site = detectionformats::site(std::move(newstation), std::move(newchannel),
+			std::move(newnetwork), std::move(newlocation));
+	source = detectionformats::source(std::move(newagencyid),
+			std::move(newauthor));
 }
 
 stationInfoRequest::stationInfoRequest(detectionformats::site newsite,
 										detectionformats::source newsource) {
 	type = STATIONINFOREQUEST_TYPE;
-	site = newsite;
-	source = newsource;
+	site = std::move(newsite);
+	source = std::move(newsource);
 }
 
 stationInfoRequest::stationInfoRequest(rapidjson::Value &json) {
-	// required values
-	// type
-	if ((json.HasMember(TYPE_KEY) == true)
-			&& (json[TYPE_KEY].IsString() == true)) {
-		type = std::string(json[TYPE_KEY].GetString(),
-							json[TYPE_KEY].GetStringLength());
-	} else {
-		type = "";
-	}
-
-	// site
-	if ((json.HasMember(SITE_KEY) == true)
-			&& (json[SITE_KEY].IsObject() == true)) {
-		rapidjson::Value & sitevalue = json["Site"];
-		site = detectionformats::site(sitevalue);
-	} else {
-		site = detectionformats::site();
-	}
-
-	// source
-	if ((json.HasMember(SOURCE_KEY) == true)
-			&& (json[SOURCE_KEY].IsObject() == true)) {
-		rapidjson::Value & sourcevalue = json[SOURCE_KEY];
-		source = detectionformats::source(sourcevalue);
-	} else {
-		source = detectionformats::source();
+	// values that are missing from the json
+	type = "";
+
+	// route each member in one pass
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+
+		switch (requestkeytable.find(member->name.GetString(),
+				member->name.GetStringLength())) {
+			// required values
+			// type
+			case stationinforequestkeyindex::requesttypekey:
+				if (value.IsString() == true) {
+					type = std::string(value.GetString(),
+							value.GetStringLength());
+				}
+				break;
+
+			// site
+			case stationinforequestkeyindex::requestsitekey:
+				if (value.IsObject() == true) {
+					site = detectionformats::site(value);
+				}
+				break;
+
+			// source
+			case stationinforequestkeyindex::requestsourcekey:
+				if (value.IsObject() == true) {
+					source = detectionformats::source(value);
+				}
+				break;
+
+			// unknown keys are ignored
+			default:
+				break;
+		}
 	}
 }
 
 stationInfoRequest::stationInfoRequest(const stationInfoRequest &newstation) {
-	type = STATIONINFOREQUEST_TYPE;
+	type = newstation.type;
 	site = newstation.site;
 	source = newstation.source;
 }
@@ -97,29 +107,68 @@ rapidjson::Value & stationInfoRequest::tojson(
 	return (json);
 }
 
-std::vector<std::string> stationInfoRequest::geterrors() {
-	std::vector<std::string> errorlist;
+void stationInfoRequest::write(jsonhandler &writer) {
+	writer.StartObject();
+
+	// required values
+	// type
+	writer.Key(TYPE_KEY);
+	writer.String(type.c_str(),
+					static_cast<rapidjson::SizeType>(type.length()));
+
+	// site
+	writer.Key(SITE_KEY);
+	site.write(writer);
+
+	// source
+	writer.Key(SOURCE_KEY);
+	source.write(writer);
+
+	writer.EndObject();
+}
+
+// stationInfoRequest validation error text, in requesterror order
+static const char *requesterrorvalues[] = {
+		"Non-stationInfoRequest type in stationInfoRequest class.",
+		"Site object did not validate in stationInfoRequest class.",
+		"Source object did not validate in stationInfoRequest class." };
+
+errorcodes stationInfoRequest::validate() {
+	errorcodes errors = 0;
 
 	// check for required data
 	// Type
 	if (type != STATIONINFOREQUEST_TYPE) {
 		// wrong type
-		errorlist.push_back(
-				"Non-stationInfoRequest type in stationInfoRequest class.");
+		errors |= ERRORCODE(requesterror::requesttypeinvalid);
 	}
 
 	// site
 	if (site.isvalid() != true) {
 		// site not found
-		errorlist.push_back(
-				"Site object did not validate in stationInfoRequest class.");
+		errors |= ERRORCODE(requesterror::requestsiteinvalid);
 	}
 
 	// source
 	if (source.isvalid() != true) {
 		// bad source
-		errorlist.push_back(
-				"Source object did not validate in stationInfoRequest class.");
+		errors |= ERRORCODE(requesterror::requestsourceinvalid);
+	}
+
+	return (errors);
+}
+
+std::vector<std::string> stationInfoRequest::geterrors() {
+	std::vector<std::string> errorlist;
+	errorcodes errors = validate();
+
+	// render the text for each error found
+	for (int i = 0; i < requesterror::requesterrorcount; i++) {
+		if ((errors & ERRORCODE(i)) == 0) {
+			continue;
+		}
+
+		errorlist.push_back(requesterrorvalues[i]);
 	}
 
 	// return the list of errors
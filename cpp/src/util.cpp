@@ -1,6 +1,8 @@
 #include <util.h>
 
-#include <regex>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 #if defined(_MSC_VER)
@@ -10,32 +12,173 @@
 namespace detectionformats {
 ////////////// functions //////////////
 
-bool IsJSONValid(std::string jsonstring) {
-	rapidjson::Document jsondocument;
+// returns the format type for a type string
+static int GetFormatType(const char *typestring, size_t typelength) {
+	if (IsStringEqual(PICK_TYPE, typestring, typelength))
+		return (formattypes::picktype);
+	else if (IsStringEqual(CORRELATION_TYPE, typestring, typelength))
+		return (formattypes::correlationtype);
+	else if (IsStringEqual(DETECTION_TYPE, typestring, typelength))
+		return (formattypes::detectiontype);
+	else if (IsStringEqual(RETRACT_TYPE, typestring, typelength))
+		return (formattypes::retracttype);
+	else if (IsStringEqual(STATIONINFO_TYPE, typestring, typelength))
+		return (formattypes::stationinfotype);
+	else if (IsStringEqual(STATIONINFOREQUEST_TYPE, typestring, typelength))
+		return (formattypes::stationinforequesttype);
+
+	return (formattypes::unknown);
+}
+
+// returns the index of the first non whitespace character at or after index
+static size_t SkipWhitespace(const char *json, size_t length, size_t index) {
+	while ((index < length) && ((json[index] == ' ') || (json[index] == '\t')
+			|| (json[index] == '\n') || (json[index] == '\r'))) {
+		index++;
+	}
+
+	return (index);
+}
+
+// moves index from the opening quote of a string to just past its closing
+// quote, returns false if the string is not terminated
+static bool SkipString(const char *json, size_t length, size_t *index) {
+	for (size_t i = *index + 1; i < length; i++) {
+		if (json[i] == '\\') {
+			// skip the escaped character
+			i++;
+		} else if (json[i] == '"') {
+			*index = i + 1;
+			return (true);
+		}
+	}
+
+	return (false);
+}
+
+// moves index from the start of a value to just past its end, returns false
+// if the value is not terminated
+static bool SkipValue(const char *json, size_t length, size_t *index) {
+	size_t i = *index;
+
+	// strings
+	if (json[i] == '"') {
+		return (SkipString(json, length, index));
+	}
+
+	// objects and arrays, only strings and nesting are tracked
+	if ((json[i] == '{') || (json[i] == '[')) {
+		int depth = 0;
+		while (i < length) {
+			char c = json[i];
+			if (c == '"') {
+				if (SkipString(json, length, &i) == false) {
+					return (false);
+				}
+				continue;
+			} else if ((c == '{') || (c == '[')) {
+				depth++;
+			} else if ((c == '}') || (c == ']')) {
+				depth--;
+				if (depth == 0) {
+					*index = i + 1;
+					return (true);
+				}
+			}
+			i++;
+		}
 
-	// parse the json into a document
-	if (jsondocument.Parse(jsonstring.c_str()).HasParseError()) {
-		// parse error
 		return (false);
 	}
 
-	// make sure we got a valid json object
-	if (jsondocument.IsObject() == false) {
+	// numbers and literals run to the next separator
+	while ((i < length) && (json[i] != ',') && (json[i] != '}')
+			&& (json[i] != ']') && (json[i] != ' ') && (json[i] != '\t')
+			&& (json[i] != '\n') && (json[i] != '\r')) {
+		i++;
+	}
+	if (i == *index) {
 		return (false);
 	}
 
-	return(true);
+	*index = i;
+	return (true);
 }
 
-int GetDetectionType(std::string jsonstring) {
-	rapidjson::Document jsondocument;
+int GetDetectionType(const char *json, size_t length) {
+	if (json == NULL) {
+		return (formattypes::error);
+	}
 
-	// parse the json into a document
-	if (jsondocument.Parse(jsonstring.c_str()).HasParseError()) {
+	// the top level must be an object
+	size_t index = SkipWhitespace(json, length, 0);
+	if ((index >= length) || (json[index] != '{')) {
 		return (formattypes::error);
 	}
+	index = SkipWhitespace(json, length, index + 1);
+	if ((index < length) && (json[index] == '}')) {
+		// empty object
+		return (formattypes::unknown);
+	}
+
+	// scan the top level members until the type is found
+	while (index < length) {
+		// key
+		if (json[index] != '"') {
+			return (formattypes::error);
+		}
+		size_t keystart = index + 1;
+		if (SkipString(json, length, &index) == false) {
+			return (formattypes::error);
+		}
+		size_t keylength = index - keystart - 1;
+
+		// separator
+		index = SkipWhitespace(json, length, index);
+		if ((index >= length) || (json[index] != ':')) {
+			return (formattypes::error);
+		}
+		index = SkipWhitespace(json, length, index + 1);
+		if (index >= length) {
+			return (formattypes::error);
+		}
+
+		// Type, stop here
+		if (IsStringEqual(TYPE_KEY, json + keystart, keylength) == true) {
+			// check type
+			if (json[index] != '"') {
+				return (formattypes::unknown);
+			}
+
+			size_t typestart = index + 1;
+			if (SkipString(json, length, &index) == false) {
+				return (formattypes::error);
+			}
+
+			return (GetFormatType(json + typestart, index - typestart - 1));
+		}
+
+		// skip any other value
+		if (SkipValue(json, length, &index) == false) {
+			return (formattypes::error);
+		}
+
+		// next member, or the end of the object
+		index = SkipWhitespace(json, length, index);
+		if ((index < length) && (json[index] == '}')) {
+			// no type found
+			return (formattypes::unknown);
+		} else if ((index >= length) || (json[index] != ',')) {
+			return (formattypes::error);
+		}
+		index = SkipWhitespace(json, length, index + 1);
+	}
+
+	return (formattypes::error);
+}
 
-	return(GetDetectionType(jsondocument));
+int GetDetectionType(std::string jsonstring) {
+	return (GetDetectionType(jsonstring.c_str(), jsonstring.length()));
 }
 
 int GetDetectionType(rapidjson::Value &json) { // NOLINT
@@ -51,24 +194,10 @@ int GetDetectionType(rapidjson::Value &json) { // NOLINT
 			return (formattypes::unknown);
 		}
 
-		// get type string
-		std::string typestring = std::string(
-				json[TYPE_KEY].GetString(),
-				json[TYPE_KEY].GetStringLength());
-
-		// return appropriate type
-		if (typestring == PICK_TYPE)
-			return (formattypes::picktype);
-		else if (typestring == CORRELATION_TYPE)
-			return (formattypes::correlationtype);
-		else if (typestring == DETECTION_TYPE)
-			return (formattypes::detectiontype);
-		else if (typestring == RETRACT_TYPE)
-			return (formattypes::retracttype);
-		else if (typestring == STATIONINFO_TYPE)
-			return (formattypes::stationinfotype);
-		else if (typestring == STATIONINFOREQUEST_TYPE)
-			return (formattypes::stationinforequesttype);
+		// compare the type string in place, so that getting the type does not
+		// allocate
+		return (GetFormatType(json[TYPE_KEY].GetString(),
+								json[TYPE_KEY].GetStringLength()));
 	}
 
 	// no / invalid type found
@@ -76,255 +205,262 @@ int GetDetectionType(rapidjson::Value &json) { // NOLINT
 }
 
 bool IsStringAlpha(const std::string &s) {
-	// use regex to figure out if this string contains only letters
-	return (std::regex_match(s, std::regex("^[A-Za-z]+$")));
+	return (IsStringAlpha(s.c_str(), s.length()));
 }
 
-bool IsStringISO8601(const std::string &s) {
-	// ISO8601 time string format:
-	// 0000000000111111111122222222
-	// 0123456789012345678901234567
-	// YYYY-MM-DDTHH:MM:SS.SSSZ
-	// YYYY-MM-DDTHH:MM:SS.SSS+0000
-
-	// length checks
-	if ((s.length() != 24) && (s.length() != 28)) {
+bool IsStringAlpha(const char *str, size_t length) {
+	// check each character, so that validation does not allocate
+	if (length == 0) {
 		return (false);
 	}
 
-	struct tm timeinfo;
-	memset(&timeinfo, 0, sizeof(struct tm));
-
-	// Time string is in ISO8601 format:
-	// 000000000011111111112222
-	// 012345678901234567890123
-	// YYYY-MM-DDTHH:MM:SS.SSSZ
-	try {
-		// year (0-3 in ISO8601 string)
-		int year = std::stoi(s.substr(0, 4));
-
-		// month (5-6 in ISO8601 string)
-		int month = std::stoi(s.substr(5, 2));
-
-		// day (8-9 in ISO8601 string)
-		int day = std::stoi(s.substr(8, 2));
-
-		// T (10 in ISO8601 string)
-		std::string t = s.substr(10, 1);
-
-		// hour (11-12 in ISO8601 string)
-		int hour = std::stoi(s.substr(11, 2));
-
-		// minute (14-15 in ISO8601 string)
-		int minute = std::stoi(s.substr(14, 2));
-
-		// seconds (17-22 in ISO8601 string)
-		double seconds = std::stod(s.substr(17, 6));
-
-		// Z or +0000 (23 in ISO8601 string)
-		std::string z = "";
-		if (s.length() == 24) {
-			z = s.substr(23, 1);
-		} else if (s.length() == 28) {
-			z = s.substr(23, 5);
-		}
-
-		if (!((year >= 0) && (year <= 9999))) {
-			throw std::invalid_argument(
-					std::string(
-							"Year out of range when validating ISO8601 time."));
+	for (size_t i = 0; i < length; i++) {
+		char c = str[i];
+		if (((c < 'A') || (c > 'Z')) && ((c < 'a') || (c > 'z'))) {
 			return (false);
 		}
+	}
 
-		if (!((month >= 1) && (month <= 12))) {
-			throw std::invalid_argument(
-					std::string(
-							"Month out of range when validating ISO8601 time."));
-			return (false);
-		}
+	return (true);
+}
 
-		if (!((day >= 1) && (day <= 31))) {
-			throw std::invalid_argument(
-					std::string(
-							"Day out of range when validating ISO8601 time."));
-			return (false);
-		}
+// returns the number of days between 1970-01-01 and the provided date in the
+// proleptic gregorian calendar, without using any time zone state
+static int64_t DaysFromCivil(int year, int month, int day) {
+	// count years from march so the leap day is the last day of the year
+	year -= (month <= 2) ? 1 : 0;
+
+	// 400 year eras of 146097 days each
+	int64_t era = ((year >= 0) ? year : (year - 399)) / 400;
+	int64_t yearofera = year - (era * 400);
+	int64_t dayofyear = ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5)
+			+ day - 1;
+	int64_t dayofera = (yearofera * 365) + (yearofera / 4) - (yearofera / 100)
+			+ dayofyear;
+
+	// 719468 is the number of days from 0000-03-01 to 1970-01-01
+	return ((era * 146097) + dayofera - 719468);
+}
 
-		if (t != "T") {
-			throw std::invalid_argument(
-					std::string("Formatting error validating ISO8601 time."));
+// reads count digits starting at str into value, returns false if any
+// character is not a digit
+static bool ReadDigits(const char *str, int count, int *value) {
+	int result = 0;
+	for (int i = 0; i < count; i++) {
+		unsigned int digit = static_cast<unsigned int>(str[i] - '0');
+		if (digit > 9) {
 			return (false);
 		}
+		result = (result * 10) + static_cast<int>(digit);
+	}
 
-		if (!((hour >= 0) && (hour <= 23))) {
-			throw std::invalid_argument(
-					std::string(
-							"Hour out of range when validating ISO8601 time."));
-			return (false);
-		}
+	*value = result;
+	return (true);
+}
 
-		if (!((minute >= 0) && (minute <= 59))) {
-			throw std::invalid_argument(
-					std::string(
-							"Minute out of range when validating ISO8601 time."));
-			return (false);
-		}
+bool ParseISO8601(const char *timestring, size_t length, double *epochtime) {
+	// ISO8601 time string format:
+	// 0000000000111111111122222222
+	// 0123456789012345678901234567
+	// YYYY-MM-DDTHH:MM:SS.SSSZ
+	// YYYY-MM-DDTHH:MM:SS.SSS+0000
 
-		if (!((seconds >= 0.0) && (seconds < 60.0))) {
-			throw std::invalid_argument(
-					std::string(
-							"Seconds out of range when validating ISO8601 time."));
-			return (false);
-		}
+	// length checks
+	if ((timestring == NULL) || ((length != 24) && (length != 28))) {
+		return (false);
+	}
+
+	int year, month, day, hour, minute, second, millisecond;
+
+	// fields and separators
+	if ((ReadDigits(timestring, 4, &year) == false)
+			|| (timestring[4] != '-')
+			|| (ReadDigits(timestring + 5, 2, &month) == false)
+			|| (timestring[7] != '-')
+			|| (ReadDigits(timestring + 8, 2, &day) == false)
+			|| (timestring[10] != 'T')
+			|| (ReadDigits(timestring + 11, 2, &hour) == false)
+			|| (timestring[13] != ':')
+			|| (ReadDigits(timestring + 14, 2, &minute) == false)
+			|| (timestring[16] != ':')
+			|| (ReadDigits(timestring + 17, 2, &second) == false)
+			|| (timestring[19] != '.')
+			|| (ReadDigits(timestring + 20, 3, &millisecond) == false)) {
+		return (false);
+	}
 
-		if ((z != "Z") && (z != "+0000")) {
-			throw std::invalid_argument(
-					std::string("Formatting error validating Z / +0000 ISO8601 time: " + z));
+	// Z or +0000
+	if (length == 24) {
+		if (timestring[23] != 'Z') {
 			return (false);
 		}
-	} catch (const std::exception &e) {
-		printf("Formatting error validating ISO8601 time: %s\n", e.what());
+	} else if ((timestring[23] != '+') || (timestring[24] != '0')
+			|| (timestring[25] != '0') || (timestring[26] != '0')
+			|| (timestring[27] != '0')) {
 		return (false);
 	}
 
-	return (true);
-}
-
-// Space where environment variable TZ will be
-// stored after the first call to ConvertISO8601ToEpochTime()
-#define MAXENV 128
-char envTZ[MAXENV];
-double ConvertISO8601ToEpochTime(std::string TimeString) {
-	// make sure we got something
-	if (IsStringISO8601(TimeString) == false) {
-		return(-1.0);
+	// ranges, the year is 0-9999 by construction
+	if ((month < 1) || (month > 12) || (day < 1) || (day > 31) || (hour > 23)
+			|| (minute > 59) || (second > 59)) {
+		return (false);
 	}
 
-	struct tm timeinfo;
-	memset(&timeinfo, 0, sizeof(struct tm));
-
-	// Time string is in ISO8601 format:
-	// 000000000011111111112222
-	// 012345678901234567890123
-	// YYYY-MM-DDTHH:MM:SS.SSSZ
-
-	// year (0-3 in ISO8601 string)
-	// struct tm stores year as "current year minus 1900"
-	timeinfo.tm_year = atoi(TimeString.substr(0, 4).c_str()) - 1900;
-
-	// month (5-6 in ISO8601 string)
-	// struct tm stores month  as number from 0 to 11, January = 0
-	timeinfo.tm_mon = atoi(TimeString.substr(5, 2).c_str()) - 1;
+	if (epochtime != NULL) {
+		int64_t wholeseconds = (DaysFromCivil(year, month, day) * 86400)
+				+ (hour * 3600) + (minute * 60);
 
-	// day (8-9 in ISO8601 string)
-	timeinfo.tm_mday = atoi(TimeString.substr(8, 2).c_str());
+		// decimal seconds are rounded the same way as parsing "SS.SSS"
+		*epochtime = static_cast<double>(wholeseconds)
+				+ (static_cast<double>((second * 1000) + millisecond) / 1000.0);
+	}
 
-	// hour (11-12 in ISO8601 string)
-	timeinfo.tm_hour = atoi(TimeString.substr(11, 2).c_str());
+	return (true);
+}
 
-	// minute (14-15 in ISO8601 string)
-	timeinfo.tm_min = atoi(TimeString.substr(14, 2).c_str());
+bool IsStringISO8601(const std::string &s) {
+	return (ParseISO8601(s.c_str(), s.length(), NULL));
+}
 
-	// decimal seconds (17-22 in ISO8601 string)
-	double seconds = atof(TimeString.substr(17, 6).c_str());
+double ConvertISO8601ToEpochTime(const char *timestring, size_t length) {
+	double epochtime;
+	if (ParseISO8601(timestring, length, &epochtime) == false) {
+		return (-1.0);
+	}
 
-#ifdef _WIN32
-	// windows specific timezone handling
-	char * pTZ;
-	char szTZExisting[32] = "TZ=";
+	return (epochtime);
+}
 
-	// Save current TZ setting locally
-	pTZ = getenv("TZ");
+double ConvertISO8601ToEpochTime(std::string TimeString) {
+	return (ConvertISO8601ToEpochTime(TimeString.c_str(), TimeString.length()));
+}
 
-	if(pTZ) {
-		/* remember we have "TZ=" stored as the first 3 chars of the array */
-		strncpy(&szTZExisting[3], pTZ, sizeof(szTZExisting) - 4);
-		szTZExisting[sizeof(szTZExisting)-1] = 0x00;
+int ConvertISO8601ToEpochTimes(const std::string *timestrings, int count,
+								double *epochtimes) {
+	int converted = 0;
+	for (int i = 0; i < count; i++) {
+		if (ParseISO8601(timestrings[i].c_str(), timestrings[i].length(),
+							&epochtimes[i]) == true) {
+			converted++;
+		} else {
+			epochtimes[i] = -1.0;
+		}
 	}
 
-	// Change time zone to GMT
-	_putenv("TZ=UTC");
-
-	// set the timezone-offset to 0
-	_timezone = 0;
-
-	// set the DST-offset to 0
-	_daylight = 0;
+	return (converted);
+}
 
-	// ensure _tzset() has been called, so that it isn't called again.
-	_tzset();
+// converts a number of days since 1970-01-01 to a date in the proleptic
+// gregorian calendar, the inverse of DaysFromCivil
+static void CivilFromDays(int64_t days, int *year, int *month, int *day) {
+	days += 719468;
+
+	int64_t era = ((days >= 0) ? days : (days - 146096)) / 146097;
+	int64_t dayofera = days - (era * 146097);
+	int64_t yearofera = (dayofera - (dayofera / 1460) + (dayofera / 36524)
+			- (dayofera / 146096)) / 365;
+	int64_t dayofyear = dayofera
+			- ((365 * yearofera) + (yearofera / 4) - (yearofera / 100));
+	int64_t monthfrommarch = ((5 * dayofyear) + 2) / 153;
+
+	*day = static_cast<int>(dayofyear - (((153 * monthfrommarch) + 2) / 5) + 1);
+	*month = static_cast<int>(
+			(monthfrommarch < 10) ? (monthfrommarch + 3) : (monthfrommarch - 9));
+	*year = static_cast<int>((yearofera + (era * 400))
+			+ ((*month <= 2) ? 1 : 0));
+}
 
-	// convert to epoch time
-	double usableTime = static_cast<double>(mktime(&timeinfo));
+// writes value as count zero padded digits ending at str + count
+static void WriteDigits(char *str, int count, int value) {
+	for (int i = count - 1; i >= 0; i--) {
+		str[i] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	}
+}
 
-	// Restore original TZ setting
-	_putenv(szTZExisting);
-	_tzset();
+// per thread cache of the last formatted YYYY-MM-DDTHH:MM: prefix, times in
+// a stream usually share their minute with the previous time
+struct iso8601prefixcache {
+	int64_t minute;
+	char prefix[ISO8601_PREFIXLENGTH];
+	bool valid;
+};
+static thread_local iso8601prefixcache prefixcache = { 0, { 0 }, false };
+
+bool IsEpochTimeValid(double epochtime) {
+	// check the time rounded to the millisecond, as FormatISO8601() writes
+	// it, so that a time in the last half millisecond of 9999 is not valid
+	// but unwritable. NaN fails both comparisons
+	double milliseconds = std::floor((epochtime * 1000.0) + 0.5);
+	return ((milliseconds >= (ISO8601_MINTIME * 1000.0))
+			&& (milliseconds < (ISO8601_MAXTIME * 1000.0)));
+}
 
-#else
-	// linux and other timezone handling
-	char *tz;
-	char TZorig[MAXENV];
+size_t FormatISO8601(double epochtime, char *buffer) {
+	if ((buffer == NULL) || (IsEpochTimeValid(epochtime) == false)) {
+		return (0);
+	}
 
-	// Save current TZ setting locally
-	tz = getenv("TZ");
-	if (tz != reinterpret_cast<char *>(NULL)) {
-		if (strlen(tz) > MAXENV - 4) {
-			printf("ConvertISO8601ToEpochTime: unable to store current TZ "
-					"environment variable.\n");
-			return (-1);
-		}
+	// round to the millisecond first, so rounding carries into the seconds,
+	// minutes, and date
+	int64_t milliseconds = static_cast<int64_t>(std::floor(
+			(epochtime * 1000.0) + 0.5));
+	int64_t seconds = milliseconds / 1000;
+	int64_t millisecond = milliseconds - (seconds * 1000);
+	if (millisecond < 0) {
+		millisecond += 1000;
+		seconds--;
 	}
-	snprintf(TZorig, sizeof(TZorig), "TZ=%s", tz);
-
-	// Change time zone to GMT
-	snprintf(envTZ, sizeof(envTZ), "TZ=GMT");
-	if (putenv(envTZ) != 0) {
-		printf("ConvertISO8601ToEpochTime: putenv: unable to set TZ "
-				"environment variable.\n");
-		return (-1);
+	int64_t minute = seconds / 60;
+	int64_t second = seconds - (minute * 60);
+	if (second < 0) {
+		second += 60;
+		minute--;
 	}
 
-	// convert to epoch time
-	double usableTime = static_cast<double>(mktime(&timeinfo));
+	// YYYY-MM-DDTHH:MM:
+	if ((prefixcache.valid == false) || (prefixcache.minute != minute)) {
+		int64_t days = minute / 1440;
+		int64_t minuteofday = minute - (days * 1440);
+		if (minuteofday < 0) {
+			minuteofday += 1440;
+			days--;
+		}
 
-	// Restore original TZ setting
-	snprintf(envTZ, sizeof(TZorig), "%s", TZorig);
-	if (putenv(envTZ) != 0) {
-		printf("ConvertISO8601ToEpochTime: putenv: unable to restore TZ "
-				"environment variable.\n");
+		int year, month, day;
+		CivilFromDays(days, &year, &month, &day);
+
+		char *prefix = prefixcache.prefix;
+		WriteDigits(prefix, 4, year);
+		prefix[4] = '-';
+		WriteDigits(prefix + 5, 2, month);
+		prefix[7] = '-';
+		WriteDigits(prefix + 8, 2, day);
+		prefix[10] = 'T';
+		WriteDigits(prefix + 11, 2, static_cast<int>(minuteofday / 60));
+		prefix[13] = ':';
+		WriteDigits(prefix + 14, 2, static_cast<int>(minuteofday % 60));
+		prefix[16] = ':';
+
+		prefixcache.minute = minute;
+		prefixcache.valid = true;
 	}
-	tzset();
+	memcpy(buffer, prefixcache.prefix, ISO8601_PREFIXLENGTH);
 
-#endif
+	// SS.SSSZ
+	WriteDigits(buffer + 17, 2, static_cast<int>(second));
+	buffer[19] = '.';
+	WriteDigits(buffer + 20, 3, static_cast<int>(millisecond));
+	buffer[23] = 'Z';
+	buffer[24] = '\0';
 
-	// add decimal seconds and return
-	return (usableTime + seconds);
+	return (ISO8601_LENGTH);
 }
 
 std::string ConvertEpochTimeToISO8601(double epochtime) {
-	time_t time = static_cast<int>(epochtime);
-	double decimalseconds = epochtime - static_cast<int>(time);
-
-	// build the time portion, all but the seconds which are
-	// seperate since time_t can't do decimal seconds
-	char timebuf[sizeof "2011-10-08T07:07:"];
-	tm* timestruct = gmtime(&time); // NOLINT
-	strftime(timebuf, sizeof timebuf, "%Y-%m-%dT%H:%M:", timestruct);
-	std::string timestring = timebuf;
-
-	// build the seconds portion
-	char secbuf[sizeof "00.000Z"];
-	if ((timestruct->tm_sec + decimalseconds) < 10)
-		snprintf(secbuf, sizeof(secbuf), "0%1.3f",
-					timestruct->tm_sec + decimalseconds);
-	else
-		snprintf(secbuf, sizeof(secbuf), "%2.3f",
-					timestruct->tm_sec + decimalseconds);
-	std::string secondsstring = secbuf;
-
-	// return the combined ISO8601 string
-	return (timestring + secondsstring + "Z");
+	char timestring[ISO8601_BUFFERSIZE];
+	size_t length = FormatISO8601(epochtime, timestring);
+	return (std::string(timestring, length));
 }
 
 std::string ToJSONString(rapidjson::Value &json) { // NOLINT
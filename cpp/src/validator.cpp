@@ -0,0 +1,860 @@
+#include <validator.h>
+#include <keys.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+/**
+ * \brief the seen mask bit for the provided key index
+ */
+#define KEYBIT(key) (static_cast<uint64_t>(1) << (key))
+
+namespace detectionformats {
+// the kinds of json value passed to validator::value()
+enum valuekind {
+	stringvalue = 0,
+	integervalue = 1,
+	doublevalue = 2
+};
+
+// the result of checking a member value
+enum valuecheck {
+	valueignored = 0,
+	valuecounted = 1,
+	valueinvalid = 2
+};
+
+////////////// member checks //////////////
+
+// returns the Type string of a top level object kind, or NULL
+static const char * typestring(int kind) {
+	switch (kind) {
+		case objectkind::pickkind: return (PICK_TYPE);
+		case objectkind::correlationkind: return (CORRELATION_TYPE);
+		case objectkind::detectionkind: return (DETECTION_TYPE);
+		case objectkind::retractkind: return (RETRACT_TYPE);
+		case objectkind::stationinfokind: return (STATIONINFO_TYPE);
+		case objectkind::stationinforequestkind:
+			return (STATIONINFOREQUEST_TYPE);
+		default: return (NULL);
+	}
+}
+
+static bool isstring(const char *expected, const char *str,
+						rapidjson::SizeType length) {
+	return ((std::strlen(expected) == length)
+			&& (std::strncmp(expected, str, length) == 0));
+}
+
+// checks an ISO8601 time string the way the decoder converts it, a
+// malformed string converts to -1.0, which is a valid time, as it is for
+// the decoder
+static valuecheck checktime(const char *str, rapidjson::SizeType length) {
+	double time = detectionformats::ConvertISO8601ToEpochTime(str, length);
+	if (detectionformats::IsEpochTimeValid(time) == false) {
+		return (valueinvalid);
+	}
+	return (valuecounted);
+}
+
+// checks a phase string, phases are optional but must be alphabetic
+static valuecheck checkphase(const char *str, rapidjson::SizeType length) {
+	if (length == 0) {
+		return (valueignored);
+	} else if (detectionformats::IsStringAlpha(str, length) == false) {
+		return (valueinvalid);
+	}
+	return (valuecounted);
+}
+
+// checks an enum string, empty strings are the unset value
+static valuecheck checkenum(int index, rapidjson::SizeType length) {
+	if (index < 0) {
+		return (valueinvalid);
+	} else if (length == 0) {
+		return (valueignored);
+	}
+	return (valuecounted);
+}
+
+// checks a string member, following the decoder's stringmember(),
+// setenummember(), and timemember() routing
+static valuecheck checkstring(int kind, int key, const char *str,
+								rapidjson::SizeType length) {
+	// top level Type, the first key of each top level object
+	if ((key == 0) && (typestring(kind) != NULL)) {
+		if (isstring(typestring(kind), str, length) == false) {
+			return (valueinvalid);
+		}
+		return (valuecounted);
+	}
+
+	switch (kind) {
+		case objectkind::pickkind:
+			switch (key) {
+				case pickkeyindex::pickidkey: break;
+				case pickkeyindex::pickphasekey:
+					return (checkphase(str, length));
+				case pickkeyindex::picktimekey: return (checktime(str, length));
+				case pickkeyindex::pickpolaritykey:
+					return (checkenum(GetPolarityIndex(str, length), length));
+				case pickkeyindex::pickonsetkey:
+					return (checkenum(GetOnsetIndex(str, length), length));
+				case pickkeyindex::pickpickerkey:
+					return (checkenum(GetPickerIndex(str, length), length));
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::correlationkind:
+			switch (key) {
+				case correlationkeyindex::correlationidkey:
+				case correlationkeyindex::correlationthresholdtypekey: break;
+				case correlationkeyindex::correlationphasekey:
+					return (checkphase(str, length));
+				case correlationkeyindex::correlationtimekey:
+					return (checktime(str, length));
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::detectionkind:
+			switch (key) {
+				case detectionkeyindex::detectionidkey: break;
+				case detectionkeyindex::detectiondetectiontypekey:
+					return (checkenum(GetDetectionTypeIndex(str, length),
+										length));
+				case detectionkeyindex::detectiontimekey:
+					return (checktime(str, length));
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::retractkind:
+			if (key != retractkeyindex::retractidkey) {
+				return (valueignored);
+			}
+			break;
+		case objectkind::sitekind:
+			switch (key) {
+				case sitekeyindex::sitestationkey:
+				case sitekeyindex::sitechannelkey:
+				case sitekeyindex::sitenetworkkey:
+				case sitekeyindex::sitelocationkey: break;
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::sourcekind:
+			switch (key) {
+				case sourcekeyindex::sourceagencyidkey:
+				case sourcekeyindex::sourceauthorkey: break;
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::associationkind:
+			if (key == associationkeyindex::associationphasekey) {
+				return (checkphase(str, length));
+			}
+			return (valueignored);
+		case objectkind::classificationkind:
+			switch (key) {
+				case classificationkeyindex::classphasekey:
+					return (checkphase(str, length));
+				case classificationkeyindex::classmagnitudetypekey: break;
+				default: return (valueignored);
+			}
+			break;
+		case objectkind::hypocenterkind:
+			if (key == hypocenterkeyindex::hypotimekey) {
+				return (checktime(str, length));
+			}
+			return (valueignored);
+		case objectkind::eventtypekind:
+			switch (key) {
+				case eventtypekeyindex::eventtypetypekey:
+					return (checkenum(GetEventTypeIndex(str, length), length));
+				case eventtypekeyindex::eventtypecertaintykey:
+					return (checkenum(GetEventTypeCertaintyIndex(str, length),
+										length));
+				default: return (valueignored);
+			}
+		default:
+			return (valueignored);
+	}
+
+	// free text, which only counts when it is not empty
+	if (length == 0) {
+		return (valueignored);
+	}
+	return (valuecounted);
+}
+
+// checks a value against an inclusive range
+static valuecheck checkrange(double value, double minimum, double maximum) {
+	if ((value < minimum) || (value > maximum)) {
+		return (valueinvalid);
+	}
+	return (valuecounted);
+}
+
+// checks a numeric member, following the decoder's numbermember() routing
+static valuecheck checknumber(int kind, int key, double value) {
+	const double maximum = std::numeric_limits<double>::infinity();
+
+	switch (kind) {
+		case objectkind::correlationkind:
+			switch (key) {
+				case correlationkeyindex::correlationvaluekey:
+					return (checkrange(value, 0, maximum));
+				case correlationkeyindex::correlationmagnitudekey:
+					return (checkrange(value, MAGNITUDE_MINIMUM,
+										MAGNITUDE_MAXIMUM));
+				case correlationkeyindex::correlationsnrkey:
+					return (checkrange(value, 0, SNR_MAXIMUM));
+				case correlationkeyindex::correlationzscorekey:
+				case correlationkeyindex::correlationthresholdkey:
+					return (valuecounted);
+				default: return (valueignored);
+			}
+		case objectkind::detectionkind:
+			switch (key) {
+				case detectionkeyindex::detectionbayeskey:
+				case detectionkeyindex::detectionmindistkey:
+					return (checkrange(value, 0, maximum));
+				case detectionkeyindex::detectionrmskey:
+					return (checkrange(value, RMS_MINIMUM, maximum));
+				case detectionkeyindex::detectiongapkey:
+					return (checkrange(value, 0, AZIMUTH_MAXIMUM));
+				default: return (valueignored);
+			}
+		case objectkind::stationinfokind:
+			if (key == stationinfokeyindex::stationinfoqualitykey) {
+				return (valuecounted);
+			}
+			return (valueignored);
+		case objectkind::sitekind:
+			switch (key) {
+				case sitekeyindex::sitelatitudekey:
+					return (checkrange(value, LATITUDE_MINIMUM,
+										LATITUDE_MAXIMUM));
+				case sitekeyindex::sitelongitudekey:
+					return (checkrange(value, LONGITUDE_MINIMUM,
+										LONGITUDE_MAXIMUM));
+				case sitekeyindex::siteelevationkey:
+					return (checkrange(value, ELEVATION_MINIMUM,
+										ELEVATION_MAXIMUM));
+				default: return (valueignored);
+			}
+		case objectkind::filterkind:
+			switch (key) {
+				case filterkeyindex::filterhighpasskey:
+				case filterkeyindex::filterlowpasskey:
+					return (valuecounted);
+				default: return (valueignored);
+			}
+		case objectkind::amplitudekind:
+			switch (key) {
+				case amplitudekeyindex::amplitudevaluekey:
+					return (valuecounted);
+				case amplitudekeyindex::amplitudeperiodkey:
+					return (checkrange(value, 0, maximum));
+				case amplitudekeyindex::amplitudesnrkey:
+					return (checkrange(value, 0, SNR_MAXIMUM));
+				default: return (valueignored);
+			}
+		case objectkind::beamkind:
+			if ((key >= beamkeyindex::beambackazimuthkey)
+					&& (key <= beamkeyindex::beampowerratioerrorkey)) {
+				return (checkrange(value, 0, maximum));
+			}
+			return (valueignored);
+		case objectkind::associationkind:
+			switch (key) {
+				case associationkeyindex::associationdistancekey:
+				case associationkeyindex::associationazimuthkey:
+					return (checkrange(value, 0, maximum));
+				case associationkeyindex::associationresidualkey:
+				case associationkeyindex::associationsigmakey:
+					return (valuecounted);
+				default: return (valueignored);
+			}
+		case objectkind::classificationkind:
+			switch (key) {
+				case classificationkeyindex::classdistancekey:
+					if ((value < 0) || (value >= DISTANCE_MAXIMUM)) {
+						return (valueinvalid);
+					}
+					return (valuecounted);
+				case classificationkeyindex::classazimuthkey:
+					if ((value < 0) || (value >= AZIMUTH_MAXIMUM)) {
+						return (valueinvalid);
+					}
+					return (valuecounted);
+				case classificationkeyindex::classmagnitudekey:
+					return (checkrange(value, MAGNITUDE_MINIMUM,
+										MAGNITUDE_MAXIMUM));
+				case classificationkeyindex::classdepthkey:
+					return (checkrange(value, DEPTH_MINIMUM, DEPTH_MAXIMUM));
+				case classificationkeyindex::classphaseprobkey:
+				case classificationkeyindex::classdistanceprobkey:
+				case classificationkeyindex::classazimuthprobkey:
+				case classificationkeyindex::classmagnitudeprobkey:
+				case classificationkeyindex::classdepthprobkey:
+				case classificationkeyindex::classeventtypeprobkey:
+					return (valuecounted);
+				default: return (valueignored);
+			}
+		case objectkind::hypocenterkind:
+			switch (key) {
+				case hypocenterkeyindex::hypolatitudekey:
+					return (checkrange(value, LATITUDE_MINIMUM,
+										LATITUDE_MAXIMUM));
+				case hypocenterkeyindex::hypolongitudekey:
+					return (checkrange(value, LONGITUDE_MINIMUM,
+										LONGITUDE_MAXIMUM));
+				case hypocenterkeyindex::hypodepthkey:
+					return (checkrange(value, DEPTH_MINIMUM, DEPTH_MAXIMUM));
+				case hypocenterkeyindex::hypolatitudeerrorkey:
+				case hypocenterkeyindex::hypolongitudeerrorkey:
+				case hypocenterkeyindex::hypodeptherrorkey:
+				case hypocenterkeyindex::hypotimeerrorkey:
+					return (valuecounted);
+				default: return (valueignored);
+			}
+		default:
+			return (valueignored);
+	}
+}
+
+////////////// object checks //////////////
+
+// returns the object kind of the member identified by kind and key, following
+// the decoder's objectmember() routing
+static int childkind(int kind, int key) {
+	switch (kind) {
+		case objectkind::pickkind:
+			switch (key) {
+				case pickkeyindex::picksitekey: return (objectkind::sitekind);
+				case pickkeyindex::picksourcekey:
+					return (objectkind::sourcekind);
+				case pickkeyindex::pickamplitudekey:
+					return (objectkind::amplitudekind);
+				case pickkeyindex::pickbeamkey: return (objectkind::beamkind);
+				case pickkeyindex::pickassociationkey:
+					return (objectkind::associationkind);
+				case pickkeyindex::pickclassificationkey:
+					return (objectkind::classificationkind);
+				default: return (objectkind::unknownkind);
+			}
+		case objectkind::correlationkind:
+			switch (key) {
+				case correlationkeyindex::correlationsitekey:
+					return (objectkind::sitekind);
+				case correlationkeyindex::correlationsourcekey:
+					return (objectkind::sourcekind);
+				case correlationkeyindex::correlationhypocenterkey:
+					return (objectkind::hypocenterkind);
+				case correlationkeyindex::correlationeventtypekey:
+					return (objectkind::eventtypekind);
+				case correlationkeyindex::correlationassociationkey:
+					return (objectkind::associationkind);
+				default: return (objectkind::unknownkind);
+			}
+		case objectkind::detectionkind:
+			switch (key) {
+				case detectionkeyindex::detectionsourcekey:
+					return (objectkind::sourcekind);
+				case detectionkeyindex::detectionhypocenterkey:
+					return (objectkind::hypocenterkind);
+				case detectionkeyindex::detectioneventtypekey:
+					return (objectkind::eventtypekind);
+				default: return (objectkind::unknownkind);
+			}
+		case objectkind::retractkind:
+			if (key == retractkeyindex::retractsourcekey) {
+				return (objectkind::sourcekind);
+			}
+			return (objectkind::unknownkind);
+		case objectkind::stationinfokind:
+			switch (key) {
+				case stationinfokeyindex::stationinfositekey:
+					return (objectkind::sitekind);
+				case stationinfokeyindex::stationinforequestorkey:
+					return (objectkind::sourcekind);
+				default: return (objectkind::unknownkind);
+			}
+		case objectkind::stationinforequestkind:
+			switch (key) {
+				case stationinforequestkeyindex::requestsitekey:
+					return (objectkind::sitekind);
+				case stationinforequestkeyindex::requestsourcekey:
+					return (objectkind::sourcekind);
+				default: return (objectkind::unknownkind);
+			}
+		case objectkind::classificationkind:
+			switch (key) {
+				case classificationkeyindex::classeventtypekey:
+					return (objectkind::eventtypekind);
+				case classificationkeyindex::classsourcekey:
+					return (objectkind::sourcekind);
+				default: return (objectkind::unknownkind);
+			}
+		default:
+			return (objectkind::unknownkind);
+	}
+}
+
+// returns the keys an object must have, parentkind is the kind of the object
+// holding it
+static uint64_t requiredkeys(int kind, int parentkind) {
+	switch (kind) {
+		case objectkind::pickkind:
+			return (KEYBIT(pickkeyindex::picktypekey)
+					| KEYBIT(pickkeyindex::pickidkey)
+					| KEYBIT(pickkeyindex::picksitekey)
+					| KEYBIT(pickkeyindex::picksourcekey)
+					| KEYBIT(pickkeyindex::picktimekey));
+		case objectkind::correlationkind:
+			return (KEYBIT(correlationkeyindex::correlationtypekey)
+					| KEYBIT(correlationkeyindex::correlationidkey)
+					| KEYBIT(correlationkeyindex::correlationsitekey)
+					| KEYBIT(correlationkeyindex::correlationsourcekey)
+					| KEYBIT(correlationkeyindex::correlationphasekey)
+					| KEYBIT(correlationkeyindex::correlationtimekey)
+					| KEYBIT(correlationkeyindex::correlationvaluekey)
+					| KEYBIT(correlationkeyindex::correlationhypocenterkey));
+		case objectkind::detectionkind:
+			return (KEYBIT(detectionkeyindex::detectiontypekey)
+					| KEYBIT(detectionkeyindex::detectionidkey)
+					| KEYBIT(detectionkeyindex::detectionsourcekey)
+					| KEYBIT(detectionkeyindex::detectionhypocenterkey));
+		case objectkind::retractkind:
+			return (KEYBIT(retractkeyindex::retracttypekey)
+					| KEYBIT(retractkeyindex::retractidkey)
+					| KEYBIT(retractkeyindex::retractsourcekey));
+		case objectkind::stationinfokind:
+			return (KEYBIT(stationinfokeyindex::stationinfotypekey)
+					| KEYBIT(stationinfokeyindex::stationinfositekey));
+		case objectkind::stationinforequestkind:
+			return (KEYBIT(stationinforequestkeyindex::requesttypekey)
+					| KEYBIT(stationinforequestkeyindex::requestsitekey)
+					| KEYBIT(stationinforequestkeyindex::requestsourcekey));
+		case objectkind::sitekind: {
+			uint64_t required = KEYBIT(sitekeyindex::sitestationkey)
+					| KEYBIT(sitekeyindex::sitenetworkkey);
+
+			// station information requires the site location
+			if (parentkind == objectkind::stationinfokind) {
+				required |= KEYBIT(sitekeyindex::sitelatitudekey)
+						| KEYBIT(sitekeyindex::sitelongitudekey)
+						| KEYBIT(sitekeyindex::siteelevationkey);
+			}
+			return (required);
+		}
+		case objectkind::sourcekind:
+			return (KEYBIT(sourcekeyindex::sourceagencyidkey)
+					| KEYBIT(sourcekeyindex::sourceauthorkey));
+		case objectkind::beamkind:
+			return (KEYBIT(beamkeyindex::beambackazimuthkey)
+					| KEYBIT(beamkeyindex::beamslownesskey));
+		case objectkind::hypocenterkind:
+			return (KEYBIT(hypocenterkeyindex::hypolatitudekey)
+					| KEYBIT(hypocenterkeyindex::hypolongitudekey)
+					| KEYBIT(hypocenterkeyindex::hypotimekey)
+					| KEYBIT(hypocenterkeyindex::hypodepthkey));
+		default:
+			return (0);
+	}
+}
+
+// returns whether an object is only checked when it is not empty
+static bool isoptional(int kind, int parentkind) {
+	if (kind == objectkind::beamkind) {
+		return (true);
+	} else if ((kind == objectkind::sourcekind)
+			&& ((parentkind == objectkind::classificationkind)
+			|| (parentkind == objectkind::stationinfokind))) {
+		return (true);
+	}
+	return (false);
+}
+
+// returns the object kind of a top level message type
+static int rootkind(int type) {
+	switch (type) {
+		case formattypes::picktype: return (objectkind::pickkind);
+		case formattypes::correlationtype:
+			return (objectkind::correlationkind);
+		case formattypes::detectiontype: return (objectkind::detectionkind);
+		case formattypes::retracttype: return (objectkind::retractkind);
+		case formattypes::stationinfotype:
+			return (objectkind::stationinfokind);
+		case formattypes::stationinforequesttype:
+			return (objectkind::stationinforequestkind);
+		default: return (objectkind::unknownkind);
+	}
+}
+
+// returns whether a frame is a detection Data element
+static bool isdataelement(const int *kind) {
+	return ((kind[0] == objectkind::pickkind)
+			&& (kind[1] == objectkind::correlationkind));
+}
+
+////////////// validator //////////////
+
+validator::validator() {
+	settype(formattypes::unknown);
+}
+
+validator::~validator() {
+}
+
+void validator::settype(int type) {
+	roottype = type;
+	depth = 0;
+	skipdepth = 0;
+	datadepth = 0;
+	valid = false;
+}
+
+bool validator::isvalid() {
+	return (valid);
+}
+
+bool validator::push(int kind0, int kind1) {
+	frame & newframe = stack[depth++];
+	newframe.kind[0] = kind0;
+	newframe.kind[1] = kind1;
+	for (int i = 0; i < 2; i++) {
+		newframe.key[i] = -1;
+		newframe.seen[i] = 0;
+		newframe.invalid[i] = false;
+		newframe.parentkey[i] = -1;
+	}
+	newframe.parentkind = objectkind::unknownkind;
+	newframe.datatype = formattypes::unknown;
+
+	return (true);
+}
+
+bool validator::fail() {
+	valid = false;
+
+	// errors inside a data element are not known to matter until the end of
+	// the element
+	return (datadepth > 0);
+}
+
+bool validator::Null() {
+	if ((skipdepth == 0) && (depth > 0)) {
+		stack[depth - 1].key[0] = -1;
+		stack[depth - 1].key[1] = -1;
+	}
+
+	// null values leave members at their defaults
+	return (depth > 0);
+}
+
+bool validator::Bool(bool) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	// the boolean members have no validation criteria
+	stack[depth - 1].key[0] = -1;
+	stack[depth - 1].key[1] = -1;
+
+	return (true);
+}
+
+bool validator::Int(int value) {
+	return (this->value(integervalue, NULL, 0, static_cast<double>(value),
+						true));
+}
+
+bool validator::Uint(unsigned value) {
+	return (this->value(integervalue, NULL, 0, static_cast<double>(value),
+						value <= static_cast<unsigned>(
+							std::numeric_limits<int>::max())));
+}
+
+bool validator::Int64(int64_t value) {
+	return (this->value(integervalue, NULL, 0, static_cast<double>(value),
+						false));
+}
+
+bool validator::Uint64(uint64_t value) {
+	return (this->value(integervalue, NULL, 0, static_cast<double>(value),
+						false));
+}
+
+bool validator::Double(double value) {
+	return (this->value(doublevalue, NULL, 0, value, false));
+}
+
+bool validator::RawNumber(const char *, rapidjson::SizeType, bool) {
+	// only called with kParseNumbersAsStringsFlag, which is not used
+	return (false);
+}
+
+bool validator::String(const char *str, rapidjson::SizeType length, bool) {
+	return (value(stringvalue, str, length, 0, false));
+}
+
+bool validator::value(int valuekind, const char *str,
+						rapidjson::SizeType length, double number, bool isint) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+	bool failed = false;
+
+	for (int i = 0; i < 2; i++) {
+		int kind = current.kind[i];
+		int key = current.key[i];
+		current.key[i] = -1;
+
+		if ((kind == objectkind::unknownkind) || (key < 0)) {
+			continue;
+		}
+
+		valuecheck result = valueignored;
+		if (valuekind == stringvalue) {
+			result = checkstring(kind, key, str, length);
+		} else if (valuekind == doublevalue) {
+			result = checknumber(kind, key, number);
+		} else if ((isint == true)
+				&& (kind == objectkind::classificationkind)
+				&& ((key == classificationkeyindex::classdistancekey)
+				|| (key == classificationkeyindex::classazimuthkey))) {
+			// classification distance and azimuth also accept integers
+			result = checknumber(kind, key, number);
+		}
+
+		if (result == valuecounted) {
+			current.seen[i] |= KEYBIT(key);
+		} else if (result == valueinvalid) {
+			current.invalid[i] = true;
+			failed = true;
+		}
+
+		// a data element is routed by the last Type string
+		if ((i == 0) && (valuekind == stringvalue)
+				&& (key == pickkeyindex::picktypekey)
+				&& (isdataelement(current.kind) == true)) {
+			if (isstring(PICK_TYPE, str, length) == true) {
+				current.datatype = formattypes::picktype;
+			} else if (isstring(CORRELATION_TYPE, str, length) == true) {
+				current.datatype = formattypes::correlationtype;
+			} else {
+				current.datatype = formattypes::unknown;
+			}
+		}
+	}
+
+	if (failed == true) {
+		return (fail());
+	}
+
+	return (true);
+}
+
+bool validator::StartObject() {
+	if (skipdepth > 0) {
+		skipdepth++;
+		return (true);
+	}
+
+	// root object
+	if (depth == 0) {
+		if (rootkind(roottype) == objectkind::unknownkind) {
+			return (false);
+		}
+		return (push(rootkind(roottype), objectkind::unknownkind));
+	}
+
+	// too deep, skip this object
+	if (depth >= DECODER_MAXDEPTH) {
+		skipdepth++;
+		return (true);
+	}
+
+	frame & current = stack[depth - 1];
+
+	// data elements are checked as both a pick and a correlation until the
+	// end of the element
+	if (current.kind[0] == objectkind::dataarraykind) {
+		datadepth++;
+		return (push(objectkind::pickkind, objectkind::correlationkind));
+	}
+
+	// object members, the subjects of a data element agree on the kind of
+	// any member they share
+	int kind = objectkind::unknownkind;
+	int parentkind = objectkind::unknownkind;
+	int kinds[2];
+	for (int i = 0; i < 2; i++) {
+		kinds[i] = objectkind::unknownkind;
+		if ((current.kind[i] != objectkind::unknownkind)
+				&& (current.key[i] >= 0)) {
+			kinds[i] = childkind(current.kind[i], current.key[i]);
+		}
+		if ((kind == objectkind::unknownkind)
+				&& (kinds[i] != objectkind::unknownkind)) {
+			kind = kinds[i];
+			parentkind = current.kind[i];
+		}
+	}
+
+	if (kind == objectkind::unknownkind) {
+		// unknown or mistyped member, skip it
+		current.key[0] = -1;
+		current.key[1] = -1;
+		skipdepth++;
+		return (true);
+	}
+
+	push(kind, objectkind::unknownkind);
+	frame & child = stack[depth - 1];
+	child.parentkind = parentkind;
+	for (int i = 0; i < 2; i++) {
+		if (kinds[i] == kind) {
+			child.parentkey[i] = current.key[i];
+		}
+		current.key[i] = -1;
+	}
+
+	return (true);
+}
+
+bool validator::Key(const char *str, rapidjson::SizeType length, bool) {
+	if (skipdepth > 0) {
+		return (true);
+	}
+
+	frame & current = stack[depth - 1];
+
+	// data element keys are looked up as both pick and correlation keys, the
+	// keys the two share are copied from the pick to the correlation
+	for (int i = 0; i < 2; i++) {
+		if (current.kind[i] != objectkind::unknownkind) {
+			current.key[i] = FindObjectKey(current.kind[i], str, length);
+		}
+	}
+
+	return (true);
+}
+
+bool validator::EndObject(rapidjson::SizeType) {
+	if (skipdepth > 0) {
+		skipdepth--;
+		return (true);
+	}
+
+	frame & current = stack[--depth];
+
+	// check the required keys of each subject
+	bool ok[2];
+	for (int i = 0; i < 2; i++) {
+		uint64_t required = requiredkeys(current.kind[i], current.parentkind);
+
+		ok[i] = (current.invalid[i] == false)
+				&& ((current.seen[i] & required) == required);
+
+		if ((current.seen[i] == 0)
+				&& (current.invalid[i] == false)
+				&& (isoptional(current.kind[i], current.parentkind) == true)) {
+			ok[i] = true;
+		}
+	}
+
+	// root object
+	if (depth == 0) {
+		valid = ok[0];
+		return (valid);
+	}
+
+	// data elements count against the detection based on their type
+	if (isdataelement(current.kind) == true) {
+		datadepth--;
+
+		bool elementok = true;
+		if (current.datatype == formattypes::picktype) {
+			elementok = ok[0];
+		} else if (current.datatype == formattypes::correlationtype) {
+			elementok = ok[1];
+		}
+
+		if (elementok == false) {
+			stack[depth - 2].invalid[0] = true;
+			return (fail());
+		}
+		return (true);
+	}
+
+	// member objects count as seen by the subjects of their parent
+	frame & parent = stack[depth - 1];
+	for (int i = 0; i < 2; i++) {
+		if (current.parentkey[i] < 0) {
+			continue;
+		}
+
+		parent.seen[i] |= KEYBIT(current.parentkey[i]);
+		if (ok[0] == false) {
+			parent.invalid[i] = true;
+		}
+	}
+
+	if (ok[0] == false) {
+		return (fail());
+	}
+
+	return (true);
+}
+
+bool validator::StartArray() {
+	if (skipdepth > 0) {
+		skipdepth++;
+		return (true);
+	}
+	if (depth == 0) {
+		// root is not an object
+		return (false);
+	}
+
+	frame & current = stack[depth - 1];
+	int key = current.key[0];
+	current.key[0] = -1;
+	current.key[1] = -1;
+
+	// only the detection Data array is checked, Filter has no criteria that
+	// affect its pick, and nested arrays are not part of any format
+	if ((depth < DECODER_MAXDEPTH)
+			&& (current.kind[0] == objectkind::detectionkind)
+			&& (key == detectionkeyindex::detectiondatakey)) {
+		return (push(objectkind::dataarraykind, objectkind::unknownkind));
+	}
+
+	skipdepth++;
+	return (true);
+}
+
+bool validator::EndArray(rapidjson::SizeType) {
+	if (skipdepth > 0) {
+		skipdepth--;
+		return (true);
+	}
+
+	depth--;
+	return (true);
+}
+}  // namespace detectionformats
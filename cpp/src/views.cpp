@@ -0,0 +1,694 @@
+#include <views.h>
+#include <keys.h>
+
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace detectionformats {
+// returns a view of a json string parsed in place
+static string_view getview(const rapidjson::Value &value) {
+	return (string_view(value.GetString(), value.GetStringLength()));
+}
+
+// returns a view of a copy of the string in the arena
+static string_view copyview(const std::string &str,
+							message_arena &memory) { // NOLINT
+	if (str.empty() == true) {
+		return (string_view());
+	}
+	return (string_view(memory.copy(str.data(), str.length()), str.length()));
+}
+
+// only doubles are read as numbers, like the owning classes
+static bool isdouble(const rapidjson::Value &value) {
+	return ((value.IsNumber() == true) && (value.IsDouble() == true));
+}
+
+////////////// site_view //////////////
+
+site_view::site_view() {
+	latitude = std::numeric_limits<double>::quiet_NaN();
+	longitude = std::numeric_limits<double>::quiet_NaN();
+	elevation = std::numeric_limits<double>::quiet_NaN();
+}
+
+void site_view::read(rapidjson::Value &json) { // NOLINT
+	*this = site_view();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		int key = sitekeytable.find(member->name.GetString(),
+									member->name.GetStringLength());
+
+		if (value.IsString() == true) {
+			switch (key) {
+				case sitekeyindex::sitestationkey:
+					station = getview(value);
+					break;
+				case sitekeyindex::sitechannelkey:
+					channel = getview(value);
+					break;
+				case sitekeyindex::sitenetworkkey:
+					network = getview(value);
+					break;
+				case sitekeyindex::sitelocationkey:
+					location = getview(value);
+					break;
+				default:
+					break;
+			}
+		} else if (isdouble(value) == true) {
+			switch (key) {
+				case sitekeyindex::sitelatitudekey:
+					latitude = value.GetDouble();
+					break;
+				case sitekeyindex::sitelongitudekey:
+					longitude = value.GetDouble();
+					break;
+				case sitekeyindex::siteelevationkey:
+					elevation = value.GetDouble();
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+void site_view::assign(const site &object,
+						message_arena &memory) { // NOLINT
+	station = copyview(object.station, memory);
+	channel = copyview(object.channel, memory);
+	network = copyview(object.network, memory);
+	location = copyview(object.location, memory);
+	latitude = object.latitude;
+	longitude = object.longitude;
+	elevation = object.elevation;
+}
+
+site site_view::tosite() const {
+	return (site(station.str(), channel.str(), network.str(), location.str(),
+					latitude, longitude, elevation));
+}
+
+////////////// source_view //////////////
+
+void source_view::read(rapidjson::Value &json) { // NOLINT
+	*this = source_view();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		if (value.IsString() == false) {
+			continue;
+		}
+
+		switch (sourcekeytable.find(member->name.GetString(),
+									member->name.GetStringLength())) {
+			case sourcekeyindex::sourceagencyidkey:
+				agencyid = getview(value);
+				break;
+			case sourcekeyindex::sourceauthorkey:
+				author = getview(value);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void source_view::assign(const source &object,
+							message_arena &memory) { // NOLINT
+	agencyid = copyview(object.agencyid, memory);
+	author = copyview(object.author, memory);
+}
+
+source source_view::tosource() const {
+	return (source(agencyid.str(), author.str()));
+}
+
+////////////// association_view //////////////
+
+association_view::association_view() {
+	distance = std::numeric_limits<double>::quiet_NaN();
+	azimuth = std::numeric_limits<double>::quiet_NaN();
+	residual = std::numeric_limits<double>::quiet_NaN();
+	sigma = std::numeric_limits<double>::quiet_NaN();
+}
+
+void association_view::read(rapidjson::Value &json) { // NOLINT
+	*this = association_view();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		int key = associationkeytable.find(member->name.GetString(),
+											member->name.GetStringLength());
+
+		if (value.IsString() == true) {
+			if (key == associationkeyindex::associationphasekey) {
+				phase = getview(value);
+			}
+		} else if (isdouble(value) == true) {
+			switch (key) {
+				case associationkeyindex::associationdistancekey:
+					distance = value.GetDouble();
+					break;
+				case associationkeyindex::associationazimuthkey:
+					azimuth = value.GetDouble();
+					break;
+				case associationkeyindex::associationresidualkey:
+					residual = value.GetDouble();
+					break;
+				case associationkeyindex::associationsigmakey:
+					sigma = value.GetDouble();
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+void association_view::assign(const association &object,
+								message_arena &memory) { // NOLINT
+	phase = copyview(object.phase, memory);
+	distance = object.distance;
+	azimuth = object.azimuth;
+	residual = object.residual;
+	sigma = object.sigma;
+}
+
+association association_view::toassociation() const {
+	return (association(phase.str(), distance, azimuth, residual, sigma));
+}
+
+////////////// pick_view //////////////
+
+pick_view::pick_view() {
+	time = std::numeric_limits<double>::quiet_NaN();
+	polarity = polarityindex::polaritycount;
+	onset = onsetindex::onsetcount;
+	picker = pickerindex::pickercount;
+	filterdata = NULL;
+	classificationinfo = NULL;
+}
+
+void pick_view::read(rapidjson::Value &json) { // NOLINT
+	*this = pick_view();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		int key = pickkeytable.find(member->name.GetString(),
+									member->name.GetStringLength());
+
+		if (value.IsString() == true) {
+			switch (key) {
+				case pickkeyindex::picktypekey:
+					type = getview(value);
+					break;
+				case pickkeyindex::pickidkey:
+					id = getview(value);
+					break;
+				case pickkeyindex::picktimekey:
+					time = ConvertISO8601ToEpochTime(value.GetString(),
+													value.GetStringLength());
+					break;
+				case pickkeyindex::pickphasekey:
+					phase = getview(value);
+					break;
+				case pickkeyindex::pickpolaritykey:
+					polarity = GetPolarityIndex(value.GetString(),
+												value.GetStringLength());
+					if (polarity < 0) {
+						polaritytext = getview(value);
+					}
+					break;
+				case pickkeyindex::pickonsetkey:
+					onset = GetOnsetIndex(value.GetString(),
+											value.GetStringLength());
+					if (onset < 0) {
+						onsettext = getview(value);
+					}
+					break;
+				case pickkeyindex::pickpickerkey:
+					picker = GetPickerIndex(value.GetString(),
+											value.GetStringLength());
+					if (picker < 0) {
+						pickertext = getview(value);
+					}
+					break;
+				default:
+					break;
+			}
+		} else if (value.IsObject() == true) {
+			switch (key) {
+				case pickkeyindex::picksitekey:
+					site.read(value);
+					break;
+				case pickkeyindex::picksourcekey:
+					source.read(value);
+					break;
+				case pickkeyindex::pickamplitudekey:
+					amplitude = detectionformats::amplitude(value);
+					break;
+				case pickkeyindex::pickbeamkey:
+					beam = detectionformats::beam(value);
+					break;
+				case pickkeyindex::pickassociationkey:
+					associationinfo.read(value);
+					break;
+				case pickkeyindex::pickclassificationkey:
+					classificationinfo = &value;
+					break;
+				default:
+					break;
+			}
+		} else if ((value.IsArray() == true)
+				&& (key == pickkeyindex::pickfilterkey)) {
+			filterdata = &value;
+		}
+	}
+}
+
+void pick_view::assign(const pick &object,
+						message_arena &memory) { // NOLINT
+	type = copyview(object.type, memory);
+	id = copyview(object.id, memory);
+	site.assign(object.site, memory);
+	time = object.time;
+	source.assign(object.source, memory);
+	phase = copyview(object.phase, memory);
+	polarity = object.polarity;
+	polaritytext = copyview(object.polaritytext, memory);
+	onset = object.onset;
+	onsettext = copyview(object.onsettext, memory);
+	picker = object.picker;
+	pickertext = copyview(object.pickertext, memory);
+	amplitude = object.amplitude;
+	beam = object.beam;
+	associationinfo.assign(object.associationinfo, memory);
+	filterdata = NULL;
+	classificationinfo = NULL;
+
+	// the rarely read members are built as json in the arena, the arena
+	// allocator does not need values to be destroyed. tojson() is not const,
+	// so they are built from copies
+	rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & allocator =
+			memory.getallocator();
+
+	if (object.filterdata.size() > 0) {
+		filterdata = new (memory.allocate(sizeof(rapidjson::Value)))
+				rapidjson::Value(rapidjson::kArrayType);
+
+		for (int i = 0; i < static_cast<int>(object.filterdata.size()); i++) {
+			rapidjson::Value filtervalue(rapidjson::kObjectType);
+			filter filterobject(object.filterdata[i]);
+			filterobject.tojson(filtervalue, allocator);
+			filterdata->PushBack(filtervalue, allocator);
+		}
+	}
+
+	if (object.classificationinfo.isempty() == false) {
+		classificationinfo = new (memory.allocate(sizeof(rapidjson::Value)))
+				rapidjson::Value(rapidjson::kObjectType);
+		classification classificationobject(object.classificationinfo);
+		classificationobject.tojson(*classificationinfo, allocator);
+	}
+}
+
+pick pick_view::topick() const {
+	pick object;
+	object.type = type.str();
+	object.id = id.str();
+	object.site = site.tosite();
+	object.time = time;
+	object.source = source.tosource();
+	object.phase = phase.str();
+	object.polarity = polarity;
+	object.polaritytext = polaritytext.str();
+	object.onset = onset;
+	object.onsettext = onsettext.str();
+	object.picker = picker;
+	object.pickertext = pickertext.str();
+	object.amplitude = amplitude;
+	object.beam = beam;
+	object.associationinfo = associationinfo.toassociation();
+
+	if (filterdata != NULL) {
+		for (rapidjson::SizeType i = 0; i < filterdata->Size(); i++) {
+			// only filter objects can be parsed
+			if ((*filterdata)[i].IsObject() == true) {
+				object.filterdata.push_back(filter((*filterdata)[i]));
+			}
+		}
+	}
+
+	if (classificationinfo != NULL) {
+		object.classificationinfo = classification(*classificationinfo);
+	}
+
+	return (object);
+}
+
+////////////// correlation_view //////////////
+
+correlation_view::correlation_view() {
+	time = std::numeric_limits<double>::quiet_NaN();
+	correlationvalue = std::numeric_limits<double>::quiet_NaN();
+	magnitude = std::numeric_limits<double>::quiet_NaN();
+	snr = std::numeric_limits<double>::quiet_NaN();
+	zscore = std::numeric_limits<double>::quiet_NaN();
+	detectionthreshold = std::numeric_limits<double>::quiet_NaN();
+}
+
+void correlation_view::read(rapidjson::Value &json) { // NOLINT
+	*this = correlation_view();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		int key = correlationkeytable.find(member->name.GetString(),
+											member->name.GetStringLength());
+
+		if (value.IsString() == true) {
+			switch (key) {
+				case correlationkeyindex::correlationtypekey:
+					type = getview(value);
+					break;
+				case correlationkeyindex::correlationidkey:
+					id = getview(value);
+					break;
+				case correlationkeyindex::correlationphasekey:
+					phase = getview(value);
+					break;
+				case correlationkeyindex::correlationtimekey:
+					time = ConvertISO8601ToEpochTime(value.GetString(),
+													value.GetStringLength());
+					break;
+				case correlationkeyindex::correlationthresholdtypekey:
+					thresholdtype = getview(value);
+					break;
+				default:
+					break;
+			}
+		} else if (isdouble(value) == true) {
+			switch (key) {
+				case correlationkeyindex::correlationvaluekey:
+					correlationvalue = value.GetDouble();
+					break;
+				case correlationkeyindex::correlationmagnitudekey:
+					magnitude = value.GetDouble();
+					break;
+				case correlationkeyindex::correlationsnrkey:
+					snr = value.GetDouble();
+					break;
+				case correlationkeyindex::correlationzscorekey:
+					zscore = value.GetDouble();
+					break;
+				case correlationkeyindex::correlationthresholdkey:
+					detectionthreshold = value.GetDouble();
+					break;
+				default:
+					break;
+			}
+		} else if (value.IsObject() == true) {
+			switch (key) {
+				case correlationkeyindex::correlationsitekey:
+					site.read(value);
+					break;
+				case correlationkeyindex::correlationsourcekey:
+					source.read(value);
+					break;
+				case correlationkeyindex::correlationhypocenterkey:
+					hypocenter = detectionformats::hypocenter(value);
+					break;
+				case correlationkeyindex::correlationeventtypekey:
+					eventtype = detectionformats::eventtype(value);
+					break;
+				case correlationkeyindex::correlationassociationkey:
+					associationinfo.read(value);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+void correlation_view::assign(const correlation &object,
+								message_arena &memory) { // NOLINT
+	type = copyview(object.type, memory);
+	id = copyview(object.id, memory);
+	site.assign(object.site, memory);
+	source.assign(object.source, memory);
+	phase = copyview(object.phase, memory);
+	time = object.time;
+	correlationvalue = object.correlationvalue;
+	hypocenter = object.hypocenter;
+	eventtype = object.eventtype;
+	magnitude = object.magnitude;
+	snr = object.snr;
+	zscore = object.zscore;
+	detectionthreshold = object.detectionthreshold;
+	thresholdtype = copyview(object.thresholdtype, memory);
+	associationinfo.assign(object.associationinfo, memory);
+}
+
+correlation correlation_view::tocorrelation() const {
+	correlation object;
+	object.type = type.str();
+	object.id = id.str();
+	object.site = site.tosite();
+	object.source = source.tosource();
+	object.phase = phase.str();
+	object.time = time;
+	object.correlationvalue = correlationvalue;
+	object.hypocenter = hypocenter;
+	object.eventtype = eventtype;
+	object.magnitude = magnitude;
+	object.snr = snr;
+	object.zscore = zscore;
+	object.detectionthreshold = detectionthreshold;
+	object.thresholdtype = thresholdtype.str();
+	object.associationinfo = associationinfo.toassociation();
+	return (object);
+}
+
+////////////// detection_view //////////////
+
+detection_view::detection_view() {
+	clear();
+}
+
+detection_view::detection_view(message_arena *memory)
+		: pickdata(arena_allocator<pick_view>(memory)),
+			correlationdata(arena_allocator<correlation_view>(memory)) {
+	clear();
+}
+
+void detection_view::clear() {
+	type = string_view();
+	id = string_view();
+	source = source_view();
+	hypocenter = detectionformats::hypocenter();
+	detectiontype = detectiontypeindex::detectiontypecount;
+	detectiontypetext = string_view();
+	eventtype = detectionformats::eventtype();
+	bayes = std::numeric_limits<double>::quiet_NaN();
+	minimumdistance = std::numeric_limits<double>::quiet_NaN();
+	rms = std::numeric_limits<double>::quiet_NaN();
+	gap = std::numeric_limits<double>::quiet_NaN();
+	detectiontime = std::numeric_limits<double>::quiet_NaN();
+	pickdata.clear();
+	correlationdata.clear();
+}
+
+void detection_view::read(rapidjson::Value &json) { // NOLINT
+	clear();
+
+	for (rapidjson::Value::MemberIterator member = json.MemberBegin();
+			member != json.MemberEnd(); ++member) {
+		rapidjson::Value & value = member->value;
+		int key = detectionkeytable.find(member->name.GetString(),
+										member->name.GetStringLength());
+
+		if (value.IsString() == true) {
+			switch (key) {
+				case detectionkeyindex::detectiontypekey:
+					type = getview(value);
+					break;
+				case detectionkeyindex::detectionidkey:
+					id = getview(value);
+					break;
+				case detectionkeyindex::detectiondetectiontypekey:
+					detectiontype = GetDetectionTypeIndex(value.GetString(),
+							value.GetStringLength());
+					if (detectiontype < 0) {
+						detectiontypetext = getview(value);
+					}
+					break;
+				case detectionkeyindex::detectiontimekey:
+					detectiontime = ConvertISO8601ToEpochTime(
+							value.GetString(), value.GetStringLength());
+					break;
+				default:
+					break;
+			}
+		} else if (isdouble(value) == true) {
+			switch (key) {
+				case detectionkeyindex::detectionbayeskey:
+					bayes = value.GetDouble();
+					break;
+				case detectionkeyindex::detectionmindistkey:
+					minimumdistance = value.GetDouble();
+					break;
+				case detectionkeyindex::detectionrmskey:
+					rms = value.GetDouble();
+					break;
+				case detectionkeyindex::detectiongapkey:
+					gap = value.GetDouble();
+					break;
+				default:
+					break;
+			}
+		} else if (value.IsObject() == true) {
+			switch (key) {
+				case detectionkeyindex::detectionsourcekey:
+					source.read(value);
+					break;
+				case detectionkeyindex::detectionhypocenterkey:
+					hypocenter = detectionformats::hypocenter(value);
+					break;
+				case detectionkeyindex::detectioneventtypekey:
+					eventtype = detectionformats::eventtype(value);
+					break;
+				default:
+					break;
+			}
+		} else if ((value.IsArray() == true)
+				&& (key == detectionkeyindex::detectiondatakey)) {
+			for (rapidjson::SizeType i = 0; i < value.Size(); i++) {
+				rapidjson::Value & datavalue = value[i];
+				if (datavalue.IsObject() == false) {
+					continue;
+				}
+
+				rapidjson::Value::MemberIterator typemember =
+						datavalue.FindMember(TYPE_KEY);
+				if ((typemember == datavalue.MemberEnd())
+						|| (typemember->value.IsString() == false)) {
+					continue;
+				}
+
+				// route based on typestring
+				string_view typestring = getview(typemember->value);
+				if (typestring == PICK_TYPE) {
+					pickdata.resize(pickdata.size() + 1);
+					pickdata.back().read(datavalue);
+				} else if (typestring == CORRELATION_TYPE) {
+					correlationdata.resize(correlationdata.size() + 1);
+					correlationdata.back().read(datavalue);
+				}
+			}
+		}
+	}
+}
+
+void detection_view::assign(const detection &object,
+								message_arena &memory) { // NOLINT
+	clear();
+	type = copyview(object.type, memory);
+	id = copyview(object.id, memory);
+	source.assign(object.source, memory);
+	hypocenter = object.hypocenter;
+	detectiontype = object.detectiontype;
+	detectiontypetext = copyview(object.detectiontypetext, memory);
+	eventtype = object.eventtype;
+	bayes = object.bayes;
+	minimumdistance = object.minimumdistance;
+	rms = object.rms;
+	gap = object.gap;
+	detectiontime = object.detectiontime;
+
+	pickdata.resize(object.pickdata.size());
+	for (size_t i = 0; i < object.pickdata.size(); i++) {
+		pickdata[i].assign(object.pickdata[i], memory);
+	}
+
+	correlationdata.resize(object.correlationdata.size());
+	for (size_t i = 0; i < object.correlationdata.size(); i++) {
+		correlationdata[i].assign(object.correlationdata[i], memory);
+	}
+}
+
+detection detection_view::todetection() const {
+	detection object;
+	object.type = type.str();
+	object.id = id.str();
+	object.source = source.tosource();
+	object.hypocenter = hypocenter;
+	object.detectiontype = detectiontype;
+	object.detectiontypetext = detectiontypetext.str();
+	object.eventtype = eventtype;
+	object.bayes = bayes;
+	object.minimumdistance = minimumdistance;
+	object.rms = rms;
+	object.gap = gap;
+	object.detectiontime = detectiontime;
+
+	object.pickdata.reserve(pickdata.size());
+	for (const pick_view &data : pickdata) {
+		object.pickdata.push_back(data.topick());
+	}
+
+	object.correlationdata.reserve(correlationdata.size());
+	for (const correlation_view &data : correlationdata) {
+		object.correlationdata.push_back(data.tocorrelation());
+	}
+
+	return (object);
+}
+
+////////////// functions //////////////
+
+// parses the provided buffer in place, returning the top level object
+static rapidjson::Value & parseinsitu(char *jsonbuffer,
+										codec_context &context) { // NOLINT
+	codecdocument & jsondocument = context.parseinsitu(jsonbuffer);
+
+	if (jsondocument.HasParseError()) {
+		throw std::invalid_argument("Error parsing JSON buffer into document.");
+	}
+
+	if (jsondocument.IsObject() == false) {
+		throw std::invalid_argument(
+				"JSON buffer did not parse into valid JSON.");
+	}
+
+	return (jsondocument);
+}
+
+pick_view & FromJSONInsitu(char *jsonbuffer, pick_view &view,
+							codec_context &context) { // NOLINT
+	view.read(parseinsitu(jsonbuffer, context));
+	return (view);
+}
+
+correlation_view & FromJSONInsitu(char *jsonbuffer, correlation_view &view,
+									codec_context &context) { // NOLINT
+	view.read(parseinsitu(jsonbuffer, context));
+	return (view);
+}
+
+detection_view & FromJSONInsitu(char *jsonbuffer, detection_view &view,
+								codec_context &context) { // NOLINT
+	view.read(parseinsitu(jsonbuffer, context));
+	return (view);
+}
+}  // namespace detectionformats
@@ -0,0 +1,96 @@
+#include <workqueue.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace detectionformats {
+////////////// workqueue //////////////
+
+workqueue::workqueue(size_t count, int workers, size_t chunksize)
+		: ranges(new range[std::max(workers, 1)]),
+			workercount(std::max(workers, 1)),
+			chunk(std::max(chunksize, static_cast<size_t>(1))) {
+	// split the items evenly, the first ranges take the remainder
+	size_t share = count / workercount;
+	size_t remainder = count % workercount;
+	size_t begin = 0;
+
+	for (int i = 0; i < workercount; i++) {
+		size_t length = share + ((static_cast<size_t>(i) < remainder) ? 1 : 0);
+		ranges[i].begin = begin;
+		ranges[i].end = begin + length;
+		begin += length;
+	}
+}
+
+workqueue::~workqueue() {
+}
+
+bool workqueue::next(int worker, size_t *begin, size_t *end) {
+	if ((worker < 0) || (worker >= workercount)) {
+		return (false);
+	}
+
+	range & own = ranges[worker];
+
+	do {
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (own.begin < own.end) {
+			*begin = own.begin;
+			*end = std::min(own.begin + chunk, own.end);
+			own.begin = *end;
+			return (true);
+		}
+	} while (steal(worker) == true);
+
+	return (false);
+}
+
+bool workqueue::steal(int worker) {
+	// stealing from the fullest range keeps the number of steals low
+	int victim = -1;
+	size_t most = 0;
+	for (int i = 1; i < workercount; i++) {
+		int candidate = (worker + i) % workercount;
+		std::lock_guard<std::mutex> guard(ranges[candidate].lock);
+		size_t remaining = ranges[candidate].end - ranges[candidate].begin;
+		if (remaining > most) {
+			most = remaining;
+			victim = candidate;
+		}
+	}
+
+	if (victim < 0) {
+		return (false);
+	}
+
+	// take the back half, the victim keeps working from the front
+	size_t begin;
+	size_t end;
+	{
+		std::lock_guard<std::mutex> guard(ranges[victim].lock);
+		size_t remaining = ranges[victim].end - ranges[victim].begin;
+		if (remaining == 0) {
+			// emptied since it was chosen, look again
+			return (true);
+		}
+
+		size_t stolen = std::max(remaining / 2, std::min(chunk, remaining));
+		end = ranges[victim].end;
+		begin = end - stolen;
+		ranges[victim].end = begin;
+	}
+
+	// only one lock is held at a time, so the worker's range is set after
+	// the victim's is released
+	std::lock_guard<std::mutex> guard(ranges[worker].lock);
+	ranges[worker].begin = begin;
+	ranges[worker].end = end;
+
+	return (true);
+}
+
+int workqueue::getworkers() const {
+	return (workercount);
+}
+}  // namespace detectionformats
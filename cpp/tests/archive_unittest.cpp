@@ -0,0 +1,222 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+#define ARCHIVEPATH "./archivetest"
+
+// removes the segments of the test archive
+void removearchive() {
+	for (int i = 0; i < 100; i++) {
+		std::string digits = std::to_string(i);
+		digits.insert(0, 6 - digits.length(), '0');
+		std::remove((std::string(ARCHIVEPATH) + "." + digits
+				+ ARCHIVE_EXTENSION).c_str());
+	}
+}
+
+// tests to see if the archive finds the records in a window
+TEST(ArchiveTest, FindsWindows) {
+	removearchive();
+	std::vector<double> times;
+	{
+		rapidjson::Document doc;
+		detectionformats::pick object(
+				detectionformats::FromJSONString(std::string(PICKSTRING),
+													doc));
+		detectionformats::archive_writer writer(ARCHIVEPATH, 1000);
+		for (int i = 0; i < 2500; i++) {
+			// picks arrive out of order
+			object.id = std::to_string(i);
+			object.time = 1000.0 + ((i * 7919) % 2500) * 0.5;
+			ASSERT_TRUE(writer.append(object));
+			times.push_back(object.time);
+		}
+		ASSERT_EQ(writer.getsegmentnumber(), 2);
+
+		object.id = "-1";
+		object.time = std::nan("");
+		ASSERT_FALSE(writer.append(object));
+
+		detectionformats::detection detectionobject(
+				detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+													doc));
+		detectionobject.hypocenter.time = 1100.0;
+		ASSERT_TRUE(writer.append(detectionobject));
+	}
+
+	detectionformats::archive_reader reader(ARCHIVEPATH);
+	ASSERT_EQ(reader.getsegmentcount(), 3);
+	ASSERT_EQ(reader.size(), 2501);
+
+	double windows[][2] = { { 1000.0, 1000.0 }, { 1100.25, 1200.0 },
+			{ 0.0, 5000.0 }, { 1500.0, 1100.0 }, { 1300.1, 1300.2 },
+			{ 2249.5, 9999.0 } };
+	for (const double *window : windows) {
+		size_t expected = 0;
+		for (double time : times) {
+			if ((time >= window[0]) && (time <= window[1])) {
+				expected++;
+			}
+		}
+
+		std::vector<detectionformats::pick> picks;
+		ASSERT_EQ(reader.read(window[0], window[1], &picks), expected);
+		ASSERT_EQ(picks.size(), expected);
+		for (detectionformats::pick &object : picks) {
+			ASSERT_GE(object.time, window[0]);
+			ASSERT_LE(object.time, window[1]);
+			ASSERT_EQ(object.time, times[std::stoi(object.id)]);
+		}
+	}
+
+	// the types are kept apart
+	std::vector<detectionformats::detection> detections;
+	ASSERT_EQ(reader.read(1000.0, 1200.0, &detections), 1);
+	ASSERT_EQ(detections[0].hypocenter.time, 1100.0);
+	std::vector<detectionformats::correlation> correlations;
+	ASSERT_EQ(reader.read(0.0, 5000.0, &correlations), 0);
+
+	removearchive();
+}
+
+// tests to see if a reopened archive appends new segments
+TEST(ArchiveTest, Appends) {
+	removearchive();
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	{
+		detectionformats::archive_writer writer(ARCHIVEPATH, 10);
+		for (int i = 0; i < 15; i++) {
+			object.id = std::to_string(i);
+			object.time = 1000.0 + i;
+			writer.append(object);
+		}
+		writer.seal();
+		ASSERT_EQ(writer.getsegmentnumber(), 2);
+	}
+	{
+		detectionformats::archive_writer writer(ARCHIVEPATH, 10);
+		ASSERT_EQ(writer.getsegmentnumber(), 2);
+		object.id = "15";
+		object.time = 1000.0;
+		writer.append(object);
+	}
+
+	detectionformats::archive_reader reader(ARCHIVEPATH);
+	ASSERT_EQ(reader.getsegmentcount(), 3);
+	std::vector<detectionformats::archive_record> found;
+	ASSERT_EQ(reader.find(detectionformats::formattypes::picktype, 1000.0,
+							1000.0, &found), 2);
+	ASSERT_EQ(found[0].time, 1000.0);
+	ASSERT_EQ(found[0].type, detectionformats::formattypes::picktype);
+
+	removearchive();
+}
+
+// tests to see if bad segments are skipped
+TEST(ArchiveTest, SkipsInvalid) {
+	removearchive();
+	{
+		rapidjson::Document doc;
+		detectionformats::pick object(
+				detectionformats::FromJSONString(std::string(PICKSTRING),
+													doc));
+		detectionformats::archive_writer writer(ARCHIVEPATH, 10);
+		for (int i = 0; i < 30; i++) {
+			object.id = std::to_string(i);
+			object.time = 1000.0 + i;
+			writer.append(object);
+		}
+	}
+	std::string corrupt = std::string(ARCHIVEPATH) + ".000000"
+			+ ARCHIVE_EXTENSION;
+	std::string empty = std::string(ARCHIVEPATH) + ".000001"
+			+ ARCHIVE_EXTENSION;
+	{
+		std::ofstream file(corrupt.c_str(), std::ios::trunc);
+		file << PICKSTRING;
+	}
+	{
+		std::ofstream file(empty.c_str(), std::ios::trunc);
+	}
+
+	// the segments after the bad ones are still read
+	{
+		detectionformats::archive_reader reader(ARCHIVEPATH);
+		ASSERT_EQ(reader.getsegmentcount(), 1);
+		ASSERT_EQ(reader.size(), 10);
+		ASSERT_EQ(reader.getskippedsegments().size(), 2);
+		ASSERT_EQ(reader.getskippedsegments()[0], corrupt);
+		ASSERT_EQ(reader.getskippedsegments()[1], empty);
+
+		std::vector<detectionformats::pick> picks;
+		ASSERT_EQ(reader.read(1000.0, 1100.0, &picks), 10);
+		ASSERT_EQ(picks.front().time, 1020.0);
+	}
+
+	// a missing archive has no segments
+	removearchive();
+	detectionformats::archive_reader reader(ARCHIVEPATH);
+	ASSERT_EQ(reader.getsegmentcount(), 0);
+	ASSERT_EQ(reader.size(), 0);
+}
+
+// tests to see if a record that does not decode leaves the output as it was
+TEST(ArchiveTest, KeepsOutputOnError) {
+	removearchive();
+	{
+		rapidjson::Document doc;
+		detectionformats::pick object(
+				detectionformats::FromJSONString(std::string(PICKSTRING),
+													doc));
+		detectionformats::archive_writer writer(ARCHIVEPATH, 10);
+		for (int i = 0; i < 5; i++) {
+			object.id = std::to_string(i);
+			object.time = 1000.0 + i;
+			writer.append(object);
+		}
+	}
+
+	// break the binary header of the third record, the records follow the
+	// 48 byte segment header, each after a 12 byte time and length
+	std::string segmentname = std::string(ARCHIVEPATH) + ".000000"
+			+ ARCHIVE_EXTENSION;
+	std::string contents;
+	{
+		std::ifstream file(segmentname.c_str(), std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file),
+						std::istreambuf_iterator<char>());
+	}
+	size_t recordlength = 12 + static_cast<uint8_t>(contents[56])
+			+ (static_cast<uint8_t>(contents[57]) << 8);
+	contents[48 + 2 * recordlength + 12 + 1] = '\x7F';
+	{
+		std::ofstream file(segmentname.c_str(),
+							std::ios::binary | std::ios::trunc);
+		file << contents;
+	}
+
+	detectionformats::archive_reader reader(ARCHIVEPATH);
+	ASSERT_EQ(reader.getsegmentcount(), 1);
+	std::vector<detectionformats::pick> picks(1);
+	picks[0].id = "kept";
+	ASSERT_THROW(reader.read(0.0, 5000.0, &picks), std::invalid_argument);
+	ASSERT_EQ(picks.size(), 1);
+	ASSERT_EQ(picks[0].id, "kept");
+
+	// the records before it still decode
+	ASSERT_EQ(reader.read(0.0, 1001.0, &picks), 2);
+	ASSERT_EQ(picks.size(), 3);
+
+	removearchive();
+}
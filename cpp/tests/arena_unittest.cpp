@@ -0,0 +1,104 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// tests to see if the arena allocates and copies
+TEST(ArenaTest, Allocates) {
+	detectionformats::message_arena memory(1024);
+	ASSERT_EQ(memory.getused(), 0);
+	ASSERT_TRUE(memory.allocate(0) == NULL);
+
+	void *block = memory.allocate(3);
+	ASSERT_TRUE(block != NULL);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(void *), 0);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(memory.allocate(8))
+				% alignof(void *), 0);
+	ASSERT_GT(memory.getused(), 0);
+
+	const char *copy = memory.copy("BMNHHZ", 3);
+	ASSERT_STREQ(copy, "BMN");
+}
+
+// tests to see if the arena releases everything and grows on reset
+TEST(ArenaTest, Resets) {
+	detectionformats::message_arena memory(1024);
+	memory.allocate(512);
+	memory.reset();
+	ASSERT_EQ(memory.getused(), 0);
+	ASSERT_EQ(memory.getpoolsize(), 1024);
+
+	// overflow the pool, the next reset grows it
+	memory.allocate(4096);
+	memory.reset();
+	ASSERT_EQ(memory.getused(), 0);
+	ASSERT_GT(memory.getpoolsize(), 4096);
+}
+
+// tests to see if containers allocate from the arena
+TEST(ArenaTest, Allocator) {
+	detectionformats::message_arena memory(1024);
+	std::vector<double, detectionformats::arena_allocator<double>> values(
+			(detectionformats::arena_allocator<double>(&memory)));
+	values.resize(16, 1.0);
+	ASSERT_GE(memory.getused(), 16 * sizeof(double));
+	ASSERT_EQ(memory.getcontainerblocks(), 1);
+
+	// without an arena the allocator uses the heap
+	std::vector<double, detectionformats::arena_allocator<double>> heapvalues;
+	heapvalues.resize(16, 1.0);
+	ASSERT_TRUE(heapvalues.get_allocator().getarena() == NULL);
+	ASSERT_TRUE(heapvalues.get_allocator() != values.get_allocator());
+
+	// an empty allocation still gives a pointer
+	detectionformats::arena_allocator<double> allocator(&memory);
+	double *empty = allocator.allocate(0);
+	ASSERT_TRUE(empty != NULL);
+	allocator.deallocate(empty, 0);
+	ASSERT_EQ(memory.getcontainerblocks(), 1);
+}
+
+// tests to see if a whole detection can be held in the arena
+TEST(ArenaTest, HoldsDetections) {
+	detectionformats::detection detectionobject;
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+										detectionobject);
+	rapidjson::Document classificationdocument;
+	detectionobject.pickdata[0].classificationinfo =
+			detectionformats::classification(detectionformats::FromJSONString(
+					std::string(CLASSIFICATIONSTRING), classificationdocument));
+	std::string detectionjson = detectionformats::ToJSONString(
+			detectionobject);
+
+	// the detection is only read
+	const detectionformats::detection &original = detectionobject;
+
+	detectionformats::message_arena memory;
+	for (int i = 0; i < 3; i++) {
+		{
+			detectionformats::detection_view view(&memory);
+			view.assign(original, memory);
+			ASSERT_TRUE(view.id == ID);
+			ASSERT_TRUE(view.pickdata[0].classificationinfo != NULL);
+
+			// the copies live in the arena, not in the detection
+			ASSERT_NE(view.id.data(), detectionobject.id.data());
+			ASSERT_EQ(view.pickdata.get_allocator().getarena(), &memory);
+			ASSERT_GT(memory.getcontainerblocks(), 0);
+
+			detectionformats::detection viewobject = view.todetection();
+			ASSERT_STREQ(detectionformats::ToJSONString(viewobject).c_str(),
+							detectionjson.c_str());
+		}
+
+		// the view is destroyed, so release the whole detection at once
+		ASSERT_EQ(memory.getcontainerblocks(), 0);
+		memory.reset();
+		ASSERT_EQ(memory.getused(), 0);
+	}
+}
@@ -0,0 +1,196 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// tests to see if picks convert to rows and back
+TEST(BatchTest, RoundTrip) {
+	rapidjson::Document doc;
+	detectionformats::pick full(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	full.time = 1000.0;
+	std::vector<detectionformats::pick> picks;
+	picks.push_back(full);
+	picks.push_back(detectionformats::pick());
+
+	// rare members
+	detectionformats::pick classified = full;
+	classified.id = "classified";
+	classified.time = 1001.0;
+	classified.classificationinfo = detectionformats::classification(
+			detectionformats::FromJSONString(std::string(CLASSIFICATIONSTRING),
+												doc));
+	picks.push_back(classified);
+	detectionformats::pick wide = full;
+	wide.id = "wide";
+	wide.time = 1002.0;
+	wide.site.station = "TOOWIDE";
+	wide.site.latitude = 40.0;
+	picks.push_back(wide);
+	detectionformats::pick renamed = full;
+	renamed.id = "renamed";
+	renamed.time = 1003.0;
+	renamed.type = "Renamed";
+	picks.push_back(renamed);
+	detectionformats::pick nul = full;
+	nul.id = "nul";
+	nul.time = 1003.5;
+	nul.site.station = std::string("AB\0C", 4);
+	picks.push_back(nul);
+	detectionformats::pick unknown = full;
+	unknown.id = "unknown";
+	unknown.time = 1003.7;
+	unknown.polarity = detectionformats::unknownpolarity;
+	unknown.polaritytext = BADPOLARITY;
+	picks.push_back(unknown);
+	detectionformats::pick bare = full;
+	bare.id = "bare";
+	bare.time = 1004.0;
+	bare.filterdata.clear();
+	bare.amplitude = detectionformats::amplitude();
+	bare.beam = detectionformats::beam();
+	bare.associationinfo = detectionformats::association();
+	picks.push_back(bare);
+
+	detectionformats::pick_batch batch;
+	ASSERT_TRUE(batch.empty());
+	batch.append(picks);
+	ASSERT_EQ(batch.size(), picks.size());
+
+	std::vector<detectionformats::pick> converted;
+	ASSERT_EQ(batch.get(&converted), picks.size());
+	detectionformats::pick object;
+	for (size_t i = 0; i < picks.size(); i++) {
+		ASSERT_EQ(detectionformats::ToJSONString(converted[i]),
+					detectionformats::ToJSONString(picks[i]));
+		ASSERT_EQ(detectionformats::ToJSONString(batch.get(i, object)),
+					detectionformats::ToJSONString(picks[i]));
+		ASSERT_EQ(object.site.station, picks[i].site.station);
+	}
+
+	batch.clear();
+	ASSERT_EQ(batch.size(), 0);
+	batch.push_back(picks[1]);
+	ASSERT_EQ(detectionformats::ToJSONString(batch.get(0, object)),
+				detectionformats::ToJSONString(picks[1]));
+}
+
+// tests to see if the columns hold the pick values
+TEST(BatchTest, Columns) {
+	rapidjson::Document doc;
+	detectionformats::pick first(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	first.time = 1000.0;
+	std::vector<detectionformats::pick> picks;
+	picks.push_back(first);
+	detectionformats::pick bare = first;
+	bare.id = "second";
+	bare.time = 1001.0;
+	bare.filterdata.clear();
+	bare.amplitude = detectionformats::amplitude();
+	picks.push_back(bare);
+
+	detectionformats::pick_batch batch;
+	batch.append(picks);
+
+	const double *times = batch.getcolumn(detectionformats::timecolumn);
+	ASSERT_EQ(times[0], 1000.0);
+	ASSERT_EQ(times[1], 1001.0);
+	const double *amplitudes =
+			batch.getcolumn(detectionformats::amplitudecolumn);
+	ASSERT_EQ(amplitudes[0], picks[0].amplitude.ampvalue);
+	ASSERT_TRUE(std::isnan(amplitudes[1]));
+	ASSERT_EQ(batch.getcolumn(detectionformats::residualcolumn)[0],
+				picks[0].associationinfo.residual);
+	ASSERT_TRUE(batch.getcolumn(detectionformats::unknowncolumn) == NULL);
+	ASSERT_TRUE(batch.getcolumn(detectionformats::pickcolumncount) == NULL);
+
+	ASSERT_TRUE(batch.getsites()[0] == detectionformats::site_key(picks[0]));
+	ASSERT_EQ(batch.getpresence()[0],
+				detectionformats::amplitudepresent
+						| detectionformats::beampresent
+						| detectionformats::associationpresent
+						| detectionformats::filterpresent);
+	ASSERT_EQ(batch.getpresence()[1],
+				detectionformats::beampresent
+						| detectionformats::associationpresent);
+	ASSERT_EQ(batch.getpolarities()[0], picks[0].polarity);
+	ASSERT_EQ(batch.getonsets()[0], picks[0].onset);
+	ASSERT_EQ(batch.getpickers()[0], picks[0].picker);
+	ASSERT_EQ(batch.getid(1), "second");
+	ASSERT_EQ(batch.getphase(1), picks[1].phase);
+}
+
+// tests to see if rows are selected by a column range
+TEST(BatchTest, Select) {
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	detectionformats::pick_batch batch;
+	for (int i = 0; i < 100; i++) {
+		object.id = std::to_string(i);
+		object.time = (i % 10 == 0) ? std::nan("") : 1000.0 + i;
+		batch.push_back(object);
+	}
+
+	std::vector<size_t> rows;
+	ASSERT_EQ(batch.select(detectionformats::timecolumn, 1015.0, 1030.0,
+							&rows), 14);
+	ASSERT_EQ(rows.front(), 15);
+	ASSERT_EQ(rows.back(), 29);
+	for (size_t row : rows) {
+		ASSERT_NE(row, 20);
+	}
+
+	// rows are added to the end
+	ASSERT_EQ(batch.select(detectionformats::timecolumn, 1099.0, 2000.0,
+							&rows), 1);
+	ASSERT_EQ(rows.size(), 15);
+	ASSERT_EQ(rows.back(), 99);
+	ASSERT_EQ(batch.select(detectionformats::unknowncolumn, 0.0, 1.0,
+							&rows), 0);
+}
+
+// tests to see if picks are decoded from NDJSON
+TEST(BatchTest, Decode) {
+	detectionformats::corpusgenerator generator;
+	std::ostringstream stream;
+	generator.write(stream, 500);
+	stream << "\n  \r\n{\"Type\":\"Pick\",\"ID\":\n";
+	stream << PICKSTRING;
+	std::string ndjson = stream.str();
+
+	std::vector<detectionformats::pick> expected;
+	std::istringstream lines(ndjson);
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (detectionformats::GetDetectionType(line)
+				== detectionformats::formattypes::picktype) {
+			try {
+				expected.push_back(detectionformats::pick());
+				detectionformats::FromJSONString(line, expected.back());
+			} catch (const std::invalid_argument &) {
+				expected.pop_back();
+			}
+		}
+	}
+
+	detectionformats::pick_batch batch;
+	size_t skipped = 0;
+	ASSERT_EQ(batch.decode(ndjson, detectionformats::GetCodecContext(),
+							&skipped), expected.size());
+	ASSERT_EQ(skipped, 1);
+	ASSERT_GT(batch.size(), 10);
+
+	detectionformats::pick object;
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQ(detectionformats::ToJSONString(batch.get(i, object)),
+					detectionformats::ToJSONString(expected[i]));
+	}
+}
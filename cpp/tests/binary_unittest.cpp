@@ -0,0 +1,187 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// encodes the object, decodes it into a new one, and checks that both
+// serialize to the same json
+template<class T>
+static void checkbinaryroundtrip(T &object) { // NOLINT
+	std::string buffer;
+	detectionformats::ToBinary(object, buffer);
+
+	T decoded;
+	detectionformats::FromBinary(buffer.data(), buffer.length(), decoded);
+	ASSERT_EQ(detectionformats::ToJSONString(decoded),
+				detectionformats::ToJSONString(object));
+	ASSERT_EQ(decoded.isvalid(), object.isvalid());
+
+	// decoding again into the same object gives the same result
+	detectionformats::FromBinary(buffer.data(), buffer.length(), decoded);
+	ASSERT_EQ(detectionformats::ToJSONString(decoded),
+				detectionformats::ToJSONString(object));
+}
+
+// tests to see if the binary header is read
+TEST(BinaryTest, Header) {
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	std::string buffer;
+	detectionformats::ToBinary(object, buffer);
+
+	ASSERT_EQ(buffer.substr(0, 2), "DF");
+	ASSERT_EQ(buffer[2], BINARY_VERSION);
+	ASSERT_EQ(detectionformats::GetBinaryType(buffer.data(), buffer.length()),
+				detectionformats::formattypes::picktype);
+
+	ASSERT_EQ(detectionformats::GetBinaryType(PICKSTRING, 10),
+				detectionformats::formattypes::unknown);
+	ASSERT_EQ(detectionformats::GetBinaryType(buffer.data(), 3),
+				detectionformats::formattypes::unknown);
+	ASSERT_EQ(detectionformats::GetBinaryType(NULL, 0),
+				detectionformats::formattypes::unknown);
+
+	// newer versions are not read
+	buffer[2] = BINARY_VERSION + 1;
+	ASSERT_EQ(detectionformats::GetBinaryType(buffer.data(), buffer.length()),
+				detectionformats::formattypes::unknown);
+}
+
+// tests to see if picks round trip, with and without optional members
+TEST(BinaryTest, Pick) {
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	checkbinaryroundtrip(object);
+
+	// smaller than the json
+	std::string buffer;
+	detectionformats::ToBinary(object, buffer);
+	ASSERT_LT(buffer.length(), std::string(PICKSTRING).length());
+
+	object.classificationinfo = detectionformats::classification(
+			detectionformats::FromJSONString(std::string(CLASSIFICATIONSTRING),
+												doc));
+	checkbinaryroundtrip(object);
+
+	object.amplitude = detectionformats::amplitude();
+	object.beam = detectionformats::beam();
+	object.associationinfo = detectionformats::association();
+	object.filterdata.clear();
+	object.polarity = detectionformats::polarityindex::unknownpolarity;
+	checkbinaryroundtrip(object);
+
+	// the text of an invalid value is kept
+	detectionformats::pick badobject(
+			detectionformats::FromJSONString(std::string(BADPICKSTRING), doc));
+	checkbinaryroundtrip(badobject);
+	detectionformats::pick decoded;
+	std::string buffer2;
+	detectionformats::ToBinary(badobject, buffer2);
+	detectionformats::FromBinary(buffer2.data(), buffer2.length(), decoded);
+	ASSERT_STREQ(decoded.polaritytext.c_str(), BADPOLARITY);
+
+	// a message type other than the class type is kept
+	object.type = "Other";
+	checkbinaryroundtrip(object);
+
+	detectionformats::pick empty;
+	checkbinaryroundtrip(empty);
+}
+
+// tests to see if the other messages round trip
+TEST(BinaryTest, Messages) {
+	rapidjson::Document doc;
+	detectionformats::correlation correlationobject(
+			detectionformats::FromJSONString(std::string(CORRELATIONSTRING),
+												doc));
+	checkbinaryroundtrip(correlationobject);
+
+	detectionformats::detection detectionobject(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+												doc));
+	checkbinaryroundtrip(detectionobject);
+
+	detectionformats::retract retractobject(
+			detectionformats::FromJSONString(std::string(RETRACTSTRING), doc));
+	checkbinaryroundtrip(retractobject);
+
+	detectionformats::stationInfo stationobject(
+			detectionformats::FromJSONString(std::string(STATIONSTRING), doc));
+	checkbinaryroundtrip(stationobject);
+
+	detectionformats::stationInfoRequest requestobject(
+			detectionformats::FromJSONString(std::string(REQUESTSTRING), doc));
+	checkbinaryroundtrip(requestobject);
+}
+
+// tests to see if bad binary messages are rejected
+TEST(BinaryTest, RejectsInvalid) {
+	rapidjson::Document doc;
+	detectionformats::detection object(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+												doc));
+	std::string buffer;
+	detectionformats::ToBinary(object, buffer);
+
+	// every truncation is caught
+	detectionformats::detection decoded;
+	for (size_t length = 0; length < buffer.length(); length++) {
+		ASSERT_THROW(detectionformats::FromBinary(buffer.data(), length,
+													decoded),
+						std::invalid_argument);
+	}
+
+	// as are trailing bytes and the wrong type
+	std::string longer = buffer + "x";
+	ASSERT_THROW(detectionformats::FromBinary(longer.data(), longer.length(),
+												decoded),
+					std::invalid_argument);
+	detectionformats::pick pickobject;
+	ASSERT_THROW(detectionformats::FromBinary(buffer.data(), buffer.length(),
+												pickobject),
+					std::invalid_argument);
+
+	// and an enum past its count, the polarity of an empty pick is followed
+	// by the onset, picker, and filter count
+	detectionformats::pick badpick;
+	detectionformats::ToBinary(badpick, buffer);
+	buffer[buffer.length() - 4] = 100;
+	ASSERT_THROW(detectionformats::FromBinary(buffer.data(), buffer.length(),
+												badpick),
+					std::invalid_argument);
+}
+
+// tests to see if array counts are checked against the fewest bytes each
+// element takes, without rejecting arrays of the smallest elements
+TEST(BinaryTest, ArrayCounts) {
+	detectionformats::pick pickobject;
+	pickobject.type = PICK_TYPE;
+	pickobject.filterdata.resize(2);
+	detectionformats::correlation correlationobject;
+	correlationobject.type = CORRELATION_TYPE;
+	detectionformats::detection object;
+	object.type = DETECTION_TYPE;
+	object.pickdata.assign(3, pickobject);
+	object.correlationdata.assign(2, correlationobject);
+	checkbinaryroundtrip(object);
+
+	// and a pick count that fits the bytes left, but not that many picks
+	std::string empty;
+	object.pickdata.clear();
+	object.correlationdata.clear();
+	detectionformats::ToBinary(object, empty);
+	std::string buffer;
+	object.pickdata.assign(1, pickobject);
+	detectionformats::ToBinary(object, buffer);
+	buffer[empty.length() - 2] = static_cast<char>(buffer.length()
+			- (empty.length() - 1));
+	ASSERT_THROW(detectionformats::FromBinary(buffer.data(), buffer.length(),
+												object),
+					std::invalid_argument);
+}
@@ -90,19 +90,19 @@ void checkdata(detectionformats::classification classificationobject,
     }
 
     // check eventtype
-	if (classificationobject.eventtype.type.empty() != true) {
-		std::string detectioneventtype = classificationobject.eventtype.type;
-		std::string expectedeventtype = std::string(EVENTTYPE);
-		ASSERT_STREQ(detectioneventtype.c_str(), expectedeventtype.c_str());
+	if (classificationobject.eventtype.type
+			!= detectionformats::eventtypecount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeValue(
+				classificationobject.eventtype.type),
+			EVENTTYPE);
 	}
 
 	// check eventtype certainty
-	if (classificationobject.eventtype.certainty.empty() != true) {
-		std::string detectioneventtypecertainty =
-			classificationobject.eventtype.certainty;
-		std::string expectedeventtypecertainty = std::string(CERTAINTY);
-		ASSERT_STREQ(detectioneventtypecertainty.c_str(),
-			expectedeventtypecertainty.c_str());
+	if (classificationobject.eventtype.certainty
+			!= detectionformats::eventtypecertaintycount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeCertaintyValue(
+				classificationobject.eventtype.certainty),
+			CERTAINTY);
 	}
 
     // check event type probability
@@ -145,8 +145,8 @@ TEST(ClassificationTest, WritesJSON) {
     classificationobject.magnitudeprobability = MAGNITUDEPROBABILITY;
     classificationobject.depth = DEPTH;
     classificationobject.depthprobability = DEPTHPROBABILITY;
-	classificationobject.eventtype.type = std::string(EVENTTYPE);
-    classificationobject.eventtype.certainty = std::string(CERTAINTY);
+	classificationobject.eventtype.type = detectionformats::earthquake;
+    classificationobject.eventtype.certainty = detectionformats::suspected;
     classificationobject.eventtypeprobability = EVENTTYPEPROBABILITY;
     classificationobject.source.agencyid = AGENCYID;
 	classificationobject.source.author = AUTHOR;
@@ -246,8 +246,8 @@ TEST(ClassificationTest, Validate) {
     classificationobject.magnitudeprobability = MAGNITUDEPROBABILITY;
     classificationobject.depth = DEPTH;
     classificationobject.depthprobability = DEPTHPROBABILITY;
-	classificationobject.eventtype.type = std::string(EVENTTYPE);
-    classificationobject.eventtype.certainty = std::string(CERTAINTY);
+	classificationobject.eventtype.type = detectionformats::earthquake;
+    classificationobject.eventtype.certainty = detectionformats::suspected;
     classificationobject.eventtypeprobability = EVENTTYPEPROBABILITY;
     classificationobject.source.agencyid = AGENCYID;
 	classificationobject.source.author = AUTHOR;
@@ -265,8 +265,9 @@ TEST(ClassificationTest, Validate) {
     badclassificationobject.azimuth = 9999;
     badclassificationobject.magnitude = 99;
     badclassificationobject.depth = -9999;
-    badclassificationobject.eventtype.type = "chair";
-    badclassificationobject.eventtype.certainty = "never";
+    badclassificationobject.eventtype.type = detectionformats::unknowneventtype;
+    badclassificationobject.eventtype.certainty =
+    		detectionformats::unknowncertainty;
 
 	result = false;
 	try {
@@ -0,0 +1,229 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// counts the operator new calls made by this thread, so that the tests can
+// check that a warmed up context does not allocate
+static thread_local int allocationcount = 0;
+
+void * operator new(std::size_t size) {
+	allocationcount++;
+	void *memory = std::malloc(size == 0 ? 1 : size);
+	if (memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return (memory);
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+// processes a pick with the context, returns the number of allocations
+int processpick(const std::string &pickstring,
+				detectionformats::codec_context &context, // NOLINT
+				detectionformats::pick &pickobject) { // NOLINT
+	int count = allocationcount;
+
+	detectionformats::FromJSONString(pickstring, pickobject, context);
+	detectionformats::ValidateJSON(pickstring, context);
+	detectionformats::ToJSONString(pickobject, context);
+
+	return (allocationcount - count);
+}
+
+// processes a detection with the context, returns the number of allocations
+int processdetection(const std::string &detectionstring,
+						detectionformats::codec_context &context, // NOLINT
+						detectionformats::detection &detectionobject) { // NOLINT
+	int count = allocationcount;
+
+	detectionformats::FromJSONString(detectionstring, detectionobject,
+										context);
+	detectionformats::ValidateJSON(detectionstring, context);
+	detectionformats::ToJSONString(detectionobject, context);
+
+	return (allocationcount - count);
+}
+
+// tests to see if the context can parse and write messages
+TEST(CodecTest, ParsesAndWrites) {
+	detectionformats::codec_context context;
+
+	// decode into an object
+	detectionformats::pick pickobject;
+	detectionformats::FromJSONString(std::string(PICKSTRING), pickobject,
+										context);
+	ASSERT_STREQ(pickobject.id.c_str(), ID);
+	ASSERT_EQ(pickobject.filterdata.size(), 2);
+
+	// write the object, the context writes the same json
+	std::string pickjson = detectionformats::ToJSONString(pickobject);
+	ASSERT_STREQ(detectionformats::ToJSONString(pickobject, context),
+					pickjson.c_str());
+	ASSERT_EQ(context.getbuffer().GetSize(), pickjson.length());
+
+	// parse into the context document and write it back out
+	detectionformats::codecdocument & pickdocument =
+			detectionformats::FromJSONString(pickjson, context);
+	ASSERT_EQ(detectionformats::GetDetectionType(pickdocument),
+				detectionformats::formattypes::picktype);
+	ASSERT_STREQ(detectionformats::ToJSONString(pickdocument, context),
+					pickjson.c_str());
+
+	// bad json
+	ASSERT_THROW(detectionformats::FromJSONString(std::string(BADMESSAGE),
+					context), std::invalid_argument);
+	ASSERT_EQ(detectionformats::IsJSONValid(std::string(BADMESSAGE), context),
+				false);
+	ASSERT_EQ(detectionformats::IsJSONValid(std::string(PICKSTRING), context),
+				true);
+	ASSERT_EQ(detectionformats::GetDetectionType(std::string(REQUESTSTRING)),
+				detectionformats::formattypes::stationinforequesttype);
+}
+
+// tests to see if the context validates messages
+TEST(CodecTest, Validates) {
+	detectionformats::codec_context context;
+
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(PICKSTRING),
+				context));
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(CORRELATIONSTRING),
+				context));
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(DETECTIONSTRING),
+				context));
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(RETRACTSTRING),
+				context));
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(STATIONSTRING),
+				context));
+	ASSERT_TRUE(detectionformats::ValidateJSON(std::string(REQUESTSTRING),
+				context));
+	ASSERT_FALSE(detectionformats::ValidateJSON(std::string(BADMESSAGE),
+				context));
+	ASSERT_FALSE(detectionformats::ValidateJSON(std::string(BADMESSAGE2),
+				context));
+
+	ASSERT_STREQ(detectionformats::ValidateJSONErrors(
+			std::string(BADMESSAGE), context).c_str(), "Parse Error");
+	ASSERT_STREQ(detectionformats::ValidateJSONErrors(
+			std::string(BADMESSAGE2), context).c_str(), "Unknown Format");
+	ASSERT_STREQ(detectionformats::ValidateJSONErrors(
+			"{\"Type\":\"Pick\",", context).c_str(), "Parse Error");
+	ASSERT_STREQ(detectionformats::ValidateJSONErrors(
+			"{\"Type\":\"MadeUp\",", context).c_str(), "Parse Error");
+	ASSERT_STREQ(detectionformats::ValidateJSONErrors(
+			"{\"Type\":\"Pick\"}", context).c_str(),
+			detectionformats::ValidateJSONErrors(
+					"{\"Type\":\"Pick\"}").c_str());
+}
+
+// tests to see if a warmed up context reuses its memory
+TEST(CodecTest, ReusesMemory) {
+	detectionformats::codec_context context;
+	detectionformats::pick pickobject;
+	std::string pickstring = std::string(PICKSTRING);
+
+	// the first message sizes the buffers
+	processpick(pickstring, context, pickobject);
+	size_t poolsize = context.getpoolsize();
+
+	// later messages do not allocate
+	ASSERT_EQ(processpick(pickstring, context, pickobject), 0);
+	ASSERT_EQ(processpick(pickstring, context, pickobject), 0);
+	ASSERT_EQ(context.getpoolsize(), poolsize);
+
+	// the context-less check uses the thread's warmed up context
+	ASSERT_TRUE(detectionformats::IsJSONValid(pickstring));
+	int count = allocationcount;
+	ASSERT_TRUE(detectionformats::IsJSONValid(pickstring));
+	ASSERT_EQ(allocationcount - count, 0);
+}
+
+// tests to see if a warmed up context reuses the memory of the Data
+// elements of a detection
+TEST(CodecTest, ReusesDetectionMemory) {
+	detectionformats::codec_context context;
+
+	// a detection with several picks, with strings too long to be stored
+	// in the string objects, and a correlation
+	rapidjson::Document detectiondocument;
+	detectionformats::detection fromdetection(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+												detectiondocument));
+	detectionformats::pick datapick = fromdetection.pickdata[0];
+	datapick.source.author = "a longer pick author name";
+	for (int i = 1; i < 8; i++) {
+		datapick.id = "a longer pick id, number " + std::to_string(i);
+		fromdetection.pickdata.push_back(datapick);
+	}
+	std::string detectionstring = detectionformats::ToJSONString(
+			fromdetection);
+
+	// the first message sizes the buffers and elements
+	detectionformats::detection detectionobject;
+	processdetection(detectionstring, context, detectionobject);
+	ASSERT_EQ(detectionobject.pickdata.size(), 8);
+	ASSERT_EQ(detectionobject.correlationdata.size(), 1);
+	ASSERT_STREQ(detectionformats::ToJSONString(detectionobject).c_str(),
+					detectionstring.c_str());
+
+	// later messages do not allocate
+	ASSERT_EQ(processdetection(detectionstring, context, detectionobject), 0);
+	ASSERT_EQ(processdetection(detectionstring, context, detectionobject), 0);
+	ASSERT_STREQ(detectionformats::ToJSONString(detectionobject).c_str(),
+					detectionstring.c_str());
+
+	// nor do later packed messages
+	std::string buffer;
+	detectionformats::ToMessagePack(detectionobject, buffer);
+	detectionformats::FromMessagePack(buffer.data(), buffer.length(),
+										detectionobject, context);
+	int count = allocationcount;
+	detectionformats::FromMessagePack(buffer.data(), buffer.length(),
+										detectionobject, context);
+	ASSERT_EQ(allocationcount - count, 0);
+
+	// a shorter Data array, or none, drops the elements left over
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+										detectionobject, context);
+	ASSERT_EQ(detectionobject.pickdata.size(), 1);
+	ASSERT_EQ(detectionobject.correlationdata.size(), 1);
+	detectionformats::detection shortdetection(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+												detectiondocument));
+	ASSERT_STREQ(detectionformats::ToJSONString(detectionobject).c_str(),
+					detectionformats::ToJSONString(shortdetection).c_str());
+	fromdetection.pickdata.clear();
+	fromdetection.correlationdata.clear();
+	detectionformats::FromJSONString(
+			detectionformats::ToJSONString(fromdetection), detectionobject,
+			context);
+	ASSERT_EQ(detectionobject.pickdata.size(), 0);
+	ASSERT_EQ(detectionobject.correlationdata.size(), 0);
+}
+
+// tests to see if the context grows a pool that is too small
+TEST(CodecTest, GrowsPool) {
+	detectionformats::codec_context context(256);
+
+	// the first parse overflows the pool
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING), context);
+	context.reset();
+	size_t poolsize = context.getpoolsize();
+	ASSERT_GT(poolsize, 256);
+
+	// the next parse fits
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING), context);
+	context.reset();
+	ASSERT_EQ(context.getpoolsize(), poolsize);
+}
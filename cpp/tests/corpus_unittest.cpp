@@ -0,0 +1,151 @@
+#include <corpus.h>
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// returns options that only produce the provided type
+detectionformats::corpusoptions onlytype(int type) {
+	detectionformats::corpusoptions options;
+	for (int i = 0; i < 6; i++) {
+		options.mix[i] = (i == type) ? 1 : 0;
+	}
+	options.stationcount = 50;
+	return (options);
+}
+
+// tests to see if the same seed gives the same messages
+TEST(CorpusTest, IsDeterministic) {
+	detectionformats::corpusoptions options;
+	options.maximumdetectionpicks = 20;
+	detectionformats::corpusgenerator first(options);
+	detectionformats::corpusgenerator second(options);
+
+	std::ostringstream firststream;
+	std::ostringstream secondstream;
+	size_t bytes = first.write(firststream, 500);
+	ASSERT_EQ(second.write(secondstream, 500), bytes);
+	ASSERT_EQ(firststream.str(), secondstream.str());
+	ASSERT_EQ(firststream.str().length(), bytes);
+
+	// another seed gives other messages
+	options.seed = 2;
+	detectionformats::corpusgenerator third(options);
+	std::ostringstream thirdstream;
+	third.write(thirdstream, 500);
+	ASSERT_NE(firststream.str(), thirdstream.str());
+}
+
+// tests to see if every message type is valid without errors
+TEST(CorpusTest, MakesValidMessages) {
+	for (int type = detectionformats::formattypes::picktype;
+			type <= detectionformats::formattypes::stationinforequesttype;
+			type++) {
+		detectionformats::corpusoptions options = onlytype(type);
+		options.minimumdetectionpicks = 3;
+		options.maximumdetectionpicks = 6;
+
+		// every optional member
+		options.optionaldensity = 1;
+		detectionformats::corpusgenerator full(options);
+
+		// only required members
+		options.optionaldensity = 0;
+		detectionformats::corpusgenerator sparse(options);
+
+		for (int i = 0; i < 50; i++) {
+			std::string message = full.next();
+			ASSERT_EQ(full.getlasttype(), type);
+			ASSERT_TRUE(full.getlastvalid());
+			ASSERT_EQ(detectionformats::GetDetectionType(message), type);
+			ASSERT_EQ(detectionformats::ValidateJSONErrors(message), "")
+					<< message;
+
+			message = sparse.next();
+			ASSERT_EQ(detectionformats::ValidateJSONErrors(message), "")
+					<< message;
+		}
+	}
+}
+
+// tests to see if the error rate makes messages invalid
+TEST(CorpusTest, MakesErrors) {
+	detectionformats::corpusoptions options;
+	options.maximumdetectionpicks = 20;
+	options.errorrate = 1;
+	detectionformats::corpusgenerator generator(options);
+
+	for (int i = 0; i < 200; i++) {
+		std::string message = generator.next();
+		ASSERT_FALSE(generator.getlastvalid());
+		ASSERT_FALSE(detectionformats::ValidateJSON(message)) << message;
+	}
+
+	// about half invalid
+	options.errorrate = 0.5;
+	detectionformats::corpusgenerator mixed(options);
+	int invalid = 0;
+	for (int i = 0; i < 1000; i++) {
+		std::string message = mixed.next();
+		ASSERT_EQ(detectionformats::ValidateJSON(message),
+					mixed.getlastvalid()) << message;
+		if (mixed.getlastvalid() == false) {
+			invalid++;
+		}
+	}
+	ASSERT_GT(invalid, 400);
+	ASSERT_LT(invalid, 600);
+}
+
+// tests to see if detections carry associated picks
+TEST(CorpusTest, MakesDetections) {
+	detectionformats::corpusoptions options = onlytype(
+			detectionformats::formattypes::detectiontype);
+	options.minimumdetectionpicks = 10;
+	options.maximumdetectionpicks = 40;
+	detectionformats::corpusgenerator generator(options);
+
+	for (int i = 0; i < 20; i++) {
+		detectionformats::detection message = generator.nextdetection();
+		ASSERT_GE(message.pickdata.size(), 10);
+		ASSERT_LE(message.pickdata.size(), 40);
+		ASSERT_FALSE(message.pickdata[0].associationinfo.isempty());
+		ASSERT_GT(message.pickdata[0].time, message.hypocenter.time);
+	}
+
+	// retracts retract earlier detections
+	detectionformats::retract retraction = generator.nextretract();
+	ASSERT_EQ(retraction.id.length(), 16);
+	ASSERT_EQ(generator.getlasttype(),
+				detectionformats::formattypes::retracttype);
+}
+
+// tests to see if retracts come from the recent detections
+TEST(CorpusTest, RetractsRecent) {
+	detectionformats::corpusoptions options = onlytype(
+			detectionformats::formattypes::detectiontype);
+	options.minimumdetectionpicks = 0;
+	options.maximumdetectionpicks = 0;
+	detectionformats::corpusgenerator generator(options);
+
+	std::vector<std::string> ids;
+	for (int i = 0; i < CORPUS_RETRACTIDS + 100; i++) {
+		ids.push_back(generator.nextdetection().id);
+	}
+	std::set<std::string> recent(ids.end() - CORPUS_RETRACTIDS, ids.end());
+	for (int i = 0; i < 200; i++) {
+		ASSERT_EQ(recent.count(generator.nextretract().id), 1);
+	}
+}
+
+// tests to see if too many stations are rejected
+TEST(CorpusTest, RejectsStationCount) {
+	detectionformats::corpusoptions options;
+	options.stationcount = CORPUS_MAXSTATIONS + 1;
+	ASSERT_THROW(detectionformats::corpusgenerator generator(options),
+					std::invalid_argument);
+}
@@ -139,19 +139,18 @@ void checkdata(detectionformats::correlation correlationobject,
 	}
 
 	// check eventtype
-	if (correlationobject.eventtype.type.empty() != true) {
-		std::string detectioneventtype = correlationobject.eventtype.type;
-		std::string expectedeventtype = std::string(EVENTTYPE);
-		ASSERT_STREQ(detectioneventtype.c_str(), expectedeventtype.c_str());
+	if (correlationobject.eventtype.type != detectionformats::eventtypecount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeValue(
+				correlationobject.eventtype.type),
+			EVENTTYPE);
 	}
 
 	// check eventtype certainty
-	if (correlationobject.eventtype.certainty.empty() != true) {
-		std::string detectioneventtypecertainty =
-			correlationobject.eventtype.certainty;
-		std::string expectedeventtypecertainty = std::string(CERTAINTY);
-		ASSERT_STREQ(detectioneventtypecertainty.c_str(),
-			expectedeventtypecertainty.c_str());
+	if (correlationobject.eventtype.certainty
+			!= detectionformats::eventtypecertaintycount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeCertaintyValue(
+				correlationobject.eventtype.certainty),
+			CERTAINTY);
 	}
 
 	// check magnitude
@@ -267,8 +266,8 @@ TEST(CorrelationTest, WritesJSON) {
 	correlationobject.hypocenter.longitudeerror = LONGITUDEERROR;
 	correlationobject.hypocenter.timeerror = TIMEERROR;
 	correlationobject.hypocenter.deptherror = DEPTHERROR;
-	correlationobject.eventtype.type = std::string(EVENTTYPE);
-	correlationobject.eventtype.certainty = std::string(CERTAINTY);
+	correlationobject.eventtype.type = detectionformats::earthquake;
+	correlationobject.eventtype.certainty = detectionformats::suspected;
 	correlationobject.magnitude = MAGNITUDE;
 	correlationobject.snr = SNR;
 	correlationobject.zscore = ZSCORE;
@@ -452,8 +451,8 @@ TEST(CorrelationTest, Validate) {
 	correlationobject.hypocenter.longitudeerror = LONGITUDEERROR;
 	correlationobject.hypocenter.timeerror = TIMEERROR;
 	correlationobject.hypocenter.deptherror = DEPTHERROR;
-	correlationobject.eventtype.type = std::string(EVENTTYPE);
-	correlationobject.eventtype.certainty = std::string(CERTAINTY);
+	correlationobject.eventtype.type = detectionformats::earthquake;
+	correlationobject.eventtype.certainty = detectionformats::suspected;
 	correlationobject.magnitude = MAGNITUDE;
 	correlationobject.snr = SNR;
 	correlationobject.zscore = ZSCORE;
@@ -492,8 +491,9 @@ TEST(CorrelationTest, Validate) {
 	badcorrelationobject2.phase = "22";
 	badcorrelationobject2.time = -1000000000000;
 	badcorrelationobject2.correlationvalue = -9999;
-	badcorrelationobject2.eventtype.type = "fjyord";
-	badcorrelationobject2.eventtype.certainty = "nah";
+	badcorrelationobject2.eventtype.type = detectionformats::unknowneventtype;
+	badcorrelationobject2.eventtype.certainty =
+			detectionformats::unknowncertainty;
 	badcorrelationobject2.magnitude = -9;
 	badcorrelationobject2.snr = -9;
 
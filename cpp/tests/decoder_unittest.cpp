@@ -0,0 +1,107 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+#define CLASSIFIEDPICKSTRING "{\"Type\":\"Pick\",\"ID\":\"12GFH48776857\",\"Site\":{\"Station\":\"BMN\",\"Network\":\"LB\"},\"Source\":{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"},\"Time\":\"2015-12-28T21:32:24.017Z\",\"ClassificationInfo\":{\"Phase\":\"P\",\"Distance\":12,\"Azimuth\":0.418479,\"Magnitude\":2.14,\"EventType\":{\"Type\":\"Earthquake\",\"Certainty\":\"Suspected\"},\"Source\":{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"}}}" // NOLINT
+#define EXTRAKEYSPICKSTRING "{\"Extra\":{\"Nested\":[1,{\"Site\":{}}]},\"Type\":\"Pick\",\"ID\":\"12GFH48776857\",\"Site\":{\"Station\":\"BMN\",\"Network\":\"LB\",\"Latitude\":40},\"Source\":\"US\",\"Time\":\"2015-12-28T21:32:24.017Z\",\"Phase\":5,\"Filter\":[{\"HighPass\":1.05}]}" // NOLINT
+#define BADFILTERPICKSTRING "{\"Type\":\"Pick\",\"Filter\":[7,{\"HighPass\":1.05},[],null]}" // NOLINT
+
+// serializes an object so decoded objects can be compared
+template<class T> std::string serialize(T &object) { // NOLINT
+	rapidjson::Document document;
+	return (detectionformats::ToJSONString(
+			object.tojson(document, document.GetAllocator())));
+}
+
+// decodes a string with both the SAX decoder and the rapidjson::Value
+// constructor and checks that the results match
+template<class T> void checkdecode(const std::string &jsonstring) {
+	rapidjson::Document document;
+	T domobject(detectionformats::FromJSONString(jsonstring, document));
+
+	T saxobject;
+	detectionformats::FromJSONString(jsonstring, saxobject);
+
+	ASSERT_STREQ(serialize(saxobject).c_str(), serialize(domobject).c_str());
+	ASSERT_EQ(saxobject.isvalid(), domobject.isvalid());
+}
+
+// tests to see if the decoder matches the rapidjson::Value constructors
+TEST(DecoderTest, MatchesDocument) {
+	checkdecode<detectionformats::pick>(std::string(PICKSTRING));
+	checkdecode<detectionformats::pick>(std::string(PICKSTRINGNOFILTER));
+	checkdecode<detectionformats::pick>(std::string(CLASSIFIEDPICKSTRING));
+	checkdecode<detectionformats::pick>(std::string(EXTRAKEYSPICKSTRING));
+	checkdecode<detectionformats::correlation>(std::string(CORRELATIONSTRING));
+	checkdecode<detectionformats::detection>(std::string(DETECTIONSTRING));
+	checkdecode<detectionformats::retract>(std::string(RETRACTSTRING));
+	checkdecode<detectionformats::stationInfo>(std::string(STATIONSTRING));
+	checkdecode<detectionformats::stationInfoRequest>(
+			std::string(REQUESTSTRING));
+
+	// wrong message type
+	checkdecode<detectionformats::pick>(std::string(RETRACTSTRING));
+}
+
+// tests to see if the decoder reads values
+TEST(DecoderTest, ReadsJSON) {
+	detectionformats::detection detectionobject;
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+										detectionobject);
+
+	ASSERT_STREQ(detectionobject.type.c_str(), DETECTION_TYPE);
+	ASSERT_EQ(detectionobject.hypocenter.latitude, LATITUDE);
+	ASSERT_EQ(detectionobject.pickdata.size(), 1);
+	ASSERT_EQ(detectionobject.correlationdata.size(), 1);
+
+	// the correlation Type key follows most of its other keys
+	ASSERT_STREQ(detectionobject.correlationdata[0].id.c_str(), ID);
+	ASSERT_STREQ(detectionobject.correlationdata[0].site.station.c_str(),
+					STATION);
+	ASSERT_EQ(detectionobject.correlationdata[0].zscore, ZSCORE);
+	ASSERT_EQ(detectionobject.correlationdata[0].associationinfo.residual,
+				RESIDUAL);
+	ASSERT_EQ(detectionobject.pickdata[0].beam.slowness, SLOWNESS);
+
+	// classification accepts integer distances
+	detectionformats::pick pickobject;
+	detectionformats::FromJSONString(std::string(CLASSIFIEDPICKSTRING),
+										pickobject);
+	ASSERT_EQ(pickobject.classificationinfo.distance, 12);
+
+	// decoding resets the object
+	detectionformats::FromJSONString(std::string(EXTRAKEYSPICKSTRING),
+										pickobject);
+	ASSERT_TRUE(pickobject.classificationinfo.isempty());
+	ASSERT_TRUE(std::isnan(pickobject.site.latitude));
+	ASSERT_TRUE(pickobject.phase.empty());
+	ASSERT_EQ(pickobject.filterdata.size(), 1);
+
+	// non-object filters are skipped
+	detectionformats::FromJSONString(std::string(BADFILTERPICKSTRING),
+										pickobject);
+	ASSERT_EQ(pickobject.filterdata.size(), 1);
+	ASSERT_EQ(pickobject.filterdata[0].highpass, HIGHPASS);
+}
+
+// tests to see if the decoder rejects bad json
+TEST(DecoderTest, Errors) {
+	detectionformats::pick pickobject;
+
+	ASSERT_THROW(detectionformats::FromJSONString(std::string(BADMESSAGE),
+													pickobject),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::FromJSONString(std::string("[1,2]"),
+													pickobject),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::FromJSONString(std::string("\"Pick\""),
+													pickobject),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::FromJSONString(std::string(""),
+													pickobject),
+					std::invalid_argument);
+}
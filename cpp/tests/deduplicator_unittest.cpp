@@ -0,0 +1,207 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// tests to see if the deduplicator suppresses duplicate picks
+TEST(DeduplicatorTest, SuppressesDuplicates) {
+	detectionformats::pick_deduplicator deduplicator;
+	uint64_t retained = 100;
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+
+	object.time = 1000.0;
+	ASSERT_TRUE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 0);
+
+	// the same pick from another feed, with another id and a small offset
+	object.id = "second";
+	object.time = 1000.005;
+	ASSERT_FALSE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 0);
+	object.id = "third";
+	object.time = 999.995;
+	ASSERT_FALSE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 0);
+
+	object.id = "fourth";
+	object.time = 1001.0;
+	ASSERT_TRUE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 3);
+
+	ASSERT_EQ(deduplicator.getoffered(), 4);
+	ASSERT_EQ(deduplicator.getduplicates(), 2);
+	ASSERT_EQ(deduplicator.size(), 2);
+
+	deduplicator.clear();
+	ASSERT_EQ(deduplicator.getoffered(), 0);
+	ASSERT_EQ(deduplicator.size(), 0);
+	object.id = "second";
+	object.time = 1000.005;
+	ASSERT_TRUE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 0);
+}
+
+// tests to see if the deduplicator keeps distinct picks
+TEST(DeduplicatorTest, KeepsDistinct) {
+	detectionformats::pick_deduplicator deduplicator;
+	rapidjson::Document doc;
+	detectionformats::pick original(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	original.time = 1000.0;
+	ASSERT_TRUE(deduplicator.offer(original));
+
+	detectionformats::pick other = original;
+	other.id = "second";
+	other.phase = "S";
+	ASSERT_TRUE(deduplicator.offer(other));
+
+	other = original;
+	other.id = "third";
+	other.site.station = "OTHER";
+	ASSERT_TRUE(deduplicator.offer(other));
+
+	other = original;
+	other.id = "fourth";
+	other.source.author = "OtherAuthor";
+	ASSERT_TRUE(deduplicator.offer(other));
+
+	// just outside the tolerance
+	other = original;
+	other.id = "fifth";
+	other.time = 1000.0101;
+	ASSERT_TRUE(deduplicator.offer(other));
+	ASSERT_EQ(deduplicator.getduplicates(), 0);
+
+	// picks without a time or valid site are always retained
+	other.id = "sixth";
+	other.time = std::nan("");
+	ASSERT_TRUE(deduplicator.offer(other));
+	other.id = "seventh";
+	ASSERT_TRUE(deduplicator.offer(other));
+	other.id = "eighth";
+	other.time = 2000.0;
+	other.site.station = "TOOLONG";
+	ASSERT_TRUE(deduplicator.offer(other));
+	ASSERT_TRUE(deduplicator.offer(other));
+	ASSERT_EQ(deduplicator.getduplicates(), 0);
+}
+
+// tests to see if duplicates are found across time buckets
+TEST(DeduplicatorTest, CrossesBuckets) {
+	detectionformats::pick_deduplicator deduplicator(0.01);
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+
+	// either side of a bucket boundary
+	object.time = 0.0099;
+	ASSERT_TRUE(deduplicator.offer(object));
+	object.time = 0.0101;
+	ASSERT_FALSE(deduplicator.offer(object));
+
+	// two buckets apart
+	object.time = 10.005;
+	ASSERT_TRUE(deduplicator.offer(object));
+	object.time = 10.0151;
+	ASSERT_TRUE(deduplicator.offer(object));
+	ASSERT_EQ(deduplicator.getduplicates(), 1);
+}
+
+// tests to see if the deduplicator forgets old picks
+TEST(DeduplicatorTest, Evicts) {
+	detectionformats::pick_deduplicator deduplicator(0.01, 10.0);
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	object.time = 1000.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+
+	// still remembered within the window
+	object.time = 1009.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+	object.time = 1000.0;
+	ASSERT_FALSE(deduplicator.offer(object));
+
+	// dropped once two generations have passed
+	object.time = 1020.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+	object.time = 1040.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+	object.time = 1000.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+}
+
+// tests to see if the deduplicator memory is bounded
+TEST(DeduplicatorTest, Bounded) {
+	detectionformats::pick_deduplicator deduplicator(0.01, 1000000.0, 64);
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	for (int i = 0; i < 1000; i++) {
+		object.time = i;
+		ASSERT_TRUE(deduplicator.offer(object));
+		ASSERT_LE(deduplicator.size(), 128);
+	}
+
+	// the newest picks are still remembered
+	object.time = 999.0;
+	ASSERT_FALSE(deduplicator.offer(object));
+}
+
+// tests to see if the deduplicator rejects bad settings and far out times
+TEST(DeduplicatorTest, RejectsInvalid) {
+	ASSERT_THROW(detectionformats::pick_deduplicator(0.0, 10.0),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(-0.01, 10.0),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(std::nan(""), 10.0),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(INFINITY, 10.0),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(0.01, 0.0),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(0.01, std::nan("")),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(0.01, -INFINITY),
+					std::invalid_argument);
+	ASSERT_THROW(detectionformats::pick_deduplicator(0.01, 10.0,
+					std::numeric_limits<size_t>::max()),
+					std::invalid_argument);
+
+	// a time too far out to number its bucket is retained, not compared
+	detectionformats::pick_deduplicator deduplicator(1.0e-300, 10.0, 64);
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	object.time = 1000.0;
+	ASSERT_TRUE(deduplicator.offer(object));
+	ASSERT_TRUE(deduplicator.offer(object));
+}
+
+// tests to see if the deduplicator takes pick views
+TEST(DeduplicatorTest, Views) {
+	detectionformats::pick_deduplicator deduplicator;
+	detectionformats::codec_context context;
+	detectionformats::pick_view view;
+
+	std::string first = PICKSTRING;
+	detectionformats::FromJSONInsitu(&first[0], view, context);
+	ASSERT_TRUE(deduplicator.offer(view));
+
+	// the same pick as an owning pick is a duplicate
+	uint64_t retained = 100;
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	object.id = "second";
+	ASSERT_FALSE(deduplicator.offer(object, &retained));
+	ASSERT_EQ(retained, 0);
+}
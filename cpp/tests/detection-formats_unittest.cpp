@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
 
 // test data
 #include "unittest_data.h" // NOLINT
@@ -34,4 +35,38 @@ TEST(DetectionFormatsTest, ValidateJSON) {
 
     // test unsuccessful validation 2
     ASSERT_EQ(detectionformats::ValidateJSON(std::string(BADMESSAGE2)), false);
-}
\ No newline at end of file
+}
+// tests to see if batches validate in parallel, in input order
+TEST(DetectionFormatsTest, ValidateJSONBatch) {
+	std::vector<std::string> messages;
+	for (int i = 0; i < 5000; i++) {
+		messages.push_back(std::string(PICKSTRING));
+		messages.push_back(std::string(BADMESSAGE));
+		messages.push_back(std::string(DETECTIONSTRING));
+	}
+
+	std::vector<bool> results = detectionformats::ValidateJSONBatch(messages,
+																	4);
+	ASSERT_EQ(results.size(), messages.size());
+	for (int i = 0; i < static_cast<int>(results.size()); i++) {
+		ASSERT_EQ(results[i], (i % 3) != 1) << i;
+	}
+
+	// every thread count gives the same results
+	ASSERT_EQ(detectionformats::ValidateJSONBatch(messages, 1), results);
+	ASSERT_EQ(detectionformats::ValidateJSONBatch(messages), results);
+
+	// nothing to validate
+	ASSERT_TRUE(detectionformats::ValidateJSONBatch(NULL, 0, 4).empty());
+
+	// a document parsed with the calling thread's context is left alone
+	detectionformats::codec_context & context =
+			detectionformats::GetCodecContext();
+	detectionformats::codecdocument & document =
+			detectionformats::FromJSONString(std::string(PICKSTRING), context);
+	std::string documentstring = detectionformats::ToJSONString(document,
+																context);
+	detectionformats::ValidateJSONBatch(messages, 1);
+	ASSERT_STREQ(detectionformats::ToJSONString(document, context),
+					documentstring.c_str());
+}
@@ -2,6 +2,9 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // test data
 #include "unittest_data.h" // NOLINT
@@ -113,11 +116,10 @@ void checkdata(detectionformats::detection detectionobject,
 	}
 
 	// check detectiontype
-	if (detectionobject.detectiontype.empty() != true) {
-		std::string detectiondetectiontype = detectionobject.detectiontype;
-		std::string expecteddetectiontype = std::string(DETECTIONTYPE);
-		ASSERT_STREQ(detectiondetectiontype.c_str(),
-				expecteddetectiontype.c_str());
+	if (detectionobject.detectiontype != detectionformats::detectiontypecount) {
+		ASSERT_STREQ(detectionformats::GetDetectionTypeValue(
+				detectionobject.detectiontype),
+			DETECTIONTYPE);
 	}
 
 	// check detectiontime
@@ -130,19 +132,18 @@ void checkdata(detectionformats::detection detectionobject,
 	}
 
 	// check eventtype
-	if (detectionobject.eventtype.type.empty() != true) {
-		std::string detectioneventtype = detectionobject.eventtype.type;
-		std::string expectedeventtype = std::string(EVENTTYPE);
-		ASSERT_STREQ(detectioneventtype.c_str(), expectedeventtype.c_str());
+	if (detectionobject.eventtype.type != detectionformats::eventtypecount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeValue(
+				detectionobject.eventtype.type),
+			EVENTTYPE);
 	}
 
 	// check eventtype certainty
-	if (detectionobject.eventtype.certainty.empty() != true) {
-		std::string detectioneventtypecertainty =
-			detectionobject.eventtype.certainty;
-		std::string expectedeventtypecertainty = std::string(CERTAINTY);
-		ASSERT_STREQ(detectioneventtypecertainty.c_str(),
-			expectedeventtypecertainty.c_str());
+	if (detectionobject.eventtype.certainty
+			!= detectionformats::eventtypecertaintycount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeCertaintyValue(
+				detectionobject.eventtype.certainty),
+			CERTAINTY);
 	}
 
 	// check bayes
@@ -200,11 +201,11 @@ TEST(DetectionTest, WritesJSON) {
 	detectionobject.hypocenter.timeerror = TIMEERROR;
 	detectionobject.hypocenter.deptherror = DEPTHERROR;
 
-	detectionobject.detectiontype = std::string(DETECTIONTYPE);
+	detectionobject.detectiontype = detectionformats::newdetection;
 	detectionobject.detectiontime = detectionformats::ConvertISO8601ToEpochTime(
 			std::string(DETECTIONTIME));
-	detectionobject.eventtype.type = std::string(EVENTTYPE);
-	detectionobject.eventtype.certainty = std::string(CERTAINTY);
+	detectionobject.eventtype.type = detectionformats::earthquake;
+	detectionobject.eventtype.certainty = detectionformats::suspected;
 	detectionobject.bayes = BAYES;
 	detectionobject.minimumdistance = MINIMUMDISTANCE;
 	detectionobject.rms = RMS;
@@ -243,6 +244,35 @@ TEST(DetectionTest, ReadsJSON) {
 	checkdata(detectionobject, "");
 }
 
+// tests to see if detection can successfully
+// stream json output
+TEST(DetectionTest, StreamsJSON) {
+	// build detection object
+	rapidjson::Document detectiondocument;
+	detectionformats::detection detectionobject(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+					detectiondocument));
+
+	// stream json string
+	std::string detectionjson = detectionformats::ToJSONString(
+			detectionobject);
+
+	// streaming writes the same json as the document
+	rapidjson::Document detectiondocument2;
+	ASSERT_STREQ(detectionjson.c_str(), detectionformats::ToJSONString(
+			detectionobject.tojson(detectiondocument2,
+					detectiondocument2.GetAllocator())).c_str());
+
+	// read it back in
+	rapidjson::Document detectiondocument3;
+	detectionformats::detection detectionobject2(
+			detectionformats::FromJSONString(detectionjson,
+					detectiondocument3));
+
+	// check data values
+	checkdata(detectionobject2, "");
+}
+
 // tests to see if detection can successfully
 // be constructed
 TEST(DetectionTest, Constructor) {
@@ -309,6 +339,56 @@ TEST(DetectionTest, CopyConstructor) {
 	checkdata(detectionobject, "");
 }
 
+// tests to see if detection can successfully
+// move its data instead of copying it
+TEST(DetectionTest, MoveConstructor) {
+	// moving does not throw, so vectors of messages move when they grow
+	static_assert(std::is_nothrow_move_constructible<
+					detectionformats::pick>::value, "pick move can throw");
+	static_assert(std::is_nothrow_move_constructible<
+					detectionformats::detection>::value,
+					"detection move can throw");
+
+	// sink arguments are moved into the detection
+	std::vector<detectionformats::pick> pickdata = buildpickdata();
+	const detectionformats::pick *pickaddress = pickdata.data();
+	detectionformats::detection fromdetectionobject(std::string(ID),
+			std::string(AGENCYID), std::string(AUTHOR), LATITUDE, LONGITUDE,
+			detectionformats::ConvertISO8601ToEpochTime(
+					std::string(TIME)),
+			DEPTH, LATITUDEERROR, LONGITUDEERROR, TIMEERROR, DEPTHERROR,
+			std::string(DETECTIONTYPE),
+			detectionformats::ConvertISO8601ToEpochTime(
+					std::string(DETECTIONTIME)),
+			std::string(EVENTTYPE), std::string(CERTAINTY),
+			BAYES, MINIMUMDISTANCE, RMS, GAP, std::move(pickdata),
+			buildcorrleationdata());
+	ASSERT_EQ(fromdetectionobject.pickdata.data(), pickaddress);
+
+	// move constructor
+	detectionformats::detection detectionobject(std::move(fromdetectionobject));
+	ASSERT_EQ(detectionobject.pickdata.data(), pickaddress);
+
+	// check data values
+	checkdata(detectionobject, "");
+
+	// move assignment
+	detectionformats::detection assigneddetectionobject;
+	assigneddetectionobject = std::move(detectionobject);
+	ASSERT_EQ(assigneddetectionobject.pickdata.data(), pickaddress);
+	checkdata(assigneddetectionobject, "");
+
+	// copying, moving, and assigning all keep the type
+	assigneddetectionobject.type = "Other";
+	detectionformats::detection copied(assigneddetectionobject);
+	ASSERT_EQ(copied.type, "Other");
+	detectionformats::detection moved(std::move(copied));
+	ASSERT_EQ(moved.type, "Other");
+	detectionformats::detection assigned;
+	assigned = moved;
+	ASSERT_EQ(assigned.type, "Other");
+}
+
 // tests to see if detection can successfully
 // validate
 TEST(DetectionTest, Validate) {
@@ -332,11 +412,11 @@ TEST(DetectionTest, Validate) {
 	detectionobject.hypocenter.timeerror = TIMEERROR;
 	detectionobject.hypocenter.deptherror = DEPTHERROR;
 
-	detectionobject.detectiontype = std::string(DETECTIONTYPE);
+	detectionobject.detectiontype = detectionformats::newdetection;
 	detectionobject.detectiontime = detectionformats::ConvertISO8601ToEpochTime(
 			std::string(DETECTIONTIME));
-	detectionobject.eventtype.type = std::string(EVENTTYPE);
-	detectionobject.eventtype.certainty = std::string(CERTAINTY);
+	detectionobject.eventtype.type = detectionformats::earthquake;
+	detectionobject.eventtype.certainty = detectionformats::suspected;
 	detectionobject.bayes = BAYES;
 	detectionobject.minimumdistance = MINIMUMDISTANCE;
 	detectionobject.rms = RMS;
@@ -368,10 +448,11 @@ TEST(DetectionTest, Validate) {
 
 	// build bad detection object
 	detectionformats::detection baddetectionobject2;
-	baddetectionobject2.detectiontype = "not";
+	baddetectionobject2.detectiontype = detectionformats::unknowndetectiontype;
 	baddetectionobject2.detectiontime = -1000000000000;
-	baddetectionobject2.eventtype.type = "fjyord";
-	baddetectionobject2.eventtype.certainty = "nah";
+	baddetectionobject2.eventtype.type = detectionformats::unknowneventtype;
+	baddetectionobject2.eventtype.certainty =
+			detectionformats::unknowncertainty;
 	baddetectionobject2.bayes = -99;
 	baddetectionobject2.minimumdistance = -99;
 	baddetectionobject2.rms = -99999;
@@ -388,3 +469,27 @@ TEST(DetectionTest, Validate) {
 	// check return code
 	ASSERT_EQ(result, false)<< "Tested for unsuccessful validation.";
 }
+
+// tests to see if an invalid detection type or event type is written back
+// out as it was read, so the detection stays invalid
+TEST(DetectionTest, KeepsInvalidValues) {
+	rapidjson::Document detectiondocument;
+	detectionformats::detection detectionobject(
+			detectionformats::FromJSONString(std::string(BADDETECTIONSTRING),
+					detectiondocument));
+	ASSERT_STREQ(detectionobject.detectiontypetext.c_str(), BADDETECTIONTYPE);
+	ASSERT_FALSE(detectionobject.isvalid());
+
+	// stream json string, it is the json that was read
+	std::string detectionjson = detectionformats::ToJSONString(detectionobject);
+	ASSERT_STREQ(detectionjson.c_str(), BADDETECTIONSTRING);
+
+	// read it back in with the decoder, it is still invalid
+	detectionformats::detection detectionobject2;
+	detectionformats::FromJSONString(detectionjson, detectionobject2);
+	ASSERT_EQ(detectionobject2.validate(),
+			ERRORCODE(detectionformats::detectiondetectiontypeinvalid)
+			| ERRORCODE(detectionformats::detectioneventtypeinvalid));
+	ASSERT_STREQ(detectionformats::ToJSONString(detectionobject2).c_str(),
+					BADDETECTIONSTRING);
+}
@@ -9,17 +9,17 @@
 void checkdata(detectionformats::eventtype eventtypeobject,
 	std::string testinfo) {
     // check type
-	if (eventtypeobject.type.empty() != true) {
-		std::string eventtypetype = eventtypeobject.type;
-		std::string expectedtype = std::string(EVENTTYPE);
-		ASSERT_STREQ(eventtypetype.c_str(), expectedtype.c_str());
+	if (eventtypeobject.type != detectionformats::eventtypecount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeValue(eventtypeobject.type),
+			EVENTTYPE);
 	}
 
     // check certainty
-	if (eventtypeobject.certainty.empty() != true) {
-		std::string eventtypecertainty = eventtypeobject.certainty;
-		std::string expectedcertainty = std::string(CERTAINTY);
-		ASSERT_STREQ(eventtypecertainty.c_str(), expectedcertainty.c_str());
+	if (eventtypeobject.certainty
+			!= detectionformats::eventtypecertaintycount) {
+		ASSERT_STREQ(detectionformats::GetEventTypeCertaintyValue(
+				eventtypeobject.certainty),
+			CERTAINTY);
 	}
 }
 
@@ -30,8 +30,8 @@ TEST(EventTypeTest, WritesJSON) {
 	detectionformats::eventtype eventtypeobject;
 
 	// build eventtype object
-	eventtypeobject.type = std::string(EVENTTYPE);
-	eventtypeobject.certainty = std::string(CERTAINTY);
+	eventtypeobject.type = detectionformats::earthquake;
+	eventtypeobject.certainty = detectionformats::suspected;
 
 	// build json string
 	rapidjson::Document eventtypedocument;
@@ -91,8 +91,8 @@ TEST(EventTypeTest, Validate) {
 	detectionformats::eventtype eventtypeobject;
 
 	// build eventtype object
-	eventtypeobject.type = std::string(EVENTTYPE);
-	eventtypeobject.certainty = std::string(CERTAINTY);
+	eventtypeobject.type = detectionformats::earthquake;
+	eventtypeobject.certainty = detectionformats::suspected;
 
 	// successful validation
 	bool result = eventtypeobject.isvalid();
@@ -102,7 +102,8 @@ TEST(EventTypeTest, Validate) {
 
 	// build bad eventtype object
 	detectionformats::eventtype badeventtypeobject;
-	badeventtypeobject.type = std::string(BADEVENTTYPE);
+	badeventtypeobject.type =
+			detectionformats::unknowneventtype;
 
 	result = false;
 	try {
@@ -125,8 +126,45 @@ TEST(EventTypeTest, IsEmpty) {
 	ASSERT_TRUE(eventtypeobject.isempty()) << "Tested for empty.";
 
 	// build event type object
-	eventtypeobject.type = std::string(EVENTTYPE);
+	eventtypeobject.type = detectionformats::earthquake;
 
 	// check return
 	ASSERT_FALSE(eventtypeobject.isempty()) << "Tested for not empty.";
 }
+
+// tests to see if an invalid type or certainty is written back out as it
+// was read, so the eventtype stays invalid
+TEST(EventTypeTest, KeepsInvalidValues) {
+	rapidjson::Document eventtypedocument;
+	detectionformats::eventtype eventtypeobject(
+			detectionformats::FromJSONString(std::string(BADEVENTTYPESTRING),
+					eventtypedocument));
+	ASSERT_EQ(eventtypeobject.type, detectionformats::unknowneventtype);
+	ASSERT_STREQ(eventtypeobject.typetext.c_str(), BADEVENTTYPE);
+	ASSERT_FALSE(eventtypeobject.isvalid());
+	ASSERT_FALSE(eventtypeobject.isempty());
+
+	// build json string, it is the json that was read
+	rapidjson::Document eventtypedocument2;
+	std::string eventtypejson = detectionformats::ToJSONString(
+			eventtypeobject.tojson(eventtypedocument2,
+					eventtypedocument2.GetAllocator()));
+	ASSERT_STREQ(eventtypejson.c_str(), BADEVENTTYPESTRING);
+	ASSERT_STREQ(detectionformats::ToJSONString(eventtypeobject).c_str(),
+					BADEVENTTYPESTRING);
+
+	// read it back in, it is still invalid
+	rapidjson::Document eventtypedocument3;
+	detectionformats::eventtype eventtypeobject2(
+			detectionformats::FromJSONString(eventtypejson,
+					eventtypedocument3));
+	ASSERT_EQ(eventtypeobject2.validate(),
+			ERRORCODE(detectionformats::eventtypetypeinvalid)
+			| ERRORCODE(detectionformats::eventtypecertaintyinvalid));
+
+	// the string constructor keeps the text
+	detectionformats::eventtype eventtypeobject3(std::string(BADEVENTTYPE),
+													std::string(CERTAINTY));
+	ASSERT_STREQ(eventtypeobject3.typetext.c_str(), BADEVENTTYPE);
+	ASSERT_TRUE(eventtypeobject3.certaintytext.empty());
+}
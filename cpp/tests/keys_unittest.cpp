@@ -0,0 +1,49 @@
+#include <keys.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+// checks that every key in a table is found at its own index
+template<int COUNT, int SIZE> void checktable(
+		const detectionformats::keytable<COUNT, SIZE> &table) {
+	for (int i = 0; i < COUNT; i++) {
+		std::string key = table.keys[i];
+		ASSERT_EQ(table.find(key.c_str(), key.length()), i);
+
+		// prefixes and extensions of a key are not the key
+		ASSERT_EQ(table.find(key.c_str(), key.length() - 1), -1);
+		std::string longer = key + "s";
+		ASSERT_EQ(table.find(longer.c_str(), longer.length()), -1);
+	}
+}
+
+// tests to see if every key table finds its keys
+TEST(KeysTest, FindsKeys) {
+	checktable(detectionformats::pickkeytable);
+	checktable(detectionformats::correlationkeytable);
+	checktable(detectionformats::detectionkeytable);
+	checktable(detectionformats::retractkeytable);
+	checktable(detectionformats::stationinfokeytable);
+	checktable(detectionformats::requestkeytable);
+	checktable(detectionformats::sitekeytable);
+	checktable(detectionformats::sourcekeytable);
+	checktable(detectionformats::filterkeytable);
+	checktable(detectionformats::amplitudekeytable);
+	checktable(detectionformats::beamkeytable);
+	checktable(detectionformats::associationkeytable);
+	checktable(detectionformats::classificationkeytable);
+	checktable(detectionformats::hypocenterkeytable);
+	checktable(detectionformats::eventtypekeytable);
+}
+
+// tests to see if unknown keys are rejected
+TEST(KeysTest, RejectsUnknownKeys) {
+	ASSERT_EQ(detectionformats::pickkeytable.find("", 0), -1);
+	ASSERT_EQ(detectionformats::pickkeytable.find("type", 4), -1);
+	ASSERT_EQ(detectionformats::pickkeytable.find("Latitude", 8), -1);
+
+	// lookups work at compile time
+	static_assert(detectionformats::sitekeytable.find("Latitude", 8)
+					== detectionformats::sitekeyindex::sitelatitudekey,
+					"compile time key lookup failed");
+}
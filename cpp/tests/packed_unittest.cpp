@@ -0,0 +1,230 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+#define PACKEDJSON "{\"a\":1,\"b\":[true,null],\"c\":\"x\",\"d\":1.5,\"e\":-2}"
+
+// encodes the object both ways, checks that the object is written as its
+// json document would be, decodes each into a new one, and checks that all
+// serialize to the same json
+template<class T>
+static void checkpackedroundtrip(T &object) { // NOLINT
+	detectionformats::codec_context context;
+	std::string json = detectionformats::ToJSONString(object);
+	std::string buffer;
+	std::string fromjson;
+
+	T decoded;
+	detectionformats::ToMessagePack(
+			detectionformats::FromJSONString(json, context), fromjson);
+	detectionformats::ToMessagePack(object, buffer);
+	ASSERT_EQ(buffer, fromjson);
+	ASSERT_LT(buffer.length(), json.length());
+	detectionformats::FromMessagePack(buffer.data(), buffer.length(), decoded,
+										context);
+	ASSERT_EQ(detectionformats::ToJSONString(decoded), json);
+
+	T cbordecoded;
+	detectionformats::ToCBOR(
+			detectionformats::FromJSONString(json, context), fromjson);
+	detectionformats::ToCBOR(object, buffer);
+	ASSERT_EQ(buffer, fromjson);
+	ASSERT_LT(buffer.length(), json.length());
+	detectionformats::FromCBOR(buffer.data(), buffer.length(), cbordecoded,
+								context);
+	ASSERT_EQ(detectionformats::ToJSONString(cbordecoded), json);
+}
+
+// tests to see if json values are encoded to the expected bytes
+TEST(PackedTest, Encodes) {
+	detectionformats::codec_context context;
+	std::string buffer;
+	const unsigned char msgpack[] = { 0x85, 0xA1, 'a', 0x01, 0xA1, 'b', 0x92,
+			0xC3, 0xC0, 0xA1, 'c', 0xA1, 'x', 0xA1, 'd', 0xCA, 0x3F, 0xC0, 0x00,
+			0x00, 0xA1, 'e', 0xFE };
+	const unsigned char cbor[] = { 0xA5, 0x61, 'a', 0x01, 0x61, 'b', 0x82,
+			0xF5, 0xF6, 0x61, 'c', 0x61, 'x', 0x61, 'd', 0xFA, 0x3F, 0xC0, 0x00,
+			0x00, 0x61, 'e', 0x21 };
+
+	detectionformats::ToMessagePack(
+			detectionformats::FromJSONString(PACKEDJSON, context), buffer);
+	ASSERT_EQ(buffer, std::string(reinterpret_cast<const char *>(msgpack),
+									sizeof(msgpack)));
+	ASSERT_STREQ(detectionformats::ToJSONString(
+			detectionformats::FromMessagePack(buffer.data(), buffer.length(),
+												context), context), PACKEDJSON);
+
+	detectionformats::ToCBOR(
+			detectionformats::FromJSONString(PACKEDJSON, context), buffer);
+	ASSERT_EQ(buffer, std::string(reinterpret_cast<const char *>(cbor),
+									sizeof(cbor)));
+	ASSERT_STREQ(detectionformats::ToJSONString(
+			detectionformats::FromCBOR(buffer.data(), buffer.length(),
+										context), context), PACKEDJSON);
+
+	// indefinite lengths, half floats, and tags are read as well
+	const unsigned char other[] = { 0xBF, 0x61, 'a', 0xF9, 0x3E, 0x00, 0x61,
+			'b', 0xC1, 0x9F, 0x20, 0xFF, 0xFF };
+	ASSERT_STREQ(detectionformats::ToJSONString(
+			detectionformats::FromCBOR(reinterpret_cast<const char *>(other),
+										sizeof(other), context), context),
+					"{\"a\":1.5,\"b\":[-1]}");
+
+	// maps and arrays too long for the short headers are widened when they
+	// end, to each longer header in turn
+	for (int length : { 15, 16, 23, 24, 255, 256, 65535, 65536 }) {
+		std::string json = "{\"a\":[";
+		for (int i = 0; i < length; i++) {
+			json += (i == 0) ? "0" : ",0";
+		}
+		json += "]";
+		for (int i = 0; i < length; i++) {
+			json += ",\"k" + std::to_string(i) + "\":1";
+		}
+		json += "}";
+
+		detectionformats::ToMessagePack(
+				detectionformats::FromJSONString(json, context), buffer);
+		ASSERT_STREQ(detectionformats::ToJSONString(
+				detectionformats::FromMessagePack(buffer.data(),
+						buffer.length(), context), context), json.c_str());
+		detectionformats::ToCBOR(
+				detectionformats::FromJSONString(json, context), buffer);
+		ASSERT_STREQ(detectionformats::ToJSONString(
+				detectionformats::FromCBOR(buffer.data(), buffer.length(),
+						context), context), json.c_str());
+	}
+
+	// values nested deeper than can be read back are not written
+	std::string deep = "{\"a\":" + std::string(PACKED_MAXDEPTH, '[')
+			+ std::string(PACKED_MAXDEPTH, ']') + "}";
+	ASSERT_THROW(detectionformats::ToMessagePack(
+			detectionformats::FromJSONString(deep, context), buffer),
+			std::invalid_argument);
+	ASSERT_THROW(detectionformats::ToCBOR(
+			detectionformats::FromJSONString(deep, context), buffer),
+			std::invalid_argument);
+}
+
+// tests to see if the messages round trip through both encodings
+TEST(PackedTest, Messages) {
+	rapidjson::Document doc;
+	detectionformats::pick pickobject(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	checkpackedroundtrip(pickobject);
+
+	// the rare members, so that every member is written
+	pickobject.classificationinfo = detectionformats::classification(
+			detectionformats::FromJSONString(std::string(CLASSIFICATIONSTRING),
+												doc));
+	pickobject.filterdata[0].type = "Butterworth";
+	pickobject.filterdata[0].units = "Hz";
+	checkpackedroundtrip(pickobject);
+
+	// the text of an invalid value is kept
+	detectionformats::pick badpickobject(
+			detectionformats::FromJSONString(std::string(BADPICKSTRING), doc));
+	checkpackedroundtrip(badpickobject);
+
+	detectionformats::correlation correlationobject(
+			detectionformats::FromJSONString(std::string(CORRELATIONSTRING),
+												doc));
+	checkpackedroundtrip(correlationobject);
+
+	detectionformats::detection detectionobject(
+			detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+												doc));
+	checkpackedroundtrip(detectionobject);
+
+	// enough picks that the Data array header is widened
+	detectionobject.pickdata.resize(300, pickobject);
+	checkpackedroundtrip(detectionobject);
+
+	detectionformats::detection baddetectionobject(
+			detectionformats::FromJSONString(std::string(BADDETECTIONSTRING),
+												doc));
+	checkpackedroundtrip(baddetectionobject);
+
+	detectionformats::retract retractobject(
+			detectionformats::FromJSONString(std::string(RETRACTSTRING), doc));
+	checkpackedroundtrip(retractobject);
+
+	detectionformats::stationInfo stationobject(
+			detectionformats::FromJSONString(std::string(STATIONSTRING), doc));
+	checkpackedroundtrip(stationobject);
+
+	detectionformats::stationInfoRequest requestobject(
+			detectionformats::FromJSONString(std::string(REQUESTSTRING), doc));
+	checkpackedroundtrip(requestobject);
+}
+
+// tests to see if decoded objects validate the same as from json
+TEST(PackedTest, Validates) {
+	detectionformats::codec_context context;
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	object.site.station = "";
+	object.phase = "";
+	std::string buffer;
+	detectionformats::ToMessagePack(object, buffer);
+
+	detectionformats::pick decoded;
+	detectionformats::FromMessagePack(buffer.data(), buffer.length(), decoded,
+										context);
+	ASSERT_FALSE(decoded.isvalid());
+	ASSERT_EQ(decoded.geterrors(), object.geterrors());
+}
+
+// tests to see if bad messages are rejected
+TEST(PackedTest, RejectsInvalid) {
+	detectionformats::codec_context context;
+	rapidjson::Document doc;
+	detectionformats::pick object(
+			detectionformats::FromJSONString(std::string(PICKSTRING), doc));
+	std::string msgpack;
+	std::string cbor;
+	detectionformats::ToMessagePack(object, msgpack);
+	detectionformats::ToCBOR(object, cbor);
+
+	// every truncation is caught
+	detectionformats::pick decoded;
+	for (size_t length = 0; length < msgpack.length(); length++) {
+		ASSERT_THROW(detectionformats::FromMessagePack(msgpack.data(), length,
+														decoded, context),
+						std::invalid_argument);
+	}
+	for (size_t length = 0; length < cbor.length(); length++) {
+		ASSERT_THROW(detectionformats::FromCBOR(cbor.data(), length, decoded,
+												context),
+						std::invalid_argument);
+	}
+
+	// as are trailing bytes
+	msgpack += '\0';
+	ASSERT_THROW(detectionformats::FromMessagePack(msgpack.data(),
+													msgpack.length(), decoded,
+													context),
+					std::invalid_argument);
+
+	// keys that are not strings, values that are not maps, and deep nesting
+	std::string numberkey("\x81\x01\x01", 3);
+	ASSERT_THROW(detectionformats::FromMessagePack(numberkey.data(),
+													numberkey.length(),
+													context),
+					std::invalid_argument);
+	std::string number("\x01", 1);
+	ASSERT_THROW(detectionformats::FromCBOR(number.data(), number.length(),
+											context),
+					std::invalid_argument);
+	std::string nested = "\xA1\x61x" + std::string(PACKED_MAXDEPTH, '\x81')
+			+ "\x01";
+	ASSERT_THROW(detectionformats::FromCBOR(nested.data(), nested.length(),
+											context),
+					std::invalid_argument);
+}
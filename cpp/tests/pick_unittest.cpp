@@ -78,27 +78,21 @@ void checkdata(detectionformats::pick pickobject, std::string testinfo) {
 	}
 
 	// check polarity
-	if (pickobject.polarity.empty() != true) {
-		std::string pickpolarity = pickobject.polarity;
-		std::string expectedpolarity = std::string(POLARITY);
-		ASSERT_STREQ(pickpolarity.c_str(),
-			expectedpolarity.c_str())<< testinfo.c_str();
+	if (pickobject.polarity != detectionformats::polaritycount) {
+		ASSERT_STREQ(detectionformats::GetPolarityValue(pickobject.polarity),
+			POLARITY)<< testinfo.c_str();
 	}
 
 	// check onset
-	if (pickobject.onset.empty() != true) {
-		std::string pickonset = pickobject.onset;
-		std::string expectedonset = std::string(ONSET);
-		ASSERT_STREQ(pickonset.c_str(),
-			expectedonset.c_str())<< testinfo.c_str();
+	if (pickobject.onset != detectionformats::onsetcount) {
+		ASSERT_STREQ(detectionformats::GetOnsetValue(pickobject.onset),
+			ONSET)<< testinfo.c_str();
 	}
 
 	// check picker
-	if (pickobject.picker.empty() != true) {
-		std::string pickpicker = pickobject.picker;
-		std::string expectedpicker = std::string(PICKER);
-		ASSERT_STREQ(pickpicker.c_str(),
-			expectedpicker.c_str())<< testinfo.c_str();
+	if (pickobject.picker != detectionformats::pickercount) {
+		ASSERT_STREQ(detectionformats::GetPickerValue(pickobject.picker),
+			PICKER)<< testinfo.c_str();
 	}
 
 	// filter
@@ -329,20 +323,19 @@ void checkdata(detectionformats::pick pickobject, std::string testinfo) {
 		}
 
 		// check eventtype
-		if (pickobject.classificationinfo.eventtype.type.empty() != true) {
-			std::string detectioneventtype =
-				pickobject.classificationinfo.eventtype.type;
-			std::string expectedeventtype = std::string(EVENTTYPE);
-			ASSERT_STREQ(detectioneventtype.c_str(), expectedeventtype.c_str());
+		if (pickobject.classificationinfo.eventtype.type
+				!= detectionformats::eventtypecount) {
+			ASSERT_STREQ(detectionformats::GetEventTypeValue(
+					pickobject.classificationinfo.eventtype.type),
+				EVENTTYPE);
 		}
 
 		// check eventtype certainty
-		if (pickobject.classificationinfo.eventtype.certainty.empty() != true) {
-			std::string detectioneventtypecertainty =
-				pickobject.classificationinfo.eventtype.certainty;
-			std::string expectedeventtypecertainty = std::string(CERTAINTY);
-			ASSERT_STREQ(detectioneventtypecertainty.c_str(),
-				expectedeventtypecertainty.c_str());
+		if (pickobject.classificationinfo.eventtype.certainty
+				!= detectionformats::eventtypecertaintycount) {
+			ASSERT_STREQ(detectionformats::GetEventTypeCertaintyValue(
+					pickobject.classificationinfo.eventtype.certainty),
+				CERTAINTY);
 		}
 
 		// check event type probability
@@ -391,9 +384,9 @@ TEST(PickTest, WritesJSON) {
 	pickobject.time = detectionformats::ConvertISO8601ToEpochTime(
 			std::string(TIME));
 	pickobject.phase = std::string(PHASE);
-	pickobject.polarity = std::string(POLARITY);
-	pickobject.onset = std::string(ONSET);
-	pickobject.picker = std::string(PICKER);
+	pickobject.polarity = detectionformats::up;
+	pickobject.onset = detectionformats::questionable;
+	pickobject.picker = detectionformats::manual;
 
 	// filter
 	detectionformats::filter filterobject;
@@ -438,8 +431,9 @@ TEST(PickTest, WritesJSON) {
     pickobject.classificationinfo.magnitudeprobability = MAGNITUDEPROBABILITY;
     pickobject.classificationinfo.depth = DEPTH;
     pickobject.classificationinfo.depthprobability = DEPTHPROBABILITY;
-	pickobject.classificationinfo.eventtype.type = std::string(EVENTTYPE);
-    pickobject.classificationinfo.eventtype.certainty = std::string(CERTAINTY);
+	pickobject.classificationinfo.eventtype.type = detectionformats::earthquake;
+    pickobject.classificationinfo.eventtype.certainty =
+    		detectionformats::suspected;
     pickobject.classificationinfo.eventtypeprobability = EVENTTYPEPROBABILITY;
     pickobject.classificationinfo.source.agencyid = AGENCYID;
 	pickobject.classificationinfo.source.author = AUTHOR;
@@ -477,9 +471,9 @@ TEST(PickTest, WritesJSONNoFilter) {
 	pickobject.time = detectionformats::ConvertISO8601ToEpochTime(
 			std::string(TIME));
 	pickobject.phase = std::string(PHASE);
-	pickobject.polarity = std::string(POLARITY);
-	pickobject.onset = std::string(ONSET);
-	pickobject.picker = std::string(PICKER);
+	pickobject.polarity = detectionformats::up;
+	pickobject.onset = detectionformats::questionable;
+	pickobject.picker = detectionformats::manual;
 
 	// no filters for this test
 
@@ -515,8 +509,9 @@ TEST(PickTest, WritesJSONNoFilter) {
     pickobject.classificationinfo.magnitudeprobability = MAGNITUDEPROBABILITY;
     pickobject.classificationinfo.depth = DEPTH;
     pickobject.classificationinfo.depthprobability = DEPTHPROBABILITY;
-	pickobject.classificationinfo.eventtype.type = std::string(EVENTTYPE);
-    pickobject.classificationinfo.eventtype.certainty = std::string(CERTAINTY);
+	pickobject.classificationinfo.eventtype.type = detectionformats::earthquake;
+    pickobject.classificationinfo.eventtype.certainty =
+    		detectionformats::suspected;
     pickobject.classificationinfo.eventtypeprobability = EVENTTYPEPROBABILITY;
     pickobject.classificationinfo.source.agencyid = AGENCYID;
 	pickobject.classificationinfo.source.author = AUTHOR;
@@ -535,6 +530,35 @@ TEST(PickTest, WritesJSONNoFilter) {
 	checkdata(pickobject2, "");
 }
 
+// tests to see if pick can successfully
+// stream json output
+TEST(PickTest, StreamsJSON) {
+	// build pick object
+	rapidjson::Document pickdocument;
+	detectionformats::pick pickobject(
+			detectionformats::FromJSONString(std::string(PICKSTRING),
+					pickdocument));
+	pickobject.classificationinfo.phase = std::string(PHASE);
+	pickobject.classificationinfo.eventtype.type = detectionformats::earthquake;
+
+	// stream json string
+	std::string pickjson = detectionformats::ToJSONString(pickobject);
+
+	// streaming writes the same json as the document
+	rapidjson::Document pickdocument2;
+	ASSERT_STREQ(pickjson.c_str(), detectionformats::ToJSONString(
+			pickobject.tojson(pickdocument2,
+					pickdocument2.GetAllocator())).c_str());
+
+	// read it back in
+	rapidjson::Document pickdocument3;
+	detectionformats::pick pickobject2(
+			detectionformats::FromJSONString(pickjson, pickdocument3));
+
+	// check data values
+	checkdata(pickobject2, "");
+}
+
 // tests to see if pick can successfully
 // read json output
 TEST(PickTest, ReadsJSON) {
@@ -733,9 +757,9 @@ TEST(PickTest, Validate) {
 	pickobject.time = detectionformats::ConvertISO8601ToEpochTime(
 			std::string(TIME));
 	pickobject.phase = std::string(PHASE);
-	pickobject.polarity = std::string(POLARITY);
-	pickobject.onset = std::string(ONSET);
-	pickobject.picker = std::string(PICKER);
+	pickobject.polarity = detectionformats::up;
+	pickobject.onset = detectionformats::questionable;
+	pickobject.picker = detectionformats::manual;
 
 	// filter
 	detectionformats::filter filterobject;
@@ -775,8 +799,9 @@ TEST(PickTest, Validate) {
     pickobject.classificationinfo.magnitudeprobability = MAGNITUDEPROBABILITY;
     pickobject.classificationinfo.depth = DEPTH;
     pickobject.classificationinfo.depthprobability = DEPTHPROBABILITY;
-	pickobject.classificationinfo.eventtype.type = std::string(EVENTTYPE);
-    pickobject.classificationinfo.eventtype.certainty = std::string(CERTAINTY);
+	pickobject.classificationinfo.eventtype.type = detectionformats::earthquake;
+    pickobject.classificationinfo.eventtype.certainty =
+    		detectionformats::suspected;
     pickobject.classificationinfo.eventtypeprobability = EVENTTYPEPROBABILITY;
     pickobject.classificationinfo.source.agencyid = AGENCYID;
 	pickobject.classificationinfo.source.author = AUTHOR;
@@ -805,9 +830,9 @@ TEST(PickTest, Validate) {
 	detectionformats::pick badpickobject2;
 	badpickobject2.time = -1000000000000;
 	badpickobject2.phase = "22";
-	badpickobject2.polarity = "22";
-	badpickobject2.onset = "22";
-	badpickobject2.picker = "22";
+	badpickobject2.polarity = detectionformats::unknownpolarity;
+	badpickobject2.onset = detectionformats::unknownonset;
+	badpickobject2.picker = detectionformats::unknownpicker;
 	badpickobject2.amplitude.period = -99;
 	badpickobject2.beam.backazimuth = -99;
 	badpickobject2.associationinfo.phase = "22";
@@ -825,3 +850,99 @@ TEST(PickTest, Validate) {
 	ASSERT_EQ(result, false)<< "Tested for unsuccessful validation.";
 
 }
+
+// tests to see if validate returns the expected error codes
+TEST(PickTest, ErrorCodes) {
+	detectionformats::pick pickobject;
+	pickobject.time = -1000000000000;
+	pickobject.phase = "22";
+	pickobject.polarity = detectionformats::unknownpolarity;
+	pickobject.beam.backazimuth = -99;
+
+	detectionformats::errorcodes errors = pickobject.validate();
+
+	// check the error codes
+	ASSERT_NE(errors & ERRORCODE(detectionformats::pickidmissing), 0);
+	ASSERT_NE(errors & ERRORCODE(detectionformats::picksiteinvalid), 0);
+	ASSERT_NE(errors & ERRORCODE(detectionformats::picktimeinvalid), 0);
+	ASSERT_NE(errors & ERRORCODE(detectionformats::pickphaseinvalid), 0);
+	ASSERT_NE(errors & ERRORCODE(detectionformats::pickpolarityinvalid), 0);
+	ASSERT_NE(errors & ERRORCODE(detectionformats::pickbeaminvalid), 0);
+	ASSERT_EQ(errors & ERRORCODE(detectionformats::picktimemissing), 0);
+	ASSERT_EQ(errors & ERRORCODE(detectionformats::pickonsetinvalid), 0);
+	ASSERT_EQ(errors & ERRORCODE(detectionformats::pickamplitudeinvalid), 0);
+
+	// one error string per error code
+	std::vector<std::string> errorlist = pickobject.geterrors();
+	int count = 0;
+	for (int i = 0; i < detectionformats::pickerrorcount; i++) {
+		if ((errors & ERRORCODE(i)) != 0) {
+			count++;
+		}
+	}
+	ASSERT_EQ(static_cast<int>(errorlist.size()), count);
+	ASSERT_STREQ(errorlist[errorlist.size() - 1].c_str(),
+					"Beam object did not validate in pick class: Invalid "
+					"BackAzimuth in beam class. No Slowness in beam class.");
+
+	// a valid object has no error codes
+	rapidjson::Document pickdocument;
+	detectionformats::pick goodpickobject(
+			detectionformats::FromJSONString(std::string(PICKSTRING),
+					pickdocument));
+	ASSERT_EQ(goodpickobject.validate(), 0);
+}
+
+// tests to see if an invalid polarity, onset, or picker is written back out
+// as it was read, so the pick stays invalid
+TEST(PickTest, KeepsInvalidValues) {
+	rapidjson::Document pickdocument;
+	detectionformats::pick pickobject(
+			detectionformats::FromJSONString(std::string(BADPICKSTRING),
+					pickdocument));
+	ASSERT_EQ(pickobject.polarity, detectionformats::unknownpolarity);
+	ASSERT_STREQ(pickobject.polaritytext.c_str(), BADPOLARITY);
+	ASSERT_FALSE(pickobject.isvalid());
+
+	// stream json string, the document writes the same json
+	std::string pickjson = detectionformats::ToJSONString(pickobject);
+	ASSERT_NE(pickjson.find("\"Polarity\":\"sideways\""), std::string::npos);
+	ASSERT_NE(pickjson.find("\"Onset\":\"sudden\""), std::string::npos);
+	ASSERT_NE(pickjson.find("\"Picker\":\"robot\""), std::string::npos);
+	rapidjson::Document pickdocument2;
+	ASSERT_STREQ(pickjson.c_str(), detectionformats::ToJSONString(
+			pickobject.tojson(pickdocument2,
+					pickdocument2.GetAllocator())).c_str());
+
+	// read it back in with the decoder, it is still invalid
+	detectionformats::pick pickobject2;
+	detectionformats::FromJSONString(pickjson, pickobject2);
+	ASSERT_FALSE(pickobject2.isvalid());
+	ASSERT_EQ(pickobject2.validate(),
+			ERRORCODE(detectionformats::pickpolarityinvalid)
+			| ERRORCODE(detectionformats::pickonsetinvalid)
+			| ERRORCODE(detectionformats::pickpickerinvalid));
+	ASSERT_STREQ(detectionformats::ToJSONString(pickobject2).c_str(),
+					pickjson.c_str());
+
+	// copies and the string constructor keep the text
+	detectionformats::pick pickobject3(pickobject2);
+	ASSERT_STREQ(detectionformats::ToJSONString(pickobject3).c_str(),
+					pickjson.c_str());
+	detectionformats::pick pickobject4(std::string(ID), std::string(STATION),
+			std::string(CHANNEL), std::string(NETWORK), std::string(LOCATION),
+			detectionformats::ConvertISO8601ToEpochTime(std::string(TIME)),
+			std::string(AGENCYID), std::string(AUTHOR), std::string(PHASE),
+			std::string(BADPOLARITY), std::string(ONSET), std::string(PICKER),
+			std::string(FILTERTYPE), HIGHPASS, LOWPASS, std::string(FILTERUNITS),
+			AMPLITUDEVALUE, PERIOD, SNR, BACKAZIMUTH,
+			BACKAZIMUTHERROR, SLOWNESS, SLOWNESSERROR, POWERRATIO,
+			POWERRATIOERROR);
+	ASSERT_STREQ(pickobject4.polaritytext.c_str(), BADPOLARITY);
+	ASSERT_FALSE(pickobject4.isvalid());
+
+	// decoding a valid pick into the same object clears the text
+	detectionformats::FromJSONString(std::string(PICKSTRING), pickobject2);
+	ASSERT_TRUE(pickobject2.polaritytext.empty());
+	ASSERT_TRUE(pickobject2.isvalid());
+}
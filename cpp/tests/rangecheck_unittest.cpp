@@ -0,0 +1,145 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// returns values around and past the edges of the ranges, including the
+// edges themselves and missing values
+std::vector<double> makerangevalues(size_t count, unsigned int seed) {
+	const double edges[] = { -9999999999.999, -500, -180, -100, -90, -2, 0,
+			10, 90, 180, 360, 1500, 8900, 9999999999.999 };
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<int> choice(0, 15);
+	std::uniform_real_distribution<double> offset(-1.0, 1.0);
+	std::uniform_real_distribution<double> anywhere(-12000.0, 12000.0);
+
+	std::vector<double> values;
+	for (size_t i = 0; i < count; i++) {
+		int chosen = choice(engine);
+		if (chosen < 14) {
+			double edge = edges[chosen];
+			double step = (chosen % 2 == 0) ? offset(engine) : 0.0;
+			values.push_back(edge + step);
+		} else if (chosen == 14) {
+			values.push_back(std::nan(""));
+		} else {
+			values.push_back(anywhere(engine));
+		}
+	}
+	return (values);
+}
+
+// tests to see if the kernels set the codes the classes do
+TEST(RangeCheckTest, MatchesValidate) {
+	// not a multiple of the vector width, so the tails are checked
+	const size_t count = 1003;
+	std::vector<double> first = makerangevalues(count, 1);
+	std::vector<double> second = makerangevalues(count, 2);
+	std::vector<double> third = makerangevalues(count, 3);
+	std::vector<double> fourth = makerangevalues(count, 4);
+
+	int best = detectionformats::GetRangeCheckLevel();
+	for (int level = detectionformats::scalarlevel; level <= best; level++) {
+		ASSERT_EQ(detectionformats::SetRangeCheckLevel(level), level);
+
+		std::vector<detectionformats::errorcodes> siteerrors(count, 0);
+		detectionformats::CheckSiteRanges(first.data(), second.data(),
+											third.data(), count,
+											siteerrors.data());
+		std::vector<detectionformats::errorcodes> classerrors(count, 0);
+		detectionformats::CheckClassificationRanges(first.data(),
+				second.data(), third.data(), fourth.data(), count,
+				classerrors.data());
+		std::vector<detectionformats::errorcodes> correlationerrors(count, 0);
+		detectionformats::CheckCorrelationRanges(first.data(),
+				second.data(), count, correlationerrors.data());
+		std::vector<detectionformats::errorcodes> stationerrors(count, 0);
+		detectionformats::CheckStationInfoRanges(first.data(),
+				second.data(), third.data(), count, stationerrors.data());
+
+		for (size_t i = 0; i < count; i++) {
+			detectionformats::site siteobject("BMN", "HHZ", "LB", "01",
+												first[i], second[i],
+												third[i]);
+			ASSERT_EQ(siteerrors[i], siteobject.validate());
+
+			detectionformats::classification classobject;
+			classobject.distance = first[i];
+			classobject.azimuth = second[i];
+			classobject.magnitude = third[i];
+			classobject.depth = fourth[i];
+			ASSERT_EQ(classerrors[i], classobject.validate());
+
+			detectionformats::correlation correlationobject;
+			correlationobject.magnitude = first[i];
+			correlationobject.snr = second[i];
+			detectionformats::errorcodes ranges =
+					ERRORCODE(detectionformats::correlationmagnitudeinvalid)
+					| ERRORCODE(detectionformats::correlationsnrinvalid);
+			ASSERT_EQ(correlationerrors[i],
+						correlationobject.validate() & ranges);
+
+			detectionformats::stationInfo stationobject;
+			stationobject.site = siteobject;
+			ranges = ERRORCODE(detectionformats::stationinfolatitudemissing)
+					| ERRORCODE(detectionformats::stationinfolatitudeinvalid)
+					| ERRORCODE(detectionformats::stationinfolongitudemissing)
+					| ERRORCODE(detectionformats::stationinfolongitudeinvalid)
+					| ERRORCODE(detectionformats::stationinfoelevationmissing)
+					| ERRORCODE(
+							detectionformats::stationinfoelevationinvalid);
+			ASSERT_EQ(stationerrors[i], stationobject.validate() & ranges);
+		}
+	}
+
+	detectionformats::SetRangeCheckLevel(best);
+}
+
+// tests to see if the range kernel ORs its codes into the bitmasks
+TEST(RangeCheckTest, CheckRange) {
+	double values[] = { 0.0, 1.0, std::nan(""), 2.0, -1.0 };
+	int best = detectionformats::GetRangeCheckLevel();
+	for (int level = detectionformats::scalarlevel; level <= best; level++) {
+		detectionformats::SetRangeCheckLevel(level);
+		std::vector<detectionformats::errorcodes> errors(5, 0x10);
+
+		detectionformats::CheckRange(values, 5, 0.0, 2.0, false, 0x1, 0x2,
+										errors.data());
+		ASSERT_EQ(errors[0], 0x10);
+		ASSERT_EQ(errors[1], 0x10);
+		ASSERT_EQ(errors[2], 0x12);
+		ASSERT_EQ(errors[3], 0x11);
+		ASSERT_EQ(errors[4], 0x11);
+
+		detectionformats::CheckRange(values, 5, 0.0, 2.0, true, 0x4, 0,
+										errors.data());
+		ASSERT_EQ(errors[2], 0x12);
+		ASSERT_EQ(errors[3], 0x11);
+		ASSERT_EQ(errors[4], 0x15);
+	}
+
+	// levels are limited to the supported ones
+	ASSERT_EQ(detectionformats::SetRangeCheckLevel(-5),
+				detectionformats::scalarlevel);
+	ASSERT_EQ(detectionformats::SetRangeCheckLevel(
+			detectionformats::rangechecklevelcount), best);
+}
+
+// tests to see if the site columns of a pick batch are checked
+TEST(RangeCheckTest, PickBatch) {
+	detectionformats::pick_batch batch;
+	detectionformats::pick object;
+	object.site.latitude = 45.0;
+	batch.push_back(object);
+	object.site.latitude = 95.0;
+	object.site.elevation = -600.0;
+	batch.push_back(object);
+
+	std::vector<detectionformats::errorcodes> errors(batch.size(), 0);
+	detectionformats::CheckSiteRanges(batch, errors.data());
+	ASSERT_EQ(errors[0], 0);
+	ASSERT_EQ(errors[1], ERRORCODE(detectionformats::sitelatitudeinvalid)
+			| ERRORCODE(detectionformats::siteelevationinvalid));
+}
@@ -0,0 +1,190 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// returns a valid stationInfo for the station at the provided position
+detectionformats::stationInfo makestation(const std::string &station,
+											double latitude,
+											double longitude) {
+	return (detectionformats::stationInfo(station, "HHZ", "LB", "01", latitude,
+											longitude, 1589.0, 1.0, true, true,
+											false, "US", "TestAuthor"));
+}
+
+// tests to see if the registry adds, finds, and replaces stations
+TEST(RegistryTest, Updates) {
+	detectionformats::station_registry registry;
+	detectionformats::site_key key(std::string("BMN"), std::string("HHZ"),
+									std::string("LB"), std::string("01"));
+	detectionformats::station_record record;
+	ASSERT_FALSE(registry.find(key, &record));
+
+	detectionformats::stationInfo station = makestation("BMN", 40.3344,
+														-121.44);
+	ASSERT_TRUE(registry.update(station));
+	ASSERT_EQ(registry.size(), 1);
+	ASSERT_EQ(registry.getversion(), 1);
+
+	ASSERT_TRUE(registry.find(key, &record));
+	ASSERT_TRUE(record.key == key);
+	ASSERT_EQ(record.latitude, 40.3344);
+	ASSERT_EQ(record.longitude, -121.44);
+	ASSERT_EQ(record.elevation, 1589.0);
+	ASSERT_EQ(record.quality, 1.0);
+	ASSERT_TRUE(record.enable);
+	ASSERT_TRUE(record.use);
+	ASSERT_FALSE(record.useforteleseismic);
+
+	// replace the station
+	station.site.latitude = 41.0;
+	ASSERT_TRUE(registry.update(station));
+	ASSERT_EQ(registry.size(), 1);
+	ASSERT_EQ(registry.getversion(), 2);
+	ASSERT_TRUE(registry.find(key, &record));
+	ASSERT_EQ(record.latitude, 41.0);
+
+	// invalid stations are not added
+	station.site.latitude = 91.0;
+	ASSERT_FALSE(registry.update(station));
+	ASSERT_EQ(registry.getversion(), 2);
+	ASSERT_TRUE(registry.find(key, &record));
+	ASSERT_EQ(record.latitude, 41.0);
+}
+
+// tests to see if the registry grows past its initial size
+TEST(RegistryTest, Grows) {
+	detectionformats::station_registry registry(16);
+	std::vector<detectionformats::stationInfo> stations;
+	for (int i = 0; i < 5000; i++) {
+		stations.push_back(makestation("S" + std::to_string(i), 0.0, i * 0.01));
+	}
+	ASSERT_EQ(registry.update(stations.data(), stations.size()), 5000);
+	ASSERT_EQ(registry.size(), 5000);
+	ASSERT_EQ(registry.getversion(), 1);
+
+	for (int i = 0; i < 5000; i++) {
+		detectionformats::station_record record;
+		ASSERT_TRUE(registry.find(detectionformats::site_key(stations[i]),
+									&record));
+		ASSERT_EQ(record.longitude, i * 0.01);
+	}
+}
+
+// tests to see if the registry loads station files
+TEST(RegistryTest, Loads) {
+	detectionformats::stationInfo other = makestation("OTHER", 10.0, 20.0);
+	std::string stationfile = std::string(STATIONSTRING) + "\n"
+			+ PICKSTRING + "\n"
+			+ "{\"Type\":\"StationInfo\",\"Site\":]}\n"
+			+ "  " + detectionformats::ToJSONString(other) + "\n"
+			+ "\n";
+
+	// the broken message and its line are skipped, the pick is ignored
+	detectionformats::station_registry registry;
+	std::istringstream stream(stationfile);
+	ASSERT_EQ(registry.load(stream), 2);
+	ASSERT_EQ(registry.size(), 2);
+
+	detectionformats::station_record record;
+	ASSERT_TRUE(registry.find(detectionformats::site_key(other), &record));
+	ASSERT_EQ(record.latitude, 10.0);
+
+	ASSERT_THROW(registry.load(std::string("./missing.jsonsta")),
+					std::invalid_argument);
+}
+
+// tests to see if lookups run while the registry is updated
+TEST(RegistryTest, ReadsWhileUpdating) {
+	detectionformats::station_registry registry(16);
+	detectionformats::stationInfo station = makestation("BMN", 0.0, 0.0);
+	registry.update(station);
+	detectionformats::site_key key(station);
+
+	std::atomic<bool> done(false);
+	std::atomic<int> mismatches(0);
+	std::thread reader([&]() {
+		detectionformats::station_record record;
+		while (done.load() == false) {
+			// every published record has matching coordinates
+			if ((registry.find(key, &record) == false)
+					|| (record.latitude != record.longitude)) {
+				mismatches++;
+			}
+		}
+	});
+
+	for (int i = 0; i < 1000; i++) {
+		station.site.latitude = i % 90;
+		station.site.longitude = i % 90;
+		registry.update(station);
+
+		// grow the table under the reader as well
+		detectionformats::stationInfo added = makestation(
+				"S" + std::to_string(i), 0.0, 0.0);
+		registry.update(added);
+	}
+
+	done = true;
+	reader.join();
+	ASSERT_EQ(mismatches.load(), 0);
+	ASSERT_EQ(registry.size(), 1001);
+}
+
+// tests to see if lookups stay safe while several writers retire records,
+// each writer flipping the phase the readers count themselves in
+TEST(RegistryTest, ReadsWhileWritersRace) {
+	detectionformats::station_registry registry(16);
+	std::vector<detectionformats::stationInfo> stations;
+	for (int i = 0; i < 8; i++) {
+		stations.push_back(makestation("S" + std::to_string(i), 0.0, 0.0));
+	}
+	registry.update(stations.data(), stations.size());
+
+	std::atomic<bool> done(false);
+	std::atomic<int> mismatches(0);
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 4; r++) {
+		readers.push_back(std::thread([&, r]() {
+			detectionformats::site_key key(stations[r % stations.size()]);
+			detectionformats::station_record record;
+			while (done.load() == false) {
+				if ((registry.find(key, &record) == false)
+						|| (record.latitude != record.longitude)) {
+					mismatches++;
+				}
+			}
+		}));
+	}
+
+	std::vector<std::thread> writers;
+	for (int w = 0; w < 2; w++) {
+		writers.push_back(std::thread([&, w]() {
+			std::vector<detectionformats::stationInfo> updates = stations;
+			for (int i = 0; i < 2000; i++) {
+				for (detectionformats::stationInfo &station : updates) {
+					station.site.latitude = (i + w) % 90;
+					station.site.longitude = (i + w) % 90;
+				}
+				registry.update(updates.data(), updates.size());
+			}
+		}));
+	}
+
+	for (std::thread &writer : writers) {
+		writer.join();
+	}
+	done = true;
+	for (std::thread &reader : readers) {
+		reader.join();
+	}
+	ASSERT_EQ(mismatches.load(), 0);
+	ASSERT_EQ(registry.size(), stations.size());
+}
@@ -0,0 +1,133 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+#define STATION "BMN"
+#define CHANNEL "HHZ"
+#define NETWORK "LB"
+#define LOCATION "01"
+
+// tests to see if the site key packs and unpacks the codes
+TEST(SiteKeyTest, Packs) {
+	detectionformats::site_key key(std::string(STATION), std::string(CHANNEL),
+									std::string(NETWORK),
+									std::string(LOCATION));
+	ASSERT_TRUE(key.isvalid());
+	ASSERT_STREQ(key.getstation().c_str(), STATION);
+	ASSERT_STREQ(key.getchannel().c_str(), CHANNEL);
+	ASSERT_STREQ(key.getnetwork().c_str(), NETWORK);
+	ASSERT_STREQ(key.getlocation().c_str(), LOCATION);
+
+	// the widest codes fit
+	detectionformats::site_key widest(std::string("ABCDE"),
+										std::string("HHZ"), std::string("US"),
+										std::string("--"));
+	ASSERT_TRUE(widest.isvalid());
+	ASSERT_STREQ(widest.getstation().c_str(), "ABCDE");
+	ASSERT_STREQ(widest.getlocation().c_str(), "--");
+
+	// an empty key is not valid
+	detectionformats::site_key empty;
+	ASSERT_FALSE(empty.isvalid());
+	ASSERT_TRUE(empty.getstation().empty());
+}
+
+// tests to see if codes that are too wide make the invalid key
+TEST(SiteKeyTest, RejectsWideCodes) {
+	detectionformats::site_key wide(std::string("ABCDEF"), std::string(CHANNEL),
+									std::string(NETWORK),
+									std::string(LOCATION));
+	ASSERT_FALSE(wide.isvalid());
+	ASSERT_TRUE(wide.getstation().empty());
+
+	detectionformats::site_key widenetwork(std::string(STATION),
+											std::string(CHANNEL),
+											std::string("USA"),
+											std::string(LOCATION));
+	ASSERT_FALSE(widenetwork.isvalid());
+	ASSERT_TRUE(wide == widenetwork);
+}
+
+// tests to see if keys compare and hash by their codes
+TEST(SiteKeyTest, Compares) {
+	detectionformats::site_key key(std::string(STATION), std::string(CHANNEL),
+									std::string(NETWORK),
+									std::string(LOCATION));
+	detectionformats::site_key same(std::string(STATION),
+									std::string(CHANNEL),
+									std::string(NETWORK),
+									std::string(LOCATION));
+	detectionformats::site_key other(std::string(STATION),
+										std::string("HHN"),
+										std::string(NETWORK),
+										std::string(LOCATION));
+
+	ASSERT_TRUE(key == same);
+	ASSERT_EQ(key.gethash(), same.gethash());
+	ASSERT_TRUE(key != other);
+
+	// codes do not run into each other
+	detectionformats::site_key shifted(std::string("BM"), std::string("NHH"),
+										std::string(NETWORK),
+										std::string(LOCATION));
+	ASSERT_TRUE(key != shifted);
+
+	// keys work in unordered containers
+	std::unordered_map<detectionformats::site_key, int> table;
+	table[key] = 1;
+	table[other] = 2;
+	ASSERT_EQ(table.size(), 2);
+	ASSERT_EQ(table[same], 1);
+}
+
+// tests to see if keys are made from objects and json
+TEST(SiteKeyTest, MakesKeys) {
+	detectionformats::site_key key(std::string(STATION), std::string(CHANNEL),
+									std::string(NETWORK),
+									std::string(LOCATION));
+
+	// from objects
+	detectionformats::pick pickobject;
+	detectionformats::FromJSONString(std::string(PICKSTRING), pickobject);
+	ASSERT_TRUE(detectionformats::site_key(pickobject) == key);
+	ASSERT_TRUE(detectionformats::site_key(pickobject.site) == key);
+
+	detectionformats::correlation correlationobject;
+	detectionformats::FromJSONString(std::string(CORRELATIONSTRING),
+										correlationobject);
+	ASSERT_TRUE(detectionformats::site_key(correlationobject) == key);
+
+	detectionformats::stationInfo stationobject;
+	detectionformats::FromJSONString(std::string(STATIONSTRING),
+										stationobject);
+	ASSERT_TRUE(detectionformats::site_key(stationobject) == key);
+
+	detectionformats::stationInfoRequest requestobject;
+	detectionformats::FromJSONString(std::string(REQUESTSTRING),
+										requestobject);
+	ASSERT_TRUE(detectionformats::site_key(requestobject) == key);
+
+	// from json messages and sites
+	rapidjson::Document pickdocument;
+	ASSERT_TRUE(detectionformats::site_key(detectionformats::FromJSONString(
+			std::string(PICKSTRING), pickdocument)) == key);
+
+	rapidjson::Document sitedocument;
+	ASSERT_TRUE(detectionformats::site_key(detectionformats::FromJSONString(
+			std::string(SITESTRING), sitedocument)) == key);
+
+	// from views
+	std::string pickstring(PICKSTRING);
+	std::vector<char> buffer(pickstring.c_str(),
+								pickstring.c_str() + pickstring.length() + 1);
+	detectionformats::codec_context context;
+	detectionformats::pick_view view;
+	detectionformats::FromJSONInsitu(buffer.data(), view, context);
+	ASSERT_TRUE(detectionformats::site_key(view.site) == key);
+}
@@ -1,6 +1,9 @@
 #include <detection-formats.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
 
 // test data
@@ -45,6 +48,46 @@ TEST(UtilTest, GetDetectionType) {
         detectionformats::formattypes::error);
 }
 
+// tests to see if the type is found by scanning the raw json
+TEST(UtilTest, ScansDetectionType) {
+	// nested objects, arrays, and strings holding a Type are skipped
+	std::string json = "{ \"Site\" : {\"Type\":\"Pick\",\"A\":[{}]},"
+			"\"Data\":[\"]}\\\"Type\",{\"Type\":\"Pick\"}],\"N\":-1.5e3,"
+			"\"B\":true,\"Type\"\t:\n\"Retract\",\"ID\":nul";
+	ASSERT_EQ(detectionformats::GetDetectionType(json.c_str(), json.length()),
+				detectionformats::formattypes::retracttype);
+
+	// nothing after the type is checked
+	json = "{\"Type\":\"StationInfoRequest\", garbage";
+	ASSERT_EQ(detectionformats::GetDetectionType(json.c_str(), json.length()),
+				detectionformats::formattypes::stationinforequesttype);
+
+	// only the length provided is scanned
+	json = "{\"Type\":\"Pick\"}";
+	ASSERT_EQ(detectionformats::GetDetectionType(json.c_str(), 12),
+				detectionformats::formattypes::error);
+
+	// missing, unknown, and mistyped types
+	ASSERT_EQ(detectionformats::GetDetectionType("{}", 2),
+				detectionformats::formattypes::unknown);
+	ASSERT_EQ(detectionformats::GetDetectionType("{\"ID\":[1,2]}", 12),
+				detectionformats::formattypes::unknown);
+	ASSERT_EQ(detectionformats::GetDetectionType("{\"Type\":\"Picks\"}", 16),
+				detectionformats::formattypes::unknown);
+	ASSERT_EQ(detectionformats::GetDetectionType("{\"Type\":1}", 10),
+				detectionformats::formattypes::unknown);
+
+	// not a json object
+	ASSERT_EQ(detectionformats::GetDetectionType("[{\"Type\":\"Pick\"}]", 17),
+				detectionformats::formattypes::error);
+	ASSERT_EQ(detectionformats::GetDetectionType("{\"ID\" 1}", 8),
+				detectionformats::formattypes::error);
+	ASSERT_EQ(detectionformats::GetDetectionType("{\"ID\":{\"A\":1}", 13),
+				detectionformats::formattypes::error);
+	ASSERT_EQ(detectionformats::GetDetectionType(NULL, 0),
+				detectionformats::formattypes::error);
+}
+
 TEST(UtilTest, IsJSONValid) {
     // test invalid json
     ASSERT_EQ(detectionformats::IsJSONValid(std::string(BADMESSAGE)),
@@ -120,6 +163,62 @@ TEST(UtilTest, ConvertISO8601ToEpochTime) {
 	ASSERT_EQ(ConvertedEpochTime, FailureTime);
 }
 
+TEST(UtilTest, ParseISO8601) {
+	double epochtime = 0;
+
+	// test ISO8601 to epoch time conversion
+	ASSERT_TRUE(detectionformats::ParseISO8601(ISO8601TIME,
+		strlen(ISO8601TIME), &epochtime));
+	ASSERT_EQ(epochtime, EPOCHTIME);
+
+	// the string does not need to be null terminated
+	std::string padded = std::string(ISO8601ALTTIME) + "trailing";
+	ASSERT_TRUE(detectionformats::ParseISO8601(padded.c_str(),
+		strlen(ISO8601ALTTIME), &epochtime));
+	ASSERT_EQ(epochtime, EPOCHTIME);
+
+	// calendar edge cases
+	ASSERT_TRUE(detectionformats::ParseISO8601("1970-01-01T00:00:00.000Z", 24,
+		&epochtime));
+	ASSERT_EQ(epochtime, 0.0);
+	ASSERT_TRUE(detectionformats::ParseISO8601("2016-02-29T00:00:00.000Z", 24,
+		&epochtime));
+	ASSERT_EQ(epochtime, 1456704000.0);
+	ASSERT_TRUE(detectionformats::ParseISO8601("1969-12-31T23:59:59.500Z", 24,
+		&epochtime));
+	ASSERT_EQ(epochtime, -0.5);
+	ASSERT_TRUE(detectionformats::ParseISO8601("0000-01-01T00:00:00.000Z", 24,
+		&epochtime));
+	ASSERT_EQ(epochtime, -62167219200.0);
+
+	// validation only
+	ASSERT_TRUE(detectionformats::ParseISO8601(ISO8601TIME,
+		strlen(ISO8601TIME), NULL));
+
+	// failure cases
+	ASSERT_FALSE(detectionformats::ParseISO8601(NULL, 24, &epochtime));
+	ASSERT_FALSE(detectionformats::ParseISO8601(BADISO8601TIME1,
+		strlen(BADISO8601TIME1), &epochtime));
+	ASSERT_FALSE(detectionformats::ParseISO8601("2015-12-28 21:32:24.017Z", 24,
+		&epochtime));
+	ASSERT_FALSE(detectionformats::ParseISO8601("2015-12-28T21:32:2a.017Z", 24,
+		&epochtime));
+	ASSERT_FALSE(detectionformats::ParseISO8601(
+		"2015-12-28T21:32:24.017+0100", 28, &epochtime));
+}
+
+TEST(UtilTest, ConvertISO8601ToEpochTimes) {
+	std::string timestrings[] = { std::string(ISO8601TIME),
+		std::string(BADISO8601TIME2), std::string(ISO8601TIME2) };
+	double epochtimes[3];
+
+	ASSERT_EQ(detectionformats::ConvertISO8601ToEpochTimes(timestrings, 3,
+		epochtimes), 2);
+	ASSERT_EQ(epochtimes[0], EPOCHTIME);
+	ASSERT_EQ(epochtimes[1], -1.0);
+	ASSERT_EQ(epochtimes[2], EPOCHTIME2);
+}
+
 TEST(UtilTest, ConvertEpochTimeToISO8601) {
 	std::string ExpectedISO8601 = std::string(ISO8601TIME);
 
@@ -151,3 +250,149 @@ TEST(UtilTest, ConvertEpochTimeToISO8601) {
 	ASSERT_STREQ(ConvertedISO8601.c_str(), ExpectedISO8601.c_str());
 }
 
+TEST(UtilTest, FormatISO8601) {
+	char buffer[ISO8601_BUFFERSIZE];
+
+	// test decimal epoch time to ISO8601 formatting
+	ASSERT_EQ(detectionformats::FormatISO8601(EPOCHTIME, buffer),
+		static_cast<size_t>(ISO8601_LENGTH));
+	ASSERT_STREQ(buffer, ISO8601TIME);
+
+	// same minute, cached prefix
+	ASSERT_EQ(detectionformats::FormatISO8601(EPOCHTIME2, buffer),
+		static_cast<size_t>(ISO8601_LENGTH));
+	ASSERT_STREQ(buffer, ISO8601TIME2);
+
+	// rounding carries into the date
+	detectionformats::FormatISO8601(1451606399.9996, buffer);
+	ASSERT_STREQ(buffer, "2016-01-01T00:00:00.000Z");
+
+	// times before the epoch
+	detectionformats::FormatISO8601(-0.5, buffer);
+	ASSERT_STREQ(buffer, "1969-12-31T23:59:59.500Z");
+	detectionformats::FormatISO8601(-62167219200.0, buffer);
+	ASSERT_STREQ(buffer, "0000-01-01T00:00:00.000Z");
+
+	// leap day
+	detectionformats::FormatISO8601(1456704000.0, buffer);
+	ASSERT_STREQ(buffer, "2016-02-29T00:00:00.000Z");
+
+	// failure cases
+	ASSERT_EQ(detectionformats::FormatISO8601(
+		std::numeric_limits<double>::quiet_NaN(), buffer), 0);
+	ASSERT_EQ(detectionformats::FormatISO8601(
+		std::numeric_limits<double>::infinity(), buffer), 0);
+	ASSERT_EQ(detectionformats::FormatISO8601(253402300800.0, buffer), 0);
+	ASSERT_EQ(detectionformats::FormatISO8601(-62167219200.001, buffer), 0);
+	ASSERT_STREQ(detectionformats::ConvertEpochTimeToISO8601(
+		std::numeric_limits<double>::quiet_NaN()).c_str(), "");
+
+	// round trip across the formatting cache
+	for (double time = EPOCHTIME; time < EPOCHTIME + 7200.0; time += 37.125) {
+		detectionformats::FormatISO8601(time, buffer);
+		ASSERT_EQ(detectionformats::ConvertISO8601ToEpochTime(buffer,
+			ISO8601_LENGTH), std::floor(time * 1000.0 + 0.5) / 1000.0);
+	}
+}
+
+TEST(UtilTest, IsEpochTimeValid) {
+	// success tests
+	ASSERT_TRUE(detectionformats::IsEpochTimeValid(EPOCHTIME));
+	ASSERT_TRUE(detectionformats::IsEpochTimeValid(0.0));
+	ASSERT_TRUE(detectionformats::IsEpochTimeValid(ISO8601_MINTIME));
+
+	// failure tests
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(
+		std::numeric_limits<double>::quiet_NaN()));
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(
+		std::numeric_limits<double>::infinity()));
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(
+		-std::numeric_limits<double>::infinity()));
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(ISO8601_MAXTIME));
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(ISO8601_MINTIME - 1.0));
+}
+
+// tests that a time is valid exactly when it can be formatted, at the edges
+// of the range where rounding to the millisecond changes the year
+TEST(UtilTest, EpochTimeEdges) {
+	char buffer[ISO8601_BUFFERSIZE];
+	const double times[] = { ISO8601_MAXTIME - 0.0004, ISO8601_MAXTIME - 0.0005,
+			ISO8601_MAXTIME - 0.0006, ISO8601_MAXTIME - 0.001,
+			ISO8601_MINTIME - 0.0004, ISO8601_MINTIME - 0.0006,
+			ISO8601_MINTIME };
+
+	for (double time : times) {
+		bool valid = detectionformats::IsEpochTimeValid(time);
+		size_t length = detectionformats::FormatISO8601(time, buffer);
+		ASSERT_EQ(valid, length > 0) << time;
+	}
+
+	// the last half millisecond of 9999 rounds up into 10000
+	ASSERT_FALSE(detectionformats::IsEpochTimeValid(253402300799.9996));
+	ASSERT_EQ(detectionformats::FormatISO8601(253402300799.9996, buffer), 0);
+	ASSERT_EQ(detectionformats::FormatISO8601(253402300799.9994, buffer),
+				static_cast<size_t>(ISO8601_LENGTH));
+	ASSERT_STREQ(buffer, "9999-12-31T23:59:59.999Z");
+
+	// and the last half millisecond before 0000 rounds up into it
+	ASSERT_TRUE(detectionformats::IsEpochTimeValid(ISO8601_MINTIME - 0.0004));
+	ASSERT_EQ(detectionformats::FormatISO8601(ISO8601_MINTIME - 0.0004,
+				buffer), static_cast<size_t>(ISO8601_LENGTH));
+	ASSERT_STREQ(buffer, "0000-01-01T00:00:00.000Z");
+
+	// a pick with such a time does not validate, rather than being written
+	// without its required time
+	detectionformats::pick pickobject;
+	detectionformats::FromJSONString(std::string(PICKSTRING), pickobject);
+	pickobject.time = 253402300799.9996;
+	ASSERT_FALSE(pickobject.isvalid());
+	ASSERT_NE(pickobject.validate()
+			& ERRORCODE(detectionformats::picktimeinvalid), 0);
+}
+
+// tests the value index lookups in both directions
+TEST(UtilTest, GetValueIndex) {
+	// every value maps to its own index and back
+	for (int i = 0; i < detectionformats::pickercount; i++) {
+		detectionformats::pickerindex index =
+				static_cast<detectionformats::pickerindex>(i);
+		const char *value = detectionformats::GetPickerValue(index);
+		ASSERT_EQ(detectionformats::GetPickerIndex(value, strlen(value)), index);
+	}
+	for (int i = 0; i < detectionformats::eventtypecount; i++) {
+		detectionformats::eventtypeindex index =
+				static_cast<detectionformats::eventtypeindex>(i);
+		const char *value = detectionformats::GetEventTypeValue(index);
+		ASSERT_EQ(detectionformats::GetEventTypeIndex(value, strlen(value)),
+					index);
+	}
+
+	// missing values
+	ASSERT_EQ(detectionformats::GetPolarityIndex("", 0),
+				detectionformats::polaritycount);
+	ASSERT_STREQ(detectionformats::GetPolarityValue(
+			detectionformats::polaritycount), "");
+
+	// unknown values, prefixes and extensions of valid values
+	ASSERT_EQ(detectionformats::GetOnsetIndex("22", 2),
+				detectionformats::unknownonset);
+	ASSERT_EQ(detectionformats::GetOnsetIndex("emerg", 5),
+				detectionformats::unknownonset);
+	ASSERT_EQ(detectionformats::GetDetectionTypeIndex("Newer", 5),
+				detectionformats::unknowndetectiontype);
+	ASSERT_STREQ(detectionformats::GetOnsetValue(
+			detectionformats::unknownonset), "");
+
+	// the string does not need to be null terminated
+	ASSERT_EQ(detectionformats::GetPolarityIndex("down, up", 4),
+				detectionformats::down);
+
+	// lookups work at compile time
+	static_assert(detectionformats::GetEventTypeCertaintyIndex("Confirmed", 9)
+					== detectionformats::confirmed,
+					"compile time value lookup failed");
+	static_assert(detectionformats::IsStringEqual(
+					detectionformats::GetDetectionTypeValue(
+							detectionformats::final), "Final", 5),
+					"compile time value lookup failed");
+}
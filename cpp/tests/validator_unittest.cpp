@@ -0,0 +1,209 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// returns the json with the first occurrence of from replaced by to
+std::string replaced(std::string json, const std::string &from,
+						const std::string &to) {
+	size_t position = json.find(from);
+	EXPECT_NE(position, std::string::npos) << from;
+	if (position != std::string::npos) {
+		json.replace(position, from.length(), to);
+	}
+	return (json);
+}
+
+// returns whether the json decodes into a valid object of its type, a
+// message the decoder cannot parse is not valid
+bool decodesvalid(const std::string &json) {
+	try {
+		switch (detectionformats::GetDetectionType(json)) {
+			case detectionformats::formattypes::picktype: {
+				detectionformats::pick object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			case detectionformats::formattypes::correlationtype: {
+				detectionformats::correlation object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			case detectionformats::formattypes::detectiontype: {
+				detectionformats::detection object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			case detectionformats::formattypes::retracttype: {
+				detectionformats::retract object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			case detectionformats::formattypes::stationinfotype: {
+				detectionformats::stationInfo object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			case detectionformats::formattypes::stationinforequesttype: {
+				detectionformats::stationInfoRequest object;
+				detectionformats::FromJSONString(json, object);
+				return (object.isvalid());
+			}
+			default:
+				return (false);
+		}
+	} catch (const std::invalid_argument &) {
+		return (false);
+	}
+}
+
+// checks that validating while parsing agrees with decoding and validating
+void checkagrees(const std::string &json, bool expected) {
+	detectionformats::codec_context context;
+
+	ASSERT_EQ(detectionformats::ValidateJSON(json, context), expected) << json;
+	ASSERT_EQ(detectionformats::ValidateJSONErrors(json, context).empty(),
+				expected) << json;
+	ASSERT_EQ(decodesvalid(json), expected) << json;
+}
+
+// tests to see if valid messages validate
+TEST(ValidatorTest, ValidatesMessages) {
+	checkagrees(PICKSTRING, true);
+	checkagrees(PICKSTRINGNOFILTER, true);
+	checkagrees(CORRELATIONSTRING, true);
+	checkagrees(DETECTIONSTRING, true);
+	checkagrees(RETRACTSTRING, true);
+	checkagrees(STATIONSTRING, true);
+	checkagrees(REQUESTSTRING, true);
+
+	// optional members that are empty are not checked
+	checkagrees(replaced(PICKSTRING, "\"Beam\":{",
+				"\"Beam\":{},\"Unused\":{"), true);
+	checkagrees(replaced(STATIONSTRING,
+				"{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"}",
+				"{\"AgencyID\":\"\",\"Unused\":\"US\"}"), true);
+
+	// members of the wrong type are ignored
+	checkagrees(replaced(PICKSTRING, "\"Phase\":\"P\",", "\"Phase\":7,"),
+				true);
+	checkagrees(replaced(PICKSTRING, "\"Polarity\":\"up\",",
+				"\"Polarity\":[\"x\"],"), true);
+
+	// the limits themselves are valid
+	checkagrees(replaced(STATIONSTRING, "\"Latitude\":40.3344",
+				"\"Latitude\":90.0"), true);
+	checkagrees(replaced(STATIONSTRING, "\"Elevation\":1589.0",
+				"\"Elevation\":-500.0"), true);
+	checkagrees(replaced(DETECTIONSTRING, "\"Depth\":32.44",
+				"\"Depth\":1500.0"), true);
+
+	// classification distances may be integers
+	checkagrees(replaced(PICKSTRING, "\"AssociationInfo\":{",
+				"\"ClassificationInfo\":{\"Distance\":12},"
+				"\"AssociationInfo\":{"), true);
+}
+
+// tests to see if invalid messages do not validate
+TEST(ValidatorTest, RejectsMessages) {
+	// missing and empty required keys
+	checkagrees(replaced(PICKSTRING, "\"ID\":\"12GFH48776857\",", ""), false);
+	checkagrees(replaced(PICKSTRING, "\"ID\":\"12GFH48776857\",",
+				"\"ID\":\"\","), false);
+	checkagrees(replaced(PICKSTRING, "\"Station\":\"BMN\",", ""), false);
+	checkagrees(replaced(RETRACTSTRING, "\"Author\":\"TestAuthor\"",
+				"\"Author\":null"), false);
+	checkagrees(replaced(CORRELATIONSTRING, "\"Correlation\":2.65,",
+				"\"Correlation\":2,"), false);
+	checkagrees(replaced(STATIONSTRING, "\"Latitude\":40.3344,", ""), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"Latitude\":40.3344,", ""),
+				false);
+
+	// wrong type
+	checkagrees(replaced(RETRACTSTRING, "\"Type\":\"Retract\"",
+				"\"Type\":\"Retract\",\"Type\":\"Pick\""), false);
+
+	// out of range values
+	checkagrees(replaced(PICKSTRING, "\"Period\":2.65", "\"Period\":-2.65"),
+				false);
+	checkagrees(replaced(STATIONSTRING, "\"Elevation\":1589.0",
+				"\"Elevation\":9589.0"), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"Gap\":33.67", "\"Gap\":433.67"),
+				false);
+	checkagrees(replaced(PICKSTRING, "\"AssociationInfo\":{",
+				"\"ClassificationInfo\":{\"Distance\":180},"
+				"\"AssociationInfo\":{"), false);
+	checkagrees(replaced(STATIONSTRING, "\"Latitude\":40.3344",
+				"\"Latitude\":90.5"), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"Longitude\":-121.44",
+				"\"Longitude\":-180.5"), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"Depth\":32.44",
+				"\"Depth\":1500.5"), false);
+	checkagrees(replaced(CORRELATIONSTRING, "\"Magnitude\":2.14",
+				"\"Magnitude\":-2.5"), false);
+	checkagrees(replaced(PICKSTRING, "\"SNR\":3.8",
+				"\"SNR\":1.0e10"), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"RMS\":3.8",
+				"\"RMS\":-10000.5"), false);
+	checkagrees(replaced(PICKSTRING, "\"AssociationInfo\":{",
+				"\"ClassificationInfo\":{\"Azimuth\":360},"
+				"\"AssociationInfo\":{"), false);
+
+	// bad enums and phases
+	checkagrees(replaced(PICKSTRING, "\"Polarity\":\"up\"",
+				"\"Polarity\":\"sideways\""), false);
+	checkagrees(replaced(DETECTIONSTRING, "\"Certainty\":\"Suspected\"",
+				"\"Certainty\":\"Maybe\""), false);
+	checkagrees(replaced(PICKSTRING, "\"Phase\":\"P\"", "\"Phase\":\"P1\""),
+				false);
+
+	// incomplete optional members
+	checkagrees(replaced(PICKSTRING, "\"Beam\":{\"BackAzimuth\":2.65,",
+				"\"Beam\":{"), false);
+	checkagrees(replaced(PICKSTRING, "\"AssociationInfo\":{",
+				"\"ClassificationInfo\":{\"Source\":{\"Author\":\"A\"}},"
+				"\"AssociationInfo\":{"), false);
+
+	// not messages
+	checkagrees(BADMESSAGE, false);
+	checkagrees(BADMESSAGE2, false);
+	checkagrees(std::string(PICKSTRING) + "}", false);
+}
+
+// tests to see if detection data elements are checked by their type
+TEST(ValidatorTest, ChecksDataElements) {
+	std::string detection = DETECTIONSTRING;
+	std::string data = "\"Data\":[";
+
+	// an invalid pick
+	checkagrees(replaced(detection, data,
+				data + "{\"Type\":\"Pick\",\"ID\":\"1\"},"), false);
+
+	// an invalid correlation, the type comes after the members
+	checkagrees(replaced(detection, data,
+				data + "{\"ID\":\"1\",\"Polarity\":\"up\","
+				"\"Type\":\"Correlation\"},"), false);
+
+	// elements of other types are not decoded
+	checkagrees(replaced(detection, data,
+				data + "{\"Type\":\"Retract\",\"ID\":\"1\"},"), true);
+	checkagrees(replaced(detection, data, data + "{\"ID\":\"1\"},2,[],"),
+				true);
+}
+
+// tests to see if validation stops at the first error
+TEST(ValidatorTest, StopsAtFirstError) {
+	detectionformats::codec_context context;
+	std::string pickstring = replaced(PICKSTRING,
+			"\"ID\":\"12GFH48776857\"", "\"ID\":\"\",\"Polarity\":\"sideways\"");
+
+	ASSERT_FALSE(detectionformats::ValidateJSON(pickstring, context));
+	ASSERT_EQ(context.getreader().GetParseErrorCode(),
+				rapidjson::kParseErrorTermination);
+	ASSERT_LT(context.getreader().GetErrorOffset(),
+				pickstring.find("\"Site\""));
+}
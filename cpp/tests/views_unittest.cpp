@@ -0,0 +1,142 @@
+#include <detection-formats.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+// test data
+#include "unittest_data.h" // NOLINT
+
+// returns a mutable, null terminated copy of the json to parse in place
+std::vector<char> makebuffer(const char *json) {
+	std::string jsonstring(json);
+	return (std::vector<char>(jsonstring.c_str(),
+								jsonstring.c_str() + jsonstring.length() + 1));
+}
+
+// tests the string view
+TEST(ViewsTest, StringView) {
+	detectionformats::string_view empty;
+	ASSERT_TRUE(empty.empty());
+	ASSERT_TRUE(empty == "");
+
+	const char *text = "BMNHHZ";
+	detectionformats::string_view station(text, 3);
+	ASSERT_EQ(station.size(), 3);
+	ASSERT_TRUE(station == "BMN");
+	ASSERT_TRUE(station == std::string("BMN"));
+	ASSERT_TRUE(station != "BMNHHZ");
+	ASSERT_TRUE(station != detectionformats::string_view(text + 3, 3));
+	ASSERT_STREQ(station.str().c_str(), "BMN");
+}
+
+// tests that a pick view reads a pick in place and converts back
+TEST(ViewsTest, PickView) {
+	detectionformats::codec_context context;
+	std::vector<char> buffer = makebuffer(PICKSTRING);
+
+	detectionformats::pick_view view;
+	detectionformats::FromJSONInsitu(buffer.data(), view, context);
+
+	// the strings point into the buffer
+	ASSERT_TRUE(view.id == ID);
+	ASSERT_GE(view.id.data(), buffer.data());
+	ASSERT_LT(view.id.data(), buffer.data() + buffer.size());
+	ASSERT_TRUE(view.site.station == "BMN");
+	ASSERT_TRUE(view.site.network == "LB");
+	ASSERT_TRUE(view.source.author == "TestAuthor");
+	ASSERT_TRUE(view.phase == "P");
+	ASSERT_TRUE(view.associationinfo.phase == "P");
+
+	// the numbers and enums are decoded
+	ASSERT_EQ(view.time, detectionformats::ConvertISO8601ToEpochTime(
+			std::string("2015-12-28T21:32:24.017Z")));
+	ASSERT_EQ(view.polarity, detectionformats::polarityindex::up);
+	ASSERT_EQ(view.amplitude.ampvalue, 1.05);
+	ASSERT_EQ(view.associationinfo.distance, 0.442559);
+	ASSERT_TRUE(view.filterdata != NULL);
+	ASSERT_TRUE(view.classificationinfo == NULL);
+
+	// the owning pick matches the decoded one
+	detectionformats::pick pickobject;
+	detectionformats::FromJSONString(std::string(PICKSTRING), pickobject);
+	detectionformats::pick viewobject = view.topick();
+	ASSERT_STREQ(detectionformats::ToJSONString(viewobject).c_str(),
+					detectionformats::ToJSONString(pickobject).c_str());
+
+	// the text of an invalid value is a view too
+	std::vector<char> badbuffer = makebuffer(BADPICKSTRING);
+	detectionformats::FromJSONInsitu(badbuffer.data(), view, context);
+	ASSERT_EQ(view.polarity, detectionformats::polarityindex::unknownpolarity);
+	ASSERT_TRUE(view.polaritytext == BADPOLARITY);
+	detectionformats::pick badobject = view.topick();
+	ASSERT_STREQ(detectionformats::ToJSONString(badobject).c_str(),
+					BADPICKSTRING);
+}
+
+// tests that a correlation view reads a correlation in place
+TEST(ViewsTest, CorrelationView) {
+	detectionformats::codec_context context;
+	std::vector<char> buffer = makebuffer(CORRELATIONSTRING);
+
+	detectionformats::correlation_view view;
+	detectionformats::FromJSONInsitu(buffer.data(), view, context);
+
+	ASSERT_TRUE(view.type == "Correlation");
+	ASSERT_TRUE(view.thresholdtype == "minimum");
+	ASSERT_EQ(view.correlationvalue, 2.65);
+	ASSERT_EQ(view.hypocenter.latitude, 40.3344);
+
+	detectionformats::correlation correlationobject;
+	detectionformats::FromJSONString(std::string(CORRELATIONSTRING),
+										correlationobject);
+	detectionformats::correlation viewobject = view.tocorrelation();
+	ASSERT_STREQ(detectionformats::ToJSONString(viewobject).c_str(),
+					detectionformats::ToJSONString(correlationobject).c_str());
+}
+
+// tests that a detection view reads its data as views
+TEST(ViewsTest, DetectionView) {
+	detectionformats::codec_context context;
+	std::vector<char> buffer = makebuffer(DETECTIONSTRING);
+
+	detectionformats::detection_view view;
+	detectionformats::FromJSONInsitu(buffer.data(), view, context);
+
+	ASSERT_TRUE(view.id == ID);
+	ASSERT_EQ(view.detectiontype,
+				detectionformats::detectiontypeindex::newdetection);
+	ASSERT_EQ(view.pickdata.size(), 1);
+	ASSERT_EQ(view.correlationdata.size(), 1);
+	ASSERT_TRUE(view.pickdata[0].site.station == "BMN");
+	ASSERT_TRUE(view.correlationdata[0].thresholdtype == "minimum");
+
+	detectionformats::detection detectionobject;
+	detectionformats::FromJSONString(std::string(DETECTIONSTRING),
+										detectionobject);
+	detectionformats::detection viewobject = view.todetection();
+	ASSERT_STREQ(detectionformats::ToJSONString(viewobject).c_str(),
+					detectionformats::ToJSONString(detectionobject).c_str());
+
+	// reading again resets the view
+	buffer = makebuffer(DETECTIONSTRING);
+	detectionformats::FromJSONInsitu(buffer.data(), view, context);
+	ASSERT_EQ(view.pickdata.size(), 1);
+	ASSERT_EQ(view.correlationdata.size(), 1);
+}
+
+// tests that invalid json is rejected
+TEST(ViewsTest, RejectsInvalidJSON) {
+	detectionformats::codec_context context;
+	detectionformats::pick_view view;
+
+	std::vector<char> buffer = makebuffer("{\"Type\":");
+	ASSERT_THROW(detectionformats::FromJSONInsitu(buffer.data(), view,
+													context),
+					std::invalid_argument);
+
+	buffer = makebuffer("[1,2]");
+	ASSERT_THROW(detectionformats::FromJSONInsitu(buffer.data(), view,
+													context),
+					std::invalid_argument);
+}
@@ -0,0 +1,84 @@
+#include <workqueue.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// tests to see if a single worker gets every item in order
+TEST(WorkQueueTest, HandsOutInOrder) {
+	detectionformats::workqueue queue(10, 1, 4);
+	size_t begin;
+	size_t end;
+
+	ASSERT_EQ(queue.getworkers(), 1);
+	ASSERT_TRUE(queue.next(0, &begin, &end));
+	ASSERT_EQ(begin, 0);
+	ASSERT_EQ(end, 4);
+	ASSERT_TRUE(queue.next(0, &begin, &end));
+	ASSERT_EQ(begin, 4);
+	ASSERT_EQ(end, 8);
+	ASSERT_TRUE(queue.next(0, &begin, &end));
+	ASSERT_EQ(begin, 8);
+	ASSERT_EQ(end, 10);
+	ASSERT_FALSE(queue.next(0, &begin, &end));
+
+	// bad worker
+	ASSERT_FALSE(queue.next(1, &begin, &end));
+
+	// nothing to do
+	detectionformats::workqueue empty(0, 4);
+	ASSERT_FALSE(empty.next(2, &begin, &end));
+}
+
+// tests to see if a worker steals the items of a worker that never runs
+TEST(WorkQueueTest, StealsWork) {
+	detectionformats::workqueue queue(100, 4, 8);
+	std::vector<int> handedout(100, 0);
+	size_t begin;
+	size_t end;
+
+	while (queue.next(3, &begin, &end) == true) {
+		for (size_t i = begin; i < end; i++) {
+			handedout[i]++;
+		}
+	}
+
+	for (int i = 0; i < 100; i++) {
+		ASSERT_EQ(handedout[i], 1) << i;
+	}
+	ASSERT_FALSE(queue.next(0, &begin, &end));
+}
+
+// tests to see if concurrent workers get each item exactly once
+TEST(WorkQueueTest, HandsOutOnce) {
+	const int count = 100000;
+	const int workers = 8;
+	detectionformats::workqueue queue(count, workers, 16);
+	std::unique_ptr<std::atomic<int>[]> handedout(
+			new std::atomic<int>[count]);
+	for (int i = 0; i < count; i++) {
+		handedout[i] = 0;
+	}
+
+	std::vector<std::thread> threads;
+	for (int worker = 0; worker < workers; worker++) {
+		threads.emplace_back([&queue, &handedout, worker]() {
+			size_t begin;
+			size_t end;
+			while (queue.next(worker, &begin, &end) == true) {
+				for (size_t i = begin; i < end; i++) {
+					handedout[i]++;
+				}
+			}
+		});
+	}
+	for (int i = 0; i < workers; i++) {
+		threads[i].join();
+	}
+
+	for (int i = 0; i < count; i++) {
+		ASSERT_EQ(handedout[i], 1) << i;
+	}
+}